@@ -0,0 +1,512 @@
+#include "CNSDKBench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+#if !defined(__GNUC__) && !defined(__clang__)
+const void* volatile g_benchSink = nullptr;
+#endif
+
+typedef std::chrono::steady_clock Clock;
+
+static double TimeBody(const std::function<void(std::uint64_t)>& body, std::uint64_t iterations)
+{
+    const Clock::time_point start = Clock::now();
+    body(iterations);
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Linear interpolation between the closest ranks of sorted samples.
+static double Percentile(const std::vector<double>& sorted, double percent)
+{
+    const double position = (percent / 100.0) * (double)(sorted.size() - 1);
+    const size_t index    = (size_t)position;
+    if (index + 1 >= sorted.size())
+        return sorted.back();
+
+    const double t = position - (double)index;
+    return sorted[index] + (sorted[index + 1] - sorted[index]) * t;
+}
+
+// Nanoseconds, or the larger unit that keeps the number short.
+static void PrintTime(double ns)
+{
+    if (ns < 1e3)
+        printf("%9.2f ns", ns);
+    else if (ns < 1e6)
+        printf("%9.2f us", ns * 1e-3);
+    else
+        printf("%9.2f ms", ns * 1e-6);
+}
+
+bool Bench::isSelected(const std::string& name) const
+{
+    if (!m_settings.filter.empty() && (name.find(m_settings.filter) == std::string::npos))
+        return false;
+
+    if (m_settings.listOnly)
+    {
+        printf("%s\n", name.c_str());
+        return false;
+    }
+    return true;
+}
+
+void Bench::run(const std::string& name, const std::function<void(std::uint64_t)>& body, double itemsPerCall, double bytesPerCall)
+{
+    if (!isSelected(name))
+        return;
+
+    // Grow the iteration count until one repetition takes the minimum time.
+    std::uint64_t iterations = 1;
+    for (;;)
+    {
+        const double elapsed = TimeBody(body, iterations);
+        if (elapsed >= m_settings.minTime)
+            break;
+
+        const double scale = (elapsed > 0.0) ? std::min(m_settings.minTime * 1.2 / elapsed, 10.0) : 10.0;
+        iterations = std::max(iterations + 1, (std::uint64_t)((double)iterations * scale));
+    }
+
+    for (int i = 0; i < m_settings.warmup; i++)
+        TimeBody(body, iterations);
+
+    const int repetitions = std::max(m_settings.repetitions, 1);
+    std::vector<double> samples((size_t)repetitions);
+    for (double& sample : samples)
+        sample = TimeBody(body, iterations) * 1e9 / (double)iterations;
+
+    BenchResult result;
+    result.name         = name;
+    result.iterations   = iterations;
+    result.repetitions  = repetitions;
+    result.itemsPerCall = itemsPerCall;
+    result.bytesPerCall = bytesPerCall;
+
+    double sum = 0.0;
+    for (double sample : samples)
+        sum += sample;
+    result.mean = sum / (double)repetitions;
+
+    double variance = 0.0;
+    for (double sample : samples)
+        variance += (sample - result.mean) * (sample - result.mean);
+    result.stddev = (repetitions > 1) ? sqrt(variance / (double)(repetitions - 1)) : 0.0;
+
+    std::sort(samples.begin(), samples.end());
+    result.min = samples.front();
+    result.p50 = Percentile(samples, 50.0);
+    result.p90 = Percentile(samples, 90.0);
+    result.p99 = Percentile(samples, 99.0);
+
+    printf("%-56s", name.c_str());
+    PrintTime(result.p50);
+    printf("  p90");
+    PrintTime(result.p90);
+    printf("  min");
+    PrintTime(result.min);
+    if (bytesPerCall > 0.0)
+        printf("  %8.2f GB/s", bytesPerCall / result.p50);
+    else if (itemsPerCall != 1.0)
+        printf("  %8.2f M/s", itemsPerCall * 1e3 / result.p50);
+    printf("\n");
+    fflush(stdout);
+
+    m_results.push_back(result);
+}
+
+void Bench::metric(const std::string& name, double value, const char* unit, double bound)
+{
+    if (!isSelected(name))
+        return;
+
+    metric(name, value, unit);
+    if (!(value <= bound))
+    {
+        printf("%-56s FAILED, exceeds the bound of %.4g %s\n", name.c_str(), bound, unit);
+        fflush(stdout);
+        m_failureCount++;
+    }
+}
+
+void Bench::metric(const std::string& name, double value, const char* unit)
+{
+    if (!isSelected(name))
+        return;
+
+    printf("%-56s %12.4g %s\n", name.c_str(), value, unit);
+    fflush(stdout);
+
+    BenchMetric metric;
+    metric.name  = name;
+    metric.value = value;
+    metric.unit  = unit;
+    m_metrics.push_back(metric);
+}
+
+void Bench::setContext(const std::string& key, const std::string& value)
+{
+    m_context.push_back(std::make_pair(key, value));
+}
+
+static void WriteJSONString(FILE* file, const std::string& value)
+{
+    fputc('"', file);
+    for (char c : value)
+    {
+        if ((c == '"') || (c == '\\'))
+            fprintf(file, "\\%c", c);
+        else if ((unsigned char)c < 0x20)
+            fprintf(file, "\\u%04x", (unsigned)c);
+        else
+            fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+bool Bench::writeJSON(const char* filename) const
+{
+    FILE* file = fopen(filename, "w");
+    if (file == nullptr)
+        return false;
+
+    fprintf(file, "{\n  \"context\": {");
+    for (size_t i = 0; i < m_context.size(); i++)
+    {
+        fprintf(file, "%s\n    ", (i == 0) ? "" : ",");
+        WriteJSONString(file, m_context[i].first);
+        fprintf(file, ": ");
+        WriteJSONString(file, m_context[i].second);
+    }
+    fprintf(file, "\n  },\n  \"benchmarks\": [");
+
+    for (size_t i = 0; i < m_results.size(); i++)
+    {
+        const BenchResult& r = m_results[i];
+        fprintf(file, "%s\n    { \"name\": ", (i == 0) ? "" : ",");
+        WriteJSONString(file, r.name);
+        fprintf(file, ", \"iterations\": %llu, \"repetitions\": %d, \"items_per_call\": %.9g, \"bytes_per_call\": %.9g,\n", (unsigned long long)r.iterations, r.repetitions, r.itemsPerCall, r.bytesPerCall);
+        fprintf(file, "      \"ns\": { \"min\": %.6g, \"p50\": %.6g, \"p90\": %.6g, \"p99\": %.6g, \"mean\": %.6g, \"stddev\": %.6g } }", r.min, r.p50, r.p90, r.p99, r.mean, r.stddev);
+    }
+    fprintf(file, "\n  ],\n  \"metrics\": [");
+
+    for (size_t i = 0; i < m_metrics.size(); i++)
+    {
+        const BenchMetric& m = m_metrics[i];
+        fprintf(file, "%s\n    { \"name\": ", (i == 0) ? "" : ",");
+        WriteJSONString(file, m.name);
+        fprintf(file, ", \"value\": %.9g, \"unit\": ", m.value);
+        WriteJSONString(file, m.unit);
+        fprintf(file, " }");
+    }
+    fprintf(file, "\n  ]\n}\n");
+
+    return fclose(file) == 0;
+}
+
+// Minimal JSON reader for the files written above.
+struct JSONValue
+{
+    enum class Type
+    {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    Type                                           type   = Type::Null;
+    double                                         number = 0.0;
+    std::string                                    string;
+    std::vector<JSONValue>                         items;
+    std::vector<std::pair<std::string, JSONValue>> members;
+
+    const JSONValue* find(const char* key) const
+    {
+        for (const auto& member : members)
+        {
+            if (member.first == key)
+                return &member.second;
+        }
+        return nullptr;
+    }
+};
+
+class JSONParser
+{
+public:
+
+    explicit JSONParser(const std::string& text) : m_text(text) {}
+
+    bool parse(JSONValue& value)
+    {
+        if (!parseValue(value, 0))
+            return false;
+        skipSpace();
+        return m_pos == m_text.size();
+    }
+
+private:
+
+    void skipSpace()
+    {
+        while ((m_pos < m_text.size()) && ((m_text[m_pos] == ' ') || (m_text[m_pos] == '\t') || (m_text[m_pos] == '\n') || (m_text[m_pos] == '\r')))
+            m_pos++;
+    }
+
+    bool consume(char c)
+    {
+        skipSpace();
+        if ((m_pos < m_text.size()) && (m_text[m_pos] == c))
+        {
+            m_pos++;
+            return true;
+        }
+        return false;
+    }
+
+    bool consumeWord(const char* word)
+    {
+        const size_t length = strlen(word);
+        if (m_text.compare(m_pos, length, word) != 0)
+            return false;
+        m_pos += length;
+        return true;
+    }
+
+    bool parseString(std::string& out)
+    {
+        if (!consume('"'))
+            return false;
+
+        while (m_pos < m_text.size())
+        {
+            const char c = m_text[m_pos++];
+            if (c == '"')
+                return true;
+            if (c != '\\')
+            {
+                out += c;
+                continue;
+            }
+            if (m_pos >= m_text.size())
+                return false;
+
+            const char escaped = m_text[m_pos++];
+            switch (escaped)
+            {
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            case 'r': out += '\r'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'u':
+                // Only the control characters WriteJSONString escapes.
+                if (m_pos + 4 > m_text.size())
+                    return false;
+                out += (char)strtol(m_text.substr(m_pos, 4).c_str(), nullptr, 16);
+                m_pos += 4;
+                break;
+            default:   out += escaped; break;
+            }
+        }
+        return false;
+    }
+
+    bool parseValue(JSONValue& value, int depth)
+    {
+        if (depth > 32)
+            return false;
+
+        skipSpace();
+        if (m_pos >= m_text.size())
+            return false;
+
+        const char c = m_text[m_pos];
+        if (c == '{')
+        {
+            m_pos++;
+            value.type = JSONValue::Type::Object;
+            if (consume('}'))
+                return true;
+            do
+            {
+                std::pair<std::string, JSONValue> member;
+                if (!parseString(member.first) || !consume(':') || !parseValue(member.second, depth + 1))
+                    return false;
+                value.members.push_back(std::move(member));
+            } while (consume(','));
+            return consume('}');
+        }
+        if (c == '[')
+        {
+            m_pos++;
+            value.type = JSONValue::Type::Array;
+            if (consume(']'))
+                return true;
+            do
+            {
+                value.items.emplace_back();
+                if (!parseValue(value.items.back(), depth + 1))
+                    return false;
+            } while (consume(','));
+            return consume(']');
+        }
+        if (c == '"')
+        {
+            value.type = JSONValue::Type::String;
+            return parseString(value.string);
+        }
+        if (consumeWord("true") || consumeWord("false"))
+        {
+            value.type   = JSONValue::Type::Bool;
+            value.number = (m_text[m_pos - 2] == 'u') ? 1.0 : 0.0;
+            return true;
+        }
+        if (consumeWord("null"))
+            return true;
+
+        char* end = nullptr;
+        value.type   = JSONValue::Type::Number;
+        value.number = strtod(m_text.c_str() + m_pos, &end);
+        if (end == m_text.c_str() + m_pos)
+            return false;
+        m_pos = (size_t)(end - m_text.c_str());
+        return true;
+    }
+
+    const std::string& m_text;
+    size_t             m_pos = 0;
+};
+
+static bool ReadJSONFile(const char* filename, JSONValue& value)
+{
+    FILE* file = fopen(filename, "rb");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "Can't open %s\n", filename);
+        return false;
+    }
+
+    std::string text;
+    char buffer[4096];
+    size_t bytes;
+    while ((bytes = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        text.append(buffer, bytes);
+    fclose(file);
+
+    JSONParser parser(text);
+    if (!parser.parse(value) || (value.type != JSONValue::Type::Object))
+    {
+        fprintf(stderr, "%s is not a benchmark result file\n", filename);
+        return false;
+    }
+    return true;
+}
+
+// Name to value of a statistic for every benchmark, and of every metric.
+static void CollectValues(const JSONValue& root, const char* statistic, std::map<std::string, double>& times, std::map<std::string, double>& metrics)
+{
+    const JSONValue* benchmarks = root.find("benchmarks");
+    if (benchmarks != nullptr)
+    {
+        for (const JSONValue& benchmark : benchmarks->items)
+        {
+            const JSONValue* name = benchmark.find("name");
+            const JSONValue* ns   = benchmark.find("ns");
+            const JSONValue* stat = (ns != nullptr) ? ns->find(statistic) : nullptr;
+            if ((name != nullptr) && (stat != nullptr))
+                times[name->string] = stat->number;
+        }
+    }
+
+    const JSONValue* metricList = root.find("metrics");
+    if (metricList != nullptr)
+    {
+        for (const JSONValue& metric : metricList->items)
+        {
+            const JSONValue* name  = metric.find("name");
+            const JSONValue* value = metric.find("value");
+            if ((name != nullptr) && (value != nullptr))
+                metrics[name->string] = value->number;
+        }
+    }
+}
+
+// Print one row per name in both maps and count the changes for the worse beyond the threshold.
+// Names in only one of the maps, e.g. from a filtered run, are counted.
+static int CompareValues(const std::map<std::string, double>& baseline, const std::map<std::string, double>& current, double thresholdPercent, bool isTime)
+{
+    int regressions = 0;
+    int added       = 0;
+    for (const auto& entry : current)
+    {
+        const auto old = baseline.find(entry.first);
+        if (old == baseline.end())
+        {
+            added++;
+            continue;
+        }
+
+        const double before = old->second;
+        const double after  = entry.second;
+        double change = 0.0;
+        if (before != 0.0)
+            change = (after - before) / fabs(before) * 100.0;
+        else if (after != 0.0)
+            change = HUGE_VAL;
+
+        const char* flag = "";
+        if (change > thresholdPercent)
+        {
+            flag = "REGRESSION";
+            regressions++;
+        }
+        else if (change < -thresholdPercent)
+        {
+            flag = isTime ? "faster" : "better";
+        }
+
+        printf("%-56s %12.4g -> %-12.4g %+8.1f%%  %s\n", entry.first.c_str(), before, after, change, flag);
+    }
+
+    int removed = 0;
+    for (const auto& entry : baseline)
+    {
+        if (current.find(entry.first) == current.end())
+            removed++;
+    }
+    if ((added > 0) || (removed > 0))
+        printf("(%d only in the baseline, %d only in the current run)\n", removed, added);
+    return regressions;
+}
+
+int CompareBenchFiles(const char* baseline, const char* current, double thresholdPercent, const char* statistic)
+{
+    JSONValue baselineRoot, currentRoot;
+    if (!ReadJSONFile(baseline, baselineRoot) || !ReadJSONFile(current, currentRoot))
+        return -1;
+
+    std::map<std::string, double> baselineTimes, baselineMetrics, currentTimes, currentMetrics;
+    CollectValues(baselineRoot, statistic, baselineTimes, baselineMetrics);
+    CollectValues(currentRoot, statistic, currentTimes, currentMetrics);
+
+    printf("Benchmark %s ns/iteration, %s -> %s, threshold %.1f%%\n\n", statistic, baseline, current, thresholdPercent);
+    int regressions = CompareValues(baselineTimes, currentTimes, thresholdPercent, true);
+
+    if (!currentMetrics.empty() || !baselineMetrics.empty())
+    {
+        printf("\nMetrics (lower is better)\n\n");
+        regressions += CompareValues(baselineMetrics, currentMetrics, thresholdPercent, false);
+    }
+
+    printf("\n%d regression%s\n", regressions, (regressions == 1) ? "" : "s");
+    return regressions;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <stddef.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Microbenchmark harness of cnsdk_math_bench.
+//
+// A benchmark is a body taking an iteration count and running the measured operation that many
+// times. The harness calibrates the count so one repetition takes at least the minimum time, runs
+// untimed warmup repetitions, then records one sample per timed repetition. Results are reported
+// in nanoseconds per iteration as min, percentiles, mean and standard deviation of the samples.
+
+// Make the compiler assume value is read, so the computation producing it is kept.
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    extern const void* volatile g_benchSink;
+    g_benchSink = &value;
+#endif
+}
+
+// Small deterministic generator for benchmark inputs, so every run measures the same data.
+class BenchRandom
+{
+public:
+
+    explicit BenchRandom(std::uint32_t seed = 1) : m_state(seed) {}
+
+    std::uint32_t next()
+    {
+        m_state = m_state * 1664525u + 1013904223u;
+        return m_state;
+    }
+
+    // Uniform in [lo, hi).
+    float nextFloat(float lo = 0.0f, float hi = 1.0f)
+    {
+        return lo + (hi - lo) * (float)(next() >> 8) * (1.0f / 16777216.0f);
+    }
+
+private:
+
+    std::uint32_t m_state;
+};
+
+struct BenchSettings
+{
+    int         warmup      = 3;    // Untimed repetitions after calibration
+    int         repetitions = 30;   // Timed repetitions, one sample each
+    double      minTime     = 2e-3; // Seconds per repetition the iteration count is calibrated to
+    std::string filter;             // Only run benchmarks whose name contains this
+    bool        listOnly    = false;
+    bool        slow        = false; // Also run benchmarks taking minutes per repetition
+};
+
+struct BenchResult
+{
+    std::string   name;
+    std::uint64_t iterations   = 0; // Per repetition
+    int           repetitions  = 0;
+    double        itemsPerCall = 1.0;
+    double        bytesPerCall = 0.0;
+
+    // Nanoseconds per iteration.
+    double        min          = 0.0;
+    double        p50          = 0.0;
+    double        p90          = 0.0;
+    double        p99          = 0.0;
+    double        mean         = 0.0;
+    double        stddev       = 0.0;
+};
+
+// Measured quantity other than time, e.g. the error of an approximation. Lower is better.
+struct BenchMetric
+{
+    std::string name;
+    double      value = 0.0;
+    std::string unit;
+};
+
+class Bench
+{
+public:
+
+    explicit Bench(const BenchSettings& settings) : m_settings(settings) {}
+
+    // Whether a benchmark of this name is selected by the filter. In list mode the name is
+    // printed and false returned. Use to skip expensive setup of unselected benchmarks.
+    bool isSelected(const std::string& name) const;
+
+    // Measure body(iterations). itemsPerCall and bytesPerCall describe one iteration, for the
+    // throughput columns.
+    void run(const std::string& name, const std::function<void(std::uint64_t)>& body, double itemsPerCall = 1.0, double bytesPerCall = 0.0);
+
+    // Record a metric, if its name is selected.
+    void metric(const std::string& name, double value, const char* unit);
+
+    // Record a metric that must not exceed bound, e.g. a documented error bound. A value above
+    // it is reported and counted in getFailureCount().
+    void metric(const std::string& name, double value, const char* unit, double bound);
+
+    // Describe the build or machine in the JSON output.
+    void setContext(const std::string& key, const std::string& value);
+
+    const BenchSettings&            getSettings() const { return m_settings; }
+    const std::vector<BenchResult>& getResults() const { return m_results; }
+    const std::vector<BenchMetric>& getMetrics() const { return m_metrics; }
+    int                             getFailureCount() const { return m_failureCount; }
+
+    // Write the context, results and metrics.
+    bool writeJSON(const char* filename) const;
+
+private:
+
+    BenchSettings                                    m_settings;
+    std::vector<BenchResult>                         m_results;
+    std::vector<BenchMetric>                         m_metrics;
+    std::vector<std::pair<std::string, std::string>> m_context;
+    int                                              m_failureCount = 0;
+};
+
+// Compare the results of two JSON files on a statistic ("min", "p50", "p90", "p99" or "mean")
+// and print the change of every benchmark and metric present in both. Changes worse than
+// thresholdPercent are flagged. Returns the number of regressions, or -1 if a file can't be read.
+int CompareBenchFiles(const char* baseline, const char* current, double thresholdPercent, const char* statistic);
+
+// Benchmark suites.
+void RunMathBenchmarks(Bench& bench);
+void RunKernelBenchmarks(Bench& bench);
@@ -0,0 +1,1224 @@
+// Benchmarks of the image and batch kernels: sRGB conversion and pixel conversion for every kernel
+// set the CPU supports (with an exhaustive check of the pixel kernels against the scalar ones),
+// batch transforms and culling by thread count, the software rasterizer's stereo frames by thread
+// count, TGA decoding from memory (a synthetic stereo frame, the bundled TILE.TGA and an 8K
+// side-by-side frame, also decoded in bands by thread count) and from files, the image cache,
+// texture files and the frame source's time to first frame. On Linux, image loading at startup is
+// also measured once per loader in a forked child, for its time and peak RSS.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CNSDKBench.h"
+#include "CNSDKGettingStartedCulling.h"
+#include "CNSDKGettingStartedFile.h"
+#include "CNSDKGettingStartedFrameSource.h"
+#include "CNSDKGettingStartedImageCache.h"
+#include "CNSDKGettingStartedMesh.h"
+#include "CNSDKGettingStartedPixels.h"
+#include "CNSDKGettingStartedSoftwareBackend.h"
+#include "CNSDKGettingStartedSRGB.h"
+#include "CNSDKGettingStartedTGA.h"
+#include "CNSDKGettingStartedTexture.h"
+#include "CNSDKGettingStartedThreadPool.h"
+#include "CNSDKGettingStartedTransforms.h"
+
+#if defined(__linux__)
+#include <malloc.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// Size of the synthetic images, a typical side-by-side stereo frame.
+const int kImageWidth  = 2048;
+const int kImageHeight = 1024;
+
+// Synthetic 8K side-by-side frame, two 3840 x 2160 views.
+const int k8KImageWidth  = 7680;
+const int k8KImageHeight = 2160;
+
+// Large image for the startup benchmarks, about 100 MB uncompressed.
+const int kLargeImageWidth  = 8192;
+const int kLargeImageHeight = 3072;
+
+static std::vector<PixelKernelSet> GetSupportedKernelSets()
+{
+    std::vector<PixelKernelSet> kernelSets;
+    for (PixelKernelSet kernelSet : { PixelKernelSet::Scalar, PixelKernelSet::SSSE3, PixelKernelSet::AVX2, PixelKernelSet::NEON })
+    {
+        if (IsPixelKernelSetSupported(kernelSet))
+            kernelSets.push_back(kernelSet);
+    }
+    return kernelSets;
+}
+
+// Thread counts to measure scaling at: powers of two up to the hardware threads, and that count.
+static std::vector<int> GetThreadCounts()
+{
+    const int hardwareThreads = std::max((int)std::thread::hardware_concurrency(), 1);
+
+    std::vector<int> counts;
+    for (int count = 1; count < hardwareThreads; count *= 2)
+        counts.push_back(count);
+    counts.push_back(hardwareThreads);
+    return counts;
+}
+
+static void RunSRGBBenchmarks(Bench& bench)
+{
+    const size_t kPixelCount = (size_t)kImageWidth * 256;
+    const size_t kValueCount = kPixelCount * 4;
+
+    std::vector<std::uint8_t> encoded(kValueCount);
+    std::vector<float>        linear(kValueCount), converted(kValueCount);
+    BenchRandom random(7);
+    for (size_t i = 0; i < kValueCount; i++)
+    {
+        encoded[i] = (std::uint8_t)(random.next() >> 24);
+        linear[i]  = random.nextFloat();
+    }
+
+    const PixelKernelSet selected = GetPixelKernelSet();
+    for (PixelKernelSet kernelSet : GetSupportedKernelSets())
+    {
+        SetPixelKernelSet(kernelSet);
+        const std::string suffix = std::string("/") + GetPixelKernelSetName(kernelSet);
+
+        bench.run("srgb/SRGBToLinear" + suffix,   [&](std::uint64_t n) { for (std::uint64_t i = 0; i < n; i++) SRGBToLinear(converted.data(), linear.data(), kValueCount); DoNotOptimize(converted[0]); }, (double)kValueCount, (double)kValueCount * 4);
+        bench.run("srgb/LinearToSRGB" + suffix,   [&](std::uint64_t n) { for (std::uint64_t i = 0; i < n; i++) LinearToSRGB(converted.data(), linear.data(), kValueCount); DoNotOptimize(converted[0]); }, (double)kValueCount, (double)kValueCount * 4);
+        bench.run("srgb/SRGBA8ToLinear" + suffix, [&](std::uint64_t n) { for (std::uint64_t i = 0; i < n; i++) SRGBA8ToLinear(converted.data(), encoded.data(), kPixelCount); DoNotOptimize(converted[0]); }, (double)kPixelCount, (double)kPixelCount * 4);
+        bench.run("srgb/LinearToSRGBA8" + suffix, [&](std::uint64_t n) { for (std::uint64_t i = 0; i < n; i++) LinearToSRGBA8(encoded.data(), linear.data(), kPixelCount); DoNotOptimize(encoded[0]); }, (double)kPixelCount, (double)kPixelCount * 4);
+    }
+    SetPixelKernelSet(selected);
+
+    bench.run("srgb/SRGBToLinear/scalar_table", [&](std::uint64_t n)
+    {
+        for (std::uint64_t i = 0; i < n; i++)
+        {
+            for (size_t j = 0; j < kValueCount; j++)
+                converted[j] = SRGBToLinear(linear[j]);
+        }
+        DoNotOptimize(converted[0]);
+    }, (double)kValueCount, (double)kValueCount * 4);
+}
+
+static const char* GetPixelFormatName(PixelFormat format)
+{
+    switch (format)
+    {
+    case PixelFormat::RGB8:  return "RGB8";
+    case PixelFormat::BGR8:  return "BGR8";
+    case PixelFormat::RGBA8: return "RGBA8";
+    case PixelFormat::BGRA8: return "BGRA8";
+    default:                 return "Gray8";
+    }
+}
+
+// Exhaustive check of the vector kernels against the scalar ones: every format pair and
+// FillPixelChannel, every length up to kMaxPixels, source and destination at every offset from
+// 4-byte alignment. A case mismatches if any output byte differs or a byte past the output
+// changes. Reports the mismatching cases per conversion and kernel set; should be none.
+static void MeasurePixelAccuracy(Bench& bench)
+{
+    const int    kMaxPixels = 300;
+    const int    kMaxOffset = 4;
+    const size_t kGuard     = 64;
+    const PixelFormat formats[] = { PixelFormat::RGB8, PixelFormat::BGR8, PixelFormat::RGBA8, PixelFormat::BGRA8, PixelFormat::Gray8 };
+
+    std::vector<std::uint8_t> src(kMaxPixels * 4 + kMaxOffset);
+    BenchRandom random(4);
+    for (std::uint8_t& value : src)
+        value = (std::uint8_t)(random.next() >> 24);
+
+    const size_t              dstSize = kMaxPixels * 4 + kMaxOffset + kGuard;
+    std::vector<std::uint8_t> expected(dstSize), actual(dstSize);
+
+    // Run convert into expected with the scalar kernels and into actual with kernelSet, both
+    // buffers filled with the same pattern first, and compare the whole buffers.
+    auto compare = [&](PixelKernelSet kernelSet, const std::function<void(std::uint8_t*)>& convert)
+    {
+        std::vector<std::uint8_t>* buffers[2] = { &expected, &actual };
+        for (int i = 0; i < 2; i++)
+        {
+            for (size_t j = 0; j < dstSize; j++)
+                (*buffers[i])[j] = (std::uint8_t)(j * 7 + 1);
+
+            SetPixelKernelSet((i == 0) ? PixelKernelSet::Scalar : kernelSet);
+            convert(buffers[i]->data());
+        }
+        return (expected != actual) ? 1 : 0;
+    };
+
+    const PixelKernelSet selected = GetPixelKernelSet();
+    for (PixelKernelSet kernelSet : GetSupportedKernelSets())
+    {
+        if (kernelSet == PixelKernelSet::Scalar)
+            continue;
+        const std::string kernelSetName = GetPixelKernelSetName(kernelSet);
+
+        for (PixelFormat srcFormat : formats)
+        {
+            for (PixelFormat dstFormat : formats)
+            {
+                if (srcFormat == dstFormat)
+                    continue;
+
+                const std::string name = std::string("accuracy/pixels/") + GetPixelFormatName(srcFormat) + "->" + GetPixelFormatName(dstFormat) + "/" + kernelSetName + "/mismatches";
+                if (!bench.isSelected(name))
+                    continue;
+
+                int mismatches = 0;
+                for (int count = 0; count < kMaxPixels; count++)
+                {
+                    for (int srcOffset = 0; srcOffset < kMaxOffset; srcOffset++)
+                    {
+                        for (int dstOffset = 0; dstOffset < kMaxOffset; dstOffset++)
+                            mismatches += compare(kernelSet, [&](std::uint8_t* dst) { ConvertPixels(dst + dstOffset, dstFormat, src.data() + srcOffset, srcFormat, count); });
+                    }
+                }
+                bench.metric(name, (double)mismatches, "cases");
+            }
+        }
+
+        const std::string name = "accuracy/pixels/FillPixelChannel/" + kernelSetName + "/mismatches";
+        if (bench.isSelected(name))
+        {
+            int mismatches = 0;
+            for (int count = 0; count < kMaxPixels; count++)
+            {
+                for (int offset = 0; offset < kMaxOffset; offset++)
+                {
+                    for (int channel = 0; channel < 4; channel++)
+                        mismatches += compare(kernelSet, [&](std::uint8_t* pixels) { FillPixelChannel(pixels + offset, count, channel, 0xA5); });
+                }
+            }
+            bench.metric(name, (double)mismatches, "cases");
+        }
+    }
+    SetPixelKernelSet(selected);
+}
+
+static void RunPixelBenchmarks(Bench& bench)
+{
+    struct Conversion
+    {
+        PixelFormat src;
+        PixelFormat dst;
+        const char* name;
+    };
+
+    const Conversion conversions[] =
+    {
+        { PixelFormat::BGR8,  PixelFormat::RGBA8, "BGR8_RGBA8"  },
+        { PixelFormat::BGRA8, PixelFormat::RGBA8, "BGRA8_RGBA8" },
+        { PixelFormat::RGB8,  PixelFormat::RGBA8, "RGB8_RGBA8"  },
+        { PixelFormat::RGBA8, PixelFormat::RGB8,  "RGBA8_RGB8"  },
+        { PixelFormat::RGBA8, PixelFormat::Gray8, "RGBA8_Gray8" },
+        { PixelFormat::Gray8, PixelFormat::RGBA8, "Gray8_RGBA8" }
+    };
+
+    const size_t kPixelCount = (size_t)kImageWidth * kImageHeight;
+    std::vector<std::uint8_t> src(kPixelCount * 4), dst(kPixelCount * 4);
+    BenchRandom random(3);
+    for (std::uint8_t& value : src)
+        value = (std::uint8_t)(random.next() >> 24);
+
+    const PixelKernelSet selected = GetPixelKernelSet();
+    for (PixelKernelSet kernelSet : GetSupportedKernelSets())
+    {
+        SetPixelKernelSet(kernelSet);
+        for (const Conversion& conversion : conversions)
+        {
+            const double bytes = (double)kPixelCount * (GetPixelFormatChannels(conversion.src) + GetPixelFormatChannels(conversion.dst));
+            bench.run(std::string("pixels/") + conversion.name + "/" + GetPixelKernelSetName(kernelSet), [&](std::uint64_t n)
+            {
+                for (std::uint64_t i = 0; i < n; i++)
+                    ConvertPixels(dst.data(), conversion.dst, src.data(), conversion.src, kPixelCount);
+                DoNotOptimize(dst[0]);
+            }, (double)kPixelCount, bytes);
+        }
+
+        bench.run(std::string("pixels/FillPixelChannel/") + GetPixelKernelSetName(kernelSet), [&](std::uint64_t n)
+        {
+            for (std::uint64_t i = 0; i < n; i++)
+                FillPixelChannel(dst.data(), kPixelCount, 3, 255);
+            DoNotOptimize(dst[0]);
+        }, (double)kPixelCount, (double)kPixelCount * 4);
+    }
+    SetPixelKernelSet(selected);
+
+    MeasurePixelAccuracy(bench);
+}
+
+static void RunTransformBenchmarks(Bench& bench)
+{
+    const size_t kObjectCount = 100000;
+
+    Vec3fBatch points, pointsOut, scales;
+    Vec3dBatch worldPositions;
+    QuatfBatch rotations;
+    points.resize(kObjectCount);
+    scales.resize(kObjectCount);
+    rotations.resize(kObjectCount);
+    worldPositions.resize(kObjectCount);
+
+    // The same objects 10000 km from the world origin, seen from a camera among them.
+    const vec3 worldOffset(1.0e7, -2.5e6, 4.0e5);
+    const vec3 cameraPosition = worldOffset + vec3(1.25, 0.5, -3.0);
+
+    std::vector<mat4f> models(kObjectCount), results(kObjectCount);
+    BenchRandom random(5);
+    for (size_t i = 0; i < kObjectCount; i++)
+    {
+        points.set(i, vec3f(random.nextFloat(-10.0f, 10.0f), random.nextFloat(-10.0f, 10.0f), random.nextFloat(-10.0f, 10.0f)));
+        scales.set(i, vec3f(random.nextFloat(0.5f, 2.0f)));
+
+        quatf rotation;
+        rotation.setEulerRotation(random.nextFloat(-3.0f, 3.0f), random.nextFloat(-3.0f, 3.0f), random.nextFloat(-3.0f, 3.0f));
+        rotations.set(i, rotation);
+        models[i] = rotation.getMat4(points.get(i));
+        worldPositions.set(i, worldOffset + vec3(points.get(i)));
+    }
+
+    // Camera-relative translation error against the exact difference: subtracting in double
+    // versus rounding world positions to float first.
+    if (bench.isSelected("accuracy/transforms/relative_translation/double"))
+    {
+        ComposeRelativeTransforms(cameraPosition, worldPositions, rotations, scales, results.data());
+
+        const vec3f cameraPositionf = cameraPosition.getVec3f();
+        double relativeError = 0.0, floatError = 0.0;
+        for (size_t i = 0; i < kObjectCount; i++)
+        {
+            const vec3  exact  = worldPositions.get(i) - cameraPosition;
+            const vec3f naive  = worldPositions.get(i).getVec3f() - cameraPositionf;
+            for (int c = 0; c < 3; c++)
+            {
+                relativeError = std::max(relativeError, fabs((double)results[i].M[3][c] - exact.e[c]));
+                floatError    = std::max(floatError, fabs((double)naive.e[c] - exact.e[c]));
+            }
+        }
+        bench.metric("accuracy/transforms/relative_translation/double", relativeError, "m");
+        bench.metric("accuracy/transforms/relative_translation/float", floatError, "m");
+    }
+
+    mat4f viewProjection;
+    viewProjection.setPerspective(1.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+
+    // nullptr first: the calling thread alone, then pools of each size.
+    std::vector<int> threadCounts = GetThreadCounts();
+    threadCounts.insert(threadCounts.begin(), 0);
+    for (int threadCount : threadCounts)
+    {
+        std::unique_ptr<ThreadPool> pool;
+        if (threadCount > 0)
+            pool.reset(new ThreadPool(threadCount));
+        const std::string suffix = (threadCount > 0) ? "/threads" + std::to_string(threadCount) : std::string("/serial");
+
+        bench.run("transforms/TransformPoints" + suffix,   [&](std::uint64_t n) { for (std::uint64_t i = 0; i < n; i++) TransformPoints(models[0], points, pointsOut, pool.get()); }, (double)kObjectCount);
+        bench.run("transforms/TransformVectors" + suffix,  [&](std::uint64_t n) { for (std::uint64_t i = 0; i < n; i++) TransformVectors(models[0], points, pointsOut, pool.get()); }, (double)kObjectCount);
+        bench.run("transforms/MultiplyMatrices" + suffix,  [&](std::uint64_t n) { for (std::uint64_t i = 0; i < n; i++) MultiplyMatrices(viewProjection, models.data(), results.data(), kObjectCount, pool.get()); }, (double)kObjectCount);
+        bench.run("transforms/ComposeTransforms" + suffix, [&](std::uint64_t n) { for (std::uint64_t i = 0; i < n; i++) ComposeTransforms(points, rotations, scales, results.data(), pool.get()); }, (double)kObjectCount);
+        bench.run("transforms/ComposeRelativeTransforms" + suffix, [&](std::uint64_t n) { for (std::uint64_t i = 0; i < n; i++) ComposeRelativeTransforms(cameraPosition, worldPositions, rotations, scales, results.data(), pool.get()); }, (double)kObjectCount);
+    }
+
+    // The same work one object at a time through the mat4f operators, for comparison.
+    bench.run("transforms/MultiplyMatrices/mat4f_loop", [&](std::uint64_t n)
+    {
+        for (std::uint64_t i = 0; i < n; i++)
+        {
+            for (size_t j = 0; j < kObjectCount; j++)
+                results[j] = viewProjection * models[j];
+        }
+        DoNotOptimize(results[0]);
+    }, (double)kObjectCount);
+}
+
+// View-projections of viewCount cameras side by side along x, looking down +y like the sample.
+static std::vector<mat4f> MakeCullViews(int viewCount)
+{
+    mat4f projection;
+    projection.setPerspective(90.0f * 3.14159f / 180.0f, 16.0f / 9.0f, 1.0f, 10000.0f);
+
+    std::vector<mat4f> viewProjections(viewCount);
+    for (int i = 0; i < viewCount; i++)
+    {
+        const vec3f eye((i - 0.5f * (viewCount - 1)) * 6.0f, 0.0f, 0.0f);
+        mat4f view;
+        view.lookAt(eye, eye + vec3f(0.0f, 1.0f, 0.0f), vec3f(0.0f, 0.0f, 1.0f));
+        viewProjections[i] = projection * view;
+    }
+    return viewProjections;
+}
+
+static void RunCullingBenchmarks(Bench& bench)
+{
+    const size_t kObjectCount = 1000000;
+
+    // Boxes and spheres scattered around the cameras, about a third of them in view.
+    Vec3fBatch centers, extents;
+    BatchArray radii;
+    centers.resize(kObjectCount);
+    extents.resize(kObjectCount);
+    radii.resize(kObjectCount);
+
+    BenchRandom random(9);
+    for (size_t i = 0; i < kObjectCount; i++)
+    {
+        centers.set(i, vec3f(random.nextFloat(-8000.0f, 8000.0f), random.nextFloat(-8000.0f, 8000.0f), random.nextFloat(-4000.0f, 4000.0f)));
+        extents.set(i, vec3f(random.nextFloat(1.0f, 20.0f), random.nextFloat(1.0f, 20.0f), random.nextFloat(1.0f, 20.0f)));
+        radii[i] = extents.get(i).getLength();
+    }
+
+    std::vector<std::uint32_t> masks(kObjectCount);
+
+    for (int viewCount : { 2, 8 })
+    {
+        const std::vector<mat4f> viewProjections = MakeCullViews(viewCount);
+        MultiViewFrustum frustum;
+        frustum.set(viewProjections.data(), viewCount);
+
+        const std::string views = (viewCount == 2) ? "stereo" : "views" + std::to_string(viewCount);
+
+        // nullptr first: the calling thread alone, then pools of each size.
+        std::vector<int> threadCounts = GetThreadCounts();
+        threadCounts.insert(threadCounts.begin(), 0);
+        for (int threadCount : threadCounts)
+        {
+            std::unique_ptr<ThreadPool> pool;
+            if (threadCount > 0)
+                pool.reset(new ThreadPool(threadCount));
+            const std::string suffix = (threadCount > 0) ? "/threads" + std::to_string(threadCount) : std::string("/serial");
+
+            bench.run("cull/boxes/" + views + suffix,   [&](std::uint64_t n) { for (std::uint64_t i = 0; i < n; i++) CullBoxes(frustum, centers, extents, masks.data(), pool.get()); }, (double)kObjectCount);
+            bench.run("cull/spheres/" + views + suffix, [&](std::uint64_t n) { for (std::uint64_t i = 0; i < n; i++) CullSpheres(frustum, centers, radii, masks.data(), pool.get()); }, (double)kObjectCount);
+        }
+
+        // The same tests one object and one view at a time, for comparison.
+        bench.run("cull/boxes/" + views + "/per_view_loop", [&](std::uint64_t n)
+        {
+            for (std::uint64_t i = 0; i < n; i++)
+            {
+                for (size_t j = 0; j < kObjectCount; j++)
+                {
+                    const vec3f center = centers.get(j);
+                    const vec3f extent = extents.get(j);
+
+                    std::uint32_t mask = 0;
+                    for (int view = 0; view < viewCount; view++)
+                        mask |= frustum.getView(view).intersectsBox(center, extent) ? (1u << view) : 0u;
+                    masks[j] = mask;
+                }
+            }
+            DoNotOptimize(masks[0]);
+        }, (double)kObjectCount);
+
+        // Objects whose batched mask differs from the single-object tests; should be none.
+        if (bench.isSelected("accuracy/cull/boxes/" + views + "/mismatches"))
+        {
+            CullBoxes(frustum, centers, extents, masks.data());
+
+            size_t mismatches = 0;
+            for (size_t j = 0; j < kObjectCount; j++)
+            {
+                const vec3f center = centers.get(j);
+                const vec3f extent = extents.get(j);
+
+                std::uint32_t expected = 0;
+                if (frustum.getUnion().intersectsBox(center, extent))
+                {
+                    for (int view = 0; view < viewCount; view++)
+                        expected |= frustum.getView(view).intersectsBox(center, extent) ? (1u << view) : 0u;
+                }
+                mismatches += (masks[j] != expected) ? 1 : 0;
+            }
+            bench.metric("accuracy/cull/boxes/" + views + "/mismatches", (double)mismatches, "objects");
+        }
+    }
+}
+
+// Vertices and indices of a mesh to rasterize.
+struct RasterMesh
+{
+    std::vector<MeshVertex>    vertices;
+    std::vector<std::uint32_t> indices;
+};
+
+// Height field of columns x rows quads facing the cameras, filling their views,
+// with a color per vertex so the rasterizer interpolates.
+static RasterMesh MakeRasterGrid(int columns, int rows)
+{
+    RasterMesh mesh;
+    BenchRandom random(11);
+    for (int v = 0; v <= rows; v++)
+    {
+        for (int u = 0; u <= columns; u++)
+        {
+            const float x = -40.0f + 80.0f * (float)u / (float)columns;
+            const float z = 25.0f - 50.0f * (float)v / (float)rows;
+            mesh.vertices.push_back(MeshVertex{ vec3f(x, 30.0f + random.nextFloat(-0.5f, 0.5f), z), vec3f(random.nextFloat(0.0f, 1.0f), random.nextFloat(0.0f, 1.0f), random.nextFloat(0.0f, 1.0f)) });
+        }
+    }
+
+    // Clockwise seen from the cameras.
+    for (int v = 0; v < rows; v++)
+    {
+        for (int u = 0; u < columns; u++)
+        {
+            const std::uint32_t c0 = v * (columns + 1) + u;
+            const std::uint32_t c1 = c0 + 1;
+            const std::uint32_t c2 = c0 + columns + 1;
+            const std::uint32_t c3 = c2 + 1;
+            for (std::uint32_t index : { c0, c1, c3, c0, c3, c2 })
+                mesh.indices.push_back(index);
+        }
+    }
+    return mesh;
+}
+
+// Stereo frames like the sample's: a 1280 x 800 view per half of the atlas, the mesh drawn into
+// both, then interlaced and presented.
+static void RunRasterBenchmarks(Bench& bench)
+{
+    const int kViewWidth  = 1280;
+    const int kViewHeight = 800;
+
+    const vec3f faceColors[6] = { vec3f(1, 0, 0), vec3f(0, 1, 0), vec3f(0, 0, 1), vec3f(1, 1, 0), vec3f(0, 1, 1), vec3f(1, 0, 1) };
+    const CubeMesh cube = MakeCubeMesh(vec3f(10.0f), faceColors);
+
+    RasterMesh cubeMesh;
+    cubeMesh.vertices.assign(cube.vertices, cube.vertices + 24);
+    cubeMesh.indices.assign(cube.indices, cube.indices + 36);
+
+    // Two eyes 6 units apart looking down +y, like the sample's cameras.
+    mat4f projection;
+    projection.setPerspective(90.0f * 3.14159f / 180.0f, (float)kViewWidth / (float)kViewHeight, 1.0f, 10000.0f);
+
+    mat4f viewProjections[2];
+    for (int i = 0; i < 2; i++)
+    {
+        const vec3f eye((i - 0.5f) * 6.0f, 0.0f, 0.0f);
+        mat4f view;
+        view.lookAt(eye, eye + vec3f(0.0f, 1.0f, 0.0f), vec3f(0.0f, 0.0f, 1.0f));
+        viewProjections[i] = projection * view;
+    }
+
+    struct RasterScene
+    {
+        const char* name;
+        RasterMesh  mesh;
+        mat4f       model;
+    };
+
+    mat4f cubeModel;
+    cubeModel.setIdentity();
+    cubeModel.e[3].y = 40.0f;
+
+    mat4f gridModel;
+    gridModel.setIdentity();
+
+    // nullptr first: the calling thread alone, then pools of each size.
+    const std::vector<int> poolSizes = GetThreadCounts();
+    std::vector<int>       threadCounts(1, 0);
+    threadCounts.insert(threadCounts.end(), poolSizes.begin(), poolSizes.end());
+
+    const RasterScene scenes[] = { { "cube", cubeMesh, cubeModel }, { "grid", MakeRasterGrid(256, 256), gridModel } };
+    for (const RasterScene& scene : scenes)
+    {
+        // Atlas pixels rendered serially, to compare the largest pool's against.
+        std::vector<std::uint8_t> serialPixels;
+
+        for (int threadCount : threadCounts)
+        {
+            std::unique_ptr<ThreadPool> pool;
+            if (threadCount > 0)
+                pool.reset(new ThreadPool(threadCount));
+            const std::string suffix = (threadCount > 0) ? "/threads" + std::to_string(threadCount) : std::string("/serial");
+
+            SoftwareRenderBackend backend(kViewWidth * 2, kViewHeight, true, pool.get());
+            const RenderHandle target         = backend.createRenderTarget(kViewWidth * 2, kViewHeight, true);
+            const RenderHandle vertexBuffer   = backend.createBuffer(RenderBufferType::Vertex, scene.mesh.vertices.data(), scene.mesh.vertices.size() * sizeof(MeshVertex));
+            const RenderHandle indexBuffer    = backend.createBuffer(RenderBufferType::Index, scene.mesh.indices.data(), scene.mesh.indices.size() * sizeof(std::uint32_t));
+            const RenderHandle constantBuffer = backend.createBuffer(RenderBufferType::Constant, nullptr, sizeof(mat4f));
+            const RenderHandle pipeline       = backend.createPipeline(RenderPipelineDesc());
+
+            const float clearColor[4] = { 0.0f, 0.0f, 0.5f, 1.0f };
+            auto renderFrame = [&]()
+            {
+                backend.clear(target, clearColor);
+                backend.setRenderTarget(target);
+                backend.setPipeline(pipeline);
+                backend.setVertexBuffer(vertexBuffer);
+                backend.setIndexBuffer(indexBuffer);
+                backend.setConstantBuffer(constantBuffer);
+                for (int i = 0; i < 2; i++)
+                {
+                    RenderViewport viewport;
+                    viewport.x      = (float)(i * kViewWidth);
+                    viewport.width  = (float)kViewWidth;
+                    viewport.height = (float)kViewHeight;
+                    backend.setViewport(viewport);
+
+                    const mat4f transform = viewProjections[i] * scene.model;
+                    backend.updateBuffer(constantBuffer, &transform, sizeof(transform));
+                    backend.drawIndexed((int)scene.mesh.indices.size(), 0);
+                }
+                backend.interlace(target, kViewWidth, kViewHeight, InterlaceMode::Views);
+                backend.present();
+            };
+
+            const std::string prefix = std::string("raster/") + scene.name;
+            bench.run(prefix + "/frame" + suffix, [&](std::uint64_t n) { for (std::uint64_t i = 0; i < n; i++) renderFrame(); }, (double)scene.mesh.indices.size() / 3 * 2);
+
+            // Pixels that differ from the serial frame; should be none, tiles are rasterized in
+            // issue order whichever thread takes them.
+            if (bench.isSelected("accuracy/" + prefix + "/threaded_mismatches"))
+            {
+                std::vector<std::uint8_t> pixels;
+                int                       width  = 0;
+                int                       height = 0;
+                renderFrame();
+                backend.readPixels(target, pixels, width, height);
+                if (threadCount == 0)
+                    serialPixels = pixels;
+                else if (threadCount == poolSizes.back())
+                {
+                    size_t mismatches = (pixels.size() != serialPixels.size()) ? pixels.size() / 4 : 0;
+                    for (size_t i = 0; (i + 4 <= pixels.size()) && (pixels.size() == serialPixels.size()); i += 4)
+                        mismatches += (memcmp(&pixels[i], &serialPixels[i], 4) != 0) ? 1 : 0;
+                    bench.metric("accuracy/" + prefix + "/threaded_mismatches", (double)mismatches, "pixels");
+                }
+            }
+        }
+    }
+}
+
+// Encode a 32-bit top-left origin TGA, uncompressed or run-length encoded one row at a time.
+static std::vector<std::uint8_t> EncodeTGA(const std::uint8_t* bgra, int width, int height, bool compressed)
+{
+    std::vector<std::uint8_t> file(18, 0);
+    file[2]  = compressed ? 10 : 2;
+    file[12] = (std::uint8_t)(width & 0xFF);
+    file[13] = (std::uint8_t)(width >> 8);
+    file[14] = (std::uint8_t)(height & 0xFF);
+    file[15] = (std::uint8_t)(height >> 8);
+    file[16] = 32;
+    file[17] = 0x28;
+
+    if (!compressed)
+    {
+        file.insert(file.end(), bgra, bgra + (size_t)width * height * 4);
+        return file;
+    }
+
+    for (int y = 0; y < height; y++)
+    {
+        const std::uint32_t* row = (const std::uint32_t*)(bgra + (size_t)y * width * 4);
+        int x = 0;
+        while (x < width)
+        {
+            int run = 1;
+            while ((x + run < width) && (run < 128) && (row[x + run] == row[x]))
+                run++;
+
+            if (run > 1)
+            {
+                file.push_back((std::uint8_t)(0x80 | (run - 1)));
+                file.insert(file.end(), (const std::uint8_t*)&row[x], (const std::uint8_t*)&row[x] + 4);
+                x += run;
+                continue;
+            }
+
+            // Raw packet up to the next run of two equal pixels.
+            int count = 0;
+            while ((x + count < width) && (count < 128) && !((x + count + 1 < width) && (row[x + count + 1] == row[x + count])))
+                count++;
+            count = std::max(count, 1);
+
+            file.push_back((std::uint8_t)(count - 1));
+            file.insert(file.end(), (const std::uint8_t*)&row[x], (const std::uint8_t*)&row[x + count]);
+            x += count;
+        }
+    }
+    return file;
+}
+
+// Checkerboard of flat color blocks, which compress, and noise, which doesn't.
+static std::vector<std::uint8_t> MakeTestImage(int width, int height, std::uint32_t seed)
+{
+    std::vector<std::uint8_t> bgra((size_t)width * height * 4);
+    BenchRandom random(seed);
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            std::uint8_t* pixel = &bgra[((size_t)y * width + x) * 4];
+            const bool    flat  = (((x >> 6) + (y >> 6)) & 1) != 0;
+            for (int c = 0; c < 3; c++)
+                pixel[c] = flat ? (std::uint8_t)((x >> 6) * 37 + (y >> 6) * 11 + c * 80) : (std::uint8_t)(random.next() >> 24);
+            pixel[3] = 255;
+        }
+    }
+    return bgra;
+}
+
+static bool WriteFile(const std::string& path, const std::vector<std::uint8_t>& data)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    const bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+    return (fclose(file) == 0) && written;
+}
+
+static bool DecodeTGA(ByteSpan file, std::uint8_t* dst)
+{
+    TGASpanInput input(file);
+    TGADecoder   decoder(input);
+    decoder.setOutputFormat(TGAOutputFormat::RGBA8);
+    return decoder.readHeader() && decoder.decode(dst, decoder.getRowSize());
+}
+
+// An image to decode, uncompressed and run-length encoded.
+struct TGABenchImage
+{
+    std::string               name;
+    int                       width  = 0;
+    int                       height = 0;
+    std::vector<std::uint8_t> raw;
+    std::vector<std::uint8_t> rle;
+};
+
+static TGABenchImage MakeTGABenchImage(const char* name, int width, int height, std::uint32_t seed)
+{
+    const std::vector<std::uint8_t> bgra = MakeTestImage(width, height, seed);
+
+    TGABenchImage image;
+    image.name   = name;
+    image.width  = width;
+    image.height = height;
+    image.raw    = EncodeTGA(bgra.data(), width, height, false);
+    image.rle    = EncodeTGA(bgra.data(), width, height, true);
+    return image;
+}
+
+// The sample's bundled TILE.TGA as shipped (24-bit, uncompressed) and its pixels run-length
+// encoded. Returns false if the file can't be read.
+static bool LoadTileImage(TGABenchImage& image)
+{
+    FileSource file;
+    if (!file.open(CNSDK_BENCH_ASSETS_DIR "/TILE.TGA"))
+        return false;
+
+    TGASpanInput input(file.getSpan());
+    TGADecoder   decoder(input);
+    decoder.setOutputFormat(TGAOutputFormat::RGBA8);
+    if (!decoder.readHeader())
+        return false;
+
+    std::vector<std::uint8_t> pixels(decoder.getRowSize() * decoder.getHeight());
+    if (!decoder.decode(pixels.data(), decoder.getRowSize()))
+        return false;
+    for (size_t i = 0; i < pixels.size(); i += 4)
+        std::swap(pixels[i], pixels[i + 2]);
+
+    image.name   = "tile";
+    image.width  = decoder.getWidth();
+    image.height = decoder.getHeight();
+    image.raw.assign(file.getSpan().data, file.getSpan().data + file.getSpan().size);
+    image.rle    = EncodeTGA(pixels.data(), image.width, image.height, true);
+    return true;
+}
+
+// The sample's file loader before FileSource, kept as the startup baseline. Every 4 KB chunk
+// reallocates and copies everything read so far, so loading is quadratic in the file size.
+static bool ReadEntireFile(const char* filename, bool binary, char*& data, size_t& dataSize)
+{
+    const int BUFFERSIZE = 4096;
+    char buffer[BUFFERSIZE];
+
+    // Open file.
+    FILE* f = fopen(filename, binary ? "rb" : "rt");
+    if (f == NULL)
+        return false;
+
+    data     = nullptr;
+    dataSize = 0;
+
+    while (true)
+    {
+        // Read chunk into buffer.
+        const size_t bytes = (int)fread(buffer, sizeof(char), BUFFERSIZE, f);
+        if (bytes <= 0)
+            break;
+
+        // Extend allocated memory and copy chunk into it.
+        char* newData = new char[dataSize + bytes];
+        if (dataSize > 0)
+        {
+            memcpy(newData, data, dataSize);
+            delete [] data;
+            data = nullptr;
+        }
+        memcpy(newData + dataSize, buffer, bytes);
+        dataSize += bytes;
+        data = newData;
+    }
+
+    // Done and close.
+    fclose(f);
+
+    return dataSize > 0;
+}
+
+// Ways to load an image file at startup.
+enum class StartupLoader
+{
+    ReadEntireFile, // The old quadratic loader
+    Mapped,         // FileSource, mapping the file
+    Buffered        // FileSource, one allocation and one read
+};
+
+static const char* GetStartupLoaderName(StartupLoader loader)
+{
+    switch (loader)
+    {
+    case StartupLoader::ReadEntireFile: return "read_entire_file";
+    case StartupLoader::Mapped:         return "file_source_mapped";
+    case StartupLoader::Buffered:       return "file_source_buffered";
+    }
+    return "unknown";
+}
+
+// Load path with loader and decode it to RGBA8, as the sample loads a texture.
+static bool LoadStartupImage(StartupLoader loader, const char* path)
+{
+    std::unique_ptr<std::uint8_t[]> decoded;
+    auto decode = [&](ByteSpan file)
+    {
+        TGASpanInput input(file);
+        TGADecoder   decoder(input);
+        decoder.setOutputFormat(TGAOutputFormat::RGBA8);
+        if (!decoder.readHeader())
+            return false;
+        decoded.reset(new std::uint8_t[decoder.getRowSize() * decoder.getHeight()]);
+        return decoder.decode(decoded.get(), decoder.getRowSize());
+    };
+
+    if (loader == StartupLoader::ReadEntireFile)
+    {
+        char*  data     = nullptr;
+        size_t dataSize = 0;
+        const bool loaded = ReadEntireFile(path, true, data, dataSize) && decode(ByteSpan((const std::uint8_t*)data, dataSize));
+        delete [] data;
+        return loaded;
+    }
+
+    FileSource file;
+    return file.open(path, loader == StartupLoader::Mapped) && decode(file.getSpan());
+}
+
+#if defined(__linux__)
+// Value of a "kB" field of /proc/self/status, e.g. "VmHWM", or -1.
+static long ReadProcStatusKB(const char* field)
+{
+    FILE* file = fopen("/proc/self/status", "r");
+    if (file == nullptr)
+        return -1;
+
+    const size_t fieldLength = strlen(field);
+    long         value       = -1;
+    char         line[256];
+    while (fgets(line, sizeof(line), file) != nullptr)
+    {
+        if ((strncmp(line, field, fieldLength) == 0) && (line[fieldLength] == ':'))
+        {
+            value = strtol(line + fieldLength + 1, nullptr, 10);
+            break;
+        }
+    }
+    fclose(file);
+    return value;
+}
+
+struct StartupSample
+{
+    double milliseconds = 0.0;
+    long   peakRSSKB    = 0; // Growth of the peak resident set over the child's size at fork
+};
+
+// Load the image once in a forked child, so the peak RSS is that of this loader alone and every
+// loader starts from the same process state. Must not be called while other threads are running.
+static bool MeasureStartupLoad(StartupLoader loader, const char* path, StartupSample& sample)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+        return false;
+
+    const pid_t pid = fork();
+    if (pid < 0)
+    {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+
+    if (pid == 0)
+    {
+        close(fds[0]);
+
+        // The child starts with the parent's heap and peak. Return the free heap to the system,
+        // or the load reuses pages already resident, then reset the peak to the current RSS.
+#if defined(__GLIBC__)
+        malloc_trim(0);
+#endif
+        FILE* clearRefs = fopen("/proc/self/clear_refs", "w");
+        const bool reset = (clearRefs != nullptr) && (fputs("5", clearRefs) >= 0);
+        if ((clearRefs != nullptr) && (fclose(clearRefs) != 0))
+            _exit(1);
+
+        StartupSample child;
+        const long rssBefore = ReadProcStatusKB("VmRSS");
+        const auto start     = std::chrono::steady_clock::now();
+        const bool loaded    = LoadStartupImage(loader, path);
+        child.milliseconds   = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        child.peakRSSKB      = ReadProcStatusKB("VmHWM") - rssBefore;
+
+        const bool written = reset && loaded && (rssBefore >= 0) && (write(fds[1], &child, sizeof(child)) == (ssize_t)sizeof(child));
+        _exit(written ? 0 : 1);
+    }
+
+    close(fds[1]);
+    const bool received = read(fds[0], &sample, sizeof(sample)) == (ssize_t)sizeof(sample);
+    close(fds[0]);
+
+    int status = 0;
+    return (waitpid(pid, &status, 0) == pid) && WIFEXITED(status) && (WEXITSTATUS(status) == 0) && received;
+}
+#endif
+
+// Time to load and decode an uncompressed image at startup and the peak RSS it takes, for the old
+// loader and both FileSource paths. Mapped pages count towards the RSS like buffered ones but are
+// clean page cache, which the kernel can drop instead of swapping. The old loader takes minutes on
+// the 100 MB image, so there it only runs with --slow.
+static void RunStartupBenchmarks(Bench& bench)
+{
+#if defined(__linux__)
+    const StartupLoader loaders[] = { StartupLoader::ReadEntireFile, StartupLoader::Mapped, StartupLoader::Buffered };
+    const int           sizes[][2] = { { kImageWidth, kImageHeight }, { kLargeImageWidth, kLargeImageHeight } };
+
+    std::error_code error;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path(error);
+
+    for (const int* size : sizes)
+    {
+        const std::string sizeName = std::to_string(size[0]) + "x" + std::to_string(size[1]);
+        const std::string path     = (directory / ("cnsdk_bench_startup_" + sizeName + ".tga")).string();
+        bool              written  = false;
+
+        for (StartupLoader loader : loaders)
+        {
+            const std::string name = std::string("startup/load_tga/") + GetStartupLoaderName(loader) + "/" + sizeName;
+            if ((loader == StartupLoader::ReadEntireFile) && (size[0] > kImageWidth) && !bench.getSettings().slow)
+                continue;
+            if (!bench.isSelected(name + "/ms") && !bench.isSelected(name + "/peak_rss"))
+                continue;
+
+            // Write the image before the first selected loader, so no unselected size is written.
+            if (!written)
+            {
+                if (!WriteFile(path, EncodeTGA(MakeTestImage(size[0], size[1], 30).data(), size[0], size[1], false)))
+                {
+                    fprintf(stderr, "Can't write %s, skipping startup benchmarks\n", path.c_str());
+                    break;
+                }
+                written = true;
+            }
+
+            StartupSample sample;
+            if (!MeasureStartupLoad(loader, path.c_str(), sample))
+            {
+                fprintf(stderr, "Can't measure %s\n", name.c_str());
+                continue;
+            }
+            bench.metric(name + "/ms", sample.milliseconds, "ms");
+            bench.metric(name + "/peak_rss", (double)sample.peakRSSKB, "KB");
+        }
+
+        if (written)
+            std::filesystem::remove(path, error);
+    }
+#else
+    (void)bench;
+#endif
+}
+
+static void RunImageBenchmarks(Bench& bench)
+{
+    const std::vector<std::uint8_t> image       = MakeTestImage(kImageWidth, kImageHeight, 11);
+    const std::vector<std::uint8_t> rawFile     = EncodeTGA(image.data(), kImageWidth, kImageHeight, false);
+    const std::vector<std::uint8_t> rleFile     = EncodeTGA(image.data(), kImageWidth, kImageHeight, true);
+    const size_t                    decodedSize = image.size();
+    const double                    pixelCount  = (double)kImageWidth * kImageHeight;
+
+    std::vector<std::uint8_t> decoded(decodedSize);
+    ThreadPool pool;
+
+    const struct
+    {
+        const std::vector<std::uint8_t>* file;
+        const char*                      name;
+    } encodings[] = { { &rawFile, "raw" }, { &rleFile, "rle" } };
+
+    for (const auto& encoding : encodings)
+    {
+        const ByteSpan    span(encoding.file->data(), encoding.file->size());
+        const std::string suffix = std::string("/") + encoding.name;
+
+        bench.run("tga/decode" + suffix, [&](std::uint64_t n)
+        {
+            for (std::uint64_t i = 0; i < n; i++)
+                DecodeTGA(span, decoded.data());
+            DoNotOptimize(decoded[0]);
+        }, pixelCount, (double)decodedSize);
+    }
+
+    // The bundled TILE.TGA and an 8K side-by-side frame, as tga/decode/<image>/<encoding>.
+    std::vector<TGABenchImage> images;
+    images.emplace_back();
+    if (!LoadTileImage(images.back()))
+    {
+        fprintf(stderr, "Can't read %s/TILE.TGA, skipping its benchmarks\n", CNSDK_BENCH_ASSETS_DIR);
+        images.pop_back();
+    }
+    images.push_back(MakeTGABenchImage("sbs8k", k8KImageWidth, k8KImageHeight, 12));
+
+    const std::vector<int> threadCounts = GetThreadCounts();
+    for (const TGABenchImage& image : images)
+    {
+        std::vector<std::uint8_t> imageDecoded((size_t)image.width * image.height * 4);
+        const double              imagePixels = (double)image.width * image.height;
+        for (const auto& encoding : { std::make_pair(&image.raw, "raw"), std::make_pair(&image.rle, "rle") })
+        {
+            const ByteSpan    span(encoding.first->data(), encoding.first->size());
+            const std::string name = image.name + "/" + encoding.second;
+            bench.run("tga/decode/" + name, [&](std::uint64_t n)
+            {
+                for (std::uint64_t i = 0; i < n; i++)
+                    DecodeTGA(span, imageDecoded.data());
+                DoNotOptimize(imageDecoded[0]);
+            }, imagePixels, (double)imageDecoded.size());
+
+            // Band decoding by pool size, on the 8K frame; the tile is a few bands at most.
+            if (image.width < k8KImageWidth)
+                continue;
+
+            // Pixels that differ from TGADecoder's at any pool size; should be none.
+            std::vector<std::uint8_t> reference;
+            const std::string         accuracyName = "accuracy/tga/decode_parallel/" + name + "/mismatches";
+            size_t                    mismatches   = 0;
+            if (bench.isSelected(accuracyName))
+            {
+                DecodeTGA(span, imageDecoded.data());
+                reference = imageDecoded;
+            }
+
+            for (int threadCount : threadCounts)
+            {
+                ThreadPool decodePool(threadCount);
+                auto decodeParallel = [&]()
+                {
+                    TGAParallelDecoder decoder(span, decodePool);
+                    decoder.setOutputFormat(TGAOutputFormat::RGBA8);
+                    return decoder.readHeader() && decoder.decode(imageDecoded.data(), decoder.getRowSize());
+                };
+
+                bench.run("tga/decode_parallel/" + name + "/threads" + std::to_string(threadCount), [&](std::uint64_t n)
+                {
+                    for (std::uint64_t i = 0; i < n; i++)
+                        decodeParallel();
+                    DoNotOptimize(imageDecoded[0]);
+                }, imagePixels, (double)imageDecoded.size());
+
+                if (!reference.empty())
+                {
+                    std::fill(imageDecoded.begin(), imageDecoded.end(), (std::uint8_t)0);
+                    // A failed decode counts every pixel.
+                    size_t differing = 0;
+                    const bool decodedAll = decodeParallel();
+                    for (size_t i = 0; i < reference.size(); i += 4)
+                        differing += (!decodedAll || (memcmp(&imageDecoded[i], &reference[i], 4) != 0)) ? 1 : 0;
+                    mismatches = std::max(mismatches, differing);
+                }
+            }
+
+            if (!reference.empty())
+                bench.metric(accuracyName, (double)mismatches, "pixels");
+        }
+    }
+
+    // Files in the temp directory, read back from the page cache.
+    std::error_code error;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path(error);
+    std::vector<std::string> tgaPaths;
+    for (int i = 0; i < 4; i++)
+    {
+        const std::string path = (directory / ("cnsdk_bench_" + std::to_string(i) + ".tga")).string();
+        if (!WriteFile(path, EncodeTGA(MakeTestImage(kImageWidth, kImageHeight, 20 + i).data(), kImageWidth, kImageHeight, true)))
+        {
+            fprintf(stderr, "Can't write %s, skipping file benchmarks\n", path.c_str());
+            break;
+        }
+        tgaPaths.push_back(path);
+    }
+
+    if (!tgaPaths.empty())
+    {
+        bench.run("tga/file_mapped/rle", [&](std::uint64_t n)
+        {
+            for (std::uint64_t i = 0; i < n; i++)
+            {
+                FileSource file;
+                if (file.open(tgaPaths[0].c_str()))
+                    DecodeTGA(file.getSpan(), decoded.data());
+            }
+            DoNotOptimize(decoded[0]);
+        }, pixelCount, (double)decodedSize);
+
+        bench.run("tga/file_chunked/rle", [&](std::uint64_t n)
+        {
+            for (std::uint64_t i = 0; i < n; i++)
+            {
+                FILE* file = fopen(tgaPaths[0].c_str(), "rb");
+                if (file == nullptr)
+                    continue;
+
+                TGAFileInput input(file);
+                TGADecoder   decoder(input);
+                decoder.setOutputFormat(TGAOutputFormat::RGBA8);
+                if (decoder.readHeader())
+                    decoder.decode(decoded.data(), decoder.getRowSize());
+                fclose(file);
+            }
+            DoNotOptimize(decoded[0]);
+        }, pixelCount, (double)decodedSize);
+    }
+
+    // Cache hits only hash the file; misses hash and decode.
+    const ByteSpan rleSpan(rleFile.data(), rleFile.size());
+    bench.run("cache/HashBytes", [&](std::uint64_t n)
+    {
+        std::uint64_t hash = 0;
+        for (std::uint64_t i = 0; i < n; i++)
+            hash += HashBytes(rleSpan.data, rleSpan.size);
+        DoNotOptimize(hash);
+    }, 1.0, (double)rleSpan.size);
+
+    ImageCache cache(256u << 20);
+    bench.run("cache/getTGA/hit", [&](std::uint64_t n)
+    {
+        const wchar_t* errorMessage = nullptr;
+        for (std::uint64_t i = 0; i < n; i++)
+            DoNotOptimize(cache.getTGA(rleSpan, pool, errorMessage));
+    });
+    bench.run("cache/getTGA/miss", [&](std::uint64_t n)
+    {
+        const wchar_t* errorMessage = nullptr;
+        for (std::uint64_t i = 0; i < n; i++)
+        {
+            cache.clear();
+            DoNotOptimize(cache.getTGA(rleSpan, pool, errorMessage));
+        }
+    });
+
+    // Offline mip generation, and opening the result as the sample does at startup.
+    const int kTextureSize = 1024;
+    TextureFileBuilder builder;
+    bench.run("texture/build_mips/srgb", [&](std::uint64_t n)
+    {
+        for (std::uint64_t i = 0; i < n; i++)
+            builder.setImage(decoded.data(), kTextureSize, kTextureSize, (size_t)kImageWidth * 4, true, true);
+    }, (double)kTextureSize * kTextureSize);
+    bench.run("texture/build_mips/linear", [&](std::uint64_t n)
+    {
+        for (std::uint64_t i = 0; i < n; i++)
+            builder.setImage(decoded.data(), kTextureSize, kTextureSize, (size_t)kImageWidth * 4, false, true);
+    }, (double)kTextureSize * kTextureSize);
+
+    const std::string texturePath = (directory / "cnsdk_bench.ctex").string();
+    if (builder.write(texturePath.c_str(), TextureFormat::RGBA8))
+    {
+        bench.run("texture/open", [&](std::uint64_t n)
+        {
+            for (std::uint64_t i = 0; i < n; i++)
+            {
+                TextureFile texture;
+                DoNotOptimize(texture.open(texturePath.c_str()));
+            }
+        });
+    }
+
+    // Time from creating a frame source to having its first frame decoded, with the smallest ring.
+    // Destroying the source waits for the second frame, which is decoding by then.
+    if (tgaPaths.size() == 4)
+    {
+        const size_t budget = decodedSize * 2;
+        bench.run("framesource/first_frame/tga", [&](std::uint64_t n)
+        {
+            for (std::uint64_t i = 0; i < n; i++)
+            {
+                StereoFrameSource source(pool);
+                for (const std::string& path : tgaPaths)
+                    source.addImage(path);
+                if (source.start(budget, false))
+                    source.waitForCurrentFrame();
+            }
+        });
+
+        // Every frame of the sequence, advancing as soon as the next one is ready.
+        bench.run("framesource/sequence/tga", [&](std::uint64_t n)
+        {
+            for (std::uint64_t i = 0; i < n; i++)
+            {
+                StereoFrameSource source(pool);
+                for (const std::string& path : tgaPaths)
+                    source.addImage(path);
+                if (!source.start(budget, false))
+                    continue;
+
+                source.waitForCurrentFrame();
+                for (int shown = 1; shown < source.getFrameCount();)
+                {
+                    if (source.advance())
+                        shown++;
+                    else
+                        std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (const std::string& path : tgaPaths)
+        std::filesystem::remove(path, error);
+    std::filesystem::remove(texturePath, error);
+}
+
+void RunKernelBenchmarks(Bench& bench)
+{
+    RunSRGBBenchmarks(bench);
+    RunPixelBenchmarks(bench);
+    RunTransformBenchmarks(bench);
+    RunCullingBenchmarks(bench);
+    RunRasterBenchmarks(bench);
+    RunImageBenchmarks(bench);
+    RunStartupBenchmarks(bench);
+}
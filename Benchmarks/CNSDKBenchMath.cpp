@@ -0,0 +1,776 @@
+// Benchmarks of the math types (CNSDKGettingStartedMath.h), deferred chains (MathExpr) and the
+// FastMath approximations, with the accuracy of the inverses and approximations as metrics.
+
+#include <math.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "CNSDKBench.h"
+#include "CNSDKGettingStartedMath.h"
+#include "CNSDKGettingStartedMathExpr.h"
+#include "CNSDKGettingStartedViewInfo.h"
+#include "CNSDKGettingStartedViewInfoCache.h"
+#include "CNSDKGettingStartedViewLatch.h"
+
+// Inputs are cycled through so results can't be folded into constants, and so the work per
+// iteration doesn't depend on a single value (e.g. an inverse of a singular matrix).
+const size_t kInputCount = 256;
+const size_t kInputMask  = kInputCount - 1;
+
+struct MathInputs
+{
+    float floats[kInputCount];
+    float angles[kInputCount];  // [-pi, pi]
+    vec3f vec3s[kInputCount];
+    vec3f axes[kInputCount];    // Normalized
+    vec4f vec4s[kInputCount];
+    mat3f mat3s[kInputCount];
+    mat4f mat4s[kInputCount];   // General
+    mat4f affines[kInputCount]; // Last row 0 0 0 1
+    mat4f rigids[kInputCount];  // Rotation and translation
+    quatf quats[kInputCount];   // Normalized
+};
+
+static void FillInputs(MathInputs& in)
+{
+    BenchRandom random(12345);
+
+    for (size_t i = 0; i < kInputCount; i++)
+    {
+        in.floats[i] = random.nextFloat(-1.0f, 1.0f);
+        in.angles[i] = random.nextFloat(-3.14159265f, 3.14159265f);
+        in.vec3s[i]  = vec3f(random.nextFloat(-10.0f, 10.0f), random.nextFloat(-10.0f, 10.0f), random.nextFloat(-10.0f, 10.0f));
+        in.axes[i]   = vec3f(random.nextFloat(-1.0f, 1.0f), random.nextFloat(-1.0f, 1.0f), random.nextFloat(0.1f, 1.0f)).getNormal();
+        in.vec4s[i]  = vec4f(random.nextFloat(-10.0f, 10.0f), random.nextFloat(-10.0f, 10.0f), random.nextFloat(-10.0f, 10.0f), 1.0f);
+
+        for (float& value : in.mat3s[i].m)
+            value = random.nextFloat(-1.0f, 1.0f);
+        for (float& value : in.mat4s[i].m)
+            value = random.nextFloat(-1.0f, 1.0f);
+
+        in.affines[i] = in.mat4s[i];
+        in.affines[i].Xw = 0.0f;
+        in.affines[i].Yw = 0.0f;
+        in.affines[i].Zw = 0.0f;
+        in.affines[i].Ww = 1.0f;
+
+        mat3f rotation;
+        rotation.setAxisAngleRotation(in.axes[i], in.angles[i]);
+        in.rigids[i].create(rotation, in.vec3s[i]);
+
+        in.quats[i].setAxisAngleRotation(in.axes[i], in.angles[i]);
+    }
+}
+
+// Time op(index) over the inputs, keeping each result.
+template <typename Op>
+static void RunOp(Bench& bench, const char* name, Op op)
+{
+    bench.run(name, [&](std::uint64_t iterations)
+    {
+        for (std::uint64_t i = 0; i < iterations; i++)
+            DoNotOptimize(op((size_t)(i & kInputMask)));
+    });
+}
+
+// Time op(count) on arrays of count values, reporting per-value throughput.
+template <typename Op>
+static void RunBatch(Bench& bench, const char* name, size_t count, Op op)
+{
+    bench.run(name, [&](std::uint64_t iterations)
+    {
+        for (std::uint64_t i = 0; i < iterations; i++)
+            op(count);
+    }, (double)count);
+}
+
+static void RunVectorBenchmarks(Bench& bench, const MathInputs& in)
+{
+    RunOp(bench, "vec3f/construct",     [&](size_t i) { return vec3f(in.floats[i], in.floats[i ^ 1], in.floats[i ^ 2]); });
+    RunOp(bench, "vec3f/add",           [&](size_t i) { return in.vec3s[i] + in.vec3s[i ^ 1]; });
+    RunOp(bench, "vec3f/scale",         [&](size_t i) { return in.vec3s[i] * in.floats[i]; });
+    RunOp(bench, "vec3f/dot",           [&](size_t i) { return vec3f::dot(in.vec3s[i], in.vec3s[i ^ 1]); });
+    RunOp(bench, "vec3f/cross",         [&](size_t i) { return vec3f::cross(in.vec3s[i], in.vec3s[i ^ 1]); });
+    RunOp(bench, "vec3f/getLength",     [&](size_t i) { return in.vec3s[i].getLength(); });
+    RunOp(bench, "vec3f/getNormal",     [&](size_t i) { return in.vec3s[i].getNormal(); });
+    RunOp(bench, "vec3f/normalize",     [&](size_t i) { vec3f v = in.vec3s[i]; v.normalize(); return v; });
+    RunOp(bench, "vec3f/fromEuler",     [&](size_t i) { vec3f v; v.fromEuler(in.angles[i], in.angles[i ^ 1]); return v; });
+
+    RunOp(bench, "vec4f/construct",     [&](size_t i) { return vec4f(in.floats[i], in.floats[i ^ 1], in.floats[i ^ 2], in.floats[i ^ 3]); });
+    RunOp(bench, "vec4f/add",           [&](size_t i) { return in.vec4s[i] + in.vec4s[i ^ 1]; });
+    RunOp(bench, "vec4f/multiply",      [&](size_t i) { return in.vec4s[i] * in.vec4s[i ^ 1]; });
+    RunOp(bench, "vec4f/scale",         [&](size_t i) { return in.vec4s[i] * in.floats[i]; });
+    RunOp(bench, "vec4f/getLength",     [&](size_t i) { return in.vec4s[i].getLength(); });
+    RunOp(bench, "vec4f/getNormal",     [&](size_t i) { return in.vec4s[i].getNormal(); });
+}
+
+static void RunMatrixBenchmarks(Bench& bench, const MathInputs& in)
+{
+    RunOp(bench, "mat3f/setIdentity",          [&](size_t i) { mat3f m; m.setIdentity(); m.Xx = in.floats[i]; return m; });
+    RunOp(bench, "mat3f/multiply",             [&](size_t i) { return in.mat3s[i] * in.mat3s[i ^ 1]; });
+    RunOp(bench, "mat3f/setAxisAngleRotation", [&](size_t i) { mat3f m; m.setAxisAngleRotation(in.axes[i], in.angles[i]); return m; });
+    RunOp(bench, "mat3f/fromQuaternion",       [&](size_t i) { mat3f m; m.fromQuaternion(vec4f(in.quats[i].v)); return m; });
+    RunOp(bench, "mat3f/getDeterminant",       [&](size_t i) { return in.mat3s[i].getDeterminant(); });
+    RunOp(bench, "mat3f/getTranspose",         [&](size_t i) { return in.mat3s[i].getTranspose(); });
+    RunOp(bench, "mat3f/getInverse",           [&](size_t i) { return in.mat3s[i].getInverse(); });
+
+    RunOp(bench, "mat4f/construct",            [&](size_t i)
+    {
+        const float* f = in.floats;
+        return mat4f(f[i], f[i ^ 1], f[i ^ 2], 0.0f, f[i ^ 3], f[i ^ 4], f[i ^ 5], 0.0f, f[i ^ 6], f[i ^ 7], f[i ^ 8], 0.0f, f[i ^ 9], f[i ^ 10], f[i ^ 11], 1.0f);
+    });
+    RunOp(bench, "mat4f/setIdentity",          [&](size_t i) { mat4f m; m.setIdentity(); m.Xx = in.floats[i]; return m; });
+    RunOp(bench, "mat4f/create",               [&](size_t i) { mat4f m; m.create(in.mat3s[i], in.vec3s[i]); return m; });
+    RunOp(bench, "mat4f/multiply",             [&](size_t i) { return in.mat4s[i] * in.mat4s[i ^ 1]; });
+    RunOp(bench, "mat4f/multiply_vec4f",       [&](size_t i) { return in.mat4s[i] * in.vec4s[i]; });
+    RunOp(bench, "mat4f/setPerspective",       [&](size_t i) { mat4f m; m.setPerspective(1.0f + in.floats[i] * 0.5f, 16.0f / 9.0f, 0.1f, 100.0f); return m; });
+    RunOp(bench, "mat4f/setOrthographic",      [&](size_t i) { mat4f m; m.setOrthographic(-2.0f, 2.0f + in.floats[i], -1.0f, 1.0f, 0.1f, 100.0f); return m; });
+    RunOp(bench, "mat4f/lookAt",               [&](size_t i) { mat4f m; m.lookAt(in.vec3s[i], in.vec3s[i ^ 1], vec3f(0.0f, 0.0f, 1.0f)); return m; });
+    RunOp(bench, "mat4f/getTranspose",         [&](size_t i) { return in.mat4s[i].getTranspose(); });
+    RunOp(bench, "mat4f/getInverse",           [&](size_t i) { return in.mat4s[i].getInverse(); });
+    RunOp(bench, "mat4f/getAffineInverse",     [&](size_t i) { return in.affines[i].getAffineInverse(); });
+    RunOp(bench, "mat4f/getRigidInverse",      [&](size_t i) { return in.rigids[i].getRigidInverse(); });
+}
+
+static void RunQuaternionBenchmarks(Bench& bench, const MathInputs& in)
+{
+    RunOp(bench, "quatf/multiply",             [&](size_t i) { return in.quats[i] * in.quats[i ^ 1]; });
+    RunOp(bench, "quatf/setAxisAngleRotation", [&](size_t i) { quatf q; q.setAxisAngleRotation(in.axes[i], in.angles[i]); return q; });
+    RunOp(bench, "quatf/setEulerRotation",     [&](size_t i) { quatf q; q.setEulerRotation(in.angles[i], in.angles[i ^ 1], in.angles[i ^ 2]); return q; });
+    RunOp(bench, "quatf/normalize",            [&](size_t i) { quatf q = in.quats[i]; q.normalize(); return q; });
+    RunOp(bench, "quatf/nlerp",                [&](size_t i) { return quatf::nlerp(in.quats[i], in.quats[i ^ 1], 0.3f); });
+    RunOp(bench, "quatf/slerp",                [&](size_t i) { return quatf::slerp(in.quats[i], in.quats[i ^ 1], 0.3f); });
+    RunOp(bench, "quatf/rotate",               [&](size_t i) { return in.quats[i].rotate(in.vec3s[i]); });
+    RunOp(bench, "quatf/getMat3",              [&](size_t i) { return in.quats[i].getMat3(); });
+    RunOp(bench, "quatf/getMat4",              [&](size_t i) { return in.quats[i].getMat4(in.vec3s[i]); });
+
+    // The sample's per-object orientation update: incremental Euler rotation, then the model matrix.
+    RunOp(bench, "scene/orientation/mat3f_chain", [&](size_t i)
+    {
+        mat3f rx, ry, rz;
+        rx.setAxisAngleRotation(vec3f(1.0f, 0.0f, 0.0f), in.angles[i]);
+        ry.setAxisAngleRotation(vec3f(0.0f, 1.0f, 0.0f), in.angles[i ^ 1]);
+        rz.setAxisAngleRotation(vec3f(0.0f, 0.0f, 1.0f), in.angles[i ^ 2]);
+        const mat3f orientation = in.mat3s[i] * (rx * ry * rz);
+
+        mat4f transform;
+        transform.create(orientation, in.vec3s[i]);
+        return transform;
+    });
+    RunOp(bench, "scene/orientation/quatf", [&](size_t i)
+    {
+        quatf rotation;
+        rotation.setEulerRotation(in.angles[i], in.angles[i ^ 1], in.angles[i ^ 2]);
+        const quatf orientation = in.quats[i] * rotation;
+        return orientation.getMat4(in.vec3s[i]);
+    });
+}
+
+static void RunChainBenchmarks(Bench& bench, const MathInputs& in)
+{
+    // Projection * view * model, as the sample builds it per view.
+    RunOp(bench, "chain/pvm/eager",  [&](size_t i) { return in.mat4s[i] * in.rigids[i ^ 1] * in.affines[i ^ 2]; });
+    RunOp(bench, "chain/pvm/affine", [&](size_t i) { const mat4f m = in.mat4s[i] * MathExpr::Affine(in.rigids[i ^ 1]) * MathExpr::Affine(in.affines[i ^ 2]); return m; });
+
+    RunOp(bench, "chain/pvm_vec4f/eager", [&](size_t i) { return in.mat4s[i] * in.rigids[i ^ 1] * in.affines[i ^ 2] * in.vec4s[i]; });
+    RunOp(bench, "chain/pvm_vec4f/lazy",  [&](size_t i) { return MathExpr::Lazy(in.mat4s[i]) * in.rigids[i ^ 1] * in.affines[i ^ 2] * in.vec4s[i]; });
+
+    RunOp(bench, "chain/mat3f_vec3f/eager", [&](size_t i) { return MathExpr::Detail::Transform(in.mat3s[i] * in.mat3s[i ^ 1], in.vec3s[i]); });
+    RunOp(bench, "chain/mat3f_vec3f/lazy",  [&](size_t i) { return MathExpr::Lazy(in.mat3s[i]) * in.mat3s[i ^ 1] * in.vec3s[i]; });
+}
+
+static void RunFastMathBenchmarks(Bench& bench, const MathInputs& in)
+{
+    RunOp(bench, "fastmath/sinf_cosf/libm",   [&](size_t i) { return sinf(in.angles[i]) + cosf(in.angles[i]); });
+    RunOp(bench, "fastmath/sinf_cosf/fast",   [&](size_t i) { float s, c; FastMath::SinCos(in.angles[i], s, c); return s + c; });
+    RunOp(bench, "fastmath/tanf/libm",        [&](size_t i) { return tanf(in.angles[i] * 0.45f); });
+    RunOp(bench, "fastmath/tanf/fast",        [&](size_t i) { return FastMath::Tan(in.angles[i] * 0.45f); });
+    RunOp(bench, "fastmath/atan2f/libm",      [&](size_t i) { return atan2f(in.floats[i], in.floats[i ^ 1]); });
+    RunOp(bench, "fastmath/atan2f/fast",      [&](size_t i) { return FastMath::Atan2(in.floats[i], in.floats[i ^ 1]); });
+    RunOp(bench, "fastmath/expf/libm",        [&](size_t i) { return expf(in.angles[i] * 10.0f); });
+    RunOp(bench, "fastmath/expf/fast",        [&](size_t i) { return FastMath::Exp(in.angles[i] * 10.0f); });
+
+    const size_t kBatchCount = 4096;
+    std::vector<float> src(kBatchCount), src2(kBatchCount), dst(kBatchCount), dst2(kBatchCount);
+    for (size_t i = 0; i < kBatchCount; i++)
+    {
+        src[i]  = in.angles[i & kInputMask] * (1.0f + (float)(i >> 8));
+        src2[i] = in.floats[(i * 7) & kInputMask];
+    }
+
+    RunBatch(bench, "fastmath/sinf_cosf/libm/4096", kBatchCount, [&](size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            dst[i]  = sinf(src[i]);
+            dst2[i] = cosf(src[i]);
+        }
+        DoNotOptimize(dst[0]);
+    });
+    RunBatch(bench, "fastmath/sinf_cosf/fast/4096", kBatchCount, [&](size_t count) { FastMath::SinCos(dst.data(), dst2.data(), src.data(), count); DoNotOptimize(dst[0]); });
+
+    RunBatch(bench, "fastmath/tanf/libm/4096", kBatchCount, [&](size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+            dst[i] = tanf(src[i]);
+        DoNotOptimize(dst[0]);
+    });
+    RunBatch(bench, "fastmath/tanf/fast/4096", kBatchCount, [&](size_t count) { FastMath::Tan(dst.data(), src.data(), count); DoNotOptimize(dst[0]); });
+
+    RunBatch(bench, "fastmath/atan2f/libm/4096", kBatchCount, [&](size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+            dst[i] = atan2f(src[i], src2[i]);
+        DoNotOptimize(dst[0]);
+    });
+    RunBatch(bench, "fastmath/atan2f/fast/4096", kBatchCount, [&](size_t count) { FastMath::Atan2(dst.data(), src.data(), src2.data(), count); DoNotOptimize(dst[0]); });
+
+    RunBatch(bench, "fastmath/expf/libm/4096", kBatchCount, [&](size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+            dst[i] = expf(src2[i] * 80.0f);
+        DoNotOptimize(dst[0]);
+    });
+    RunBatch(bench, "fastmath/expf/fast/4096", kBatchCount, [&](size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+            dst2[i] = src2[i] * 80.0f;
+        FastMath::Exp(dst.data(), dst2.data(), count);
+        DoNotOptimize(dst[0]);
+    });
+}
+
+// Error of a float result in units in the last place of the exact result.
+static double UlpError(float value, double exact)
+{
+    int exponent = 0;
+    frexp(exact, &exponent);
+    const double ulp = ldexp(1.0, std::max(exponent, -125) - 24);
+    return fabs((double)value - exact) / ulp;
+}
+
+static void MeasureFastMathAccuracy(Bench& bench)
+{
+    const int kSamples = 200000;
+
+    double sinCosUlp = 0.0, sinCosAbs = 0.0, tanUlp = 0.0, atan2Ulp = 0.0, expUlp = 0.0;
+    for (int i = 0; i <= kSamples; i++)
+    {
+        const double t = (double)i / kSamples;
+
+        const float x = (float)((t * 2.0 - 1.0) * 0.785398163397448310);
+        float s, c;
+        FastMath::SinCos(x, s, c);
+        sinCosUlp = std::max(sinCosUlp, std::max(UlpError(s, sin((double)x)), UlpError(c, cos((double)x))));
+        tanUlp    = std::max(tanUlp, UlpError(FastMath::Tan(x), tan((double)x)));
+
+        const float wide = (float)((t * 2.0 - 1.0) * 8192.0);
+        FastMath::SinCos(wide, s, c);
+        sinCosAbs = std::max(sinCosAbs, std::max(fabs(s - sin((double)wide)), fabs(c - cos((double)wide))));
+
+        const float angle = (float)(t * 6.283185307179586);
+        const float y     = (float)sin((double)angle) * (1.0f + (float)(i & 7));
+        const float xx    = (float)cos((double)angle) * (1.0f + (float)(i & 7));
+        atan2Ulp = std::max(atan2Ulp, UlpError(FastMath::Atan2(y, xx), atan2((double)y, (double)xx)));
+
+        const float e = (float)(-87.3 + t * (88.3 + 87.3));
+        expUlp = std::max(expUlp, UlpError(FastMath::Exp(e), exp((double)e)));
+    }
+
+    // Within the bounds documented in CNSDKGettingStartedFastMath.h.
+    bench.metric("accuracy/fastmath/SinCos/pi4",     sinCosUlp, "ulp", FastMath::kSinCosMaxUlp);
+    bench.metric("accuracy/fastmath/SinCos/8192",    sinCosAbs, "abs", FastMath::kSinCosWideMaxAbs);
+    bench.metric("accuracy/fastmath/Tan/pi4",        tanUlp,    "ulp", FastMath::kTanMaxUlp);
+    bench.metric("accuracy/fastmath/Atan2",          atan2Ulp,  "ulp", FastMath::kAtan2MaxUlp);
+    bench.metric("accuracy/fastmath/Exp",            expUlp,    "ulp", FastMath::kExpMaxUlp);
+}
+
+// Inverse of a column-major n x n matrix by Gauss-Jordan elimination with partial pivoting.
+static bool InvertReference(const double* matrix, double* inverse, int n)
+{
+    double rows[4][8];
+    for (int r = 0; r < n; r++)
+    {
+        for (int c = 0; c < n; c++)
+        {
+            rows[r][c]     = matrix[c * n + r];
+            rows[r][c + n] = (r == c) ? 1.0 : 0.0;
+        }
+    }
+
+    for (int c = 0; c < n; c++)
+    {
+        int pivot = c;
+        for (int r = c + 1; r < n; r++)
+        {
+            if (fabs(rows[r][c]) > fabs(rows[pivot][c]))
+                pivot = r;
+        }
+        if (rows[pivot][c] == 0.0)
+            return false;
+
+        for (int j = 0; j < 2 * n; j++)
+            std::swap(rows[c][j], rows[pivot][j]);
+
+        const double scale = 1.0 / rows[c][c];
+        for (int j = 0; j < 2 * n; j++)
+            rows[c][j] *= scale;
+
+        for (int r = 0; r < n; r++)
+        {
+            if (r == c)
+                continue;
+            const double factor = rows[r][c];
+            for (int j = 0; j < 2 * n; j++)
+                rows[r][j] -= factor * rows[c][j];
+        }
+    }
+
+    for (int r = 0; r < n; r++)
+    {
+        for (int c = 0; c < n; c++)
+            inverse[c * n + r] = rows[r][c + n];
+    }
+    return true;
+}
+
+// Largest element error relative to the largest reference element. Returns -1 for matrices too
+// badly conditioned (product of the largest elements of matrix and inverse over 100) to judge.
+static double InverseError(const float* matrix, const float* inverse, int n)
+{
+    double reference[16], referenceInverse[16];
+    for (int i = 0; i < n * n; i++)
+        reference[i] = matrix[i];
+    if (!InvertReference(reference, referenceInverse, n))
+        return -1.0;
+
+    double maxMatrix = 0.0, maxInverse = 0.0, maxError = 0.0;
+    for (int i = 0; i < n * n; i++)
+    {
+        maxMatrix  = std::max(maxMatrix, fabs(reference[i]));
+        maxInverse = std::max(maxInverse, fabs(referenceInverse[i]));
+        maxError   = std::max(maxError, fabs(inverse[i] - referenceInverse[i]));
+    }
+    if (maxMatrix * maxInverse > 100.0)
+        return -1.0;
+    return maxError / maxInverse;
+}
+
+static void MeasureInverseAccuracy(Bench& bench)
+{
+    const int kSamples = 50000;
+    BenchRandom random(99);
+
+    double general = 0.0, affine = 0.0, rigid = 0.0, general3 = 0.0;
+    for (int i = 0; i < kSamples; i++)
+    {
+        mat4f m;
+        for (float& value : m.m)
+            value = random.nextFloat(-1.0f, 1.0f);
+        general = std::max(general, InverseError(m.m, m.getInverse().m, 4));
+
+        m.Xw = 0.0f;
+        m.Yw = 0.0f;
+        m.Zw = 0.0f;
+        m.Ww = 1.0f;
+        affine = std::max(affine, InverseError(m.m, m.getAffineInverse().m, 4));
+
+        const vec3f axis = vec3f(random.nextFloat(-1.0f, 1.0f), random.nextFloat(-1.0f, 1.0f), random.nextFloat(0.1f, 1.0f)).getNormal();
+        mat3f rotation;
+        rotation.setAxisAngleRotation(axis, random.nextFloat(-3.0f, 3.0f));
+        mat4f r;
+        r.create(rotation, vec3f(random.nextFloat(-10.0f, 10.0f), random.nextFloat(-10.0f, 10.0f), random.nextFloat(-10.0f, 10.0f)));
+        rigid = std::max(rigid, InverseError(r.m, r.getRigidInverse().m, 4));
+
+        mat3f m3;
+        for (float& value : m3.m)
+            value = random.nextFloat(-1.0f, 1.0f);
+        general3 = std::max(general3, InverseError(m3.m, m3.getInverse().m, 3));
+    }
+
+    bench.metric("accuracy/mat4f/getInverse",       general,  "relative");
+    bench.metric("accuracy/mat4f/getAffineInverse", affine,   "relative");
+    bench.metric("accuracy/mat4f/getRigidInverse",  rigid,    "relative");
+    bench.metric("accuracy/mat3f/getInverse",       general3, "relative");
+}
+
+// Largest element difference of mat4f::setOrthographic from mat4::setOrthographic in double,
+// relative to the largest reference element.
+static void MeasureOrthographicAccuracy(Bench& bench)
+{
+    const int kSamples = 50000;
+    BenchRandom random(101);
+
+    double error = 0.0;
+    for (int i = 0; i < kSamples; i++)
+    {
+        const float left   = random.nextFloat(-1000.0f, 0.0f);
+        const float right  = left + random.nextFloat(1.0f, 2000.0f);
+        const float bottom = random.nextFloat(-1000.0f, 0.0f);
+        const float top    = bottom + random.nextFloat(1.0f, 2000.0f);
+        const float znear  = random.nextFloat(0.01f, 10.0f);
+        const float zfar   = znear + random.nextFloat(1.0f, 10000.0f);
+
+        mat4f m;
+        m.setOrthographic(left, right, bottom, top, znear, zfar);
+        mat4 reference;
+        reference.setOrthographic(left, right, bottom, top, znear, zfar);
+
+        double maxReference = 0.0, maxError = 0.0;
+        for (int j = 0; j < 16; j++)
+        {
+            maxReference = std::max(maxReference, fabs(reference.m[j]));
+            maxError     = std::max(maxError, fabs(m.m[j] - reference.m[j]));
+        }
+        error = std::max(error, maxError / maxReference);
+    }
+
+    bench.metric("accuracy/mat4f/setOrthographic", error, "relative");
+}
+
+// Rotations about X, Y and Z composed as X * Y * Z, by mat3f products and by quatf Euler angles,
+// against the mat3 product in double: the largest element difference (all elements are in
+// [-1, 1]). Vectors rotated by the product and the quaternion are compared too.
+static void MeasureRotationAccuracy(Bench& bench)
+{
+    const int kSamples = 50000;
+    BenchRandom random(103);
+
+    double product = 0.0, euler = 0.0, rotate = 0.0;
+    for (int i = 0; i < kSamples; i++)
+    {
+        const float ax = random.nextFloat(-3.0f, 3.0f);
+        const float ay = random.nextFloat(-3.0f, 3.0f);
+        const float az = random.nextFloat(-3.0f, 3.0f);
+
+        mat3f rx, ry, rz;
+        rx.setAxisAngleRotation(vec3f(1.0f, 0.0f, 0.0f), ax);
+        ry.setAxisAngleRotation(vec3f(0.0f, 1.0f, 0.0f), ay);
+        rz.setAxisAngleRotation(vec3f(0.0f, 0.0f, 1.0f), az);
+        const mat3f m = rx * ry * rz;
+
+        quatf q;
+        q.setEulerRotation(ax, ay, az);
+        const mat3f mq = q.getMat3();
+
+        mat3 refX, refY, refZ;
+        refX.setAxisAngleRotation(vec3(1.0, 0.0, 0.0), ax);
+        refY.setAxisAngleRotation(vec3(0.0, 1.0, 0.0), ay);
+        refZ.setAxisAngleRotation(vec3(0.0, 0.0, 1.0), az);
+        const mat3 reference = refX * refY * refZ;
+
+        for (int j = 0; j < 9; j++)
+        {
+            product = std::max(product, fabs(m.m[j] - reference.m[j]));
+            euler   = std::max(euler, fabs(mq.m[j] - reference.m[j]));
+        }
+
+        const vec3f p  = vec3f(random.nextFloat(-1.0f, 1.0f), random.nextFloat(-1.0f, 1.0f), random.nextFloat(-1.0f, 1.0f));
+        const vec3f pm = m.e[0] * p.x + m.e[1] * p.y + m.e[2] * p.z;
+        const vec3f pq = q.rotate(p);
+        for (int j = 0; j < 3; j++)
+            rotate = std::max(rotate, (double)fabsf(pm.e[j] - pq.e[j]));
+    }
+
+    bench.metric("accuracy/mat3f/product",         product, "abs");
+    bench.metric("accuracy/quatf/setEulerRotation", euler,   "abs");
+    bench.metric("accuracy/quatf/rotate",           rotate,  "abs");
+}
+
+static const char* GetViewInfoModeName(ViewInfoMode mode)
+{
+    switch (mode)
+    {
+    case ViewInfoMode::Perspective:          return "perspective";
+    case ViewInfoMode::PerspectiveFromPlane: return "perspective_from_plane";
+    default:                                 return "orthographic";
+    }
+}
+
+// Offsets of viewCount views spread along x, like a display's view offsets.
+static std::vector<vec3f> MakeViewOffsets(int viewCount)
+{
+    std::vector<vec3f> offsets(viewCount);
+    for (int i = 0; i < viewCount; i++)
+        offsets[i] = vec3f((i - 0.5f * (viewCount - 1)) * 3.25f, 0.1f * i, -0.05f * i);
+    return offsets;
+}
+
+static ViewInfoCamera MakeViewInfoCamera(ViewInfoMode mode)
+{
+    ViewInfoCamera camera;
+    camera.mode                     = mode;
+    camera.position                 = vec3f(10.0f, -20.0f, 5.0f);
+    camera.direction                = vec3f(0.6f, 0.8f, 0.0f);
+    camera.up                       = vec3f(0.0f, 0.0f, 1.0f);
+    camera.perspectiveFieldOfView   = 1.2f;
+    camera.perspectiveAspectRatio   = 16.0f / 9.0f;
+    camera.orthoWidth               = 800.0f;
+    camera.orthoHeight              = 450.0f;
+    camera.convergencePlaneDistance = 500.0f;
+    camera.convergencePlaneHeight   = 400.0f;
+    return camera;
+}
+
+static void RunViewInfoBenchmarks(Bench& bench)
+{
+    for (ViewInfoMode mode : { ViewInfoMode::Perspective, ViewInfoMode::PerspectiveFromPlane, ViewInfoMode::Orthographic })
+    {
+        const ViewInfoCamera camera = MakeViewInfoCamera(mode);
+
+        for (int viewCount : { 2, 8 })
+        {
+            const std::vector<vec3f> offsets = MakeViewOffsets(viewCount);
+            std::vector<vec3f> positions(viewCount);
+            std::vector<mat4f> projections(viewCount);
+
+            const std::string name = std::string("viewinfo/") + GetViewInfoModeName(mode) + "/views" + std::to_string(viewCount);
+
+            bench.run(name + "/batched", [&](std::uint64_t n)
+            {
+                for (std::uint64_t i = 0; i < n; i++)
+                {
+                    GetViewInfos(camera, offsets.data(), viewCount, positions.data(), projections.data());
+                    DoNotOptimize(projections[0]);
+                }
+            }, (double)viewCount);
+
+            // One call per view, as with the SDK, recomputing the shared terms each time.
+            bench.run(name + "/per_view", [&](std::uint64_t n)
+            {
+                for (std::uint64_t i = 0; i < n; i++)
+                {
+                    for (int view = 0; view < viewCount; view++)
+                        GetViewInfos(camera, &offsets[view], 1, &positions[view], &projections[view]);
+                    DoNotOptimize(projections[0]);
+                }
+            }, (double)viewCount);
+        }
+    }
+}
+
+// A frame's view info lookup with a still camera and face, against computing the views every frame.
+static void RunViewInfoCacheBenchmarks(Bench& bench)
+{
+    const int kViewCount = 8;
+
+    const std::vector<vec3f> offsets = MakeViewOffsets(kViewCount);
+    std::vector<vec3f> positions(kViewCount);
+    std::vector<mat4f> projections(kViewCount);
+
+    ViewInfoCacheKey key;
+    key.camera    = MakeViewInfoCamera(ViewInfoMode::Perspective);
+    key.viewCount = kViewCount;
+    std::copy(offsets.begin(), offsets.end(), key.viewOffsets);
+
+    ViewInfoCache cache;
+    GetViewInfos(key.camera, offsets.data(), kViewCount, positions.data(), projections.data());
+    cache.insert(key, positions.data(), projections.data());
+
+    bench.run("viewinfo/cache/views8/hit", [&](std::uint64_t n)
+    {
+        for (std::uint64_t i = 0; i < n; i++)
+        {
+            cache.find(key, positions.data(), projections.data());
+            DoNotOptimize(projections[0]);
+        }
+    }, (double)kViewCount);
+
+    bench.run("viewinfo/cache/views8/miss", [&](std::uint64_t n)
+    {
+        for (std::uint64_t i = 0; i < n; i++)
+        {
+            cache.invalidate();
+            if (!cache.find(key, positions.data(), projections.data()))
+            {
+                GetViewInfos(key.camera, offsets.data(), kViewCount, positions.data(), projections.data());
+                cache.insert(key, positions.data(), projections.data());
+            }
+            DoNotOptimize(projections[0]);
+        }
+    }, (double)kViewCount);
+}
+
+// Per-frame cost of late latching two views through the cache, clock reads included.
+static void RunViewLatchBenchmarks(Bench& bench)
+{
+    const std::vector<vec3f> offsets = MakeViewOffsets(2);
+
+    ViewInfoCacheKey key;
+    key.camera    = MakeViewInfoCamera(ViewInfoMode::Perspective);
+    key.viewCount = 2;
+    std::copy(offsets.begin(), offsets.end(), key.viewOffsets);
+
+    ViewInfoCache cache;
+    ViewLatch latch([&](FrameViews& views)
+    {
+        views.viewCount   = key.viewCount;
+        views.faceTracked = true;
+        views.viewsReused = cache.find(key, views.viewPositions, views.viewProjections);
+        if (!views.viewsReused)
+        {
+            GetViewInfos(key.camera, key.viewOffsets, key.viewCount, views.viewPositions, views.viewProjections);
+            cache.insert(key, views.viewPositions, views.viewProjections);
+        }
+        return true;
+    });
+
+    bench.run("viewlatch/stereo/frame", [&](std::uint64_t n)
+    {
+        for (std::uint64_t i = 0; i < n; i++)
+        {
+            latch.beginFrame();
+            DoNotOptimize(latch.latch().viewProjections[0]);
+            latch.submit();
+        }
+    });
+}
+
+// Hit rate of the view info cache for a seated viewer: the tracked face jitters by up to 0.3 mm a
+// frame around a point and drifts 5 mm over the run, moving the view offsets by 0.1 scene units
+// per mm. Reported as the miss rate, lower is better.
+static void MeasureViewInfoCacheHitRate(Bench& bench)
+{
+    const int   kFrames          = 10000;
+    const float kSceneUnitsPerMm = 0.1f;
+
+    ViewInfoCacheKey key;
+    key.camera    = MakeViewInfoCamera(ViewInfoMode::Perspective);
+    key.viewCount = 2;
+
+    const std::vector<vec3f> offsets = MakeViewOffsets(key.viewCount);
+    vec3f positions[2];
+    mat4f projections[2];
+
+    ViewInfoCache cache;
+    std::uint32_t seed = 1;
+    for (int frame = 0; frame < kFrames; frame++)
+    {
+        float jitter[3];
+        for (int i = 0; i < 3; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            jitter[i] = 0.3f * ((float)(seed >> 8) / 16777216.0f * 2.0f - 1.0f);
+        }
+        const vec3f faceMovement = vec3f(jitter[0] + 5.0f * frame / kFrames, jitter[1], jitter[2]);
+        for (int i = 0; i < key.viewCount; i++)
+            key.viewOffsets[i] = offsets[i] + faceMovement * kSceneUnitsPerMm;
+
+        if (!cache.find(key, positions, projections))
+        {
+            GetViewInfos(key.camera, key.viewOffsets, key.viewCount, positions, projections);
+            cache.insert(key, positions, projections);
+        }
+    }
+
+    bench.metric("viewinfo/cache/seated/miss_rate", 1.0 - cache.getStats().getHitRate(), "ratio");
+}
+
+// Largest difference of GetViewInfos from the same formulas in double, over matrix elements and
+// position components.
+static void MeasureViewInfoAccuracy(Bench& bench)
+{
+    const int kViewCount = 8;
+    const std::vector<vec3f> offsets = MakeViewOffsets(kViewCount);
+
+    for (ViewInfoMode mode : { ViewInfoMode::Perspective, ViewInfoMode::PerspectiveFromPlane, ViewInfoMode::Orthographic })
+    {
+        const std::string name = std::string("accuracy/viewinfo/") + GetViewInfoModeName(mode);
+        if (!bench.isSelected(name))
+            continue;
+
+        const ViewInfoCamera camera = MakeViewInfoCamera(mode);
+        const bool orthographic = (mode == ViewInfoMode::Orthographic);
+
+        vec3f positions[kViewCount];
+        mat4f projections[kViewCount];
+        GetViewInfos(camera, offsets.data(), kViewCount, positions, projections);
+
+        const vec3 forward(camera.direction);
+        const vec3 right = vec3::cross(forward, vec3(camera.up)).getNormal();
+        const vec3 up    = vec3::cross(right, forward);
+
+        double halfWidth, halfHeight;
+        if (mode == ViewInfoMode::Perspective)
+        {
+            halfWidth  = camera.convergencePlaneDistance * tan(0.5 * camera.perspectiveFieldOfView);
+            halfHeight = halfWidth / camera.perspectiveAspectRatio;
+        }
+        else if (mode == ViewInfoMode::PerspectiveFromPlane)
+        {
+            halfHeight = 0.5 * camera.convergencePlaneHeight;
+            halfWidth  = halfHeight * camera.perspectiveAspectRatio;
+        }
+        else
+        {
+            halfWidth  = 0.5 * camera.orthoWidth;
+            halfHeight = 0.5 * camera.orthoHeight;
+        }
+
+        const double n = camera.nearPlane;
+        const double f = camera.farPlane;
+
+        double projectionError = 0.0, positionError = 0.0;
+        for (int view = 0; view < kViewCount; view++)
+        {
+            const vec3   o(offsets[view]);
+            const double planeDistance = camera.convergencePlaneDistance - o.z;
+            const double shearX        = -o.x / planeDistance;
+            const double shearY        = -o.y / planeDistance;
+
+            mat4 expected;
+            expected.clear();
+            if (orthographic)
+            {
+                expected.Xx = 1.0 / halfWidth;
+                expected.Yy = 1.0 / halfHeight;
+                expected.Zx = shearX / halfWidth;
+                expected.Zy = shearY / halfHeight;
+                expected.Zz = -2.0 / (f - n);
+                expected.Wz = -(f + n) / (f - n);
+                expected.Ww = 1.0;
+            }
+            else
+            {
+                expected.Xx = planeDistance / halfWidth;
+                expected.Yy = planeDistance / halfHeight;
+                expected.Zx = -o.x / halfWidth;
+                expected.Zy = -o.y / halfHeight;
+                expected.Zz = -(f + n) / (f - n);
+                expected.Zw = -1.0;
+                expected.Wz = -(2.0 * f * n) / (f - n);
+            }
+
+            const vec3 position = vec3(camera.position) + right * o.x + up * o.y + forward * o.z;
+            for (int i = 0; i < 16; i++)
+                projectionError = std::max(projectionError, fabs(projections[view].m[i] - expected.m[i]));
+            for (int i = 0; i < 3; i++)
+                positionError = std::max(positionError, fabs(positions[view].e[i] - position.e[i]));
+        }
+
+        bench.metric(name + "/projection", projectionError, "abs");
+        bench.metric(name + "/position",   positionError,   "abs");
+    }
+}
+
+void RunMathBenchmarks(Bench& bench)
+{
+    std::unique_ptr<MathInputs> inputs(new MathInputs);
+    FillInputs(*inputs);
+
+    RunVectorBenchmarks(bench, *inputs);
+    RunMatrixBenchmarks(bench, *inputs);
+    RunQuaternionBenchmarks(bench, *inputs);
+    RunChainBenchmarks(bench, *inputs);
+    RunFastMathBenchmarks(bench, *inputs);
+    RunViewInfoBenchmarks(bench);
+    RunViewInfoCacheBenchmarks(bench);
+    RunViewLatchBenchmarks(bench);
+
+    MeasureFastMathAccuracy(bench);
+    MeasureInverseAccuracy(bench);
+    MeasureOrthographicAccuracy(bench);
+    MeasureRotationAccuracy(bench);
+    MeasureViewInfoAccuracy(bench);
+    MeasureViewInfoCacheHitRate(bench);
+}
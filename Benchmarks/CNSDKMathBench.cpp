@@ -0,0 +1,166 @@
+// Microbenchmarks of the math types and the image/batch kernels, see CNSDKBench.h.
+//
+// Usage: cnsdk_math_bench [--filter text] [--quick] [--repetitions n] [--warmup n] [--min-time ms]
+//                         [--json output.json] [--list] [--slow]
+//        cnsdk_math_bench --compare baseline.json current.json [--threshold percent] [--stat min]
+//
+// --compare prints the change of every benchmark between two runs and exits with status 1 if any
+// got slower (or, for the accuracy metrics, less accurate) by more than the threshold, 5% by default.
+// It compares the fastest repetition unless --stat picks another statistic; the minimum is the
+// least disturbed by other load on the machine. To compare builds, e.g. the SIMD math against
+// CNSDK_MATH_SCALAR, save a run of each and compare them.
+//
+// A run exits with status 1 if a metric exceeds its documented bound, e.g. the FastMath error bounds.
+//
+// --slow also runs benchmarks taking minutes, e.g. the old quadratic file read on a 100 MB image.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include "CNSDKBench.h"
+#include "CNSDKGettingStartedMath.h"
+#include "CNSDKGettingStartedPixels.h"
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+static void PrintUsage()
+{
+    printf("Usage: cnsdk_math_bench [--filter text] [--quick] [--repetitions n] [--warmup n] [--min-time ms]\n");
+    printf("                        [--json output.json] [--list] [--slow]\n");
+    printf("       cnsdk_math_bench --compare baseline.json current.json [--threshold percent] [--stat min|p50|p90|p99|mean]\n");
+}
+
+static const char* GetMathBackendName()
+{
+#if defined(CNSDK_MATH_AVX)
+    return "AVX";
+#elif defined(CNSDK_MATH_SSE)
+    return "SSE2";
+#elif defined(CNSDK_MATH_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+static std::string GetCompilerName()
+{
+#if defined(__clang__)
+    return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    return std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+static void SetBuildContext(Bench& bench)
+{
+    bench.setContext("math_backend", GetMathBackendName());
+#if defined(CNSDK_MATH_FAST_TRIG)
+    bench.setContext("math_trig", "fast");
+#else
+    bench.setContext("math_trig", "libm");
+#endif
+    bench.setContext("pixel_kernels", GetPixelKernelSetName(GetPixelKernelSet()));
+    bench.setContext("compiler", GetCompilerName());
+#if defined(NDEBUG)
+    bench.setContext("assertions", "off");
+#else
+    bench.setContext("assertions", "on");
+#endif
+    bench.setContext("hardware_threads", std::to_string(std::thread::hardware_concurrency()));
+}
+
+int main(int argc, char** argv)
+{
+    BenchSettings settings;
+    const char*   jsonPath  = nullptr;
+    const char*   baseline  = nullptr;
+    const char*   current   = nullptr;
+    const char*   statistic = "min";
+    double        threshold = 5.0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg     = argv[i];
+        const bool  hasNext = (i + 1 < argc);
+
+        if (strcmp(arg, "--filter") == 0 && hasNext)
+            settings.filter = argv[++i];
+        else if (strcmp(arg, "--quick") == 0)
+        {
+            settings.warmup      = 1;
+            settings.repetitions = 10;
+            settings.minTime     = 0.5e-3;
+        }
+        else if (strcmp(arg, "--repetitions") == 0 && hasNext)
+            settings.repetitions = atoi(argv[++i]);
+        else if (strcmp(arg, "--warmup") == 0 && hasNext)
+            settings.warmup = atoi(argv[++i]);
+        else if (strcmp(arg, "--min-time") == 0 && hasNext)
+            settings.minTime = atof(argv[++i]) * 1e-3;
+        else if (strcmp(arg, "--json") == 0 && hasNext)
+            jsonPath = argv[++i];
+        else if (strcmp(arg, "--list") == 0)
+            settings.listOnly = true;
+        else if (strcmp(arg, "--slow") == 0)
+            settings.slow = true;
+        else if (strcmp(arg, "--compare") == 0 && (i + 2 < argc))
+        {
+            baseline = argv[++i];
+            current  = argv[++i];
+        }
+        else if (strcmp(arg, "--threshold") == 0 && hasNext)
+            threshold = atof(argv[++i]);
+        else if (strcmp(arg, "--stat") == 0 && hasNext)
+            statistic = argv[++i];
+        else
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    if (baseline != nullptr)
+    {
+        const int regressions = CompareBenchFiles(baseline, current, threshold, statistic);
+        return (regressions < 0) ? 2 : (regressions > 0) ? 1 : 0;
+    }
+
+    Bench bench(settings);
+    SetBuildContext(bench);
+    if (!settings.listOnly)
+        printf("Math backend %s, pixel kernels %s, %u hardware threads\n\n", GetMathBackendName(), GetPixelKernelSetName(GetPixelKernelSet()), std::thread::hardware_concurrency());
+
+    RunMathBenchmarks(bench);
+    RunKernelBenchmarks(bench);
+
+    if (settings.listOnly)
+        return 0;
+
+#if defined(__linux__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        bench.setContext("peak_rss_kb", std::to_string(usage.ru_maxrss));
+#endif
+
+    if ((jsonPath != nullptr) && !bench.writeJSON(jsonPath))
+    {
+        fprintf(stderr, "Can't write %s\n", jsonPath);
+        return 2;
+    }
+
+    if (bench.getFailureCount() > 0)
+    {
+        fprintf(stderr, "%d metrics exceed their bounds\n", bench.getFailureCount());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,327 @@
+#include "CNSDKGettingStartedCulling.h"
+#include <string.h>
+#include <algorithm>
+#include <memory>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace MathSIMD;
+
+namespace
+{
+    // Objects per step, one bit each in the masks of Outside.
+    const size_t kBlockSize = 8;
+    static_assert(kBatchPadding % kBlockSize == 0, "ForEachBatchRange ranges must start on whole blocks");
+
+#if defined(CNSDK_MATH_AVX)
+    // A block in one AVX register. Blocks start on kBatchAlignment boundaries.
+    typedef __m256 Vec8;
+
+    inline Vec8 Load8(const float* p)           { return _mm256_load_ps(p); }
+    inline Vec8 Splat8(float s)                 { return _mm256_set1_ps(s); }
+    inline Vec8 Add8(Vec8 a, Vec8 b)            { return _mm256_add_ps(a, b); }
+    inline Vec8 Mul8(Vec8 a, Vec8 b)            { return _mm256_mul_ps(a, b); }
+    inline Vec8 Or8(Vec8 a, Vec8 b)             { return _mm256_or_ps(a, b); }
+    inline Vec8 Less8(Vec8 a, Vec8 b)           { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    inline int  MoveMask8(Vec8 mask)            { return _mm256_movemask_ps(mask); }
+#else
+    // A block in two MathSIMD registers.
+    struct Vec8
+    {
+        Vec4 lo, hi;
+    };
+
+    inline Vec8 Load8(const float* p)           { return Vec8{ Load(p), Load(p + 4) }; }
+    inline Vec8 Splat8(float s)                 { return Vec8{ Splat(s), Splat(s) }; }
+    inline Vec8 Add8(Vec8 a, Vec8 b)            { return Vec8{ Add(a.lo, b.lo), Add(a.hi, b.hi) }; }
+    inline Vec8 Mul8(Vec8 a, Vec8 b)            { return Vec8{ Mul(a.lo, b.lo), Mul(a.hi, b.hi) }; }
+    inline Vec8 Or8(Vec8 a, Vec8 b)             { return Vec8{ Or(a.lo, b.lo), Or(a.hi, b.hi) }; }
+    inline Vec8 Less8(Vec8 a, Vec8 b)           { return Vec8{ Less(a.lo, b.lo), Less(a.hi, b.hi) }; }
+    inline int  MoveMask8(Vec8 mask)            { return MoveMask(mask.lo) | (MoveMask(mask.hi) << 4); }
+#endif
+
+    // Index of the lowest set bit of a nonzero value.
+    inline int CountTrailingZeros(int value)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, (unsigned long)value);
+        return (int)index;
+#else
+        return __builtin_ctz((unsigned int)value);
+#endif
+    }
+
+    struct BoxBlock
+    {
+        Vec8 x, y, z;
+        Vec8 ex, ey, ez;
+    };
+
+    struct SphereBlock
+    {
+        Vec8 x, y, z;
+        Vec8 r;
+    };
+
+    // A plane splatted across a block, with the absolute normal for the box extents.
+    struct PlaneLanes
+    {
+        Vec8 x, y, z, d;
+        Vec8 ax, ay, az;
+    };
+
+    struct FrustumLanes
+    {
+        PlaneLanes planes[Frustum::PlaneCount];
+
+        void set(const Frustum& frustum)
+        {
+            for (int i = 0; i < Frustum::PlaneCount; i++)
+            {
+                const vec4f& plane = frustum.planes[i];
+                planes[i] = PlaneLanes{ Splat8(plane.x), Splat8(plane.y), Splat8(plane.z), Splat8(plane.w), Splat8(fabsf(plane.x)), Splat8(fabsf(plane.y)), Splat8(fabsf(plane.z)) };
+            }
+        }
+    };
+
+    // Bit j set if object j of the block is entirely outside a plane of frustum. The arithmetic is
+    // the same as Frustum::intersectsBox and intersectsSphere.
+    int Outside(const FrustumLanes& frustum, const BoxBlock& block)
+    {
+        const Vec8 zero = Splat8(0.0f);
+
+        Vec8 outside = zero;
+        for (const PlaneLanes& plane : frustum.planes)
+        {
+            const Vec8 distance = Add8(Add8(Add8(Mul8(plane.x, block.x), Mul8(plane.y, block.y)), Mul8(plane.z, block.z)), plane.d);
+            const Vec8 radius   = Add8(Add8(Mul8(plane.ax, block.ex), Mul8(plane.ay, block.ey)), Mul8(plane.az, block.ez));
+            outside = Or8(outside, Less8(Add8(distance, radius), zero));
+        }
+        return MoveMask8(outside);
+    }
+
+    int Outside(const FrustumLanes& frustum, const SphereBlock& block)
+    {
+        const Vec8 zero = Splat8(0.0f);
+
+        Vec8 outside = zero;
+        for (const PlaneLanes& plane : frustum.planes)
+        {
+            const Vec8 distance = Add8(Add8(Add8(Mul8(plane.x, block.x), Mul8(plane.y, block.y)), Mul8(plane.z, block.z)), plane.d);
+            outside = Or8(outside, Less8(Add8(distance, block.r), zero));
+        }
+        return MoveMask8(outside);
+    }
+
+    // Blocks of kBlockSize covering [begin, end). Batch arrays are padded, so the last block may
+    // read past end; masks are only written up to end.
+    template <typename LoadBlock>
+    void CullRange(const MultiViewFrustum& frustum, const LoadBlock& loadBlock, std::uint32_t* masks, size_t begin, size_t end)
+    {
+        const int blockBits = (1 << kBlockSize) - 1;
+        const int viewCount = frustum.getViewCount();
+
+        FrustumLanes unionLanes;
+        unionLanes.set(frustum.getUnion());
+        std::unique_ptr<FrustumLanes[]> viewLanes(new FrustumLanes[viewCount]);
+        for (int view = 0; view < viewCount; view++)
+            viewLanes[view].set(frustum.getView(view));
+
+        for (size_t i = begin; i < end; i += kBlockSize)
+        {
+            const auto block = loadBlock(i);
+
+            std::uint32_t blockMasks[kBlockSize] = {};
+            const int inUnion = ~Outside(unionLanes, block) & blockBits;
+            if (inUnion != 0)
+            {
+                // With one view the union is that view.
+                if (viewCount == 1)
+                {
+                    for (size_t j = 0; j < kBlockSize; j++)
+                        blockMasks[j] = (inUnion >> j) & 1;
+                }
+                else
+                {
+                    for (int view = 0; view < viewCount; view++)
+                    {
+                        // Set bit j of inView in mask j, one set bit at a time.
+                        for (int inView = inUnion & ~Outside(viewLanes[view], block); inView != 0; inView &= inView - 1)
+                            blockMasks[CountTrailingZeros(inView)] |= 1u << view;
+                    }
+                }
+            }
+
+            memcpy(masks + i, blockMasks, std::min(kBlockSize, end - i) * sizeof(std::uint32_t));
+        }
+    }
+}
+
+void Frustum::setFromMatrix(const mat4f& viewProjection)
+{
+    // Row r of the column-major matrix, the clip-space coordinate r as a function of position.
+    const mat4f& m = viewProjection;
+    const vec4f row0(m.M[0][0], m.M[1][0], m.M[2][0], m.M[3][0]);
+    const vec4f row1(m.M[0][1], m.M[1][1], m.M[2][1], m.M[3][1]);
+    const vec4f row2(m.M[0][2], m.M[1][2], m.M[2][2], m.M[3][2]);
+    const vec4f row3(m.M[0][3], m.M[1][3], m.M[2][3], m.M[3][3]);
+
+    planes[Left]   = row3 + row0;
+    planes[Right]  = row3 - row0;
+    planes[Bottom] = row3 + row1;
+    planes[Top]    = row3 - row1;
+    planes[Near]   = row3 + row2;
+    planes[Far]    = row3 - row2;
+
+    for (vec4f& plane : planes)
+    {
+        const float length = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f)
+            plane = plane * (1.0f / length);
+    }
+}
+
+bool Frustum::containsPoint(const vec3f& p) const
+{
+    for (const vec4f& plane : planes)
+    {
+        if ((plane.x * p.x + plane.y * p.y + plane.z * p.z) + plane.w < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+bool Frustum::intersectsBox(const vec3f& center, const vec3f& extent) const
+{
+    for (const vec4f& plane : planes)
+    {
+        const float distance = (plane.x * center.x + plane.y * center.y + plane.z * center.z) + plane.w;
+        const float radius   = fabsf(plane.x) * extent.x + fabsf(plane.y) * extent.y + fabsf(plane.z) * extent.z;
+        if (distance + radius < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+bool Frustum::intersectsSphere(const vec3f& center, float radius) const
+{
+    for (const vec4f& plane : planes)
+    {
+        const float distance = (plane.x * center.x + plane.y * center.y + plane.z * center.z) + plane.w;
+        if (distance + radius < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+bool MultiViewFrustum::set(const mat4f* viewProjections, int viewCount)
+{
+    m_viewCount = 0;
+    if ((viewCount < 1) || (viewCount > kMaxCullViews))
+        return false;
+
+    // World-space corners of every view, unprojected in double.
+    vec3 corners[kMaxCullViews * 8];
+    for (int view = 0; view < viewCount; view++)
+    {
+        m_views[view].setFromMatrix(viewProjections[view]);
+
+        const mat4 inverse = mat4(viewProjections[view]).getInverse();
+        for (int corner = 0; corner < 8; corner++)
+        {
+            const vec4 ndc((corner & 1) ? 1.0 : -1.0, (corner & 2) ? 1.0 : -1.0, (corner & 4) ? 1.0 : -1.0, 1.0);
+
+            vec4 p(0.0);
+            for (int c = 0; c < 4; c++)
+                p += inverse.e[c] * ndc.e[c];
+            if (!(p.w > 0.0))
+                return false;
+
+            corners[view * 8 + corner] = vec3(p.x, p.y, p.z) / p.w;
+        }
+    }
+
+    m_viewCount = viewCount;
+    if (viewCount == 1)
+    {
+        m_union = m_views[0];
+        return true;
+    }
+
+    // Each union plane faces the average direction of the view planes and is pushed out until
+    // every corner is inside it. The frusta are the convex hulls of their corners, so they are
+    // inside too.
+    for (int index = 0; index < Frustum::PlaneCount; index++)
+    {
+        vec3 normal(0.0);
+        for (int view = 0; view < viewCount; view++)
+        {
+            const vec4f& plane = m_views[view].planes[index];
+            normal += vec3(plane.x, plane.y, plane.z);
+        }
+        if (normal.normalize() == 0.0)
+        {
+            const vec4f& plane = m_views[0].planes[index];
+            normal = vec3(plane.x, plane.y, plane.z);
+        }
+
+        // Distances with the normal as stored, so the rounding of the normal is accounted for.
+        const vec3f n = normal.getVec3f();
+        double nearest = vec3::dot(vec3(n), corners[0]);
+        for (int corner = 1; corner < viewCount * 8; corner++)
+            nearest = std::min(nearest, vec3::dot(vec3(n), corners[corner]));
+
+        // Round d up, never moving the plane inwards.
+        float d = (float)-nearest;
+        if ((double)d < -nearest)
+            d = nextafterf(d, INFINITY);
+
+        m_union.planes[index] = vec4f(n, d);
+    }
+    return true;
+}
+
+void CullBoxes(const MultiViewFrustum& frustum, const Vec3fBatch& centers, const Vec3fBatch& extents, std::uint32_t* masks, ThreadPool* pool)
+{
+    const size_t count = std::min(centers.size(), extents.size());
+
+    const auto loadBlock = [&](size_t i)
+    {
+        BoxBlock block;
+        block.x  = Load8(centers.x.data() + i);
+        block.y  = Load8(centers.y.data() + i);
+        block.z  = Load8(centers.z.data() + i);
+        block.ex = Load8(extents.x.data() + i);
+        block.ey = Load8(extents.y.data() + i);
+        block.ez = Load8(extents.z.data() + i);
+        return block;
+    };
+
+    ForEachBatchRange(count, pool, [&](size_t begin, size_t end)
+    {
+        CullRange(frustum, loadBlock, masks, begin, end);
+    });
+}
+
+void CullSpheres(const MultiViewFrustum& frustum, const Vec3fBatch& centers, const BatchArray& radii, std::uint32_t* masks, ThreadPool* pool)
+{
+    const size_t count = std::min(centers.size(), radii.size());
+
+    const auto loadBlock = [&](size_t i)
+    {
+        SphereBlock block;
+        block.x = Load8(centers.x.data() + i);
+        block.y = Load8(centers.y.data() + i);
+        block.z = Load8(centers.z.data() + i);
+        block.r = Load8(radii.data() + i);
+        return block;
+    };
+
+    ForEachBatchRange(count, pool, [&](size_t begin, size_t end)
+    {
+        CullRange(frustum, loadBlock, masks, begin, end);
+    });
+}
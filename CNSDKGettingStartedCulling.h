@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stddef.h>
+#include <cstdint>
+#include "CNSDKGettingStartedMath.h"
+#include "CNSDKGettingStartedTransforms.h"
+
+class ThreadPool;
+
+// View frustum culling of bounding boxes and spheres on structure-of-arrays batches (see
+// CNSDKGettingStartedTransforms.h), for several views at once.
+//
+// Every object is tested once against a union frustum enclosing all views; only objects inside
+// it are tested against the individual views. The result is a bitmask per object with bit v set
+// when the object may be visible in view v. Tests are conservative: an object reported invisible
+// is entirely outside, one reported visible may still be just outside near a frustum corner.
+
+// Most views a MultiViewFrustum holds, the bits of a visibility mask.
+const int kMaxCullViews = 32;
+
+// Six planes (n.x, n.y, n.z, d) with unit normals n pointing inside: a point p is inside when
+// n.p + d >= 0 for all of them.
+struct Frustum
+{
+    enum { Left, Right, Bottom, Top, Near, Far, PlaneCount };
+
+    vec4f planes[PlaneCount];
+
+    // Planes of a view-projection matrix, where clip-space -w <= x, y, z <= w. For projections
+    // mapping depth to 0..w the near plane lies slightly behind the true one, still conservative.
+    void setFromMatrix(const mat4f& viewProjection);
+
+    bool containsPoint(const vec3f& p) const;
+    bool intersectsBox(const vec3f& center, const vec3f& extent) const;
+    bool intersectsSphere(const vec3f& center, float radius) const;
+};
+
+// The frusta of the views of one camera, e.g. a stereo pair, and a frustum enclosing them all.
+class MultiViewFrustum
+{
+public:
+
+    // Frusta of viewProjections[0 .. viewCount - 1]. The union is built from the frustum corners,
+    // so the projections need a finite far plane. Returns false if viewCount is out of range or
+    // a matrix can't be inverted.
+    bool set(const mat4f* viewProjections, int viewCount);
+
+    int            getViewCount() const         { return m_viewCount; }
+    const Frustum& getView(int index) const     { return m_views[index]; }
+    const Frustum& getUnion() const             { return m_union; }
+
+    // Bits of all views.
+    std::uint32_t  getAllViewsMask() const      { return (m_viewCount >= 32) ? 0xFFFFFFFFu : ((1u << m_viewCount) - 1u); }
+
+private:
+
+    Frustum m_views[kMaxCullViews];
+    Frustum m_union;
+    int     m_viewCount = 0;
+};
+
+// Visibility masks of axis-aligned boxes given by center and half extent: bit v of masks[i] is set
+// if box i may be visible in view v. masks must hold centers.size() entries.
+void CullBoxes(const MultiViewFrustum& frustum, const Vec3fBatch& centers, const Vec3fBatch& extents, std::uint32_t* masks, ThreadPool* pool = nullptr);
+
+// Visibility masks of spheres, as CullBoxes.
+void CullSpheres(const MultiViewFrustum& frustum, const Vec3fBatch& centers, const BatchArray& radii, std::uint32_t* masks, ThreadPool* pool = nullptr);
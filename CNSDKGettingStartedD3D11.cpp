@@ -10,7 +10,15 @@
 
 // CNSDKGettingStartedD3D11 includes
 #include "CNSDKGettingStartedD3D11.h"
+#include "CNSDKGettingStartedD3D11Backend.h"
+#include "CNSDKGettingStartedFrameSource.h"
 #include "CNSDKGettingStartedMath.h"
+#include "CNSDKGettingStartedMathExpr.h"
+#include "CNSDKGettingStartedScene.h"
+#include "CNSDKGettingStartedThreadPool.h"
+#include "CNSDKGettingStartedViewInfo.h"
+#include "CNSDKGettingStartedViewInfoCache.h"
+#include "CNSDKGettingStartedViewLatch.h"
 
 // D3D11 includes.
 #include <d3d11_1.h>
@@ -28,8 +36,6 @@
 #define SAFE_RELEASE(x) if(x != nullptr) { x->Release(); x = nullptr; }
 #endif
 
-enum class eDemoMode { Spinning3DCube, StereoImage };
-
 // Global Variables.
 const wchar_t*                         g_windowTitle                  = L"CNSDK Getting Started D3D11 Sample";
 const wchar_t*                         g_windowClass                  = L"CNSDKGettingStartedD3D11WindowClass";
@@ -39,14 +45,30 @@ bool                                   g_fullscreen                   = true;
 std::unique_ptr<leia::Core>            g_sdk                          = nullptr;
 std::unique_ptr<leia::InterlacerD3D11> g_interlacer                   = nullptr;
 eDemoMode                              g_demoMode                     = eDemoMode::Spinning3DCube;
-float                                  g_geometryDist                 = 500;
+double                                 g_geometryDist                 = 500;
+vec3                                   g_cameraPosition               = vec3(6.4e6, 0.0, 0.0); // Far from the world origin, rendered relative to the camera
 bool                                   g_perspective                  = true;
+bool                                   g_batchedViewInfo              = false;
+ViewInfoCacheTolerance                 g_viewInfoCacheTolerance       = {};
+ViewInfoCache                          g_viewInfoCache;
+std::unique_ptr<ViewLatch>             g_viewLatch                    = nullptr;
 float                                  g_perspectiveCameraFiledOfView = 90.0f * 3.14159f / 180.0f;
 float                                  g_orthographicCameraHeight     = 500.0f;
 bool                                   g_showGUI                      = true;
 int                                    g_viewWidth                    = -1;
 int                                    g_viewHeight                   = -1;
 bool                                   g_sRGB                         = true;
+std::unique_ptr<ThreadPool>            g_threadPool                   = nullptr;
+bool                                   g_asyncLoad                    = true;
+LARGE_INTEGER                          g_startTime                    = {};
+std::vector<std::string>               g_stereoImageFiles             = { "StereoBeerGlass.tga" };
+float                                  g_stereoImageInterval          = 5.0f;
+size_t                                 g_stereoImageMemoryBudget      = 256 * 1024 * 1024;
+std::unique_ptr<StereoFrameSource>     g_stereoImageSource            = nullptr;
+size_t                                 g_imageCacheBudget             = 512 * 1024 * 1024;
+std::unique_ptr<ImageCache>            g_imageCache                   = nullptr;
+std::unique_ptr<D3D11RenderBackend>    g_backend                      = nullptr;
+std::unique_ptr<StereoScene>           g_scene                        = nullptr;
 
 // Global D3D11 Variables.
 D3D_DRIVER_TYPE           g_driverType                  = D3D_DRIVER_TYPE_NULL;
@@ -61,56 +83,10 @@ IDXGISwapChain1*          g_swapChain1                  = nullptr;
 ID3D11RenderTargetView*   g_renderTargetView            = nullptr;
 ID3D11Texture2D*          g_depthStencilTexture         = nullptr;
 ID3D11DepthStencilView*   g_depthStencilView            = nullptr;
-ID3D11Texture2D*          g_offscreenTexture            = nullptr;
-ID3D11ShaderResourceView* g_offscreenShaderResourceView = nullptr;
-ID3D11RenderTargetView*   g_offscreenRenderTargetView   = nullptr;
-ID3D11Texture2D*          g_offscreenDepthTexture       = nullptr;
-ID3D11DepthStencilView*   g_offscreenDepthStencilView   = nullptr;
-ID3D11Buffer*             g_vertexBuffer                = nullptr;
-ID3D11Buffer*             g_indexBuffer                 = nullptr;
-ID3D11Buffer*             g_shaderConstantBuffer        = nullptr;
-ID3D11VertexShader*       g_vertexShader                = nullptr;
-ID3D11InputLayout*        g_inputLayout                 = nullptr;
-ID3D11PixelShader*        g_pixelShader                 = nullptr;
-ID3D11Texture2D*          g_imageTexture                = nullptr;
-ID3D11ShaderResourceView* g_imageShaderResourceView     = nullptr;
-
-#pragma pack(push, 1)
-
-struct CONSTANTBUFFER
-{
-    mat4f transform;
-};
 
-struct VERTEX
-{
-    float pos[3];
-    float color[3];
-
-    VERTEX() = default;
-
-    VERTEX(const float* p, const float* c)
-    {
-        pos[0] = p[0];
-        pos[1] = p[1];
-        pos[2] = p[2];
-        color[0] = c[0];
-        color[1] = c[1];
-        color[2] = c[2];
-    }
-
-    VERTEX(float p0, float p1, float p2, float c0, float c1, float c2)
-    {
-        pos[0] = p0;
-        pos[1] = p1;
-        pos[2] = p2;
-        color[0] = c0;
-        color[1] = c1;
-        color[2] = c2;
-    }
-};
-
-#pragma pack(pop)
+// First failure of PrepareScene, which runs on a worker thread while the device and SDK
+// initialize. Reported on the main thread by LoadScene.
+const wchar_t* g_prepareSceneError = nullptr;
 
 void OnError(const wchar_t* msg)
 {
@@ -118,174 +94,6 @@ void OnError(const wchar_t* msg)
     exit(-1);
 }
 
-bool ReadEntireFile(const char* filename, bool binary, char*& data, size_t& dataSize)
-{
-    const int BUFFERSIZE = 4096;
-    char buffer[BUFFERSIZE];
-
-    // Open file.
-    FILE* f = fopen(filename, binary ? "rb" : "rt");    
-    if (f == NULL)
-        return false;
-
-    data     = nullptr;
-    dataSize = 0;
-
-    while (true)
-    {
-        // Read chunk into buffer.
-        const size_t bytes = (int)fread(buffer, sizeof(char), BUFFERSIZE, f);
-        if (bytes <= 0)
-            break;
-
-        // Extend allocated memory and copy chunk into it.
-        char* newData = new char[dataSize + bytes];
-        if (dataSize > 0)
-        {
-            memcpy(newData, data, dataSize);
-            delete [] data;
-            data = nullptr;
-        }
-        memcpy(newData + dataSize, buffer, bytes);
-        dataSize += bytes;
-        data = newData;
-    }
-
-    // Done and close.
-    fclose(f);
-
-    return dataSize > 0;
-}
-
-bool ReadTGA(const char* filename, int& width, int& height, char*& data, int& dataSize)
-{
-    char* ptr = nullptr;
-    size_t fileSize = 0;
-    if (!ReadEntireFile(filename, true, ptr, fileSize))
-    {
-        OnError(L"Failed to read TGA file.");
-        return false;
-    }
-
-    static std::uint8_t DeCompressed[12] = { 0x0, 0x0, 0x2, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0 };
-    static std::uint8_t IsCompressed[12] = { 0x0, 0x0, 0xA, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0 };
-
-    typedef union PixelInfo
-    {
-        std::uint32_t Colour;
-        struct
-        {
-            std::uint8_t R, G, B, A;
-        };
-    } *PPixelInfo;
-
-    // Read header.
-    std::uint8_t Header[18] = { 0 };
-    memcpy(&Header, ptr, sizeof(Header));
-    ptr += sizeof(Header);
-
-    int bitsPerPixel = 0;
-
-    if (!std::memcmp(DeCompressed, &Header, sizeof(DeCompressed)))
-    {
-        bitsPerPixel = Header[16];
-        width        = Header[13] * 256 + Header[12];
-        height       = Header[15] * 256 + Header[14];
-        dataSize     = ((width * bitsPerPixel + 31) / 32) * 4 * height;
-
-        if ((bitsPerPixel != 24) && (bitsPerPixel != 32))
-        {
-            OnError(L"Invalid TGA file isn't 24/32-bit.");
-            return false;
-        }
-
-        data = new char[dataSize];
-        memcpy(data, ptr, dataSize);
-    }
-    else if (!std::memcmp(IsCompressed, &Header, sizeof(IsCompressed)))
-    {
-        bitsPerPixel = Header[16];
-        width        = Header[13] * 256 + Header[12];
-        height       = Header[15] * 256 + Header[14];
-        dataSize     = width * height * sizeof(PixelInfo);
-
-        if ((bitsPerPixel != 24) && (bitsPerPixel != 32))
-        {
-            OnError(L"Invalid TGA file isn't 24/32-bit.");
-            return false;
-        }
-
-        PixelInfo Pixel = { 0 };
-        int CurrentByte = 0;
-        std::size_t CurrentPixel = 0;
-        std::uint8_t ChunkHeader = { 0 };
-        int BytesPerPixel = (bitsPerPixel / 8);
-
-        data = new char[dataSize];
-
-        do
-        {
-            memcpy(&ChunkHeader, ptr, sizeof(ChunkHeader));
-            ptr += sizeof(ChunkHeader);
-
-            if (ChunkHeader < 128)
-            {
-                ++ChunkHeader;
-                for (int I = 0; I < ChunkHeader; ++I, ++CurrentPixel)
-                {
-                    memcpy(&Pixel, ptr, BytesPerPixel);
-                    ptr += BytesPerPixel;
-
-                    data[CurrentByte++] = Pixel.B;
-                    data[CurrentByte++] = Pixel.G;
-                    data[CurrentByte++] = Pixel.R;
-                    if (bitsPerPixel > 24)
-                        data[CurrentByte++] = Pixel.A;
-                }
-            }
-            else
-            {
-                ChunkHeader -= 127;
-                memcpy(&Pixel, ptr, BytesPerPixel);
-                ptr += BytesPerPixel;
-
-                for (int I = 0; I < ChunkHeader; ++I, ++CurrentPixel)
-                {
-                    data[CurrentByte++] = Pixel.B;
-                    data[CurrentByte++] = Pixel.G;
-                    data[CurrentByte++] = Pixel.R;
-                    if (bitsPerPixel > 24)
-                        data[CurrentByte++] = Pixel.A;
-                }
-            }
-        } while (CurrentPixel < (width * height));
-    }
-    else
-    {
-        OnError(L"Invalid TGA file isn't 24/32-bit.");
-        return false;
-    }
-   
-    return true;
-}
-
-float GetSRGB(float value)
-{
-    // If already in sRGB, no change.
-    if (g_sRGB)
-        return value;
-
-    // Convert linear->sRGB.
-    if (value <= 0.0f)
-        return 0.0f;
-    else if (value >= 1.0f)
-        return 1.0f;
-    else if (value <= 0.0031308f)
-        return value * 12.92f;
-    else
-        return 1.055f * pow(value, 1.0f / 2.4f) - 0.055f;
-}
-
 BOOL CALLBACK GetDefaultWindowStartPos_MonitorEnumProc(__in  HMONITOR hMonitor, __in  HDC hdcMonitor, __in  LPRECT lprcMonitor, __in  LPARAM dwData)
 {
     std::vector<MONITORINFOEX>& infoArray = *reinterpret_cast<std::vector<MONITORINFOEX>*>(dwData);
@@ -473,6 +281,8 @@ HRESULT ResizeBuffers(int width, int height)
 
     // Set render target and depth stencil.
     g_immediateContext->OMSetRenderTargets(1, &g_renderTargetView, g_depthStencilView);
+    if (g_backend != nullptr)
+        g_backend->setBackBuffer(g_renderTargetView, g_depthStencilView, width, height);
 
     return S_OK;
 }
@@ -672,6 +482,160 @@ HRESULT InitializeD3D11(HWND hWnd)
     return S_OK;
 }
 
+// The sample's camera, looking down +y from the origin, as GetViewInfos arguments.
+ViewInfoCamera GetViewInfoCamera(ViewInfoMode mode, float aspectRatio)
+{
+    ViewInfoCamera camera;
+    camera.mode                     = mode;
+    camera.position                 = vec3f(0, 0, 0);
+    camera.direction                = vec3f(0, 1, 0);
+    camera.up                       = vec3f(0, 0, 1);
+    camera.perspectiveFieldOfView   = g_perspectiveCameraFiledOfView;
+    camera.perspectiveAspectRatio   = aspectRatio;
+    camera.orthoWidth               = g_orthographicCameraHeight * aspectRatio;
+    camera.orthoHeight              = g_orthographicCameraHeight;
+    camera.nearPlane                = 1.0f;
+    camera.farPlane                 = 10000.0f;
+    camera.convergencePlaneDistance = g_interlacer->GetConvergenceDistance();
+    camera.convergencePlaneHeight   = g_orthographicCameraHeight;
+    return camera;
+}
+
+// Largest difference of a and b relative to the magnitude of b, at least 1.
+float GetMaxDifference(const float* a, const float* b, int count)
+{
+    float difference = 0.0f;
+    for (int i = 0; i < count; i++)
+        difference = fmaxf(difference, fabsf(a[i] - b[i]) / fmaxf(1.0f, fabsf(b[i])));
+    return difference;
+}
+
+// Compare GetViewInfos with leia_get_view_info in every mode, and with the interlacer's converged
+// view info Render uses. Render only switches to the batched path when they agree.
+bool VerifyBatchedViewInfo()
+{
+    const float aspectRatio = (float)g_viewWidth / (float)g_viewHeight;
+    const int   numViews    = g_interlacer->GetNumViews();
+
+    std::vector<vec3f> offsets(numViews), positions(numViews);
+    std::vector<mat4f> projections(numViews);
+    std::vector<float> fieldOfViews(numViews), shearX(numViews), shearY(numViews);
+    for (int i = 0; i < numViews; i++)
+        g_interlacer->GetViewOffset(i, { offsets[i].e, 3 });
+
+    float difference = 0.0f;
+    for (ViewInfoMode mode : { ViewInfoMode::Perspective, ViewInfoMode::PerspectiveFromPlane, ViewInfoMode::Orthographic })
+    {
+        ViewInfoCamera camera = GetViewInfoCamera(mode, aspectRatio);
+        GetViewInfos(camera, offsets.data(), numViews, positions.data(), projections.data(), fieldOfViews.data(), shearX.data(), shearY.data());
+
+        for (int i = 0; i < numViews; i++)
+        {
+            vec3f sdkPosition = vec3f(0, 0, 0);
+            mat4f sdkProjection;
+            float sdkFieldOfView = 0.0f, sdkShearX = 0.0f, sdkShearY = 0.0f;
+            leia::GetViewInfo((leia::ViewInfoMode)mode, { offsets[i].e, 3 }, { camera.position.e, 3 }, { camera.direction.e, 3 }, { camera.up.e, 3 },
+                camera.perspectiveFieldOfView, camera.perspectiveAspectRatio, camera.orthoWidth, camera.orthoHeight, camera.nearPlane, camera.farPlane,
+                camera.convergencePlaneDistance, camera.convergencePlaneHeight, { sdkPosition.e, 3 }, { sdkProjection.m, 16 }, &sdkFieldOfView, &sdkShearX, &sdkShearY);
+
+            difference = fmaxf(difference, GetMaxDifference(positions[i].e, sdkPosition.e, 3));
+            difference = fmaxf(difference, GetMaxDifference(projections[i].m, sdkProjection.m, 16));
+            difference = fmaxf(difference, GetMaxDifference(&shearX[i], &sdkShearX, 1));
+            difference = fmaxf(difference, GetMaxDifference(&shearY[i], &sdkShearY, 1));
+            if (mode != ViewInfoMode::Orthographic)
+                difference = fmaxf(difference, GetMaxDifference(&fieldOfViews[i], &sdkFieldOfView, 1));
+
+            // The interlacer's converged view info.
+            if (mode != ViewInfoMode::PerspectiveFromPlane)
+            {
+                if (mode == ViewInfoMode::Perspective)
+                    g_interlacer->GetConvergedPerspectiveViewInfo(i, { camera.position.e, 3 }, { camera.direction.e, 3 }, { camera.up.e, 3 }, camera.perspectiveFieldOfView, aspectRatio, camera.nearPlane, camera.farPlane, { sdkPosition.e, 3 }, { sdkProjection.m, 16 }, nullptr, nullptr, nullptr);
+                else
+                    g_interlacer->GetConvergedOrthographicViewInfo(i, { camera.position.e, 3 }, { camera.direction.e, 3 }, { camera.up.e, 3 }, camera.orthoWidth, camera.orthoHeight, camera.nearPlane, camera.farPlane, { sdkPosition.e, 3 }, { sdkProjection.m, 16 }, nullptr, nullptr);
+
+                difference = fmaxf(difference, GetMaxDifference(positions[i].e, sdkPosition.e, 3));
+                difference = fmaxf(difference, GetMaxDifference(projections[i].m, sdkProjection.m, 16));
+            }
+        }
+    }
+
+    const bool agree = (difference <= 1e-4f);
+
+    wchar_t message[160];
+    swprintf_s(message, L"Batched view info: largest relative difference from the SDK %g, %s\n", difference, agree ? L"using it" : L"using the SDK");
+    OutputDebugStringW(message);
+    return agree;
+}
+
+// Sample the tracked face and compute the stereo views from it, for the view latch.
+bool SampleFrameViews(FrameViews& views)
+{
+    const float aspectRatio = (float)g_viewWidth / (float)g_viewHeight;
+
+    // Get camera properties. The camera is at the origin of the camera-relative space.
+    vec3f camPos = vec3f(0, 0, 0);
+    vec3f camDir = vec3f(0, 1, 0);
+    vec3f camUp  = vec3f(0, 0, 1);
+
+    // Inputs the views depend on: the camera, the view offsets and the baseline.
+    ViewInfoCacheKey viewKey;
+    viewKey.camera          = GetViewInfoCamera(g_perspective ? ViewInfoMode::Perspective : ViewInfoMode::Orthographic, aspectRatio);
+    viewKey.baselineScaling = g_interlacer->GetBaselineScaling();
+    viewKey.viewCount       = 2;
+    for (int i = 0; i < 2; i++)
+        g_interlacer->GetViewOffset(i, { viewKey.viewOffsets[i].e, 3 });
+
+    vec3f      facePosition = vec3f(0.0f);
+    const bool faceTracked  = g_sdk->GetPrimaryFace({ facePosition.e, 3 });
+
+    // Reuse the cached view positions and projection matrices unless the inputs moved.
+    // Otherwise compute them, for both views in one pass once that's been verified against
+    // the SDK.
+    vec3f viewPositions[2];
+    mat4f cameraProjections[2];
+    views.viewsReused = g_viewInfoCache.find(viewKey, viewPositions, cameraProjections);
+    if (!views.viewsReused)
+    {
+        if (g_batchedViewInfo)
+        {
+            GetViewInfos(viewKey.camera, viewKey.viewOffsets, 2, viewPositions, cameraProjections);
+        }
+        else
+        {
+            for (int i = 0; i < 2; i++)
+            {
+                viewPositions[i] = vec3f(0, 0, 0);
+                if (g_perspective)
+                {
+                    g_interlacer->GetConvergedPerspectiveViewInfo(i, { camPos.e, 3 }, { camDir.e, 3 }, { camUp.e, 3 }, g_perspectiveCameraFiledOfView, aspectRatio, 1.0f, 10000.0f, { viewPositions[i].e, 3 }, { cameraProjections[i].m, 16 }, nullptr, nullptr, nullptr);
+                }
+                else
+                {
+                    g_interlacer->GetConvergedOrthographicViewInfo(i, { camPos.e, 3 }, { camDir.e, 3 }, { camUp.e, 3 }, g_orthographicCameraHeight * aspectRatio, g_orthographicCameraHeight, 1.0f, 10000.0f, { viewPositions[i].e, 3 }, { cameraProjections[i].m, 16 }, nullptr, nullptr);
+                }
+            }
+        }
+        g_viewInfoCache.insert(viewKey, viewPositions, cameraProjections);
+    }
+
+    // View-projection matrices of the stereo views.
+    views.viewCount    = 2;
+    views.faceTracked  = faceTracked;
+    views.facePosition = facePosition;
+    for (int i = 0; i < 2; i++)
+    {
+        // Get camera transform.
+        mat4f cameraTransform;
+        cameraTransform.lookAt(viewPositions[i], viewPositions[i] + camDir, camUp);
+
+        // The camera transform is affine.
+        views.viewPositions[i]   = viewPositions[i];
+        views.viewProjections[i] = cameraProjections[i] * MathExpr::Affine(cameraTransform);
+    }
+
+    return true;
+}
+
 void InitializeCNSDK(HWND hWnd)
 {
     // Initialize SDK.
@@ -706,530 +670,71 @@ void InitializeCNSDK(HWND hWnd)
     g_viewWidth = config->viewResolution[0];
     g_viewHeight = config->viewResolution[1];
     g_sdk->ReleaseDeviceConfig(config);
+
+    g_batchedViewInfo = VerifyBatchedViewInfo();
+    g_viewInfoCache.setTolerance(g_viewInfoCacheTolerance);
+    g_viewLatch = std::make_unique<ViewLatch>(SampleFrameViews);
+    g_backend->setInterlacer(g_interlacer.get());
 }
 
-void LoadScene()
+void PrepareScene()
 {
     if (g_demoMode == eDemoMode::Spinning3DCube)
     {
-        const float cubeWidth = 200.0f;
-        const float cubeHeight = 200.0f;
-        const float cubeDepth = 200.0f;
-
-        const float l = -cubeWidth / 2.0f;
-        const float r = l + cubeWidth;
-        const float b = -cubeHeight / 2.0f;
-        const float t = b + cubeHeight;
-        const float n = -cubeDepth / 2.0f;
-        const float f = n + cubeDepth;
-
-        const int vertexCount = 8;
-        const int indexCount  = 36;
-
-        const float cubeVerts[vertexCount][3] =
-        {
-            {l, n, b}, // Left Near Bottom
-            {l, f, b}, // Left Far Bottom
-            {r, f, b}, // Right Far Bottom
-            {r, n, b}, // Right Near Bottom
-            {l, n, t}, // Left Near Top
-            {l, f, t}, // Left Far Top
-            {r, f, t}, // Right Far Top
-            {r, n, t}  // Right Near Top
-        };
-
-        static const int faces[6][4] =
-        {
-            {0,1,2,3}, // bottom
-            {1,0,4,5}, // left
-            {0,3,7,4}, // front
-            {3,2,6,7}, // right
-            {2,1,5,6}, // back
-            {4,7,6,5}  // top
-        };
-
-        float c = GetSRGB(0.5f);
-
-        static const float faceColors[6][3] =
-        {
-            {c,0,0},
-            {0,c,0},
-            {0,0,c},
-            {c,c,0},
-            {0,c,c},
-            {c,0,c}
-        };
-
-        std::vector<VERTEX> vertices;
-        std::vector<int> indices;
-        for (int i = 0; i < 6; i++)
-        {
-            const int i0 = faces[i][0];
-            const int i1 = faces[i][1];
-            const int i2 = faces[i][2];
-            const int i3 = faces[i][3];
-
-            // Add indices.
-            const int startIndex = (int)vertices.size();
-            indices.emplace_back(startIndex + 0);
-            indices.emplace_back(startIndex + 2);
-            indices.emplace_back(startIndex + 1);
-            indices.emplace_back(startIndex + 0);
-            indices.emplace_back(startIndex + 3);
-            indices.emplace_back(startIndex + 2);
-
-            vertices.emplace_back(VERTEX(cubeVerts[i0], faceColors[i]));
-            vertices.emplace_back(VERTEX(cubeVerts[i1], faceColors[i]));
-            vertices.emplace_back(VERTEX(cubeVerts[i2], faceColors[i]));
-            vertices.emplace_back(VERTEX(cubeVerts[i3], faceColors[i]));
-        }        
-
-        // Create vertex buffer.
-        {
-            // Format = XYZ|RGB
-            const int vertexSize       = sizeof(VERTEX);
-            const int vertexBufferSize = vertices.size() * vertexSize;
-
-            D3D11_BUFFER_DESC bd = {};
-            bd.Usage          = D3D11_USAGE_DEFAULT;
-            bd.ByteWidth      = vertexBufferSize;
-            bd.BindFlags      = D3D11_BIND_VERTEX_BUFFER;
-            bd.CPUAccessFlags = 0;
-
-            D3D11_SUBRESOURCE_DATA initData = {};
-            initData.pSysMem = vertices.data();
-
-            HRESULT hr = g_device->CreateBuffer(&bd, &initData, &g_vertexBuffer);
-            if (FAILED(hr))
-            {
-                OnError(L"Error creating vertex buffer");
-                return;
-            }
-        }
-
-        // Create index buffer.
-        {
-            // Format = int
-            const int ibsize = indexCount * sizeof(int);
-
-            D3D11_BUFFER_DESC bd = {};
-            bd.Usage          = D3D11_USAGE_DEFAULT;
-            bd.ByteWidth      = ibsize;
-            bd.BindFlags      = D3D11_BIND_INDEX_BUFFER;
-            bd.CPUAccessFlags = 0;
-
-            D3D11_SUBRESOURCE_DATA initData = {};
-            initData.pSysMem = indices.data();
-
-            HRESULT hr = g_device->CreateBuffer(&bd, &initData, &g_indexBuffer);
-            if (FAILED(hr))
-            {
-                OnError(L"Error creating index buffer");
-                return;
-            }
-        }        
-
-        {
-            // Round up to 16 bytes.
-            int shaderUniformBufferSizeRounded = (sizeof(CONSTANTBUFFER) + 15) & ~15;
-
-            D3D11_BUFFER_DESC bd = {};
-            bd.ByteWidth           = shaderUniformBufferSizeRounded;
-            bd.Usage               = D3D11_USAGE_DEFAULT;
-            bd.BindFlags           = D3D11_BIND_CONSTANT_BUFFER;
-            bd.CPUAccessFlags      = 0;
-            bd.MiscFlags           = 0;
-            bd.StructureByteStride = 0;
-
-            // Create the buffer.
-            HRESULT hr = g_device->CreateBuffer(&bd, NULL, &g_shaderConstantBuffer);
-            if (FAILED(hr))
-            {
-                OnError(L"Failed to create constant buffer");
-                return;
-            }
-        }
-
-        const char* vertexShaderText = 
-            "struct VSInput\n"
-            "{\n"
-            "    float3 Pos : POSITION;\n"
-            "    float3 Col : COLOR;\n"
-            "};\n"
-            "struct PSInput\n"
-            "{\n"
-            "    float4 Pos : SV_POSITION;\n"
-            "    float3 Col : COLOR;\n"
-            "};\n"
-            "cbuffer ConstantBufferData : register(b0)\n"
-            "{\n"
-            "    float4x4 transform;\n"
-            "};\n"
-            "PSInput VSMain(VSInput input)\n"
-            "{\n"
-            "    PSInput output = (PSInput)0;\n"
-            "    output.Pos = mul(transform, float4(input.Pos, 1.0f));\n"
-            "    output.Col = input.Col;\n"
-            "    return output;\n"
-            "}\n";
-
-	    const char* pixelShaderText =
-            "struct PSInput\n"
-            "{\n"
-            "    float4 Pos : SV_POSITION;\n"
-            "    float3 Col : COLOR;\n"
-            "};\n"
-            "float4 PSMain(PSInput input) : SV_Target0\n"
-            "{\n"
-            "    return float4(input.Col, 1);\n"
-            "};\n";
-
-        // Compile the vertex shader
-        ID3DBlob* pVSBlob = nullptr;
-        ID3DBlob* pVSErrors = nullptr;
-        HRESULT hr = D3DCompile(vertexShaderText, strlen(vertexShaderText), NULL, NULL, NULL, "VSMain", "vs_5_0", 0, 0, &pVSBlob, &pVSErrors);
-        if (FAILED(hr))
-        {
-            std::string errorMsg;
-            if (pVSErrors != nullptr)
-                errorMsg.append((char*)pVSErrors->GetBufferPointer(), pVSErrors->GetBufferSize());
-            OnError(L"Failed to compile vertex shader");
-            return;
-        }
-
-        // Create the vertex shader
-        hr = g_device->CreateVertexShader(pVSBlob->GetBufferPointer(), pVSBlob->GetBufferSize(), nullptr, &g_vertexShader);
-        if (FAILED(hr))
-        {
-            SAFE_RELEASE(pVSBlob);
-            OnError(L"Failed to create vertex shader");
-            return;
-        }
-
-        // Define the input layout
-        const D3D11_INPUT_ELEMENT_DESC layoutElements[] =
-        {
-            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0,  D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "COLOR",    0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        };
-        const int layoutElementCount = ARRAYSIZE(layoutElements);
-
-        // Create the input layout        
-        hr = g_device->CreateInputLayout(layoutElements, layoutElementCount, pVSBlob->GetBufferPointer(), pVSBlob->GetBufferSize(), &g_inputLayout);
-        SAFE_RELEASE(pVSBlob);
-        if (FAILED(hr))
-        {
-            OnError(L"Failed to create vertex layout");
-            return;
-        }
-
-        // Compile the pixel shader
-        ID3DBlob* pPSBlob = nullptr;
-        ID3DBlob* pPSErrors = nullptr;
-        hr = D3DCompile(pixelShaderText, strlen(pixelShaderText), NULL, NULL, NULL, "PSMain", "ps_5_0", 0, 0, &pPSBlob, &pPSErrors);
-        if (FAILED(hr))
-        {
-            std::string errorMsg;
-            if (pPSErrors != nullptr)
-                errorMsg.append((char*)pPSErrors->GetBufferPointer(), pPSErrors->GetBufferSize());
-            OnError(L"Failed to compile pixel shader");
-            return;
-        }
-
-        // Create the pixel shader
-        hr = g_device->CreatePixelShader(pPSBlob->GetBufferPointer(), pPSBlob->GetBufferSize(), nullptr, &g_pixelShader);
-        SAFE_RELEASE(pPSBlob);
-        if (FAILED(hr))
-        {
-            OnError(L"Failed to create pixel shader");
-            return;
-        }
+        // Compile the shaders, D3DCompile doesn't need the device.
+        g_prepareSceneError = g_backend->compilePipeline(GetCubePipelineDesc());
     }
     else if (g_demoMode == eDemoMode::StereoImage)
     {
-        // Load stereo image.
-        int width = 0;
-        int height = 0;
-        char* data = nullptr;
-        int dataSize = 0;
-        ReadTGA("StereoBeerGlass.tga", width, height, data, dataSize);
-
-        // D3D11 doesn't support RGB textures, so expand initial data from RGB->RGBA.
-        unsigned char* convertedInitialData = nullptr;
-        {
-            convertedInitialData = new unsigned char[width * height * 4];
-
-            const unsigned char* pSrc = (const unsigned char*)data;
-                  unsigned char* pDst = (unsigned char*)convertedInitialData;
-
-            for (int i = 0; i < width * height; i++)
-            {
-                pDst[0] = pSrc[2];
-                pDst[1] = pSrc[1];
-                pDst[2] = pSrc[0];
-                pDst[3] = 255;
+        // Stereo images are decoded ahead into a ring of buffers. Only start it here, the first frame
+        // decodes on this pool, which may have no other worker to run it while this task waits.
+        // LoadScene waits for it on the main thread.
+        g_stereoImageSource = std::make_unique<StereoFrameSource>(*g_threadPool);
+        g_stereoImageSource->setImageCache(g_imageCache.get());
+        for (const std::string& file : g_stereoImageFiles)
+            g_stereoImageSource->addImage(file);
 
-                pDst += 4;
-                pSrc += 3;
-            }
-        }
-
-        D3D11_SUBRESOURCE_DATA initData = {};
-        initData.pSysMem          = convertedInitialData;
-        initData.SysMemPitch      = width * 4;
-        initData.SysMemSlicePitch = height * initData.SysMemPitch;
-
-        // Create texture.
-        D3D11_TEXTURE2D_DESC textureDesc = {};
-        textureDesc.Width            = width;
-        textureDesc.Height           = height;
-        textureDesc.Format           = g_sRGB ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
-        textureDesc.MipLevels        = 1;
-        textureDesc.ArraySize        = 1;
-        textureDesc.SampleDesc.Count = 1;
-        textureDesc.Usage            = D3D11_USAGE_DEFAULT;
-        textureDesc.BindFlags        = D3D11_BIND_SHADER_RESOURCE;
-        HRESULT hr = g_device->CreateTexture2D(&textureDesc, &initData, &g_imageTexture);
-        if (FAILED(hr))
-        {
-            OnError(L"Failed to create stereo image texture");
-            return;
-        }
-
-        D3D11_SHADER_RESOURCE_VIEW_DESC SRVDesc = {};
-        SRVDesc.Format                    = textureDesc.Format;
-        SRVDesc.ViewDimension             = D3D11_SRV_DIMENSION_TEXTURE2D;
-        SRVDesc.Texture2D.MostDetailedMip = 0;
-        SRVDesc.Texture2D.MipLevels       = 1;
-
-        hr = g_device->CreateShaderResourceView(g_imageTexture, &SRVDesc, &g_imageShaderResourceView);
-        if (FAILED(hr))
-        {
-            OnError(L"Failed to create stereo image shader resource view");
-            return;
-        }
+        if (!g_stereoImageSource->start(g_stereoImageMemoryBudget))
+            g_prepareSceneError = g_stereoImageSource->getError();
     }
 }
 
-void InitializeOffscreenFrameBuffer()
-{    
-    // Create a single double-wide offscreen framebuffer. 
-    // When rendering, we will do two passes, like a typical VR application.
-    // On pass 1 we render to the left and on pass 2 we render to the right.
-    
-    // Use Leia's pre-defined view size (you can use a different size to suit your application).
-    const int width  = g_viewWidth * 2;
-    const int height = g_viewHeight;
-
-    // Create render-target.
-    D3D11_TEXTURE2D_DESC textureDesc = {};
-    textureDesc.Width            = width;
-    textureDesc.Height           = height;
-    textureDesc.Format           = g_sRGB ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
-    textureDesc.MipLevels        = 1;
-    textureDesc.ArraySize        = 1;
-    textureDesc.SampleDesc.Count = 1;
-    textureDesc.Usage            = D3D11_USAGE_DEFAULT;
-    textureDesc.BindFlags        = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
-    HRESULT hr = g_device->CreateTexture2D(&textureDesc, nullptr, &g_offscreenTexture);
-    if (FAILED(hr))
-    {
-        OnError(L"Failed to create offscreen texture");
-        return;
-    }
-
-    // Create shader view.        
-    {
-        D3D11_SHADER_RESOURCE_VIEW_DESC SRVDesc = {};
-        SRVDesc.Format                    = textureDesc.Format;
-        SRVDesc.ViewDimension             = D3D11_SRV_DIMENSION_TEXTURE2D;
-        SRVDesc.Texture2D.MostDetailedMip = 0;
-        SRVDesc.Texture2D.MipLevels       = 1;
-
-        hr = g_device->CreateShaderResourceView(g_offscreenTexture, &SRVDesc, &g_offscreenShaderResourceView);
-        if (FAILED(hr))
-        {
-            OnError(L"Failed to create shader resource view");
-            return;
-        }
-    }
+void LoadScene()
+{
+    if ((g_prepareSceneError == nullptr) && g_stereoImageSource && !g_stereoImageSource->waitForCurrentFrame())
+        g_prepareSceneError = g_stereoImageSource->getError();
 
-    // Create render-target view.        
-    {
-        D3D11_RENDER_TARGET_VIEW_DESC RTVDesc = {};
-        RTVDesc.Format             = textureDesc.Format;
-        RTVDesc.ViewDimension      = D3D11_RTV_DIMENSION_TEXTURE2D;
-        RTVDesc.Texture2D.MipSlice = 0;
-        hr = g_device->CreateRenderTargetView(g_offscreenTexture, &RTVDesc, &g_offscreenRenderTargetView);
-        if (FAILED(hr))
-        {
-            OnError(L"Failed to create render-target view");
-            return;
-        }
-    }
-                
-    // Create depth texture.
-    textureDesc.Format    = DXGI_FORMAT_D24_UNORM_S8_UINT;
-    textureDesc.BindFlags = D3D11_BIND_DEPTH_STENCIL;
-    hr = g_device->CreateTexture2D(&textureDesc, nullptr, &g_offscreenDepthTexture);
-    if (FAILED(hr))
+    if (g_prepareSceneError != nullptr)
     {
-        OnError(L"Failed to create depth texture");
+        OnError(g_prepareSceneError);
         return;
     }
 
-    // Create depth view.
-    {
-        D3D11_DEPTH_STENCIL_VIEW_DESC DSVDesc = {};
-        DSVDesc.Format             = textureDesc.Format;
-        DSVDesc.ViewDimension      = D3D11_DSV_DIMENSION_TEXTURE2D;
-        DSVDesc.Texture2D.MipSlice = 0;
-        hr = g_device->CreateDepthStencilView(g_offscreenDepthTexture, &DSVDesc, &g_offscreenDepthStencilView);
-        if (FAILED(hr))
-        {
-            OnError(L"Failed to create depth-stencil view");
-            return;
-        }
-    }
+    if (!g_scene->loadScene(g_stereoImageSource.get()))
+        OnError(g_scene->getError());
 }
 
-void RotateOrientation(mat3f& orientation, float x, float y, float z)
-{
-    mat3f rx, ry, rz;
-    rx.setAxisAngleRotation(vec3f(1.0, 0.0, 0.0), x);
-    ry.setAxisAngleRotation(vec3f(0.0, 1.0, 0.0), y);
-    rz.setAxisAngleRotation(vec3f(0.0, 0.0, 1.0), z);
-    orientation = orientation * (rx * ry * rz);
+void InitializeOffscreenFrameBuffer()
+{    
+    // Create a single double-wide offscreen framebuffer. 
+    // When rendering, we will do two passes, like a typical VR application.
+    // On pass 1 we render to the left and on pass 2 we render to the right.
+    if (!g_scene->initializeOffscreenFrameBuffer())
+        OnError(g_scene->getError());
 }
 
 void Render(float elapsedTime) 
 {
-    const int   viewWidth   = g_viewWidth;
-    const int   viewHeight  = g_viewHeight;
-    const float aspectRatio = (float)viewWidth / (float)viewHeight;
-
-    if (g_demoMode == eDemoMode::StereoImage)
-    {
-        // Clear backbuffer to green.
-        const FLOAT color[4] = { GetSRGB(0.0f), GetSRGB(0.25f), GetSRGB(0.0f), 1.0f};
-        g_immediateContext->ClearRenderTargetView(g_renderTargetView, color);
-        g_immediateContext->ClearDepthStencilView(g_depthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
-
-        // Perform interlacing.
-        g_interlacer->SetSourceViewsSize(viewWidth, viewHeight, true);
-        g_interlacer->DoPostProcessPicture(g_windowWidth, g_windowHeight, g_imageShaderResourceView, g_renderTargetView);
-    }
-    else if (g_demoMode == eDemoMode::Spinning3DCube)
-    {
-        // geometry transform.
-        mat4f geometryTransform;
-        {
-            // Place cube at specified distance.
-            vec3f geometryPos = vec3f(0, g_geometryDist, 0);
-
-            mat3f geometryOrientation;
-            geometryOrientation.setIdentity();
-            RotateOrientation(geometryOrientation, 0.1f * elapsedTime, 0.2f * elapsedTime, 0.3f * elapsedTime);
-            geometryTransform.create(geometryOrientation, geometryPos);
-        }
-
-        // Clear back-buffer to green.
-        const FLOAT backBufferColor[4] = { GetSRGB(0.0f), GetSRGB(0.25f), GetSRGB(0.0f), 1.0f };
-        g_immediateContext->ClearRenderTargetView(g_renderTargetView, backBufferColor);
-        g_immediateContext->ClearDepthStencilView(g_depthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
-
-        // Clear offscreen render-target to blue
-        const FLOAT offscreenColor[4] = { GetSRGB(0.0f), GetSRGB(0.0f), GetSRGB(0.25f), 1.0f };
-        g_immediateContext->ClearRenderTargetView(g_offscreenRenderTargetView, offscreenColor);
-        g_immediateContext->ClearDepthStencilView(g_offscreenDepthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
-
-        // Render stereo views.
-        for (int i = 0; i < 2; i++)
-        {
-            // Get camera properties.
-            vec3f camPos = vec3f(0, 0, 0);
-            vec3f camDir = vec3f(0, 1, 0);
-            vec3f camUp  = vec3f(0, 0, 1);
-            
-            // Compute view position and projection matrix for view.
-            vec3f viewPos = vec3f(0, 0, 0);
-            mat4f cameraProjection;
-            if (g_perspective)
-            {
-                g_interlacer->GetConvergedPerspectiveViewInfo(i, { camPos.e, 3 }, { camDir.e, 3 }, { camUp.e, 3 }, g_perspectiveCameraFiledOfView, aspectRatio, 1.0f, 10000.0f, { viewPos.e, 3 }, { cameraProjection.m, 16 }, nullptr, nullptr, nullptr);
-            }
-            else
-            {
-                g_interlacer->GetConvergedOrthographicViewInfo(i, { camPos.e, 3 }, { camDir.e, 3 }, { camUp.e, 3 }, g_orthographicCameraHeight * aspectRatio, g_orthographicCameraHeight, 1.0f, 10000.0f, { viewPos.e, 3 }, { cameraProjection.m, 16 }, nullptr, nullptr);
-            }
-
-            // Get camera transform.
-            mat4f cameraTransform;
-            cameraTransform.lookAt(viewPos, viewPos + camDir, camUp);
-
-            // Compute combined matrix.
-            const mat4f mvp = cameraProjection * cameraTransform * geometryTransform;
-
-            // Set viewport to render to left, then right.
-            D3D11_VIEWPORT viewport = {};
-            viewport.TopLeftX = (FLOAT)(i * viewWidth);
-            viewport.TopLeftY = 0.0f;
-            viewport.Width    = (FLOAT)viewWidth;
-            viewport.Height   = (FLOAT)viewHeight;
-            viewport.MinDepth = 0.0f;
-            viewport.MaxDepth = 1.0f;
-            g_immediateContext->RSSetViewports(1, &viewport);
-
-            g_immediateContext->OMSetRenderTargets(1, &g_offscreenRenderTargetView, g_offscreenDepthStencilView);
-
-            g_immediateContext->VSSetShader(g_vertexShader, nullptr, 0);
-            g_immediateContext->PSSetShader(g_pixelShader, nullptr, 0);
-            g_immediateContext->IASetInputLayout(g_inputLayout);
-
-            g_immediateContext->UpdateSubresource(g_shaderConstantBuffer, 0, NULL, &mvp, 0, 0);
-            g_immediateContext->VSSetConstantBuffers(0, 1, &g_shaderConstantBuffer);
-            g_immediateContext->PSSetConstantBuffers(0, 1, &g_shaderConstantBuffer);
-
-            // Set vertex buffer (XYZ|RGB)
-            UINT stride = 6 * sizeof(float);
-            UINT offset = 0;
-            g_immediateContext->IASetVertexBuffers(0, 1, &g_vertexBuffer, &stride, &offset);
-
-            // Set index buffer.
-            g_immediateContext->IASetIndexBuffer(g_indexBuffer, DXGI_FORMAT_R32_UINT, 0);
-
-            // Set primitive topology
-            g_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-            // Render.
-            g_immediateContext->DrawIndexed(36, 0, 0);
-        }    
-
-        // Set viewport.
-        D3D11_VIEWPORT viewport = {};
-        viewport.TopLeftX = 0.0f;
-        viewport.TopLeftY = 0.0f;
-        viewport.Width    = (FLOAT)g_windowWidth;
-        viewport.Height   = (FLOAT)g_windowHeight;
-        viewport.MinDepth = 0.0f;
-        viewport.MaxDepth = 1.0f;
-        g_immediateContext->RSSetViewports(1, &viewport);
-
-        g_immediateContext->OMSetRenderTargets(1, &g_renderTargetView, g_depthStencilView);
-
-        // Perform interlacing.
-        g_interlacer->SetSourceViewsSize(viewWidth, viewHeight, true);
-        g_interlacer->SetSourceViews(g_offscreenShaderResourceView);
-        g_interlacer->DoPostProcess(g_windowWidth, g_windowHeight, false, g_renderTargetView);
-    }
-    
-    g_swapChain->Present(1, 0);
+    if (!g_scene->render(elapsedTime, *g_viewLatch))
+        OnError(g_scene->getError());
 }
 
 void UpdateWindowTitle(HWND hWnd, double curTime) 
 {
     static double prevTime = 0;
     static int frameCount = 0;
+    static ViewInfoCache::Stats prevViewInfoStats;
+    static ViewLatch::Stats prevViewLatchStats;
 
     frameCount++;
 
@@ -1237,12 +742,29 @@ void UpdateWindowTitle(HWND hWnd, double curTime)
     {
         const double fps = frameCount / (curTime - prevTime);
 
-        wchar_t newWindowTitle[128];
-        swprintf(newWindowTitle, 128, L"%s (%.1f FPS)", g_windowTitle, fps);
+        // View info cache hits over the same interval.
+        const ViewInfoCache::Stats viewInfoStats = g_viewInfoCache.getStats();
+        ViewInfoCache::Stats intervalStats;
+        intervalStats.hits   = viewInfoStats.hits - prevViewInfoStats.hits;
+        intervalStats.misses = viewInfoStats.misses - prevViewInfoStats.misses;
+
+        // Mean pose staleness at submit over the same interval.
+        const ViewLatch::Stats viewLatchStats = g_viewLatch->getStats();
+        ViewLatch::Stats intervalLatchStats;
+        intervalLatchStats.frames         = viewLatchStats.frames - prevViewLatchStats.frames;
+        intervalLatchStats.totalStaleness = viewLatchStats.totalStaleness - prevViewLatchStats.totalStaleness;
+
+        wchar_t newWindowTitle[192];
+        if (intervalStats.hits + intervalStats.misses > 0)
+            swprintf(newWindowTitle, 192, L"%s (%.1f FPS, view info cache %.0f%% hits, pose %.2f ms old at submit)", g_windowTitle, fps, 100.0 * intervalStats.getHitRate(), 1000.0 * intervalLatchStats.getMeanStaleness());
+        else
+            swprintf(newWindowTitle, 192, L"%s (%.1f FPS)", g_windowTitle, fps);
         SetWindowText(hWnd, newWindowTitle);
 
         prevTime = curTime;
         frameCount = 0;
+        prevViewInfoStats = viewInfoStats;
+        prevViewLatchStats = viewLatchStats;
     }
 }
 
@@ -1295,8 +817,56 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
     return 0;
 }
 
+void ReportTimeToFirstFrame()
+{
+    static bool reported = false;
+    if (reported)
+        return;
+    reported = true;
+
+    LARGE_INTEGER now, frequency;
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&frequency);
+    const double ms = (double)(now.QuadPart - g_startTime.QuadPart) * 1000.0 / (double)frequency.QuadPart;
+
+    wchar_t message[128];
+    swprintf_s(message, L"Time to first frame: %.1f ms (%s loading)\n", ms, g_asyncLoad ? L"async" : L"sequential");
+    OutputDebugStringW(message);
+}
+
+void ReportImageCacheStats()
+{
+    const ImageCache::Stats stats = g_imageCache->getStats();
+
+    wchar_t message[160];
+    swprintf_s(message, L"Image cache: %llu hits, %llu misses, %llu evictions, %zu images, %.1f MB\n",
+        stats.hits, stats.misses, stats.evictions, stats.entries, (double)stats.bytes / (1024.0 * 1024.0));
+    OutputDebugStringW(message);
+}
+
+void ReportViewInfoCacheStats()
+{
+    const ViewInfoCache::Stats stats = g_viewInfoCache.getStats();
+
+    wchar_t message[160];
+    swprintf_s(message, L"View info cache: %llu hits, %llu misses, %.1f%% hit rate\n", stats.hits, stats.misses, 100.0 * stats.getHitRate());
+    OutputDebugStringW(message);
+}
+
+void ReportViewLatchStats()
+{
+    const ViewLatch::Stats stats = g_viewLatch->getStats();
+
+    wchar_t message[192];
+    swprintf_s(message, L"View latch: %llu frames, pose at submit %.2f ms old on average, %.2f ms at most, sampled %.2f ms after frame start\n",
+        stats.frames, 1000.0 * stats.getMeanStaleness(), 1000.0 * stats.maxStaleness, 1000.0 * stats.getMeanLatchDelay());
+    OutputDebugStringW(message);
+}
+
 int APIENTRY wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLine, int nCmdShow)
 {
+    QueryPerformanceCounter(&g_startTime);
+
     // Register window class.
     WNDCLASSEXW wcex;
     wcex.cbSize        = sizeof(WNDCLASSEX);
@@ -1323,19 +893,40 @@ int APIENTRY wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmd
     if (g_fullscreen)
         SetFullscreen(hWnd, true);
 
+    // Start preparing scene assets on a worker while the device and SDK come up.
+    g_threadPool = std::make_unique<ThreadPool>();
+    g_imageCache = std::make_unique<ImageCache>(g_imageCacheBudget);
+    g_backend    = std::make_unique<D3D11RenderBackend>();
+    TaskHandle sceneTask = g_threadPool->submit(PrepareScene, TaskPriority::High);
+    if (!g_asyncLoad)
+        sceneTask.wait();
+
     // Initialize OpenGL.
     HRESULT hr = InitializeD3D11(hWnd);
     if (FAILED(hr))
         OnError(L"Failed to initialize D3D11");
+    g_backend->setDevice(g_device, g_immediateContext, g_swapChain);
 
     // Initialize CNSDK.
     InitializeCNSDK(hWnd);
 
+    // Create the scene on the D3D11 backend.
+    SceneSettings sceneSettings;
+    sceneSettings.demoMode            = g_demoMode;
+    sceneSettings.sRGB                = g_sRGB;
+    sceneSettings.viewWidth           = g_viewWidth;
+    sceneSettings.viewHeight          = g_viewHeight;
+    sceneSettings.geometryDist        = g_geometryDist;
+    sceneSettings.cameraPosition      = g_cameraPosition;
+    sceneSettings.stereoImageInterval = g_stereoImageInterval;
+    g_scene = std::make_unique<StereoScene>(*g_backend, sceneSettings);
+
     // Create our stereo (double-wide) frame buffer.
     if (g_demoMode == eDemoMode::Spinning3DCube)
         InitializeOffscreenFrameBuffer();
 
-    // Prepare everything to draw.
+    // Create GPU resources once the assets are ready.
+    sceneTask.wait();
     LoadScene();
 
     // Show window.
@@ -1377,6 +968,7 @@ int APIENTRY wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmd
 
             // Render.
             Render((float)elapsedTime);
+            ReportTimeToFirstFrame();
 
             // Update window title with FPS.
             UpdateWindowTitle(hWnd, curTime);
@@ -1386,19 +978,16 @@ int APIENTRY wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmd
     // Disable Leia display backlight.
     g_sdk->SetBacklight(false);
 
-    SAFE_RELEASE(g_imageShaderResourceView);
-    SAFE_RELEASE(g_imageTexture);
-    SAFE_RELEASE(g_pixelShader);
-    SAFE_RELEASE(g_inputLayout);
-    SAFE_RELEASE(g_vertexShader);
-    SAFE_RELEASE(g_shaderConstantBuffer);
-    SAFE_RELEASE(g_indexBuffer);
-    SAFE_RELEASE(g_vertexBuffer);
-    SAFE_RELEASE(g_offscreenDepthStencilView);
-    SAFE_RELEASE(g_offscreenDepthTexture);
-    SAFE_RELEASE(g_offscreenRenderTargetView);
-    SAFE_RELEASE(g_offscreenShaderResourceView);
-    SAFE_RELEASE(g_offscreenTexture);
+    // Stop worker threads.
+    g_scene.reset();
+    g_stereoImageSource.reset();
+    g_threadPool.reset();
+    ReportImageCacheStats();
+    ReportViewInfoCacheStats();
+    ReportViewLatchStats();
+    g_imageCache.reset();
+    g_backend.reset();
+
     SAFE_RELEASE(g_depthStencilView);
     SAFE_RELEASE(g_depthStencilTexture);
     SAFE_RELEASE(g_renderTargetView);
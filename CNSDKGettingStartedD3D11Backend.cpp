@@ -0,0 +1,509 @@
+#include <string.h>
+#include "CNSDKGettingStartedD3D11Backend.h"
+#include "CNSDKGettingStartedMesh.h"
+
+// CNSDK includes
+#include "leia/core/cxx/interlacer.d3d11.hpp"
+
+// D3D11 includes.
+#include <d3dcompiler.h>
+
+#ifndef SAFE_RELEASE
+#define SAFE_RELEASE(x) if(x != nullptr) { x->Release(); x = nullptr; }
+#endif
+
+namespace
+{
+    DXGI_FORMAT GetColorFormat(TextureFormat format, bool sRGB)
+    {
+        if (format == TextureFormat::BGRA8)
+            return sRGB ? DXGI_FORMAT_B8G8R8A8_UNORM_SRGB : DXGI_FORMAT_B8G8R8A8_UNORM;
+        return sRGB ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
+    }
+}
+
+D3D11RenderBackend::~D3D11RenderBackend()
+{
+    for (Resource& resource : m_resources)
+        release(resource);
+
+    for (CompiledPipeline& compiled : m_compiled)
+    {
+        SAFE_RELEASE(compiled.vertexShaderBlob);
+        SAFE_RELEASE(compiled.pixelShaderBlob);
+    }
+}
+
+const wchar_t* D3D11RenderBackend::compilePipeline(const RenderPipelineDesc& desc)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_compiledMutex);
+        for (const CompiledPipeline& compiled : m_compiled)
+        {
+            if ((compiled.vertexShader == desc.vertexShader) && (compiled.pixelShader == desc.pixelShader))
+                return nullptr;
+        }
+    }
+
+    // Compile the shaders, D3DCompile doesn't need the device.
+    CompiledPipeline compiled;
+    compiled.vertexShader = desc.vertexShader;
+    compiled.pixelShader  = desc.pixelShader;
+
+    ID3DBlob* pVSErrors = nullptr;
+    HRESULT hr = D3DCompile(desc.vertexShader, strlen(desc.vertexShader), NULL, NULL, NULL, "VSMain", "vs_5_0", 0, 0, &compiled.vertexShaderBlob, &pVSErrors);
+    SAFE_RELEASE(pVSErrors);
+    if (FAILED(hr))
+        return L"Failed to compile vertex shader";
+
+    ID3DBlob* pPSErrors = nullptr;
+    hr = D3DCompile(desc.pixelShader, strlen(desc.pixelShader), NULL, NULL, NULL, "PSMain", "ps_5_0", 0, 0, &compiled.pixelShaderBlob, &pPSErrors);
+    SAFE_RELEASE(pPSErrors);
+    if (FAILED(hr))
+    {
+        SAFE_RELEASE(compiled.vertexShaderBlob);
+        return L"Failed to compile pixel shader";
+    }
+
+    std::lock_guard<std::mutex> lock(m_compiledMutex);
+    m_compiled.push_back(compiled);
+    return nullptr;
+}
+
+void D3D11RenderBackend::setDevice(ID3D11Device* device, ID3D11DeviceContext* context, IDXGISwapChain* swapChain)
+{
+    m_device    = device;
+    m_context   = context;
+    m_swapChain = swapChain;
+}
+
+void D3D11RenderBackend::setBackBuffer(ID3D11RenderTargetView* renderTargetView, ID3D11DepthStencilView* depthStencilView, int width, int height)
+{
+    m_renderTargetView = renderTargetView;
+    m_depthStencilView = depthStencilView;
+    m_width            = width;
+    m_height           = height;
+}
+
+RenderHandle D3D11RenderBackend::createBuffer(RenderBufferType type, const void* data, size_t size)
+{
+    Resource resource;
+    resource.kind = ResourceKind::Buffer;
+
+    D3D11_BUFFER_DESC bd = {};
+    bd.Usage     = D3D11_USAGE_DEFAULT;
+    bd.ByteWidth = (UINT)size;
+    if (type == RenderBufferType::Vertex)
+        bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    else if (type == RenderBufferType::Index)
+        bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
+    else
+    {
+        // Round up to 16 bytes.
+        bd.ByteWidth = (UINT)((size + 15) & ~(size_t)15);
+        bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+        resource.constants.assign(bd.ByteWidth, 0);
+        if (data != nullptr)
+            memcpy(resource.constants.data(), data, size);
+    }
+
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = (type == RenderBufferType::Constant) ? resource.constants.data() : data;
+
+    HRESULT hr = m_device->CreateBuffer(&bd, (initData.pSysMem != nullptr) ? &initData : NULL, &resource.buffer);
+    if (FAILED(hr))
+    {
+        fail(L"Error creating buffer");
+        return kNullRenderHandle;
+    }
+    return add(resource);
+}
+
+RenderHandle D3D11RenderBackend::createTexture(const RenderTextureDesc& desc, const TextureMip* mips)
+{
+    Resource resource;
+    resource.kind = ResourceKind::Texture;
+    resource.desc = desc;
+
+    D3D11_TEXTURE2D_DESC textureDesc = {};
+    textureDesc.Width            = desc.width;
+    textureDesc.Height           = desc.height;
+    textureDesc.Format           = GetColorFormat(desc.format, desc.sRGB);
+    textureDesc.MipLevels        = desc.mipCount;
+    textureDesc.ArraySize        = 1;
+    textureDesc.SampleDesc.Count = 1;
+    textureDesc.Usage            = D3D11_USAGE_DEFAULT;
+    textureDesc.BindFlags        = D3D11_BIND_SHADER_RESOURCE;
+
+    D3D11_SUBRESOURCE_DATA initData[kTextureFileMaxMips] = {};
+    for (int level = 0; level < desc.mipCount; level++)
+    {
+        initData[level].pSysMem     = mips[level].data;
+        initData[level].SysMemPitch = (UINT)mips[level].rowPitch;
+    }
+
+    HRESULT hr = m_device->CreateTexture2D(&textureDesc, initData, &resource.texture);
+    if (FAILED(hr))
+    {
+        fail(L"Failed to create texture");
+        return kNullRenderHandle;
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC SRVDesc = {};
+    SRVDesc.Format                    = textureDesc.Format;
+    SRVDesc.ViewDimension             = D3D11_SRV_DIMENSION_TEXTURE2D;
+    SRVDesc.Texture2D.MostDetailedMip = 0;
+    SRVDesc.Texture2D.MipLevels       = desc.mipCount;
+
+    hr = m_device->CreateShaderResourceView(resource.texture, &SRVDesc, &resource.shaderResourceView);
+    if (FAILED(hr))
+    {
+        release(resource);
+        fail(L"Failed to create shader resource view");
+        return kNullRenderHandle;
+    }
+    return add(resource);
+}
+
+RenderHandle D3D11RenderBackend::createPipeline(const RenderPipelineDesc& desc)
+{
+    // Shaders not compiled ahead are compiled now.
+    const wchar_t* compileError = compilePipeline(desc);
+    if (compileError != nullptr)
+    {
+        fail(compileError);
+        return kNullRenderHandle;
+    }
+
+    CompiledPipeline compiled;
+    {
+        std::lock_guard<std::mutex> lock(m_compiledMutex);
+        for (const CompiledPipeline& candidate : m_compiled)
+        {
+            if ((candidate.vertexShader == desc.vertexShader) && (candidate.pixelShader == desc.pixelShader))
+                compiled = candidate;
+        }
+    }
+
+    Resource resource;
+    resource.kind = ResourceKind::Pipeline;
+
+    // Create the vertex shader
+    ID3DBlob* pVSBlob = compiled.vertexShaderBlob;
+    HRESULT hr = m_device->CreateVertexShader(pVSBlob->GetBufferPointer(), pVSBlob->GetBufferSize(), nullptr, &resource.vertexShader);
+    if (FAILED(hr))
+    {
+        fail(L"Failed to create vertex shader");
+        return kNullRenderHandle;
+    }
+
+    // Define the input layout (RenderVertexFormat::PositionColor)
+    const D3D11_INPUT_ELEMENT_DESC layoutElements[] =
+    {
+        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0,  D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "COLOR",    0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+    };
+    const int layoutElementCount = ARRAYSIZE(layoutElements);
+
+    // Create the input layout
+    hr = m_device->CreateInputLayout(layoutElements, layoutElementCount, pVSBlob->GetBufferPointer(), pVSBlob->GetBufferSize(), &resource.inputLayout);
+    if (FAILED(hr))
+    {
+        release(resource);
+        fail(L"Failed to create vertex layout");
+        return kNullRenderHandle;
+    }
+
+    // Create the pixel shader
+    ID3DBlob* pPSBlob = compiled.pixelShaderBlob;
+    hr = m_device->CreatePixelShader(pPSBlob->GetBufferPointer(), pPSBlob->GetBufferSize(), nullptr, &resource.pixelShader);
+    if (FAILED(hr))
+    {
+        release(resource);
+        fail(L"Failed to create pixel shader");
+        return kNullRenderHandle;
+    }
+    return add(resource);
+}
+
+RenderHandle D3D11RenderBackend::createRenderTarget(int width, int height, bool sRGB)
+{
+    Resource resource;
+    resource.kind        = ResourceKind::RenderTarget;
+    resource.desc.width  = width;
+    resource.desc.height = height;
+    resource.desc.sRGB   = sRGB;
+
+    // Create render-target.
+    D3D11_TEXTURE2D_DESC textureDesc = {};
+    textureDesc.Width            = width;
+    textureDesc.Height           = height;
+    textureDesc.Format           = GetColorFormat(TextureFormat::RGBA8, sRGB);
+    textureDesc.MipLevels        = 1;
+    textureDesc.ArraySize        = 1;
+    textureDesc.SampleDesc.Count = 1;
+    textureDesc.Usage            = D3D11_USAGE_DEFAULT;
+    textureDesc.BindFlags        = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+    HRESULT hr = m_device->CreateTexture2D(&textureDesc, nullptr, &resource.texture);
+    if (FAILED(hr))
+    {
+        fail(L"Failed to create offscreen texture");
+        return kNullRenderHandle;
+    }
+
+    // Create shader view.
+    D3D11_SHADER_RESOURCE_VIEW_DESC SRVDesc = {};
+    SRVDesc.Format                    = textureDesc.Format;
+    SRVDesc.ViewDimension             = D3D11_SRV_DIMENSION_TEXTURE2D;
+    SRVDesc.Texture2D.MostDetailedMip = 0;
+    SRVDesc.Texture2D.MipLevels       = 1;
+    hr = m_device->CreateShaderResourceView(resource.texture, &SRVDesc, &resource.shaderResourceView);
+    if (FAILED(hr))
+    {
+        release(resource);
+        fail(L"Failed to create shader resource view");
+        return kNullRenderHandle;
+    }
+
+    // Create render-target view.
+    D3D11_RENDER_TARGET_VIEW_DESC RTVDesc = {};
+    RTVDesc.Format             = textureDesc.Format;
+    RTVDesc.ViewDimension      = D3D11_RTV_DIMENSION_TEXTURE2D;
+    RTVDesc.Texture2D.MipSlice = 0;
+    hr = m_device->CreateRenderTargetView(resource.texture, &RTVDesc, &resource.renderTargetView);
+    if (FAILED(hr))
+    {
+        release(resource);
+        fail(L"Failed to create render-target view");
+        return kNullRenderHandle;
+    }
+
+    // Create depth texture.
+    textureDesc.Format    = DXGI_FORMAT_D24_UNORM_S8_UINT;
+    textureDesc.BindFlags = D3D11_BIND_DEPTH_STENCIL;
+    hr = m_device->CreateTexture2D(&textureDesc, nullptr, &resource.depthTexture);
+    if (FAILED(hr))
+    {
+        release(resource);
+        fail(L"Failed to create depth texture");
+        return kNullRenderHandle;
+    }
+
+    // Create depth view.
+    D3D11_DEPTH_STENCIL_VIEW_DESC DSVDesc = {};
+    DSVDesc.Format             = textureDesc.Format;
+    DSVDesc.ViewDimension      = D3D11_DSV_DIMENSION_TEXTURE2D;
+    DSVDesc.Texture2D.MipSlice = 0;
+    hr = m_device->CreateDepthStencilView(resource.depthTexture, &DSVDesc, &resource.depthStencilView);
+    if (FAILED(hr))
+    {
+        release(resource);
+        fail(L"Failed to create depth-stencil view");
+        return kNullRenderHandle;
+    }
+    return add(resource);
+}
+
+bool D3D11RenderBackend::updateTexture(RenderHandle texture, const TextureMip* mips)
+{
+    Resource* resource = get(texture, ResourceKind::Texture);
+    if (resource == nullptr)
+        return false;
+
+    for (int level = 0; level < resource->desc.mipCount; level++)
+        m_context->UpdateSubresource(resource->texture, level, nullptr, mips[level].data, (UINT)mips[level].rowPitch, 0);
+    return true;
+}
+
+void D3D11RenderBackend::destroy(RenderHandle resource)
+{
+    if ((resource <= kBackBuffer) || (resource - 2 >= m_resources.size()) || (m_resources[resource - 2].kind == ResourceKind::None))
+        return;
+
+    release(m_resources[resource - 2]);
+    m_resources[resource - 2] = Resource();
+    m_freeHandles.push_back(resource);
+}
+
+void D3D11RenderBackend::clear(RenderHandle target, const float color[4])
+{
+    ID3D11RenderTargetView* renderTargetView = nullptr;
+    ID3D11DepthStencilView* depthStencilView = nullptr;
+    if (!getTargetViews(target, renderTargetView, depthStencilView))
+        return;
+
+    m_context->ClearRenderTargetView(renderTargetView, color);
+    m_context->ClearDepthStencilView(depthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+}
+
+void D3D11RenderBackend::setRenderTarget(RenderHandle target)
+{
+    ID3D11RenderTargetView* renderTargetView = nullptr;
+    ID3D11DepthStencilView* depthStencilView = nullptr;
+    if (getTargetViews(target, renderTargetView, depthStencilView))
+        m_context->OMSetRenderTargets(1, &renderTargetView, depthStencilView);
+}
+
+void D3D11RenderBackend::setViewport(const RenderViewport& viewport)
+{
+    D3D11_VIEWPORT d3dViewport = {};
+    d3dViewport.TopLeftX = viewport.x;
+    d3dViewport.TopLeftY = viewport.y;
+    d3dViewport.Width    = viewport.width;
+    d3dViewport.Height   = viewport.height;
+    d3dViewport.MinDepth = viewport.minDepth;
+    d3dViewport.MaxDepth = viewport.maxDepth;
+    m_context->RSSetViewports(1, &d3dViewport);
+}
+
+void D3D11RenderBackend::setPipeline(RenderHandle pipeline)
+{
+    const Resource* resource = get(pipeline, ResourceKind::Pipeline);
+    if (resource == nullptr)
+        return;
+
+    m_context->VSSetShader(resource->vertexShader, nullptr, 0);
+    m_context->PSSetShader(resource->pixelShader, nullptr, 0);
+    m_context->IASetInputLayout(resource->inputLayout);
+    m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
+
+void D3D11RenderBackend::setVertexBuffer(RenderHandle buffer)
+{
+    const Resource* resource = get(buffer, ResourceKind::Buffer);
+    if (resource == nullptr)
+        return;
+
+    // Set vertex buffer (XYZ|RGB)
+    UINT stride = sizeof(MeshVertex);
+    UINT offset = 0;
+    m_context->IASetVertexBuffers(0, 1, &resource->buffer, &stride, &offset);
+}
+
+void D3D11RenderBackend::setIndexBuffer(RenderHandle buffer)
+{
+    const Resource* resource = get(buffer, ResourceKind::Buffer);
+    if (resource != nullptr)
+        m_context->IASetIndexBuffer(resource->buffer, DXGI_FORMAT_R32_UINT, 0);
+}
+
+void D3D11RenderBackend::setConstantBuffer(RenderHandle buffer)
+{
+    const Resource* resource = get(buffer, ResourceKind::Buffer);
+    if (resource == nullptr)
+        return;
+
+    m_context->VSSetConstantBuffers(0, 1, &resource->buffer);
+    m_context->PSSetConstantBuffers(0, 1, &resource->buffer);
+}
+
+void D3D11RenderBackend::updateBuffer(RenderHandle buffer, const void* data, size_t size)
+{
+    Resource* resource = get(buffer, ResourceKind::Buffer);
+    if ((resource == nullptr) || (size > resource->constants.size()))
+    {
+        fail(L"Failed to update constant buffer");
+        return;
+    }
+
+    memcpy(resource->constants.data(), data, size);
+    m_context->UpdateSubresource(resource->buffer, 0, NULL, resource->constants.data(), 0, 0);
+}
+
+void D3D11RenderBackend::drawIndexed(int indexCount, int firstIndex)
+{
+    m_context->DrawIndexed((UINT)indexCount, (UINT)firstIndex, 0);
+}
+
+void D3D11RenderBackend::interlace(RenderHandle source, int viewWidth, int viewHeight, InterlaceMode mode)
+{
+    const ResourceKind kind     = (mode == InterlaceMode::Views) ? ResourceKind::RenderTarget : ResourceKind::Texture;
+    const Resource*    resource = get(source, kind);
+    if ((resource == nullptr) || (m_interlacer == nullptr))
+        return;
+
+    // Set viewport.
+    D3D11_VIEWPORT viewport = {};
+    viewport.TopLeftX = 0.0f;
+    viewport.TopLeftY = 0.0f;
+    viewport.Width    = (FLOAT)m_width;
+    viewport.Height   = (FLOAT)m_height;
+    viewport.MinDepth = 0.0f;
+    viewport.MaxDepth = 1.0f;
+    m_context->RSSetViewports(1, &viewport);
+
+    m_context->OMSetRenderTargets(1, &m_renderTargetView, m_depthStencilView);
+
+    // Perform interlacing.
+    m_interlacer->SetSourceViewsSize(viewWidth, viewHeight, true);
+    if (mode == InterlaceMode::Picture)
+        m_interlacer->DoPostProcessPicture(m_width, m_height, resource->shaderResourceView, m_renderTargetView);
+    else
+    {
+        m_interlacer->SetSourceViews(resource->shaderResourceView);
+        m_interlacer->DoPostProcess(m_width, m_height, false, m_renderTargetView);
+    }
+}
+
+void D3D11RenderBackend::present()
+{
+    m_swapChain->Present(1, 0);
+}
+
+RenderHandle D3D11RenderBackend::add(const Resource& resource)
+{
+    if (!m_freeHandles.empty())
+    {
+        const RenderHandle handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+        m_resources[handle - 2] = resource;
+        return handle;
+    }
+
+    m_resources.push_back(resource);
+    return (RenderHandle)m_resources.size() + 1;
+}
+
+D3D11RenderBackend::Resource* D3D11RenderBackend::get(RenderHandle handle, ResourceKind kind)
+{
+    if ((handle <= kBackBuffer) || (handle - 2 >= m_resources.size()) || (m_resources[handle - 2].kind != kind))
+        return nullptr;
+    return &m_resources[handle - 2];
+}
+
+bool D3D11RenderBackend::getTargetViews(RenderHandle target, ID3D11RenderTargetView*& renderTargetView, ID3D11DepthStencilView*& depthStencilView)
+{
+    if (target == kBackBuffer)
+    {
+        renderTargetView = m_renderTargetView;
+        depthStencilView = m_depthStencilView;
+        return true;
+    }
+
+    const Resource* resource = get(target, ResourceKind::RenderTarget);
+    if (resource == nullptr)
+        return false;
+
+    renderTargetView = resource->renderTargetView;
+    depthStencilView = resource->depthStencilView;
+    return true;
+}
+
+void D3D11RenderBackend::release(Resource& resource)
+{
+    SAFE_RELEASE(resource.buffer);
+    SAFE_RELEASE(resource.depthStencilView);
+    SAFE_RELEASE(resource.depthTexture);
+    SAFE_RELEASE(resource.renderTargetView);
+    SAFE_RELEASE(resource.shaderResourceView);
+    SAFE_RELEASE(resource.texture);
+    SAFE_RELEASE(resource.pixelShader);
+    SAFE_RELEASE(resource.inputLayout);
+    SAFE_RELEASE(resource.vertexShader);
+}
+
+void D3D11RenderBackend::fail(const wchar_t* error)
+{
+    if (m_error == nullptr)
+        m_error = error;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include "framework.h"
+#include <d3d11.h>
+#include "CNSDKGettingStartedRenderBackend.h"
+
+namespace leia { class InterlacerD3D11; }
+
+// RenderBackend on a D3D11 immediate context, interlacing with the Leia SDK.
+//
+// Pipelines can be compiled ahead with compilePipeline(), which only needs D3DCompile and may run
+// on a worker thread before the device exists; createPipeline() then takes the compiled shaders.
+// Everything else runs on the thread that owns the context, after setDevice().
+class D3D11RenderBackend : public RenderBackend
+{
+public:
+
+    D3D11RenderBackend() = default;
+    ~D3D11RenderBackend();
+
+    D3D11RenderBackend(const D3D11RenderBackend&) = delete;
+    D3D11RenderBackend& operator=(const D3D11RenderBackend&) = delete;
+
+    // Compile desc's shaders for a later createPipeline(). Thread-safe, and leaves getError()
+    // alone: returns null on success, otherwise what failed.
+    const wchar_t* compilePipeline(const RenderPipelineDesc& desc);
+
+    // The device, context and swap chain to render with. Not owned.
+    void setDevice(ID3D11Device* device, ID3D11DeviceContext* context, IDXGISwapChain* swapChain);
+
+    // The window's views, after every resize. Not owned.
+    void setBackBuffer(ID3D11RenderTargetView* renderTargetView, ID3D11DepthStencilView* depthStencilView, int width, int height);
+
+    void setInterlacer(leia::InterlacerD3D11* interlacer) { m_interlacer = interlacer; }
+
+    RenderHandle createBuffer(RenderBufferType type, const void* data, size_t size) override;
+    RenderHandle createTexture(const RenderTextureDesc& desc, const TextureMip* mips) override;
+    RenderHandle createPipeline(const RenderPipelineDesc& desc) override;
+    RenderHandle createRenderTarget(int width, int height, bool sRGB) override;
+    RenderHandle getBackBuffer() const override { return kBackBuffer; }
+    bool         updateTexture(RenderHandle texture, const TextureMip* mips) override;
+    void         destroy(RenderHandle resource) override;
+
+    void clear(RenderHandle target, const float color[4]) override;
+    void setRenderTarget(RenderHandle target) override;
+    void setViewport(const RenderViewport& viewport) override;
+    void setPipeline(RenderHandle pipeline) override;
+    void setVertexBuffer(RenderHandle buffer) override;
+    void setIndexBuffer(RenderHandle buffer) override;
+    void setConstantBuffer(RenderHandle buffer) override;
+    void updateBuffer(RenderHandle buffer, const void* data, size_t size) override;
+    void drawIndexed(int indexCount, int firstIndex) override;
+    void interlace(RenderHandle source, int viewWidth, int viewHeight, InterlaceMode mode) override;
+    void present() override;
+
+    const wchar_t* getError() const override { return m_error; }
+
+private:
+
+    enum class ResourceKind
+    {
+        None,
+        Buffer,
+        Texture,
+        RenderTarget,
+        Pipeline
+    };
+
+    struct Resource
+    {
+        ResourceKind              kind               = ResourceKind::None;
+
+        // Buffer. Constant buffers keep a copy of their contents, as D3D11.0 only updates them whole.
+        ID3D11Buffer*             buffer             = nullptr;
+        std::vector<std::uint8_t> constants;
+
+        // Texture and render target.
+        RenderTextureDesc         desc;
+        ID3D11Texture2D*          texture            = nullptr;
+        ID3D11ShaderResourceView* shaderResourceView = nullptr;
+        ID3D11RenderTargetView*   renderTargetView   = nullptr;
+        ID3D11Texture2D*          depthTexture       = nullptr;
+        ID3D11DepthStencilView*   depthStencilView   = nullptr;
+
+        // Pipeline.
+        ID3D11VertexShader*       vertexShader       = nullptr;
+        ID3D11PixelShader*        pixelShader        = nullptr;
+        ID3D11InputLayout*        inputLayout        = nullptr;
+    };
+
+    // Shaders compiled by compilePipeline(), found by the desc's shader text.
+    struct CompiledPipeline
+    {
+        const char* vertexShader     = nullptr;
+        const char* pixelShader      = nullptr;
+        ID3DBlob*   vertexShaderBlob = nullptr;
+        ID3DBlob*   pixelShaderBlob  = nullptr;
+    };
+
+    static const RenderHandle kBackBuffer = 1;
+
+    RenderHandle add(const Resource& resource);
+
+    // The resource of a handle if it's live and of kind, otherwise null.
+    Resource* get(RenderHandle handle, ResourceKind kind);
+
+    // Color and depth views of a render target or the back buffer.
+    bool getTargetViews(RenderHandle target, ID3D11RenderTargetView*& renderTargetView, ID3D11DepthStencilView*& depthStencilView);
+
+    static void release(Resource& resource);
+
+    void fail(const wchar_t* error);
+
+    ID3D11Device*                 m_device           = nullptr;
+    ID3D11DeviceContext*          m_context          = nullptr;
+    IDXGISwapChain*               m_swapChain        = nullptr;
+    leia::InterlacerD3D11*        m_interlacer       = nullptr;
+    ID3D11RenderTargetView*       m_renderTargetView = nullptr;
+    ID3D11DepthStencilView*       m_depthStencilView = nullptr;
+    int                           m_width            = 0;
+    int                           m_height           = 0;
+
+    std::vector<Resource>         m_resources;        // Index handle - 2, handle 1 is the back buffer
+    std::vector<RenderHandle>     m_freeHandles;
+
+    std::mutex                    m_compiledMutex;
+    std::vector<CompiledPipeline> m_compiled;
+
+    const wchar_t*                m_error            = nullptr;
+};
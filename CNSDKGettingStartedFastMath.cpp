@@ -0,0 +1,48 @@
+#include "CNSDKGettingStartedMath.h"
+
+using namespace MathSIMD;
+
+void FastMath::SinCos(float* sines, float* cosines, const float* angles, size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        Vec4 s, c;
+        SinCos(Load(angles + i), s, c);
+        Store(sines + i, s);
+        Store(cosines + i, c);
+    }
+
+    for (; i < count; i++)
+        SinCos(angles[i], sines[i], cosines[i]);
+}
+
+void FastMath::Tan(float* dst, const float* angles, size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+        Store(dst + i, Tan(Load(angles + i)));
+
+    for (; i < count; i++)
+        dst[i] = Tan(angles[i]);
+}
+
+void FastMath::Atan2(float* dst, const float* y, const float* x, size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+        Store(dst + i, Atan2(Load(y + i), Load(x + i)));
+
+    for (; i < count; i++)
+        dst[i] = Atan2(y[i], x[i]);
+}
+
+void FastMath::Exp(float* dst, const float* src, size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+        Store(dst + i, Exp(Load(src + i)));
+
+    for (; i < count; i++)
+        dst[i] = Exp(src[i]);
+}
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <stddef.h>
+#include <math.h>
+#include <float.h>
+#include <string.h>
+
+// Fast float sin, cos, tan, atan2 and exp: range reduction and short polynomials, on single
+// floats and on MathSIMD::Vec4. Both forms do the same float operations in the same order, so
+// they return identical results on every backend. Maximum error against the exact result, for
+// finite inputs:
+//
+//   SinCos   |x| <= pi/4     1.0 ulp
+//            |x| <= 8192     1.6 ulp where the result is at least 0.25, 8e-8 absolute
+//   Tan      |x| <= pi/4     2.7 ulp
+//            |x| <= 8192     relative 3e-7 where sin and cos are at least 0.01
+//   Atan2    all             3.3 ulp
+//   Exp      [-87.3, 88.3]   1.0 ulp; inputs outside are clamped to the range
+//
+// Atan2 returns +0 or +pi for y = -0, and 0 for x = y = 0. The bounds are also the constants
+// below, which cnsdk_math_bench checks its measurements against.
+//
+// Part of CNSDKGettingStartedMath.h, which includes this after MathSIMD. Include that instead.
+// The math types use these for their trig when CNSDK_MATH_FAST_TRIG is defined.
+
+namespace FastMath
+{
+    // Maximum errors of the table above.
+    const double kSinCosMaxUlp     = 1.0;  // |x| <= pi/4
+    const double kSinCosWideMaxAbs = 8e-8; // |x| <= 8192
+    const double kTanMaxUlp        = 2.7;  // |x| <= pi/4
+    const double kAtan2MaxUlp      = 3.3;
+    const double kExpMaxUlp        = 1.0;
+
+    namespace Detail
+    {
+        const float kTwoOverPi  = 0.636619772367581343f;
+        const float kPi         = 3.14159265358979324f;
+        const float kPiOver2    = 1.57079632679489662f;
+        const float kPiOver4    = 0.785398163397448310f;
+        const float kTanPiOver8 = 0.414213562373095049f;
+        const float kLog2E      = 1.44269504088896341f;
+
+        // pi/2 in three parts. Multiples of the first two by integers up to 2^13 are exact.
+        const float kPiOver2Hi  = 1.5703125f;
+        const float kPiOver2Mid = 4.837512969970703125e-4f;
+        const float kPiOver2Lo  = 7.54978995489188216e-8f;
+
+        // ln 2 in two parts, the first exact when multiplied by integers up to 2^15.
+        const float kLn2Hi = 0.693359375f;
+        const float kLn2Lo = -2.12194440e-4f;
+
+        const float kExpMin = -87.3f;
+        const float kExpMax = 88.3f;
+
+        // sin(r) = r + r^3 (S1 + S2 r^2 + S3 r^4), cos(r) = 1 - r^2 / 2 + r^4 (C1 + C2 r^2 + C3 r^4),
+        // on [-pi/4, pi/4].
+        const float kS1 = -1.6666654611e-1f;
+        const float kS2 = 8.3321608736e-3f;
+        const float kS3 = -1.9515295891e-4f;
+        const float kC1 = 4.166664568298827e-2f;
+        const float kC2 = -1.388731625493765e-3f;
+        const float kC3 = 2.443315711809948e-5f;
+
+        // atan(u) = u + u^3 (A1 + A2 u^2 + A3 u^4 + A4 u^6), on [-tan(pi/8), tan(pi/8)].
+        const float kA1 = -3.33329491539e-1f;
+        const float kA2 = 1.99777106478e-1f;
+        const float kA3 = -1.38776856032e-1f;
+        const float kA4 = 8.05374449538e-2f;
+
+        // exp(r) = 1 + r + r^2 (E0 + E1 r + ... + E5 r^5), on [-ln2 / 2, ln2 / 2].
+        const float kE0 = 5.0000001201e-1f;
+        const float kE1 = 1.6666665459e-1f;
+        const float kE2 = 4.1665795894e-2f;
+        const float kE3 = 8.3334519073e-3f;
+        const float kE4 = 1.3981999507e-3f;
+        const float kE5 = 1.9875691500e-4f;
+    }
+
+    inline void SinCos(float x, float& s, float& c)
+    {
+        using namespace Detail;
+
+        // x = j * pi/2 + r, then the quadrant j picks and negates the polynomials.
+        const int   n = MathSIMD::RoundToInt(x * kTwoOverPi);
+        const float j = (float)n;
+        const float r = ((x - j * kPiOver2Hi) - j * kPiOver2Mid) - j * kPiOver2Lo;
+        const float z = r * r;
+
+        const float sr = ((kS3 * z + kS2) * z + kS1) * z * r + r;
+        const float cr = ((kC3 * z + kC2) * z + kC1) * z * z - 0.5f * z + 1.0f;
+
+        // Indexing and multiplying by +-1 rather than branching, as the quadrant is unpredictable.
+        const float poly[2] = { sr, cr };
+        s = poly[n & 1] * (1.0f - (float)(n & 2));
+        c = poly[~n & 1] * (1.0f - (float)((n + 1) & 2));
+    }
+
+    inline float Sin(float x)
+    {
+        float s, c;
+        SinCos(x, s, c);
+        return s;
+    }
+
+    inline float Cos(float x)
+    {
+        float s, c;
+        SinCos(x, s, c);
+        return c;
+    }
+
+    inline float Tan(float x)
+    {
+        float s, c;
+        SinCos(x, s, c);
+        return s / c;
+    }
+
+    inline float Atan2(float y, float x)
+    {
+        using namespace Detail;
+
+        // atan of the smaller over the larger magnitude, then reflected into the right octant.
+        const float ax = fabsf(x);
+        const float ay = fabsf(y);
+        const float lo = (ax < ay) ? ax : ay;
+        const float hi = (ax > ay) ? ax : ay;
+        const float t  = lo / ((hi > FLT_MIN) ? hi : FLT_MIN);
+
+        const bool  big = kTanPiOver8 < t;
+        const float u   = big ? ((t - 1.0f) / (t + 1.0f)) : t;
+        const float z   = u * u;
+
+        float a = (((kA4 * z + kA3) * z + kA2) * z + kA1) * z * u + u;
+        a = a + (big ? kPiOver4 : 0.0f);
+        a = (ax < ay) ? (kPiOver2 - a) : a;
+        a = (x < 0.0f) ? (kPi - a) : a;
+        return (y < 0.0f) ? -a : a;
+    }
+
+    inline float Exp(float x)
+    {
+        using namespace Detail;
+
+        // exp(x) = 2^n exp(r), |r| <= ln2 / 2.
+        x = (x > kExpMin) ? x : kExpMin;
+        x = (x < kExpMax) ? x : kExpMax;
+
+        const int   n = MathSIMD::RoundToInt(x * kLog2E);
+        const float j = (float)n;
+        const float r = (x - j * kLn2Hi) - j * kLn2Lo;
+        const float z = r * r;
+
+        const float p = (((((kE5 * r + kE4) * r + kE3) * r + kE2) * r + kE1) * r + kE0) * z + r + 1.0f;
+
+        // 2^n from its exponent bits.
+        const int bits = (n + 127) << 23;
+        float scale;
+        memcpy(&scale, &bits, sizeof(scale));
+        return p * scale;
+    }
+
+    inline void SinCos(MathSIMD::Vec4 x, MathSIMD::Vec4& s, MathSIMD::Vec4& c)
+    {
+        using namespace MathSIMD;
+        using namespace Detail;
+
+        const Vec4 j = Round(Mul(x, Splat(kTwoOverPi)));
+        const Vec4 r = Sub(Sub(Sub(x, Mul(j, Splat(kPiOver2Hi))), Mul(j, Splat(kPiOver2Mid))), Mul(j, Splat(kPiOver2Lo)));
+        const Vec4 z = Mul(r, r);
+
+        const Vec4 sr = MulAdd(Mul(MulAdd(MulAdd(Splat(kS3), z, Splat(kS2)), z, Splat(kS1)), z), r, r);
+        const Vec4 cr = Add(Sub(Mul(Mul(MulAdd(MulAdd(Splat(kC3), z, Splat(kC2)), z, Splat(kC1)), z), z), Mul(Splat(0.5f), z)), Splat(1.0f));
+
+        // quadrant = j mod 4 = 2 * half + odd, in floats: floor(j / 4) is round((j - 1.5) / 4).
+        const Vec4 quadrant = Sub(j, Mul(Round(Mul(Sub(j, Splat(1.5f)), Splat(0.25f))), Splat(4.0f)));
+        const Vec4 half     = Round(Mul(Sub(quadrant, Splat(0.5f)), Splat(0.5f)));
+        const Vec4 odd      = Sub(quadrant, Add(half, half));
+
+        const Vec4 swap   = Less(Splat(0.5f), odd);
+        const Vec4 negSin = Less(Splat(0.5f), half);
+        const Vec4 negCos = Less(Abs(Sub(quadrant, Splat(1.5f))), Splat(1.0f));
+
+        const Vec4 sq = Select(swap, cr, sr);
+        const Vec4 cq = Select(swap, sr, cr);
+        s = Select(negSin, Neg(sq), sq);
+        c = Select(negCos, Neg(cq), cq);
+    }
+
+    inline MathSIMD::Vec4 Tan(MathSIMD::Vec4 x)
+    {
+        MathSIMD::Vec4 s, c;
+        SinCos(x, s, c);
+        return MathSIMD::Div(s, c);
+    }
+
+    inline MathSIMD::Vec4 Atan2(MathSIMD::Vec4 y, MathSIMD::Vec4 x)
+    {
+        using namespace MathSIMD;
+        using namespace Detail;
+
+        const Vec4 zero = Splat(0.0f);
+        const Vec4 one  = Splat(1.0f);
+
+        const Vec4 ax = Abs(x);
+        const Vec4 ay = Abs(y);
+        const Vec4 t  = Div(Min(ax, ay), Max(Max(ax, ay), Splat(FLT_MIN)));
+
+        const Vec4 big = Less(Splat(kTanPiOver8), t);
+        const Vec4 u   = Select(big, Div(Sub(t, one), Add(t, one)), t);
+        const Vec4 z   = Mul(u, u);
+
+        Vec4 a = MulAdd(Mul(MulAdd(MulAdd(MulAdd(Splat(kA4), z, Splat(kA3)), z, Splat(kA2)), z, Splat(kA1)), z), u, u);
+        a = Add(a, Select(big, Splat(kPiOver4), zero));
+        a = Select(Less(ax, ay), Sub(Splat(kPiOver2), a), a);
+        a = Select(Less(x, zero), Sub(Splat(kPi), a), a);
+        return Select(Less(y, zero), Neg(a), a);
+    }
+
+    inline MathSIMD::Vec4 Exp(MathSIMD::Vec4 x)
+    {
+        using namespace MathSIMD;
+        using namespace Detail;
+
+        x = Min(Max(x, Splat(kExpMin)), Splat(kExpMax));
+
+        const Vec4 j = Round(Mul(x, Splat(kLog2E)));
+        const Vec4 r = Sub(Sub(x, Mul(j, Splat(kLn2Hi))), Mul(j, Splat(kLn2Lo)));
+        const Vec4 z = Mul(r, r);
+
+        Vec4 p = MulAdd(Splat(kE5), r, Splat(kE4));
+        p = MulAdd(p, r, Splat(kE3));
+        p = MulAdd(p, r, Splat(kE2));
+        p = MulAdd(p, r, Splat(kE1));
+        p = MulAdd(p, r, Splat(kE0));
+        p = Add(Add(Mul(p, z), r), Splat(1.0f));
+        return Mul(p, Exp2i(j));
+    }
+
+    // Evaluate count values, four at a time. Outputs may be the same buffers as the inputs.
+    void SinCos(float* sines, float* cosines, const float* angles, size_t count);
+    void Tan(float* dst, const float* angles, size_t count);
+    void Atan2(float* dst, const float* y, const float* x, size_t count);
+    void Exp(float* dst, const float* src, size_t count);
+}
@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include "CNSDKGettingStartedFile.h"
+
+#ifdef _WIN32
+#include "framework.h"
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+bool FileSource::open(const char* filename, bool map)
+{
+    close();
+
+    if (map && openMapped(filename))
+        return true;
+
+    return openBuffered(filename);
+}
+
+void FileSource::close()
+{
+    if (m_mapped && (m_data != nullptr))
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+#else
+        munmap(const_cast<std::uint8_t*>(m_data), m_size);
+#endif
+    }
+
+#ifdef _WIN32
+    if (m_mappingHandle != nullptr)
+        CloseHandle((HANDLE)m_mappingHandle);
+    if (m_fileHandle != nullptr)
+        CloseHandle((HANDLE)m_fileHandle);
+    m_mappingHandle = nullptr;
+    m_fileHandle    = nullptr;
+#endif
+
+    m_buffer.reset();
+    m_data   = nullptr;
+    m_size   = 0;
+    m_mapped = false;
+}
+
+bool FileSource::openMapped(const char* filename)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    // Zero-sized files can't be mapped.
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(file, &fileSize) || (fileSize.QuadPart <= 0))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle    = file;
+    m_mappingHandle = mapping;
+    m_data          = (const std::uint8_t*)view;
+    m_size          = (size_t)fileSize.QuadPart;
+    m_mapped        = true;
+    return true;
+#else
+    const int fd = ::open(filename, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    // Zero-sized files can't be mapped.
+    struct stat st = {};
+    if ((fstat(fd, &st) != 0) || (st.st_size <= 0))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+
+    if (view == MAP_FAILED)
+        return false;
+
+    // Images are decoded front to back.
+    madvise(view, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    m_data   = (const std::uint8_t*)view;
+    m_size   = (size_t)st.st_size;
+    m_mapped = true;
+    return true;
+#endif
+}
+
+bool FileSource::openBuffered(const char* filename)
+{
+    FILE* f = fopen(filename, "rb");
+    if (f == NULL)
+        return false;
+
+    // Get size first so we can read everything with one allocation.
+    long fileSize = -1;
+    if (fseek(f, 0, SEEK_END) == 0)
+        fileSize = ftell(f);
+    if ((fileSize <= 0) || (fseek(f, 0, SEEK_SET) != 0))
+    {
+        fclose(f);
+        return false;
+    }
+
+    m_buffer.reset(new std::uint8_t[(size_t)fileSize]);
+    const size_t bytesRead = fread(m_buffer.get(), 1, (size_t)fileSize, f);
+    fclose(f);
+
+    if (bytesRead != (size_t)fileSize)
+    {
+        m_buffer.reset();
+        return false;
+    }
+
+    m_data = m_buffer.get();
+    m_size = bytesRead;
+    return true;
+}
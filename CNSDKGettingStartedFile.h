@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stddef.h>
+#include <cstdint>
+#include <memory>
+
+// Non-owning view of a contiguous block of bytes.
+struct ByteSpan
+{
+    const std::uint8_t* data = nullptr;
+    size_t              size = 0;
+
+    ByteSpan() = default;
+    ByteSpan(const std::uint8_t* _data, size_t _size) : data(_data), size(_size) {}
+
+    bool                empty() const { return size == 0; }
+    const std::uint8_t* begin() const { return data; }
+    const std::uint8_t* end()   const { return data + size; }
+};
+
+// Read-only view of a whole file.
+//
+// The file is memory-mapped when the platform allows it (MapViewOfFile on Windows, mmap elsewhere),
+// so pages are only faulted in as they are decoded. If mapping fails the file size is queried up-front
+// and the contents are read with a single allocation and a single read.
+class FileSource
+{
+public:
+
+    FileSource() = default;
+    ~FileSource() { close(); }
+
+    FileSource(const FileSource&) = delete;
+    FileSource& operator=(const FileSource&) = delete;
+
+    // Open the file. Returns false if it can't be opened or is empty. With map false the file is
+    // read into memory even where it could be mapped, e.g. to compare the two.
+    bool open(const char* filename, bool map = true);
+
+    // Release the mapping or buffer. Spans previously returned become invalid.
+    void close();
+
+    // Entire file contents, valid until close() or destruction.
+    ByteSpan getSpan() const { return ByteSpan(m_data, m_size); }
+
+    bool isOpen()   const { return m_data != nullptr; }
+    bool isMapped() const { return m_mapped; }
+
+private:
+
+    bool openMapped(const char* filename);
+    bool openBuffered(const char* filename);
+
+    const std::uint8_t*             m_data   = nullptr;
+    size_t                          m_size   = 0;
+    bool                            m_mapped = false;
+    std::unique_ptr<std::uint8_t[]> m_buffer;
+
+#ifdef _WIN32
+    void* m_fileHandle    = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+};
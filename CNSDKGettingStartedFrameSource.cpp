@@ -0,0 +1,356 @@
+#include <string.h>
+#include "CNSDKGettingStartedFile.h"
+#include "CNSDKGettingStartedFrameSource.h"
+#include "CNSDKGettingStartedTGA.h"
+
+StereoFrameSource::~StereoFrameSource()
+{
+    // Decodes write into the slots, let them finish.
+    for (Slot& slot : m_slots)
+        if (slot.task.valid())
+            slot.task.wait();
+
+    if (m_timingLog != nullptr)
+        fflush(m_timingLog);
+}
+
+void StereoFrameSource::addImage(const std::string& path)
+{
+    Item item;
+    item.path    = path;
+    item.texture = (path.size() >= 5) && (path.compare(path.size() - 5, 5, ".ctex") == 0);
+    m_items.push_back(item);
+}
+
+bool StereoFrameSource::addRawSequence(const std::string& path, int width, int height)
+{
+    FileSource file;
+    if (!file.open(path.c_str()) || (width <= 0) || (height <= 0))
+    {
+        m_error = L"Failed to open raw frame sequence.";
+        return false;
+    }
+
+    Item item;
+    item.path   = path;
+    item.raw    = true;
+    item.width  = width;
+    item.height = height;
+
+    const size_t frameSize  = (size_t)width * height * 4;
+    const size_t frameCount = file.getSpan().size / frameSize;
+    for (size_t i = 0; i < frameCount; i++)
+    {
+        item.frameOffset = i * frameSize;
+        m_items.push_back(item);
+    }
+
+    return true;
+}
+
+bool StereoFrameSource::start(size_t memoryBudget, bool loop)
+{
+    if (m_items.empty())
+    {
+        m_error = L"Stereo frame sequence is empty.";
+        return false;
+    }
+
+    // Read the headers to size the ring buffers for the largest frame decoded into them.
+    size_t maxFrameSize   = 0;
+    size_t maxDecodedSize = 0;
+    for (Item& item : m_items)
+    {
+        if (item.texture)
+        {
+            TextureFile textureFile;
+            if (!textureFile.open(item.path.c_str()))
+            {
+                m_error = textureFile.getError();
+                return false;
+            }
+
+            item.width  = textureFile.getMip(0).width;
+            item.height = textureFile.getMip(0).height;
+        }
+        else if (!item.raw)
+        {
+            FILE* file = fopen(item.path.c_str(), "rb");
+            if (file == nullptr)
+            {
+                m_error = L"Failed to read TGA file.";
+                return false;
+            }
+
+            TGAFileInput input(file, 256);
+            TGADecoder   decoder(input);
+            const bool   ok = decoder.readHeader();
+            fclose(file);
+            if (!ok)
+            {
+                m_error = decoder.getError();
+                return false;
+            }
+
+            item.width  = decoder.getWidth();
+            item.height = decoder.getHeight();
+        }
+
+        const size_t frameSize = (size_t)item.width * item.height * 4;
+        if (frameSize > maxFrameSize)
+            maxFrameSize = frameSize;
+        const bool cached = !item.raw && (m_imageCache != nullptr);
+        if (!item.texture && !cached && (frameSize > maxDecodedSize))
+            maxDecodedSize = frameSize;
+    }
+
+    // As many slots as the budget allows, at least two so one frame decodes while another is shown,
+    // and no more than there are frames.
+    size_t slotCount = memoryBudget / maxFrameSize;
+    if (slotCount < 2)
+        slotCount = 2;
+    if (slotCount > m_items.size())
+        slotCount = m_items.size();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_loop         = loop;
+    m_currentSlot  = 0;
+    m_currentFrame = 0;
+    m_slots        = std::vector<Slot>(slotCount); // Slots own mappings, so they can't be moved by resize()
+    for (size_t i = 0; i < slotCount; i++)
+    {
+        if (maxDecodedSize > 0)
+            m_slots[i].buffer.reset(new std::uint8_t[maxDecodedSize]);
+        queueDecode((int)i, (int)i);
+    }
+
+    return true;
+}
+
+int StereoFrameSource::getFrameAhead(int k) const
+{
+    const int frameIndex = m_currentFrame + k;
+    if (frameIndex < (int)m_items.size())
+        return frameIndex;
+    return m_loop ? (frameIndex % (int)m_items.size()) : -1;
+}
+
+void StereoFrameSource::queueDecode(int slotIndex, int frameIndex)
+{
+    Slot& slot = m_slots[slotIndex];
+
+    // Nothing left to decode, or the frame is already there (every frame fits in the ring).
+    if ((frameIndex < 0) || ((slot.frameIndex == frameIndex) && (slot.state == SlotState::Ready)))
+    {
+        if (frameIndex < 0)
+            slot.state = SlotState::Empty;
+        return;
+    }
+
+    slot.textureFile.close();
+    slot.image.reset();
+    slot.state      = SlotState::Decoding;
+    slot.frameIndex = frameIndex;
+    slot.width      = m_items[frameIndex].width;
+    slot.height     = m_items[frameIndex].height;
+    slot.task       = m_pool.submit([this, slotIndex, frameIndex]() { decodeFrame(slotIndex, frameIndex); });
+}
+
+void StereoFrameSource::decodeFrame(int slotIndex, int frameIndex)
+{
+    // The slot is owned by this task until its state leaves Decoding, so the buffer is written unlocked.
+    Slot&                   slot        = m_slots[slotIndex];
+    const Clock::time_point decodeStart = Clock::now();
+    const wchar_t*          error       = nullptr;
+    const bool              ok          = decodeItem(m_items[frameIndex], slot, error);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        slot.state       = ok ? SlotState::Ready : SlotState::Failed;
+        slot.decodeStart = decodeStart;
+        slot.decodeEnd   = Clock::now();
+        if (!ok)
+            m_error = error;
+    }
+    m_readyCondition.notify_all();
+}
+
+bool StereoFrameSource::decodeItem(const Item& item, Slot& slot, const wchar_t*& error)
+{
+    if (item.texture)
+    {
+        TextureFile& textureFile = slot.textureFile;
+        if (!textureFile.open(item.path.c_str()) || (textureFile.getMip(0).width != item.width) || (textureFile.getMip(0).height != item.height))
+        {
+            error = (textureFile.getError() != nullptr) ? textureFile.getError() : L"Texture file changed size.";
+            return false;
+        }
+
+        // Fault the mapped pages in here rather than during upload on the render thread.
+        const size_t pageSize = 4096;
+        std::uint8_t touched  = 0;
+        for (int level = 0; level < textureFile.getMipCount(); level++)
+        {
+            const TextureMip& mip  = textureFile.getMip(level);
+            const size_t      size = mip.rowPitch * mip.height;
+            for (size_t offset = 0; offset < size; offset += pageSize)
+                touched ^= mip.data[offset];
+        }
+        volatile std::uint8_t sink = touched;
+        (void)sink;
+        return true;
+    }
+
+    std::uint8_t* dst = slot.buffer.get();
+    slot.bufferMip.data     = dst;
+    slot.bufferMip.width    = item.width;
+    slot.bufferMip.height   = item.height;
+    slot.bufferMip.rowPitch = (size_t)item.width * 4;
+
+    FileSource file;
+    if (!file.open(item.path.c_str()))
+    {
+        error = item.raw ? L"Failed to open raw frame sequence." : L"Failed to read TGA file.";
+        return false;
+    }
+
+    const size_t frameSize = (size_t)item.width * item.height * 4;
+
+    if (item.raw)
+    {
+        // The file may have changed since it was added.
+        const ByteSpan span = file.getSpan();
+        if ((span.size < item.frameOffset) || (span.size - item.frameOffset < frameSize))
+        {
+            error = L"Raw frame sequence is truncated.";
+            return false;
+        }
+
+        memcpy(dst, span.data + item.frameOffset, frameSize);
+        return true;
+    }
+
+    // With a cache the frame uses the cached pixels directly.
+    if (m_imageCache != nullptr)
+    {
+        slot.image = m_imageCache->getTGA(file.getSpan(), m_pool, error);
+        if ((slot.image == nullptr) || (slot.image->width != item.width) || (slot.image->height != item.height))
+        {
+            if (error == nullptr)
+                error = L"TGA file changed size.";
+            return false;
+        }
+
+        slot.bufferMip.data = slot.image->pixels.data();
+        return true;
+    }
+
+    // Large stills are themselves split into bands across the pool.
+    TGAParallelDecoder decoder(file.getSpan(), m_pool);
+    decoder.setOutputFormat(TGAOutputFormat::RGBA8);
+    if (!decoder.readHeader() || (decoder.getWidth() != item.width) || (decoder.getHeight() != item.height) ||
+        !decoder.decode(dst, decoder.getRowSize()))
+    {
+        error = (decoder.getError() != nullptr) ? decoder.getError() : L"TGA file changed size.";
+        return false;
+    }
+
+    return true;
+}
+
+bool StereoFrameSource::waitForCurrentFrame()
+{
+    if (m_slots.empty())
+        return false;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const Slot& slot = m_slots[m_currentSlot];
+    m_readyCondition.wait(lock, [&slot] { return slot.state != SlotState::Decoding; });
+    return slot.state == SlotState::Ready;
+}
+
+bool StereoFrameSource::getCurrentFrame(StereoFrame& frame) const
+{
+    if (m_slots.empty())
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const Slot& slot = m_slots[m_currentSlot];
+    if (slot.state != SlotState::Ready)
+        return false;
+
+    if (slot.textureFile.isOpen())
+    {
+        frame.format   = slot.textureFile.getFormat();
+        frame.mips     = &slot.textureFile.getMip(0);
+        frame.mipCount = slot.textureFile.getMipCount();
+        frame.sRGB     = slot.textureFile.isSRGB();
+    }
+    else
+    {
+        frame.format   = TextureFormat::RGBA8;
+        frame.mips     = &slot.bufferMip;
+        frame.mipCount = 1;
+        frame.sRGB     = true;
+    }
+
+    frame.pixels   = frame.mips[0].data;
+    frame.width    = slot.width;
+    frame.height   = slot.height;
+    frame.rowPitch = frame.mips[0].rowPitch;
+    frame.index    = slot.frameIndex;
+    return true;
+}
+
+bool StereoFrameSource::advance()
+{
+    if (m_slots.empty() || (m_items.size() < 2))
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const int   nextSlot = (m_currentSlot + 1) % (int)m_slots.size();
+    const Slot& next     = m_slots[nextSlot];
+    if ((getFrameAhead(1) < 0) || (next.state == SlotState::Empty))
+        return false;
+
+    // At startup the current frame may still be decoding, its slot can't be recycled before it's done.
+    if ((next.state == SlotState::Decoding) || (m_slots[m_currentSlot].state == SlotState::Decoding))
+    {
+        m_stallCount++;
+        m_frameStalls++;
+        return false;
+    }
+
+    // Recycle the current slot for the frame a full ring ahead.
+    const int recycledSlot  = m_currentSlot;
+    const int recycledFrame = getFrameAhead((int)m_slots.size());
+    m_currentSlot  = nextSlot;
+    m_currentFrame = getFrameAhead(1);
+    queueDecode(recycledSlot, recycledFrame);
+
+    if (m_timingLog != nullptr)
+    {
+        typedef std::chrono::duration<double, std::milli> Milliseconds;
+        const double decodeMs = Milliseconds(next.decodeEnd - next.decodeStart).count();
+        const double readyMs  = Milliseconds(Clock::now() - next.decodeEnd).count();
+        fprintf(m_timingLog, "%d,%.3f,%.3f,%d\n", m_currentFrame, decodeMs, readyMs, m_frameStalls);
+    }
+    m_frameStalls = 0;
+
+    return true;
+}
+
+const wchar_t* StereoFrameSource::getError() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_error;
+}
+
+void StereoFrameSource::setTimingLog(FILE* file)
+{
+    m_timingLog = file;
+    if (m_timingLog != nullptr)
+        fprintf(m_timingLog, "frame,decode_ms,ready_ms,stalls\n");
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <stdio.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "CNSDKGettingStartedImageCache.h"
+#include "CNSDKGettingStartedTexture.h"
+#include "CNSDKGettingStartedThreadPool.h"
+
+// Frame owned by a StereoFrameSource. pixels/rowPitch describe the full-size level, texture files
+// also carry their prebuilt mips.
+struct StereoFrame
+{
+    const std::uint8_t* pixels   = nullptr;
+    int                 width    = 0;
+    int                 height   = 0;
+    size_t              rowPitch = 0;
+    TextureFormat       format   = TextureFormat::RGBA8;
+    const TextureMip*   mips     = nullptr;
+    int                 mipCount = 0;
+    bool                sRGB     = true; // Color channels are sRGB encoded, false for linear texture files
+    int                 index    = -1;   // Position in the sequence
+};
+
+// Sequence of side-by-side stereo frames (TGA stills, .ctex texture files and files of raw RGBA8
+// frames) prepared ahead on a thread pool. TGA and raw frames are decoded into a fixed ring of
+// recycled buffers; texture files are mapped and their pages touched, so they are used in place.
+// The ring holds as many frames as fit in the memory budget, at least two. The current frame
+// stays valid until advance() moves past it.
+class StereoFrameSource
+{
+public:
+
+    explicit StereoFrameSource(ThreadPool& pool) : m_pool(pool) {}
+    ~StereoFrameSource();
+
+    StereoFrameSource(const StereoFrameSource&) = delete;
+    StereoFrameSource& operator=(const StereoFrameSource&) = delete;
+
+    // Append a TGA still or, if the name ends in .ctex, a texture file.
+    void addImage(const std::string& path);
+
+    // Append every frame of a file of back-to-back width x height RGBA8 frames.
+    bool addRawSequence(const std::string& path, int width, int height);
+
+    // Share decoded TGA stills through a cache, so frames shown again (or already decoded
+    // elsewhere) aren't decoded twice. Must be called before start().
+    void setImageCache(ImageCache* cache) { m_imageCache = cache; }
+
+    // Read the frame sizes, allocate the ring and start decoding from the first frame.
+    // With loop set the sequence wraps around, otherwise it stops at the last frame.
+    bool start(size_t memoryBudget, bool loop = true);
+
+    // Block until the current frame is decoded, for startup when there's nothing to show yet. Not
+    // from a task on the source's pool: the decode may be queued behind it with no worker to run it.
+    bool waitForCurrentFrame();
+
+    // Get the current frame. Returns false if it isn't decoded yet or failed to decode. Never blocks.
+    bool getCurrentFrame(StereoFrame& frame) const;
+
+    // Move to the next frame and recycle the current frame's buffer for a frame further ahead.
+    // Returns false, keeping the current frame, if the next frame is still decoding or the
+    // sequence has ended. Never blocks.
+    bool advance();
+
+    int            getFrameCount() const { return (int)m_items.size(); }
+    int            getSlotCount()  const { return (int)m_slots.size(); }
+    int            getStallCount() const { return m_stallCount; }
+    const wchar_t* getError()      const;
+
+    // Write one CSV line per frame shown: frame index, decode time, how long the frame was ready
+    // before it was needed, and advance() calls that stalled on it.
+    void setTimingLog(FILE* file);
+
+private:
+
+    typedef std::chrono::steady_clock Clock;
+
+    enum class SlotState
+    {
+        Empty,
+        Decoding,
+        Ready,
+        Failed
+    };
+
+    struct Item
+    {
+        std::string path;
+        bool        raw         = false;
+        bool        texture     = false;
+        int         width       = 0;
+        int         height      = 0;
+        size_t      frameOffset = 0; // Raw frames only
+    };
+
+    struct Slot
+    {
+        std::unique_ptr<std::uint8_t[]> buffer;
+        DecodedImageHandle              image;
+        TextureFile                     textureFile;
+        TextureMip                      bufferMip;
+        SlotState                       state      = SlotState::Empty;
+        int                             frameIndex = -1;
+        int                             width      = 0;
+        int                             height     = 0;
+        TaskHandle                      task;
+        Clock::time_point               decodeStart;
+        Clock::time_point               decodeEnd;
+    };
+
+    // Frame index k frames after the current one, or -1 past the end of a non-looping sequence.
+    int getFrameAhead(int k) const;
+
+    // Queue decoding of frameIndex into a slot. Called with m_mutex held.
+    void queueDecode(int slotIndex, int frameIndex);
+
+    // Worker side of queueDecode.
+    void decodeFrame(int slotIndex, int frameIndex);
+
+    bool decodeItem(const Item& item, Slot& slot, const wchar_t*& error);
+
+    ThreadPool&       m_pool;
+    ImageCache*       m_imageCache   = nullptr;
+    std::vector<Item> m_items;
+    std::vector<Slot> m_slots;
+    bool              m_loop         = true;
+    int               m_currentSlot  = 0;
+    int               m_currentFrame = 0;
+    int               m_stallCount   = 0;
+    int               m_frameStalls  = 0;
+    FILE*             m_timingLog    = nullptr;
+    const wchar_t*    m_error        = nullptr;
+
+    mutable std::mutex              m_mutex;
+    mutable std::condition_variable m_readyCondition;
+};
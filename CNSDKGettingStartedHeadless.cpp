@@ -0,0 +1,354 @@
+// Headless run of the sample's frame loop (see CNSDKGettingStartedScene.h) on the null or the
+// software render backend, with a simulated face tracker in place of the Leia SDK. Measures the
+// CPU cost of a frame without a GPU, window or display, and checks the commands the scene issues.
+//
+// Usage: cnsdk_headless [--frames n] [--view-size width height] [--still] [--image file]...
+//                       [--print-frame] [--backend null|software] [--threads n] [--save prefix]
+//
+// --image switches from the spinning cube to the stereo images; --still keeps the simulated face
+// within tracker noise of one point instead of swaying. --print-frame lists the last frame's
+// commands (null backend). The software backend rasterizes the frames on a pool of --threads
+// workers (0, the default, for one per hardware thread, 1 for the calling thread only), and
+// --save writes the last frame's view atlas and back buffer to prefix_atlas.tga and
+// prefix_interlaced.tga. Exits with status 1 if the scene or the backend reports an error.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CNSDKGettingStartedFrameSource.h"
+#include "CNSDKGettingStartedImageCache.h"
+#include "CNSDKGettingStartedMathExpr.h"
+#include "CNSDKGettingStartedNullBackend.h"
+#include "CNSDKGettingStartedScene.h"
+#include "CNSDKGettingStartedSoftwareBackend.h"
+#include "CNSDKGettingStartedThreadPool.h"
+#include "CNSDKGettingStartedViewInfo.h"
+#include "CNSDKGettingStartedViewInfoCache.h"
+#include "CNSDKGettingStartedViewLatch.h"
+
+namespace
+{
+    // Frames per second the loop simulates; the scene's animation advances by 1 / kFrameRate a frame.
+    const float kFrameRate = 60.0f;
+
+    // Stand-in for the display and its tracker. The face sways in front of the display, or with
+    // still set stays within tracker noise of one point. The two views sit an interpupillary
+    // distance apart around the face, scaled from millimeters to scene units.
+    class SimulatedDisplay
+    {
+    public:
+
+        SimulatedDisplay(int viewWidth, int viewHeight, bool still)
+            : m_aspectRatio((float)viewWidth / (float)viewHeight)
+            , m_still(still)
+        {
+        }
+
+        bool sampleViews(FrameViews& views)
+        {
+            const float kInterpupillaryDistance = 65.0f; // mm
+            const float kSceneUnitsPerMm        = 0.1f;
+
+            const float time = (float)m_frame++ / kFrameRate;
+
+            ViewInfoCacheKey key;
+            key.camera.mode                     = ViewInfoMode::Perspective;
+            key.camera.position                 = vec3f(0, 0, 0);
+            key.camera.direction                = vec3f(0, 1, 0);
+            key.camera.up                       = vec3f(0, 0, 1);
+            key.camera.perspectiveFieldOfView   = 90.0f * 3.14159f / 180.0f;
+            key.camera.perspectiveAspectRatio   = m_aspectRatio;
+            key.camera.nearPlane                = 1.0f;
+            key.camera.farPlane                 = 10000.0f;
+            key.camera.convergencePlaneDistance = 500.0f;
+            key.viewCount                       = 2;
+
+            vec3f facePosition;
+            if (m_still)
+            {
+                // Uniform noise of +-0.2 mm.
+                float noise[3];
+                for (float& n : noise)
+                {
+                    m_seed = m_seed * 1664525u + 1013904223u;
+                    n = 0.4f * ((float)(m_seed >> 8) / 16777216.0f - 0.5f);
+                }
+                facePosition = vec3f(noise[0], noise[1], 600.0f + noise[2]);
+            }
+            else
+                facePosition = vec3f(40.0f * sinf(1.3f * time), 10.0f * sinf(0.7f * time), 600.0f + 30.0f * sinf(0.4f * time));
+
+            for (int i = 0; i < 2; i++)
+                key.viewOffsets[i] = vec3f((facePosition.x + (i - 0.5f) * kInterpupillaryDistance) * kSceneUnitsPerMm, 0.0f, 0.0f);
+
+            vec3f viewPositions[2];
+            mat4f cameraProjections[2];
+            views.viewsReused = m_cache.find(key, viewPositions, cameraProjections);
+            if (!views.viewsReused)
+            {
+                GetViewInfos(key.camera, key.viewOffsets, 2, viewPositions, cameraProjections);
+                m_cache.insert(key, viewPositions, cameraProjections);
+            }
+
+            views.viewCount    = 2;
+            views.faceTracked  = true;
+            views.facePosition = facePosition;
+            for (int i = 0; i < 2; i++)
+            {
+                mat4f cameraTransform;
+                cameraTransform.lookAt(viewPositions[i], viewPositions[i] + key.camera.direction, key.camera.up);
+
+                views.viewPositions[i]   = viewPositions[i];
+                views.viewProjections[i] = cameraProjections[i] * MathExpr::Affine(cameraTransform);
+            }
+            return true;
+        }
+
+        ViewInfoCache::Stats getCacheStats() const { return m_cache.getStats(); }
+
+    private:
+
+        ViewInfoCache m_cache;
+        float         m_aspectRatio = 1.0f;
+        bool          m_still       = false;
+        int           m_frame       = 0;
+        std::uint32_t m_seed        = 1;
+    };
+
+    void PrintUsage()
+    {
+        printf("Usage: cnsdk_headless [--frames n] [--view-size width height] [--still] [--image file]...\n");
+        printf("                      [--print-frame] [--backend null|software] [--threads n] [--save prefix]\n");
+    }
+
+    // Write tightly packed RGBA8 rows, top to bottom, as an uncompressed 32-bit TGA.
+    bool SaveTGA(const std::string& fileName, const std::vector<std::uint8_t>& pixels, int width, int height)
+    {
+        FILE* file = fopen(fileName.c_str(), "wb");
+        if (file == nullptr)
+            return false;
+
+        std::uint8_t header[18] = {};
+        header[2]  = 2;    // Uncompressed true-color
+        header[12] = (std::uint8_t)(width & 0xFF);
+        header[13] = (std::uint8_t)(width >> 8);
+        header[14] = (std::uint8_t)(height & 0xFF);
+        header[15] = (std::uint8_t)(height >> 8);
+        header[16] = 32;
+        header[17] = 0x28; // 8 alpha bits, top-left origin
+        bool succeeded = (fwrite(header, 1, sizeof(header), file) == sizeof(header));
+
+        std::vector<std::uint8_t> row((size_t)width * 4);
+        for (int y = 0; (y < height) && succeeded; y++)
+        {
+            const std::uint8_t* src = &pixels[(size_t)y * width * 4];
+            for (int x = 0; x < width; x++)
+            {
+                row[x * 4 + 0] = src[x * 4 + 2];
+                row[x * 4 + 1] = src[x * 4 + 1];
+                row[x * 4 + 2] = src[x * 4 + 0];
+                row[x * 4 + 3] = src[x * 4 + 3];
+            }
+            succeeded = (fwrite(row.data(), 1, row.size(), file) == row.size());
+        }
+        return (fclose(file) == 0) && succeeded;
+    }
+
+    // Value at fraction p of sorted values.
+    double GetPercentile(const std::vector<double>& sorted, double p)
+    {
+        if (sorted.empty())
+            return 0.0;
+        const size_t index = std::min(sorted.size() - 1, (size_t)(p * (double)(sorted.size() - 1) + 0.5));
+        return sorted[index];
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int                      frameCount = 1000;
+    int                      viewWidth  = 1280;
+    int                      viewHeight = 800;
+    bool                     still      = false;
+    bool                     printFrame = false;
+    bool                     software   = false;
+    int                      threads    = 0;
+    std::string              savePrefix;
+    std::vector<std::string> images;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg     = argv[i];
+        const bool  hasNext = (i + 1 < argc);
+
+        if (strcmp(arg, "--frames") == 0 && hasNext)
+            frameCount = atoi(argv[++i]);
+        else if (strcmp(arg, "--view-size") == 0 && (i + 2 < argc))
+        {
+            viewWidth  = atoi(argv[++i]);
+            viewHeight = atoi(argv[++i]);
+        }
+        else if (strcmp(arg, "--still") == 0)
+            still = true;
+        else if (strcmp(arg, "--image") == 0 && hasNext)
+            images.push_back(argv[++i]);
+        else if (strcmp(arg, "--print-frame") == 0)
+            printFrame = true;
+        else if (strcmp(arg, "--backend") == 0 && hasNext && (strcmp(argv[i + 1], "null") == 0 || strcmp(argv[i + 1], "software") == 0))
+            software = (strcmp(argv[++i], "software") == 0);
+        else if (strcmp(arg, "--threads") == 0 && hasNext)
+            threads = atoi(argv[++i]);
+        else if (strcmp(arg, "--save") == 0 && hasNext)
+            savePrefix = argv[++i];
+        else
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+    if ((frameCount <= 0) || (viewWidth <= 0) || (viewHeight <= 0) || (threads < 0) || (!software && (!savePrefix.empty() || (threads != 0))))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    SceneSettings settings;
+    settings.demoMode   = images.empty() ? eDemoMode::Spinning3DCube : eDemoMode::StereoImage;
+    settings.viewWidth  = viewWidth;
+    settings.viewHeight = viewHeight;
+
+    // Stereo images are decoded ahead on workers, as in the sample.
+    std::unique_ptr<ThreadPool>        threadPool;
+    std::unique_ptr<ImageCache>        imageCache;
+    std::unique_ptr<StereoFrameSource> stereoImageSource;
+    if (settings.demoMode == eDemoMode::StereoImage)
+    {
+        threadPool        = std::make_unique<ThreadPool>();
+        imageCache        = std::make_unique<ImageCache>(512 * 1024 * 1024);
+        stereoImageSource = std::make_unique<StereoFrameSource>(*threadPool);
+        stereoImageSource->setImageCache(imageCache.get());
+        for (const std::string& image : images)
+            stereoImageSource->addImage(image);
+
+        if (!stereoImageSource->start(256 * 1024 * 1024) || !stereoImageSource->waitForCurrentFrame())
+        {
+            fprintf(stderr, "%ls\n", stereoImageSource->getError());
+            return 1;
+        }
+    }
+
+    // The software backend's back buffer is the size of the view atlas.
+    std::unique_ptr<ThreadPool>            rasterPool;
+    std::unique_ptr<SoftwareRenderBackend> softwareBackend;
+    NullRenderBackend                      nullBackend;
+    if (software)
+    {
+        if (threads != 1)
+            rasterPool = std::make_unique<ThreadPool>(threads);
+        softwareBackend = std::make_unique<SoftwareRenderBackend>(viewWidth * 2, viewHeight, settings.sRGB, rasterPool.get());
+    }
+
+    RenderBackend&    backend = software ? (RenderBackend&)*softwareBackend : nullBackend;
+    SimulatedDisplay  display(viewWidth, viewHeight, still);
+    ViewLatch         latch([&](FrameViews& views) { return display.sampleViews(views); });
+
+    bool succeeded = true;
+    {
+        StereoScene scene(backend, settings);
+        if (!scene.initializeOffscreenFrameBuffer() || !scene.loadScene(stereoImageSource.get()))
+        {
+            fprintf(stderr, "%ls\n", scene.getError());
+            return 1;
+        }
+
+        typedef std::chrono::steady_clock                  Clock;
+        typedef std::chrono::duration<double, std::micro> Microseconds;
+
+        std::vector<double> frameTimes;
+        frameTimes.reserve(frameCount);
+        for (int frame = 0; (frame < frameCount) && succeeded; frame++)
+        {
+            const Clock::time_point start = Clock::now();
+            succeeded = scene.render((float)frame / kFrameRate, latch);
+            frameTimes.push_back(Microseconds(Clock::now() - start).count());
+        }
+        if (!succeeded)
+            fprintf(stderr, "%ls\n", scene.getError());
+
+        if (printFrame && !software)
+            nullBackend.printFrame(stdout);
+
+        if (succeeded && !savePrefix.empty())
+        {
+            std::vector<std::uint8_t> pixels;
+            int                       width  = 0;
+            int                       height = 0;
+            for (int i = 0; i < 2; i++)
+            {
+                const std::string fileName = savePrefix + ((i == 0) ? "_atlas.tga" : "_interlaced.tga");
+                const RenderHandle target   = (i == 0) ? scene.getOffscreenTarget() : backend.getBackBuffer();
+                if (!softwareBackend->readPixels(target, pixels, width, height) || !SaveTGA(fileName, pixels, width, height))
+                {
+                    fprintf(stderr, "Failed to save %s\n", fileName.c_str());
+                    succeeded = false;
+                }
+            }
+        }
+
+        double total = 0.0;
+        for (double t : frameTimes)
+            total += t;
+        std::sort(frameTimes.begin(), frameTimes.end());
+
+        const ViewInfoCache::Stats cacheStats = display.getCacheStats();
+        const ViewLatch::Stats     latchStats = latch.getStats();
+
+        printf("%s, %d x %d views, %zu frames, %s backend\n", (settings.demoMode == eDemoMode::Spinning3DCube) ? "Spinning cube" : "Stereo images", viewWidth, viewHeight, frameTimes.size(),
+            software ? "software" : "null");
+        printf("Frame CPU time        mean %.2f us, min %.2f us, p50 %.2f us, p99 %.2f us, max %.2f us\n",
+            total / (double)frameTimes.size(), frameTimes.front(), GetPercentile(frameTimes, 0.5), GetPercentile(frameTimes, 0.99), frameTimes.back());
+        if (software)
+        {
+            const SoftwareRenderBackend::Stats backendStats = softwareBackend->getStats();
+            const double                       frames       = (double)std::max<std::uint64_t>(backendStats.frames, 1);
+            const double                       seconds      = 1e-6 * total;
+
+            printf("Rasterizer            %d threads, %.1f frames/s, %.0f triangles/s\n", (rasterPool != nullptr) ? rasterPool->getThreadCount() : 1, (double)frameTimes.size() / seconds,
+                (double)backendStats.triangles / seconds);
+            printf("Per frame             %.1f draws, %.1f triangles, %.1f rasterized, %.1f tiles\n",
+                (double)backendStats.draws / frames, (double)backendStats.triangles / frames, (double)backendStats.rasterized / frames, (double)backendStats.tileBatches / frames);
+        }
+        else
+        {
+            const NullRenderBackend::Stats backendStats = nullBackend.getStats();
+            const double                   frames       = (double)std::max<std::uint64_t>(backendStats.frames, 1);
+
+            printf("Commands per frame    %.1f, %.1f draws, %.1f triangles, %.0f bytes uploaded\n",
+                (double)backendStats.commands / frames, (double)backendStats.draws / frames, (double)backendStats.triangles / frames, (double)backendStats.uploadBytes / frames);
+        }
+        if (settings.demoMode == eDemoMode::Spinning3DCube)
+        {
+            printf("View info cache       %.1f%% hits\n", 100.0 * cacheStats.getHitRate());
+            printf("Pose age at submit    mean %.2f us, max %.2f us\n", 1e6 * latchStats.getMeanStaleness(), 1e6 * latchStats.maxStaleness);
+        }
+    }
+
+    if (backend.getError() != nullptr)
+    {
+        fprintf(stderr, "%ls\n", backend.getError());
+        return 1;
+    }
+    const int resourceCount = software ? softwareBackend->getResourceCount() : nullBackend.getResourceCount();
+    if (resourceCount != 0)
+    {
+        fprintf(stderr, "%d resources not destroyed\n", resourceCount);
+        return 1;
+    }
+    return succeeded ? 0 : 1;
+}
@@ -0,0 +1,226 @@
+#include <string.h>
+#include "CNSDKGettingStartedImageCache.h"
+#include "CNSDKGettingStartedTGA.h"
+
+namespace
+{
+    // XXH64 constants and round functions.
+    const std::uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+    const std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+    const std::uint64_t kPrime3 = 0x165667B19E3779F9ull;
+    const std::uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+    const std::uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+    // Decode parameters that are part of the cache key.
+    const std::uint32_t kDecodeTGAToRGBA8 = 1;
+
+    inline std::uint64_t RotateLeft(std::uint64_t value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    inline std::uint64_t Read64(const std::uint8_t* p)
+    {
+        std::uint64_t value;
+        memcpy(&value, p, 8);
+        return value;
+    }
+
+    inline std::uint32_t Read32(const std::uint8_t* p)
+    {
+        std::uint32_t value;
+        memcpy(&value, p, 4);
+        return value;
+    }
+
+    inline std::uint64_t Round(std::uint64_t accumulator, std::uint64_t input)
+    {
+        accumulator += input * kPrime2;
+        accumulator  = RotateLeft(accumulator, 31);
+        return accumulator * kPrime1;
+    }
+
+    inline std::uint64_t MergeRound(std::uint64_t accumulator, std::uint64_t value)
+    {
+        accumulator ^= Round(0, value);
+        return accumulator * kPrime1 + kPrime4;
+    }
+}
+
+std::uint64_t HashBytes(const void* data, size_t size, std::uint64_t seed)
+{
+    const std::uint8_t* p   = (const std::uint8_t*)data;
+    const std::uint8_t* end = p + size;
+    std::uint64_t       hash;
+
+    if (size >= 32)
+    {
+        // Four independent lanes over 32-byte stripes.
+        std::uint64_t v1 = seed + kPrime1 + kPrime2;
+        std::uint64_t v2 = seed + kPrime2;
+        std::uint64_t v3 = seed;
+        std::uint64_t v4 = seed - kPrime1;
+
+        const std::uint8_t* limit = end - 32;
+        do
+        {
+            v1 = Round(v1, Read64(p +  0));
+            v2 = Round(v2, Read64(p +  8));
+            v3 = Round(v3, Read64(p + 16));
+            v4 = Round(v4, Read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+        hash = MergeRound(hash, v1);
+        hash = MergeRound(hash, v2);
+        hash = MergeRound(hash, v3);
+        hash = MergeRound(hash, v4);
+    }
+    else
+    {
+        hash = seed + kPrime5;
+    }
+
+    hash += (std::uint64_t)size;
+
+    for (; p + 8 <= end; p += 8)
+    {
+        hash ^= Round(0, Read64(p));
+        hash  = RotateLeft(hash, 27) * kPrime1 + kPrime4;
+    }
+
+    if (p + 4 <= end)
+    {
+        hash ^= (std::uint64_t)Read32(p) * kPrime1;
+        hash  = RotateLeft(hash, 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+
+    for (; p < end; p++)
+    {
+        hash ^= (*p) * kPrime5;
+        hash  = RotateLeft(hash, 11) * kPrime1;
+    }
+
+    // Avalanche.
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+DecodedImageHandle ImageCache::find(const ImageCacheKey& key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    LookupMap::iterator it = m_lookup.find(key);
+    if (it == m_lookup.end())
+    {
+        m_stats.misses++;
+        return nullptr;
+    }
+
+    m_stats.hits++;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->image;
+}
+
+DecodedImageHandle ImageCache::insert(const ImageCacheKey& key, std::shared_ptr<DecodedImage> image)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    LookupMap::iterator it = m_lookup.find(key);
+    if (it != m_lookup.end())
+    {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return it->second->image;
+    }
+
+    const size_t bytes = image->pixels.size();
+    m_entries.push_front({ key, std::move(image), bytes });
+    m_lookup[key]  = m_entries.begin();
+    m_stats.bytes += bytes;
+
+    // The new image itself is kept in the returned handle even if it alone exceeds the budget.
+    DecodedImageHandle handle = m_entries.front().image;
+    trim();
+    return handle;
+}
+
+DecodedImageHandle ImageCache::getTGA(ByteSpan file, ThreadPool& pool, const wchar_t*& error)
+{
+    ImageCacheKey key;
+    key.contentHash  = HashBytes(file.data, file.size);
+    key.contentSize  = file.size;
+    key.decodeParams = kDecodeTGAToRGBA8;
+
+    DecodedImageHandle cached = find(key);
+    if (cached != nullptr)
+        return cached;
+
+    TGAParallelDecoder decoder(file, pool);
+    decoder.setOutputFormat(TGAOutputFormat::RGBA8);
+    if (!decoder.readHeader())
+    {
+        error = decoder.getError();
+        return nullptr;
+    }
+
+    std::shared_ptr<DecodedImage> image = std::make_shared<DecodedImage>();
+    image->width    = decoder.getWidth();
+    image->height   = decoder.getHeight();
+    image->rowPitch = decoder.getRowSize();
+    image->pixels.resize(image->rowPitch * image->height);
+    if (!decoder.decode(image->pixels.data(), image->rowPitch))
+    {
+        error = decoder.getError();
+        return nullptr;
+    }
+
+    return insert(key, std::move(image));
+}
+
+void ImageCache::setBudget(size_t byteBudget)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budget = byteBudget;
+    trim();
+}
+
+size_t ImageCache::getBudget() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budget;
+}
+
+void ImageCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.evictions += m_entries.size();
+    m_entries.clear();
+    m_lookup.clear();
+    m_stats.bytes = 0;
+}
+
+ImageCache::Stats ImageCache::getStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats   = m_stats;
+    stats.entries = m_entries.size();
+    return stats;
+}
+
+void ImageCache::trim()
+{
+    while ((m_stats.bytes > m_budget) && !m_entries.empty())
+    {
+        const Entry& oldest = m_entries.back();
+        m_stats.bytes -= oldest.bytes;
+        m_stats.evictions++;
+        m_lookup.erase(oldest.key);
+        m_entries.pop_back();
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stddef.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "CNSDKGettingStartedFile.h"
+
+class ThreadPool;
+
+// 64-bit XXH64 hash of a block of bytes.
+std::uint64_t HashBytes(const void* data, size_t size, std::uint64_t seed = 0);
+
+// Identifies a decoded image: what it was decoded from and how.
+struct ImageCacheKey
+{
+    std::uint64_t contentHash  = 0;
+    std::uint64_t contentSize  = 0;
+    std::uint32_t decodeParams = 0; // Decoder and output format
+
+    bool operator==(const ImageCacheKey& other) const
+    {
+        return (contentHash == other.contentHash) && (contentSize == other.contentSize) && (decodeParams == other.decodeParams);
+    }
+};
+
+// Tightly packed decoded image.
+struct DecodedImage
+{
+    int                       width    = 0;
+    int                       height   = 0;
+    size_t                    rowPitch = 0;
+    std::vector<std::uint8_t> pixels;
+};
+
+// Reference-counted handle. The pixels stay alive while any handle exists, even after eviction.
+typedef std::shared_ptr<const DecodedImage> DecodedImageHandle;
+
+// Cache of decoded images keyed by content hash and decode parameters, so reloading the same
+// asset (under any file name) skips decoding. Least recently used images are evicted once the
+// cached pixels exceed the byte budget. Thread-safe.
+class ImageCache
+{
+public:
+
+    struct Stats
+    {
+        std::uint64_t hits      = 0;
+        std::uint64_t misses    = 0;
+        std::uint64_t evictions = 0;
+        size_t        bytes     = 0;
+        size_t        entries   = 0;
+    };
+
+    explicit ImageCache(size_t byteBudget) : m_budget(byteBudget) {}
+
+    ImageCache(const ImageCache&) = delete;
+    ImageCache& operator=(const ImageCache&) = delete;
+
+    // Look up an image and mark it most recently used. Returns null on a miss.
+    DecodedImageHandle find(const ImageCacheKey& key);
+
+    // Add an image, evicting older ones to stay within budget. If the key is already present
+    // (two threads decoded the same image) the cached copy is kept and returned.
+    DecodedImageHandle insert(const ImageCacheKey& key, std::shared_ptr<DecodedImage> image);
+
+    // Decode TGA file contents to RGBA8 through the cache, in bands across the pool on a miss.
+    // Returns null if the image fails to decode, error says why.
+    DecodedImageHandle getTGA(ByteSpan file, ThreadPool& pool, const wchar_t*& error);
+
+    void   setBudget(size_t byteBudget);
+    size_t getBudget() const;
+    void   clear();
+
+    Stats getStats() const;
+
+private:
+
+    struct KeyHash
+    {
+        size_t operator()(const ImageCacheKey& key) const { return (size_t)(key.contentHash ^ (key.decodeParams * 0x9E3779B97F4A7C15ull)); }
+    };
+
+    struct Entry
+    {
+        ImageCacheKey      key;
+        DecodedImageHandle image;
+        size_t             bytes;
+    };
+
+    typedef std::list<Entry>                                                EntryList;
+    typedef std::unordered_map<ImageCacheKey, EntryList::iterator, KeyHash> LookupMap;
+
+    // Evict from the back until the budget is met. Called with m_mutex held.
+    void trim();
+
+    mutable std::mutex m_mutex;
+    EntryList          m_entries; // Most recently used first
+    LookupMap          m_lookup;
+    size_t             m_budget = 0;
+    Stats              m_stats;
+};
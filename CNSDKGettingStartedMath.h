@@ -1,8 +1,478 @@
 #pragma once
 
 #include <math.h>
+#include <string.h>
+
+// SIMD backend, chosen at compile time: SSE2 (plus AVX for mat4f products when the compiler
+// targets it) on x86, NEON on ARM, plain C++ otherwise. Define CNSDK_MATH_SCALAR to force the
+// plain C++ version. Every backend performs the same float operations in the same order as the
+// scalar code (multiplies and adds are never fused), so results are identical across backends.
+#if !defined(CNSDK_MATH_SCALAR) && (defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define CNSDK_MATH_SSE
+#if defined(__AVX__)
+#define CNSDK_MATH_AVX
+#endif
+#include <immintrin.h>
+#elif !defined(CNSDK_MATH_SCALAR) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define CNSDK_MATH_NEON
+#include <arm_neon.h>
+#endif
 
-#pragma pack(push,1)
+// mat3f and mat4f name their axes x, y, z, w through an anonymous struct of vectors, which GCC
+// rejects (the vectors have constructors). There only the indexed axes e[] are available, so
+// portable code uses those.
+#if defined(__GNUC__) && !defined(__clang__)
+#define CNSDK_MATH_AXIS_NAMES 0
+#else
+#define CNSDK_MATH_AXIS_NAMES 1
+#endif
+
+    // Four-lane register operations the math types are built on.
+    namespace MathSIMD
+    {
+#if defined(CNSDK_MATH_SSE)
+
+        typedef __m128 Vec4;
+
+        inline Vec4  Load(const float* p)              { return _mm_loadu_ps(p); }
+        inline void  Store(float* p, Vec4 v)           { _mm_storeu_ps(p, v); }
+        inline Vec4  Set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+        inline Vec4  Splat(float s)                    { return _mm_set1_ps(s); }
+        inline Vec4  Add(Vec4 a, Vec4 b)               { return _mm_add_ps(a, b); }
+        inline Vec4  Sub(Vec4 a, Vec4 b)               { return _mm_sub_ps(a, b); }
+        inline Vec4  Mul(Vec4 a, Vec4 b)               { return _mm_mul_ps(a, b); }
+        inline Vec4  Div(Vec4 a, Vec4 b)               { return _mm_div_ps(a, b); }
+        inline Vec4  Sqrt(Vec4 a)                      { return _mm_sqrt_ps(a); }
+        inline Vec4  Neg(Vec4 a)                       { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+        inline float GetX(Vec4 a)                      { return _mm_cvtss_f32(a); }
+        inline bool  AllEqual(Vec4 a, Vec4 b)          { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)) == 0xF; }
+
+        // Lanes i0..i3 of a.
+        template <int i0, int i1, int i2, int i3>
+        inline Vec4 Shuffle(Vec4 a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(i3, i2, i1, i0)); }
+
+        // Lanes i0, i1 of a then j0, j1 of b.
+        template <int i0, int i1, int j0, int j1>
+        inline Vec4 Shuffle2(Vec4 a, Vec4 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(j1, j0, i1, i0)); }
+
+        // Exactly three floats, w is zero. x and y move as one double through memcpy, reading the
+        // floats through a double pointer would break strict aliasing.
+        inline Vec4 Load3(const float* p)
+        {
+            double xy;
+            memcpy(&xy, p, sizeof(xy));
+            return _mm_movelh_ps(_mm_castpd_ps(_mm_load_sd(&xy)), _mm_load_ss(p + 2));
+        }
+
+        inline void Store3(float* p, Vec4 v)
+        {
+            double xy;
+            _mm_store_sd(&xy, _mm_castps_pd(v));
+            memcpy(p, &xy, sizeof(xy));
+            _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+        }
+
+        inline void Transpose(Vec4& r0, Vec4& r1, Vec4& r2, Vec4& r3)
+        {
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        }
+
+        // Masks from Less pick lanes in Select: a where set, b elsewhere. MoveMask packs lane i of a
+        // mask into bit i.
+        inline Vec4  Abs(Vec4 a)                       { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+        inline Vec4  Min(Vec4 a, Vec4 b)               { return _mm_min_ps(a, b); }
+        inline Vec4  Max(Vec4 a, Vec4 b)               { return _mm_max_ps(a, b); }
+        inline Vec4  Less(Vec4 a, Vec4 b)              { return _mm_cmplt_ps(a, b); }
+        inline Vec4  Select(Vec4 mask, Vec4 a, Vec4 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+        inline Vec4  Or(Vec4 a, Vec4 b)                { return _mm_or_ps(a, b); }
+        inline int   MoveMask(Vec4 mask)               { return _mm_movemask_ps(mask); }
+
+        // Nearest integer, ties to even, through int32 (so -0.25 rounds to +0).
+        inline Vec4  Round(Vec4 a)                     { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+        inline int   RoundToInt(float a)               { return _mm_cvtss_si32(_mm_set_ss(a)); }
+
+        // 2^n for integer n in [-126, 127], built in the exponent bits.
+        inline Vec4  Exp2i(Vec4 n)                     { return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127)), 23)); }
+
+        // p[0..3] - origin, subtracted in double and rounded to float.
+        inline Vec4 LoadRelative(const double* p, double origin)
+        {
+#if defined(CNSDK_MATH_AVX)
+            return _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(p), _mm256_set1_pd(origin)));
+#else
+            const __m128d o = _mm_set1_pd(origin);
+            return _mm_movelh_ps(_mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(p), o)), _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(p + 2), o)));
+#endif
+        }
+
+#elif defined(CNSDK_MATH_NEON)
+
+        typedef float32x4_t Vec4;
+
+        inline Vec4  Load(const float* p)              { return vld1q_f32(p); }
+        inline void  Store(float* p, Vec4 v)           { vst1q_f32(p, v); }
+        inline Vec4  Set(float x, float y, float z, float w) { const float e[4] = { x, y, z, w }; return vld1q_f32(e); }
+        inline Vec4  Splat(float s)                    { return vdupq_n_f32(s); }
+        inline Vec4  Add(Vec4 a, Vec4 b)               { return vaddq_f32(a, b); }
+        inline Vec4  Sub(Vec4 a, Vec4 b)               { return vsubq_f32(a, b); }
+        inline Vec4  Mul(Vec4 a, Vec4 b)               { return vmulq_f32(a, b); }
+        inline Vec4  Neg(Vec4 a)                       { return vnegq_f32(a); }
+        inline float GetX(Vec4 a)                      { return vgetq_lane_f32(a, 0); }
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+        inline Vec4  Div(Vec4 a, Vec4 b)               { return vdivq_f32(a, b); }
+        inline Vec4  Sqrt(Vec4 a)                      { return vsqrtq_f32(a); }
+#else
+        // ARMv7 NEON only has estimates, so divide and square root per lane to keep results exact.
+        inline Vec4  Div(Vec4 a, Vec4 b)               { float x[4], y[4]; vst1q_f32(x, a); vst1q_f32(y, b); return Set(x[0] / y[0], x[1] / y[1], x[2] / y[2], x[3] / y[3]); }
+        inline Vec4  Sqrt(Vec4 a)                      { float x[4]; vst1q_f32(x, a); return Set(sqrtf(x[0]), sqrtf(x[1]), sqrtf(x[2]), sqrtf(x[3])); }
+#endif
+
+        inline bool AllEqual(Vec4 a, Vec4 b)
+        {
+            const uint32x4_t equal = vceqq_f32(a, b);
+            const uint32x2_t both  = vand_u32(vget_low_u32(equal), vget_high_u32(equal));
+            return (vget_lane_u32(both, 0) & vget_lane_u32(both, 1)) != 0;
+        }
+
+        template <int i0, int i1, int i2, int i3>
+        inline Vec4 Shuffle(Vec4 a)
+        {
+            Vec4 r = vdupq_n_f32(vgetq_lane_f32(a, i0));
+            r = vsetq_lane_f32(vgetq_lane_f32(a, i1), r, 1);
+            r = vsetq_lane_f32(vgetq_lane_f32(a, i2), r, 2);
+            return vsetq_lane_f32(vgetq_lane_f32(a, i3), r, 3);
+        }
+
+        template <int i0, int i1, int j0, int j1>
+        inline Vec4 Shuffle2(Vec4 a, Vec4 b)
+        {
+            Vec4 r = vdupq_n_f32(vgetq_lane_f32(a, i0));
+            r = vsetq_lane_f32(vgetq_lane_f32(a, i1), r, 1);
+            r = vsetq_lane_f32(vgetq_lane_f32(b, j0), r, 2);
+            return vsetq_lane_f32(vgetq_lane_f32(b, j1), r, 3);
+        }
+
+        inline Vec4 Load3(const float* p)
+        {
+            return vcombine_f32(vld1_f32(p), vld1_lane_f32(p + 2, vdup_n_f32(0.0f), 0));
+        }
+
+        inline void Store3(float* p, Vec4 v)
+        {
+            vst1_f32(p, vget_low_f32(v));
+            vst1q_lane_f32(p + 2, v, 2);
+        }
+
+        inline void Transpose(Vec4& r0, Vec4& r1, Vec4& r2, Vec4& r3)
+        {
+            const float32x4x2_t t01 = vtrnq_f32(r0, r1);
+            const float32x4x2_t t23 = vtrnq_f32(r2, r3);
+            r0 = vcombine_f32(vget_low_f32(t01.val[0]),  vget_low_f32(t23.val[0]));
+            r1 = vcombine_f32(vget_low_f32(t01.val[1]),  vget_low_f32(t23.val[1]));
+            r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+            r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+        }
+
+        inline Vec4  Abs(Vec4 a)                       { return vabsq_f32(a); }
+        inline Vec4  Min(Vec4 a, Vec4 b)               { return vminq_f32(a, b); }
+        inline Vec4  Max(Vec4 a, Vec4 b)               { return vmaxq_f32(a, b); }
+        inline Vec4  Less(Vec4 a, Vec4 b)              { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+        inline Vec4  Select(Vec4 mask, Vec4 a, Vec4 b) { return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+        inline Vec4  Or(Vec4 a, Vec4 b)                { return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+
+        inline int MoveMask(Vec4 mask)
+        {
+            const uint32_t   weights[4] = { 1, 2, 4, 8 };
+            const uint32x4_t bits       = vandq_u32(vreinterpretq_u32_f32(mask), vld1q_u32(weights));
+#if defined(__aarch64__) || defined(_M_ARM64)
+            return (int)vaddvq_u32(bits);
+#else
+            const uint32x2_t sum = vpadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+            return (int)vget_lane_u32(vpadd_u32(sum, sum), 0);
+#endif
+        }
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+        inline Vec4  Round(Vec4 a)                     { return vcvtq_f32_s32(vcvtnq_s32_f32(a)); }
+        inline int   RoundToInt(float a)               { return vcvtns_s32_f32(a); }
+#else
+        inline Vec4  Round(Vec4 a)                     { float x[4]; vst1q_f32(x, a); return Set((float)lrintf(x[0]), (float)lrintf(x[1]), (float)lrintf(x[2]), (float)lrintf(x[3])); }
+        inline int   RoundToInt(float a)               { return (int)lrintf(a); }
+#endif
+
+        inline Vec4  Exp2i(Vec4 n)                     { return vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127)), 23)); }
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+        inline Vec4 LoadRelative(const double* p, double origin)
+        {
+            const float64x2_t o = vdupq_n_f64(origin);
+            return vcvt_high_f32_f64(vcvt_f32_f64(vsubq_f64(vld1q_f64(p), o)), vsubq_f64(vld1q_f64(p + 2), o));
+        }
+#else
+        // ARMv7 NEON has no double lanes.
+        inline Vec4 LoadRelative(const double* p, double origin)
+        {
+            return Set((float)(p[0] - origin), (float)(p[1] - origin), (float)(p[2] - origin), (float)(p[3] - origin));
+        }
+#endif
+
+#else
+
+        struct Vec4
+        {
+            float e[4];
+        };
+
+        inline Vec4  Load(const float* p)              { return Vec4{ { p[0], p[1], p[2], p[3] } }; }
+        inline void  Store(float* p, Vec4 v)           { p[0] = v.e[0]; p[1] = v.e[1]; p[2] = v.e[2]; p[3] = v.e[3]; }
+        inline Vec4  Set(float x, float y, float z, float w) { return Vec4{ { x, y, z, w } }; }
+        inline Vec4  Splat(float s)                    { return Vec4{ { s, s, s, s } }; }
+        inline Vec4  Add(Vec4 a, Vec4 b)               { return Vec4{ { a.e[0] + b.e[0], a.e[1] + b.e[1], a.e[2] + b.e[2], a.e[3] + b.e[3] } }; }
+        inline Vec4  Sub(Vec4 a, Vec4 b)               { return Vec4{ { a.e[0] - b.e[0], a.e[1] - b.e[1], a.e[2] - b.e[2], a.e[3] - b.e[3] } }; }
+        inline Vec4  Mul(Vec4 a, Vec4 b)               { return Vec4{ { a.e[0] * b.e[0], a.e[1] * b.e[1], a.e[2] * b.e[2], a.e[3] * b.e[3] } }; }
+        inline Vec4  Div(Vec4 a, Vec4 b)               { return Vec4{ { a.e[0] / b.e[0], a.e[1] / b.e[1], a.e[2] / b.e[2], a.e[3] / b.e[3] } }; }
+        inline Vec4  Sqrt(Vec4 a)                      { return Vec4{ { sqrtf(a.e[0]), sqrtf(a.e[1]), sqrtf(a.e[2]), sqrtf(a.e[3]) } }; }
+        inline Vec4  Neg(Vec4 a)                       { return Vec4{ { -a.e[0], -a.e[1], -a.e[2], -a.e[3] } }; }
+        inline float GetX(Vec4 a)                      { return a.e[0]; }
+        inline bool  AllEqual(Vec4 a, Vec4 b)          { return (a.e[0] == b.e[0]) && (a.e[1] == b.e[1]) && (a.e[2] == b.e[2]) && (a.e[3] == b.e[3]); }
+
+        template <int i0, int i1, int i2, int i3>
+        inline Vec4 Shuffle(Vec4 a) { return Vec4{ { a.e[i0], a.e[i1], a.e[i2], a.e[i3] } }; }
+
+        template <int i0, int i1, int j0, int j1>
+        inline Vec4 Shuffle2(Vec4 a, Vec4 b) { return Vec4{ { a.e[i0], a.e[i1], b.e[j0], b.e[j1] } }; }
+
+        inline Vec4 Load3(const float* p)              { return Vec4{ { p[0], p[1], p[2], 0.0f } }; }
+        inline void Store3(float* p, Vec4 v)           { p[0] = v.e[0]; p[1] = v.e[1]; p[2] = v.e[2]; }
+
+        inline void Transpose(Vec4& r0, Vec4& r1, Vec4& r2, Vec4& r3)
+        {
+            const Vec4 a = r0, b = r1, c = r2, d = r3;
+            r0 = Vec4{ { a.e[0], b.e[0], c.e[0], d.e[0] } };
+            r1 = Vec4{ { a.e[1], b.e[1], c.e[1], d.e[1] } };
+            r2 = Vec4{ { a.e[2], b.e[2], c.e[2], d.e[2] } };
+            r3 = Vec4{ { a.e[3], b.e[3], c.e[3], d.e[3] } };
+        }
+
+        // Masks are 1.0f where set.
+        inline Vec4  Abs(Vec4 a)                       { return Vec4{ { fabsf(a.e[0]), fabsf(a.e[1]), fabsf(a.e[2]), fabsf(a.e[3]) } }; }
+        inline Vec4  Min(Vec4 a, Vec4 b)               { return Vec4{ { (a.e[0] < b.e[0]) ? a.e[0] : b.e[0], (a.e[1] < b.e[1]) ? a.e[1] : b.e[1], (a.e[2] < b.e[2]) ? a.e[2] : b.e[2], (a.e[3] < b.e[3]) ? a.e[3] : b.e[3] } }; }
+        inline Vec4  Max(Vec4 a, Vec4 b)               { return Vec4{ { (a.e[0] > b.e[0]) ? a.e[0] : b.e[0], (a.e[1] > b.e[1]) ? a.e[1] : b.e[1], (a.e[2] > b.e[2]) ? a.e[2] : b.e[2], (a.e[3] > b.e[3]) ? a.e[3] : b.e[3] } }; }
+        inline Vec4  Less(Vec4 a, Vec4 b)              { return Vec4{ { (a.e[0] < b.e[0]) ? 1.0f : 0.0f, (a.e[1] < b.e[1]) ? 1.0f : 0.0f, (a.e[2] < b.e[2]) ? 1.0f : 0.0f, (a.e[3] < b.e[3]) ? 1.0f : 0.0f } }; }
+        inline Vec4  Select(Vec4 mask, Vec4 a, Vec4 b) { return Vec4{ { mask.e[0] ? a.e[0] : b.e[0], mask.e[1] ? a.e[1] : b.e[1], mask.e[2] ? a.e[2] : b.e[2], mask.e[3] ? a.e[3] : b.e[3] } }; }
+        inline Vec4  Or(Vec4 a, Vec4 b)                { return Vec4{ { (a.e[0] || b.e[0]) ? 1.0f : 0.0f, (a.e[1] || b.e[1]) ? 1.0f : 0.0f, (a.e[2] || b.e[2]) ? 1.0f : 0.0f, (a.e[3] || b.e[3]) ? 1.0f : 0.0f } }; }
+        inline int   MoveMask(Vec4 mask)               { return (mask.e[0] ? 1 : 0) | (mask.e[1] ? 2 : 0) | (mask.e[2] ? 4 : 0) | (mask.e[3] ? 8 : 0); }
+        inline Vec4  Round(Vec4 a)                     { return Vec4{ { (float)lrintf(a.e[0]), (float)lrintf(a.e[1]), (float)lrintf(a.e[2]), (float)lrintf(a.e[3]) } }; }
+        inline int   RoundToInt(float a)               { return (int)lrintf(a); }
+        inline Vec4  Exp2i(Vec4 n)                     { return Vec4{ { ldexpf(1.0f, (int)n.e[0]), ldexpf(1.0f, (int)n.e[1]), ldexpf(1.0f, (int)n.e[2]), ldexpf(1.0f, (int)n.e[3]) } }; }
+        inline Vec4  LoadRelative(const double* p, double origin) { return Vec4{ { (float)(p[0] - origin), (float)(p[1] - origin), (float)(p[2] - origin), (float)(p[3] - origin) } }; }
+
+#endif
+
+        // a * b + c, as a separate multiply and add.
+        inline Vec4 MulAdd(Vec4 a, Vec4 b, Vec4 c) { return Add(Mul(a, b), c); }
+
+        template <int i>
+        inline Vec4 SplatLane(Vec4 a) { return Shuffle<i, i, i, i>(a); }
+
+        // x * x + y * y + z * z in every lane, summed in that order.
+        inline Vec4 Dot3(Vec4 a, Vec4 b)
+        {
+            const Vec4 p = Mul(a, b);
+            return Add(Add(SplatLane<0>(p), SplatLane<1>(p)), SplatLane<2>(p));
+        }
+
+        // Sum of the four lane products in every lane.
+        inline Vec4 Dot4(Vec4 a, Vec4 b)
+        {
+            const Vec4 p = Mul(a, b);
+            const Vec4 s = Add(p, Shuffle<1, 0, 3, 2>(p));
+            return Add(s, Shuffle<2, 3, 0, 1>(s));
+        }
+
+        inline Vec4 Cross3(Vec4 a, Vec4 b)
+        {
+            return Sub(Mul(Shuffle<1, 2, 0, 3>(a), Shuffle<2, 0, 1, 3>(b)), Mul(Shuffle<2, 0, 1, 3>(a), Shuffle<1, 2, 0, 3>(b)));
+        }
+
+        // Same as vec3f::getNormal().
+        inline Vec4 Normalize3(Vec4 a)
+        {
+            const Vec4 length = Sqrt(Dot3(a, a));
+            return (GetX(length) > 0.0f) ? Mul(a, Div(Splat(1.0f), length)) : Splat(0.0f);
+        }
+
+        // Column-major 4x4 product out = a * b. out may not alias a or b.
+        inline void Mat4Mul(float* out, const float* a, const float* b)
+        {
+#if defined(CNSDK_MATH_AVX)
+            // Two result columns per step, each 128-bit lane broadcasting from its own column of b.
+            const __m256 a0 = _mm256_broadcast_ps((const __m128*)(a + 0));
+            const __m256 a1 = _mm256_broadcast_ps((const __m128*)(a + 4));
+            const __m256 a2 = _mm256_broadcast_ps((const __m128*)(a + 8));
+            const __m256 a3 = _mm256_broadcast_ps((const __m128*)(a + 12));
+            for (int j = 0; j < 16; j += 8)
+            {
+                const __m256 c = _mm256_loadu_ps(b + j);
+                __m256 r = _mm256_mul_ps(a0, _mm256_permute_ps(c, 0x00));
+                r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_permute_ps(c, 0x55)));
+                r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_permute_ps(c, 0xAA)));
+                r = _mm256_add_ps(r, _mm256_mul_ps(a3, _mm256_permute_ps(c, 0xFF)));
+                _mm256_storeu_ps(out + j, r);
+            }
+#else
+            const Vec4 a0 = Load(a + 0);
+            const Vec4 a1 = Load(a + 4);
+            const Vec4 a2 = Load(a + 8);
+            const Vec4 a3 = Load(a + 12);
+            for (int j = 0; j < 16; j += 4)
+            {
+                const Vec4 c = Load(b + j);
+                Vec4 r = Mul(a0, SplatLane<0>(c));
+                r = MulAdd(a1, SplatLane<1>(c), r);
+                r = MulAdd(a2, SplatLane<2>(c), r);
+                r = MulAdd(a3, SplatLane<3>(c), r);
+                Store(out + j, r);
+            }
+#endif
+        }
+
+        // Mat4Mul for b with last row 0 0 0 1, skipping the products with its zero w components.
+        // Same results, up to the sign of zero elements. out may not alias a or b.
+        inline void Mat4MulAffine(float* out, const float* a, const float* b)
+        {
+#if defined(CNSDK_MATH_AVX)
+            const __m256 a0 = _mm256_broadcast_ps((const __m128*)(a + 0));
+            const __m256 a1 = _mm256_broadcast_ps((const __m128*)(a + 4));
+            const __m256 a2 = _mm256_broadcast_ps((const __m128*)(a + 8));
+            const __m256 t  = _mm256_insertf128_ps(_mm256_setzero_ps(), _mm_loadu_ps(a + 12), 1);
+            for (int j = 0; j < 16; j += 8)
+            {
+                const __m256 c = _mm256_loadu_ps(b + j);
+                __m256 r = _mm256_mul_ps(a0, _mm256_permute_ps(c, 0x00));
+                r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_permute_ps(c, 0x55)));
+                r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_permute_ps(c, 0xAA)));
+                _mm256_storeu_ps(out + j, (j == 8) ? _mm256_add_ps(r, t) : r);
+            }
+#else
+            const Vec4 a0 = Load(a + 0);
+            const Vec4 a1 = Load(a + 4);
+            const Vec4 a2 = Load(a + 8);
+            const Vec4 a3 = Load(a + 12);
+            for (int j = 0; j < 16; j += 4)
+            {
+                const Vec4 c = Load(b + j);
+                Vec4 r = Mul(a0, SplatLane<0>(c));
+                r = MulAdd(a1, SplatLane<1>(c), r);
+                r = MulAdd(a2, SplatLane<2>(c), r);
+                Store(out + j, (j == 12) ? Add(r, a3) : r);
+            }
+#endif
+        }
+
+        // Column-major 3x3 product out = a * b. out may not alias a or b.
+        inline void Mat3Mul(float* out, const float* a, const float* b)
+        {
+            const Vec4 a0 = Load3(a + 0);
+            const Vec4 a1 = Load3(a + 3);
+            const Vec4 a2 = Load3(a + 6);
+            for (int j = 0; j < 9; j += 3)
+            {
+                Vec4 r = Mul(a0, Splat(b[j]));
+                r = MulAdd(a1, Splat(b[j + 1]), r);
+                r = MulAdd(a2, Splat(b[j + 2]), r);
+                Store3(out + j, r);
+            }
+        }
+
+        // Column-major 4x4 inverse by cofactors, from the 2x2 determinants of the first two and
+        // last two columns. Returns the determinant; out is all zero if it is zero. out may be m.
+        inline float Mat4Inverse(float* out, const float* m)
+        {
+            const Vec4 c0 = Load(m + 0);
+            const Vec4 c1 = Load(m + 4);
+            const Vec4 c2 = Load(m + 8);
+            const Vec4 c3 = Load(m + 12);
+
+            // a0..a5 from columns 0 and 1, b0..b5 from columns 2 and 3:
+            // (row 0, 1) (0, 2) (0, 3) (1, 2) (1, 3) (2, 3).
+            const Vec4 a03 = Sub(Mul(Shuffle<0, 0, 0, 1>(c0), Shuffle<1, 2, 3, 2>(c1)), Mul(Shuffle<1, 2, 3, 2>(c0), Shuffle<0, 0, 0, 1>(c1)));
+            const Vec4 a45 = Sub(Mul(Shuffle<1, 2, 1, 2>(c0), Shuffle<3, 3, 3, 3>(c1)), Mul(Shuffle<3, 3, 3, 3>(c0), Shuffle<1, 2, 1, 2>(c1)));
+            const Vec4 b03 = Sub(Mul(Shuffle<0, 0, 0, 1>(c2), Shuffle<1, 2, 3, 2>(c3)), Mul(Shuffle<1, 2, 3, 2>(c2), Shuffle<0, 0, 0, 1>(c3)));
+            const Vec4 b45 = Sub(Mul(Shuffle<1, 2, 1, 2>(c2), Shuffle<3, 3, 3, 3>(c3)), Mul(Shuffle<3, 3, 3, 3>(c2), Shuffle<1, 2, 1, 2>(c3)));
+
+            // sk = (bk, bk, ak, ak): the first two output rows use b, the last two a.
+            const Vec4 s0 = Shuffle2<0, 0, 0, 0>(b03, a03);
+            const Vec4 s1 = Shuffle2<1, 1, 1, 1>(b03, a03);
+            const Vec4 s2 = Shuffle2<2, 2, 2, 2>(b03, a03);
+            const Vec4 s3 = Shuffle2<3, 3, 3, 3>(b03, a03);
+            const Vec4 s4 = Shuffle2<0, 0, 0, 0>(b45, a45);
+            const Vec4 s5 = Shuffle2<1, 1, 1, 1>(b45, a45);
+
+            // rj = row j of columns 1, 0, 3, 2.
+            Vec4 r0 = c1, r1 = c0, r2 = c3, r3 = c2;
+            Transpose(r0, r1, r2, r3);
+
+            const Vec4 even = Set(1.0f, -1.0f, 1.0f, -1.0f);
+            const Vec4 odd  = Set(-1.0f, 1.0f, -1.0f, 1.0f);
+            const Vec4 i0 = Mul(Add(Sub(Mul(r1, s5), Mul(r2, s4)), Mul(r3, s3)), even);
+            const Vec4 i1 = Mul(Add(Sub(Mul(r0, s5), Mul(r2, s2)), Mul(r3, s1)), odd);
+            const Vec4 i2 = Mul(Add(Sub(Mul(r0, s4), Mul(r1, s2)), Mul(r3, s0)), even);
+            const Vec4 i3 = Mul(Add(Sub(Mul(r0, s3), Mul(r1, s1)), Mul(r2, s0)), odd);
+
+            // Row 0 of m dotted with column 0 of the adjugate.
+            const Vec4 det = Dot4(Shuffle<1, 0, 3, 2>(r0), i0);
+            if (GetX(det) == 0.0f)
+            {
+                const Vec4 zero = Splat(0.0f);
+                Store(out + 0, zero);
+                Store(out + 4, zero);
+                Store(out + 8, zero);
+                Store(out + 12, zero);
+                return 0.0f;
+            }
+
+            const Vec4 invDet = Div(Splat(1.0f), det);
+            Store(out + 0, Mul(i0, invDet));
+            Store(out + 4, Mul(i1, invDet));
+            Store(out + 8, Mul(i2, invDet));
+            Store(out + 12, Mul(i3, invDet));
+            return GetX(det);
+        }
+    }
+
+#include "CNSDKGettingStartedFastMath.h"
+
+    // Trig used by the math types: the C library, or the FastMath approximations when
+    // CNSDK_MATH_FAST_TRIG is defined.
+    inline void MathSinCos(float angle, float& s, float& c)
+    {
+#if defined(CNSDK_MATH_FAST_TRIG)
+        FastMath::SinCos(angle, s, c);
+#else
+        s = sinf(angle);
+        c = cosf(angle);
+#endif
+    }
+
+    inline float MathSin(float angle)
+    {
+#if defined(CNSDK_MATH_FAST_TRIG)
+        return FastMath::Sin(angle);
+#else
+        return sinf(angle);
+#endif
+    }
+
+    inline float MathTan(float angle)
+    {
+#if defined(CNSDK_MATH_FAST_TRIG)
+        return FastMath::Tan(angle);
+#else
+        return tanf(angle);
+#endif
+    }
 
     struct vec2f
     {
@@ -17,8 +487,8 @@
         vec2f() = default;
 
         // Constructors
-        explicit vec2f(float xy) : x(xy), y(xy) {}
-        explicit vec2f(float _x, float _y) : x(_x), y(_y) {}
+        constexpr explicit vec2f(float xy) : x(xy), y(xy) {}
+        constexpr explicit vec2f(float _x, float _y) : x(_x), y(_y) {}
     };
 
     struct vec3f
@@ -36,54 +506,54 @@
 
 
         // Constructors
-        explicit vec3f (float xyz) : x(xyz), y(xyz), z(xyz) {}
-        explicit vec3f (float _x, float _y, float _z) : x(_x), y(_y), z(_z) {}
-        explicit vec3f (const vec2f& xy, float _z) : x(xy.x), y(xy.y), z(_z) {}
+        constexpr explicit vec3f (float xyz) : x(xyz), y(xyz), z(xyz) {}
+        constexpr explicit vec3f (float _x, float _y, float _z) : x(_x), y(_y), z(_z) {}
+        constexpr explicit vec3f (const vec2f& xy, float _z) : x(xy.x), y(xy.y), z(_z) {}
 
         // Binary operators
-        friend vec3f operator+ (const vec3f& lhs, float rhs)        { return vec3f(lhs.x + rhs, lhs.y + rhs, lhs.z + rhs); }
-        friend vec3f operator- (const vec3f& lhs, float rhs)        { return vec3f(lhs.x - rhs, lhs.y - rhs, lhs.z - rhs); }
-        friend vec3f operator* (const vec3f& lhs, float rhs)        { return vec3f(lhs.x * rhs, lhs.y * rhs, lhs.z * rhs); }
-        friend vec3f operator/ (const vec3f& lhs, float rhs)        { const float InvRHS = 1.0f / rhs; return vec3f(lhs.x * InvRHS, lhs.y * InvRHS, lhs.z * InvRHS); }
-        friend vec3f operator+ (float lhs, const vec3f& rhs)        { return vec3f(lhs + rhs.x, lhs + rhs.y, lhs + rhs.z); }
-        friend vec3f operator- (float lhs, const vec3f& rhs)        { return vec3f(lhs - rhs.x, lhs - rhs.y, lhs - rhs.z); }
-        friend vec3f operator* (float lhs, const vec3f& rhs)        { return vec3f(lhs * rhs.x, lhs * rhs.y, lhs * rhs.z); }
-        friend vec3f operator/ (float lhs, const vec3f& rhs)        { return vec3f(lhs / rhs.x, lhs / rhs.y, lhs / rhs.z); }
-        friend vec3f operator+ (const vec3f& lhs, const vec3f& rhs) { return vec3f(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z); }
-        friend vec3f operator- (const vec3f& lhs, const vec3f& rhs) { return vec3f(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z); }
-        friend vec3f operator* (const vec3f& lhs, const vec3f& rhs) { return vec3f(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z); }
-        friend vec3f operator/ (const vec3f& lhs, const vec3f& rhs) { return vec3f(lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z); }
-        friend bool operator<  (const vec3f& lhs, const vec3f& rhs) { return (lhs.x <  rhs.x) && (lhs.y <  rhs.y) && (lhs.z <  rhs.z); }
-        friend bool operator<  (const vec3f& lhs, float rhs)        { return (lhs.x <  rhs)   && (lhs.y <  rhs)   && (lhs.z <  rhs); }
-        friend bool operator<= (const vec3f& lhs, const vec3f& rhs) { return (lhs.x <= rhs.x) && (lhs.y <= rhs.y) && (lhs.z <= rhs.z); }
-        friend bool operator<= (const vec3f& lhs, float rhs)        { return (lhs.x <= rhs)   && (lhs.y <= rhs)   && (lhs.z <= rhs); }
-        friend bool operator>  (const vec3f& lhs, const vec3f& rhs) { return (lhs.x >  rhs.x) && (lhs.y >  rhs.y) && (lhs.z >  rhs.z); }
-        friend bool operator>  (const vec3f& lhs, float rhs)        { return (lhs.x >  rhs)   && (lhs.y >  rhs)   && (lhs.z >  rhs); }
-        friend bool operator>= (const vec3f& lhs, const vec3f& rhs) { return (lhs.x >= rhs.x) && (lhs.y >= rhs.y) && (lhs.z >= rhs.z); }
-        friend bool operator>= (const vec3f& lhs, float rhs)        { return (lhs.x >= rhs)   && (lhs.y >= rhs)   && (lhs.z >= rhs); }
+        friend constexpr vec3f operator+ (const vec3f& lhs, float rhs)        { return vec3f(lhs.x + rhs, lhs.y + rhs, lhs.z + rhs); }
+        friend constexpr vec3f operator- (const vec3f& lhs, float rhs)        { return vec3f(lhs.x - rhs, lhs.y - rhs, lhs.z - rhs); }
+        friend constexpr vec3f operator* (const vec3f& lhs, float rhs)        { return vec3f(lhs.x * rhs, lhs.y * rhs, lhs.z * rhs); }
+        friend constexpr vec3f operator/ (const vec3f& lhs, float rhs)        { const float InvRHS = 1.0f / rhs; return vec3f(lhs.x * InvRHS, lhs.y * InvRHS, lhs.z * InvRHS); }
+        friend constexpr vec3f operator+ (float lhs, const vec3f& rhs)        { return vec3f(lhs + rhs.x, lhs + rhs.y, lhs + rhs.z); }
+        friend constexpr vec3f operator- (float lhs, const vec3f& rhs)        { return vec3f(lhs - rhs.x, lhs - rhs.y, lhs - rhs.z); }
+        friend constexpr vec3f operator* (float lhs, const vec3f& rhs)        { return vec3f(lhs * rhs.x, lhs * rhs.y, lhs * rhs.z); }
+        friend constexpr vec3f operator/ (float lhs, const vec3f& rhs)        { return vec3f(lhs / rhs.x, lhs / rhs.y, lhs / rhs.z); }
+        friend constexpr vec3f operator+ (const vec3f& lhs, const vec3f& rhs) { return vec3f(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z); }
+        friend constexpr vec3f operator- (const vec3f& lhs, const vec3f& rhs) { return vec3f(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z); }
+        friend constexpr vec3f operator* (const vec3f& lhs, const vec3f& rhs) { return vec3f(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z); }
+        friend constexpr vec3f operator/ (const vec3f& lhs, const vec3f& rhs) { return vec3f(lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z); }
+        friend constexpr bool operator<  (const vec3f& lhs, const vec3f& rhs) { return (lhs.x <  rhs.x) && (lhs.y <  rhs.y) && (lhs.z <  rhs.z); }
+        friend constexpr bool operator<  (const vec3f& lhs, float rhs)        { return (lhs.x <  rhs)   && (lhs.y <  rhs)   && (lhs.z <  rhs); }
+        friend constexpr bool operator<= (const vec3f& lhs, const vec3f& rhs) { return (lhs.x <= rhs.x) && (lhs.y <= rhs.y) && (lhs.z <= rhs.z); }
+        friend constexpr bool operator<= (const vec3f& lhs, float rhs)        { return (lhs.x <= rhs)   && (lhs.y <= rhs)   && (lhs.z <= rhs); }
+        friend constexpr bool operator>  (const vec3f& lhs, const vec3f& rhs) { return (lhs.x >  rhs.x) && (lhs.y >  rhs.y) && (lhs.z >  rhs.z); }
+        friend constexpr bool operator>  (const vec3f& lhs, float rhs)        { return (lhs.x >  rhs)   && (lhs.y >  rhs)   && (lhs.z >  rhs); }
+        friend constexpr bool operator>= (const vec3f& lhs, const vec3f& rhs) { return (lhs.x >= rhs.x) && (lhs.y >= rhs.y) && (lhs.z >= rhs.z); }
+        friend constexpr bool operator>= (const vec3f& lhs, float rhs)        { return (lhs.x >= rhs)   && (lhs.y >= rhs)   && (lhs.z >= rhs); }
 
         // Singular operators
-        float  operator[](int index) const        { return e[index]; }
-        float& operator[](int index)              { return e[index]; }
-        bool   operator==(const vec3f& rhs) const { return (x == rhs.x) && (y == rhs.y) && (z == rhs.z); }
-        bool   operator!=(const vec3f& rhs) const { return (x != rhs.x) || (y != rhs.y) || (z != rhs.z); }
-        vec3f& operator+=(const vec3f& rhs)       { x += rhs.x; y += rhs.y; z += rhs.z; return *this; }
-        vec3f& operator-=(const vec3f& rhs)       { x -= rhs.x; y -= rhs.y; z -= rhs.z; return *this; }
-        vec3f& operator*=(const vec3f& rhs)       { x *= rhs.x; y *= rhs.y; z *= rhs.z; return *this; }
-        vec3f& operator/=(const vec3f& rhs)       { x /= rhs.x; y /= rhs.y; z /= rhs.z; return *this; }
-        vec3f& operator+=(float rhs)              { x += rhs; y += rhs; z += rhs; return *this; }
-        vec3f& operator-=(float rhs)              { x -= rhs; y -= rhs; z -= rhs; return *this; }
-        vec3f& operator*=(float rhs)              { x *= rhs; y *= rhs; z *= rhs; return *this; }
-        vec3f& operator/=(float rhs)              { const float InvRHS = 1.0f / rhs;  x *= InvRHS; y *= InvRHS; z *= InvRHS; return *this; }
+                  float  operator[](int index) const        { return e[index]; }
+                  float& operator[](int index)              { return e[index]; }
+        constexpr bool   operator==(const vec3f& rhs) const { return (x == rhs.x) && (y == rhs.y) && (z == rhs.z); }
+        constexpr bool   operator!=(const vec3f& rhs) const { return (x != rhs.x) || (y != rhs.y) || (z != rhs.z); }
+        constexpr vec3f& operator+=(const vec3f& rhs)       { x += rhs.x; y += rhs.y; z += rhs.z; return *this; }
+        constexpr vec3f& operator-=(const vec3f& rhs)       { x -= rhs.x; y -= rhs.y; z -= rhs.z; return *this; }
+        constexpr vec3f& operator*=(const vec3f& rhs)       { x *= rhs.x; y *= rhs.y; z *= rhs.z; return *this; }
+        constexpr vec3f& operator/=(const vec3f& rhs)       { x /= rhs.x; y /= rhs.y; z /= rhs.z; return *this; }
+        constexpr vec3f& operator+=(float rhs)              { x += rhs; y += rhs; z += rhs; return *this; }
+        constexpr vec3f& operator-=(float rhs)              { x -= rhs; y -= rhs; z -= rhs; return *this; }
+        constexpr vec3f& operator*=(float rhs)              { x *= rhs; y *= rhs; z *= rhs; return *this; }
+        constexpr vec3f& operator/=(float rhs)              { const float InvRHS = 1.0f / rhs;  x *= InvRHS; y *= InvRHS; z *= InvRHS; return *this; }
 
         // Unary operators
-        vec3f operator-() const { return vec3f(-x, -y, -z); };
+        constexpr vec3f operator-() const { return vec3f(-x, -y, -z); };
 
         // Static methods
-        static vec3f cross (const vec3f& lhs, const vec3f& rhs) { return vec3f(lhs.y * rhs.z - lhs.z * rhs.y, lhs.z * rhs.x - lhs.x * rhs.z, lhs.x * rhs.y - lhs.y * rhs.x); }
-        static float dot   (const vec3f& lhs, const vec3f& rhs) { return (lhs.x * rhs.x) + (lhs.y * rhs.y) + (lhs.z * rhs.z); }
+        static constexpr vec3f cross (const vec3f& lhs, const vec3f& rhs) { return vec3f(lhs.y * rhs.z - lhs.z * rhs.y, lhs.z * rhs.x - lhs.x * rhs.z, lhs.x * rhs.y - lhs.y * rhs.x); }
+        static constexpr float dot   (const vec3f& lhs, const vec3f& rhs) { return (lhs.x * rhs.x) + (lhs.y * rhs.y) + (lhs.z * rhs.z); }
 
-        float getLengthSq() const
+        constexpr float getLengthSq() const
         {
             return (x * x) + (y * y) + (z * z);
         }
@@ -143,10 +613,9 @@
 
         void fromEuler(float yaw, float pitch)
         {
-            const float sy = sinf(yaw);
-            const float cy = cosf(yaw);
-            const float sp = sinf(pitch);
-            const float cp = cosf(pitch);
+            float sy, cy, sp, cp;
+            MathSinCos(yaw, sy, cy);
+            MathSinCos(pitch, sp, cp);
 
             x = cy * cp;
             y = sy * cp;
@@ -154,7 +623,7 @@
         }
     };
 
-    struct vec4f
+    struct alignas(16) vec4f
     {
         union
         {
@@ -163,49 +632,51 @@
                      float z;         ///< Z component
                      float w; };      ///< W component
             struct { float e[4]; };   ///< Indexed components
+            MathSIMD::Vec4 v;         ///< SIMD register
         };
 
         // Default constructor
         vec4f() = default;
 
         // Constructors
-        explicit vec4f(float xyzw) : x(xyzw), y(xyzw), z(xyzw), w(xyzw) {}
-        explicit vec4f(float _x, float _y, float _z, float _w) : x(_x), y(_y), z(_z), w(_w) {}
-        explicit vec4f(const vec3f& xyz, float _w) : x(xyz.x), y(xyz.y), z(xyz.z), w(_w) {}
+        constexpr explicit vec4f(float xyzw) : x(xyzw), y(xyzw), z(xyzw), w(xyzw) {}
+        constexpr explicit vec4f(float _x, float _y, float _z, float _w) : x(_x), y(_y), z(_z), w(_w) {}
+        constexpr explicit vec4f(const vec3f& xyz, float _w) : x(xyz.x), y(xyz.y), z(xyz.z), w(_w) {}
+        explicit vec4f(MathSIMD::Vec4 _v) : v(_v) {}
 
         // Binary operators
-        friend vec4f operator+(const vec4f& lhs, float rhs)        { return vec4f(lhs.x + rhs, lhs.y + rhs, lhs.z + rhs, lhs.w + rhs); };
-        friend vec4f operator-(const vec4f& lhs, float rhs)        { return vec4f(lhs.x - rhs, lhs.y - rhs, lhs.z - rhs, lhs.w - rhs); };
-        friend vec4f operator*(const vec4f& lhs, float rhs)        { return vec4f(lhs.x * rhs, lhs.y * rhs, lhs.z * rhs, lhs.w * rhs); };
-        friend vec4f operator/(const vec4f& lhs, float rhs)        { const float InvRHS = 1.0f / rhs; return vec4f(lhs.x * InvRHS, lhs.y * InvRHS, lhs.z * InvRHS, lhs.w * InvRHS); };
-        friend vec4f operator+(float lhs, const vec4f& rhs)        { return vec4f(lhs + rhs.x, lhs + rhs.y, lhs + rhs.z, lhs + rhs.w); };
-        friend vec4f operator-(float lhs, const vec4f& rhs)        { return vec4f(lhs - rhs.x, lhs - rhs.y, lhs - rhs.z, lhs - rhs.w); };
-        friend vec4f operator*(float lhs, const vec4f& rhs)        { return vec4f(lhs * rhs.x, lhs * rhs.y, lhs * rhs.z, lhs * rhs.w); };
-        friend vec4f operator/(float lhs, const vec4f& rhs)        { return vec4f(lhs / rhs.x, lhs / rhs.y, lhs / rhs.z, lhs / rhs.w); };
-        friend vec4f operator+(const vec4f& lhs, const vec4f& rhs) { return vec4f(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w); };
-        friend vec4f operator-(const vec4f& lhs, const vec4f& rhs) { return vec4f(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w); };
-        friend vec4f operator*(const vec4f& lhs, const vec4f& rhs) { return vec4f(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z, lhs.w * rhs.w); };
-        friend vec4f operator/(const vec4f& lhs, const vec4f& rhs) { return vec4f(lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z, lhs.w / rhs.w); };
+        friend vec4f operator+(const vec4f& lhs, float rhs)        { return vec4f(MathSIMD::Add(lhs.v, MathSIMD::Splat(rhs))); };
+        friend vec4f operator-(const vec4f& lhs, float rhs)        { return vec4f(MathSIMD::Sub(lhs.v, MathSIMD::Splat(rhs))); };
+        friend vec4f operator*(const vec4f& lhs, float rhs)        { return vec4f(MathSIMD::Mul(lhs.v, MathSIMD::Splat(rhs))); };
+        friend vec4f operator/(const vec4f& lhs, float rhs)        { const float InvRHS = 1.0f / rhs; return vec4f(MathSIMD::Mul(lhs.v, MathSIMD::Splat(InvRHS))); };
+        friend vec4f operator+(float lhs, const vec4f& rhs)        { return vec4f(MathSIMD::Add(MathSIMD::Splat(lhs), rhs.v)); };
+        friend vec4f operator-(float lhs, const vec4f& rhs)        { return vec4f(MathSIMD::Sub(MathSIMD::Splat(lhs), rhs.v)); };
+        friend vec4f operator*(float lhs, const vec4f& rhs)        { return vec4f(MathSIMD::Mul(MathSIMD::Splat(lhs), rhs.v)); };
+        friend vec4f operator/(float lhs, const vec4f& rhs)        { return vec4f(MathSIMD::Div(MathSIMD::Splat(lhs), rhs.v)); };
+        friend vec4f operator+(const vec4f& lhs, const vec4f& rhs) { return vec4f(MathSIMD::Add(lhs.v, rhs.v)); };
+        friend vec4f operator-(const vec4f& lhs, const vec4f& rhs) { return vec4f(MathSIMD::Sub(lhs.v, rhs.v)); };
+        friend vec4f operator*(const vec4f& lhs, const vec4f& rhs) { return vec4f(MathSIMD::Mul(lhs.v, rhs.v)); };
+        friend vec4f operator/(const vec4f& lhs, const vec4f& rhs) { return vec4f(MathSIMD::Div(lhs.v, rhs.v)); };
 
         // Singular operators
         float  operator[](int index) const        { return e[index]; }
         float& operator[](int index)              { return e[index]; }
-        bool   operator==(const vec4f& rhs) const { return (x == rhs.x) && (y == rhs.y) && (z == rhs.z) && (w == rhs.w); }
-        bool   operator!=(const vec4f& rhs) const { return (x != rhs.x) || (y != rhs.y) || (z != rhs.z) || (w != rhs.w); }
-        vec4f& operator+=(const vec4f& rhs)       { x += rhs.x; y += rhs.y; z += rhs.z; w += rhs.w; return *this; }
-        vec4f& operator-=(const vec4f& rhs)       { x -= rhs.x; y -= rhs.y; z -= rhs.z; w -= rhs.w; return *this; }
-        vec4f& operator*=(const vec4f& rhs)       { x *= rhs.x; y *= rhs.y; z *= rhs.z; w *= rhs.w; return *this; }
-        vec4f& operator/=(const vec4f& rhs)       { x /= rhs.x; y /= rhs.y; z /= rhs.z; w /= rhs.w; return *this; }
-        vec4f& operator+=(float rhs)              { x += rhs; y += rhs; z += rhs; w += rhs; return *this; }
-        vec4f& operator-=(float rhs)              { x -= rhs; y -= rhs; z -= rhs; w -= rhs; return *this; }
-        vec4f& operator*=(float rhs)              { x *= rhs; y *= rhs; z *= rhs; w *= rhs; return *this; }
-        vec4f& operator/=(float rhs)              { const float InvRHS = 1.0f / rhs; x *= InvRHS; y *= InvRHS; z *= InvRHS; w *= InvRHS; return *this; }
+        bool   operator==(const vec4f& rhs) const { return MathSIMD::AllEqual(v, rhs.v); }
+        bool   operator!=(const vec4f& rhs) const { return !MathSIMD::AllEqual(v, rhs.v); }
+        vec4f& operator+=(const vec4f& rhs)       { v = MathSIMD::Add(v, rhs.v); return *this; }
+        vec4f& operator-=(const vec4f& rhs)       { v = MathSIMD::Sub(v, rhs.v); return *this; }
+        vec4f& operator*=(const vec4f& rhs)       { v = MathSIMD::Mul(v, rhs.v); return *this; }
+        vec4f& operator/=(const vec4f& rhs)       { v = MathSIMD::Div(v, rhs.v); return *this; }
+        vec4f& operator+=(float rhs)              { v = MathSIMD::Add(v, MathSIMD::Splat(rhs)); return *this; }
+        vec4f& operator-=(float rhs)              { v = MathSIMD::Sub(v, MathSIMD::Splat(rhs)); return *this; }
+        vec4f& operator*=(float rhs)              { v = MathSIMD::Mul(v, MathSIMD::Splat(rhs)); return *this; }
+        vec4f& operator/=(float rhs)              { const float InvRHS = 1.0f / rhs; v = MathSIMD::Mul(v, MathSIMD::Splat(InvRHS)); return *this; }
 
         // Unary operators
-        vec4f operator-() const { return vec4f(-x, -y, -z, -w); };
+        vec4f operator-() const { return vec4f(MathSIMD::Neg(v)); };
 
         //
-        float getLengthSq() const
+        constexpr float getLengthSq() const
         {
             return (x * x) + (y * y) + (z * z) + (w * w);
         }
@@ -270,15 +741,17 @@
     {
         union
         {
+#if CNSDK_MATH_AXIS_NAMES
             struct { vec3f  x;               ///< X-Axis
                      vec3f  y;               ///< Y-Axis
                      vec3f  z; };            ///< Z-Axis
+#endif
             struct { float Xx, Xy, Xz;       ///< X-Axis scalars
                      float Yx, Yy, Yz;       ///< Y-Axis scalars
                      float Zx, Zy, Zz; };    ///< Z-Axis scalars
             struct { float M[3][3]; };       ///< All components in a float array
             struct { float m[9]; };          ///< All components in an array
-            struct { vec3f  e[3]; };         ///< Indexed axes
+            vec3f  e[3];                     ///< Indexed axes
         };
     
         mat3f() = default;
@@ -289,43 +762,39 @@
         mat3f operator*(const mat3f& rhs) const
         {
             mat3f ret;
-            ret.x = x * rhs.Xx + y * rhs.Xy + z * rhs.Xz;
-            ret.y = x * rhs.Yx + y * rhs.Yy + z * rhs.Yz;
-            ret.z = x * rhs.Zx + y * rhs.Zy + z * rhs.Zz;
+            MathSIMD::Mat3Mul(ret.m, m, rhs.m);
             return ret;
         }
 
         void clear(float value = 0.0)
         {
-            x = vec3f(value);
-            y = vec3f(value);
-            z = vec3f(value);
+            e[0] = vec3f(value);
+            e[1] = vec3f(value);
+            e[2] = vec3f(value);
         }
 
         void setIdentity()
         {
-            x = vec3f(1.0, 0.0, 0.0);
-            y = vec3f(0.0, 1.0, 0.0);
-            z = vec3f(0.0, 0.0, 1.0);
+            e[0] = vec3f(1.0, 0.0, 0.0);
+            e[1] = vec3f(0.0, 1.0, 0.0);
+            e[2] = vec3f(0.0, 0.0, 1.0);
         }
 
         void setAxisAngleRotation(const vec3f& _Axis, float _Angle)
         {
-            const float ca = cosf(_Angle);
-            const float sa = sinf(_Angle);
+            float sa, ca;
+            MathSinCos(_Angle, sa, ca);
             const float oneMinusCosA = 1.0f - ca;
 
-            x.x = oneMinusCosA * _Axis.x * _Axis.x + ca;
-            x.y = oneMinusCosA * _Axis.x * _Axis.y - sa * _Axis.z;
-            x.z = oneMinusCosA * _Axis.x * _Axis.z + sa * _Axis.y;
+            // Each axis is oneMinusCosA * _Axis[i] * _Axis plus a cosine/sine term per component.
+            const MathSIMD::Vec4 axis = MathSIMD::Load3(_Axis.e);
+            const float sx = sa * _Axis.x;
+            const float sy = sa * _Axis.y;
+            const float sz = sa * _Axis.z;
 
-            y.x = oneMinusCosA * _Axis.y * _Axis.x + sa * _Axis.z;
-            y.y = oneMinusCosA * _Axis.y * _Axis.y + ca;
-            y.z = oneMinusCosA * _Axis.y * _Axis.z - sa * _Axis.x;
-
-            z.x = oneMinusCosA * _Axis.z * _Axis.x - sa * _Axis.y;
-            z.y = oneMinusCosA * _Axis.z * _Axis.y + sa * _Axis.x;
-            z.z = oneMinusCosA * _Axis.z * _Axis.z + ca;
+            MathSIMD::Store3(e[0].e, MathSIMD::MulAdd(MathSIMD::Splat(oneMinusCosA * _Axis.x), axis, MathSIMD::Set(ca, -sz, sy, 0.0f)));
+            MathSIMD::Store3(e[1].e, MathSIMD::MulAdd(MathSIMD::Splat(oneMinusCosA * _Axis.y), axis, MathSIMD::Set(sz, ca, -sx, 0.0f)));
+            MathSIMD::Store3(e[2].e, MathSIMD::MulAdd(MathSIMD::Splat(oneMinusCosA * _Axis.z), axis, MathSIMD::Set(-sy, sx, ca, 0.0f)));
         }
 
         void fromQuaternion(vec4f u)
@@ -357,38 +826,85 @@
             Zy = yz2 - sx2;
             Zz = 1.0f - (xx2 + yy2);
         }
+
+        float getDeterminant() const
+        {
+            return vec3f::dot(e[0], vec3f::cross(e[1], e[2]));
+        }
+
+        mat3f getTranspose() const
+        {
+            mat3f transpose;
+            transpose.Xx = Xx; transpose.Yx = Xy; transpose.Zx = Xz;
+            transpose.Xy = Yx; transpose.Yy = Yy; transpose.Zy = Yz;
+            transpose.Xz = Zx; transpose.Yz = Zy; transpose.Zz = Zz;
+            return transpose;
+        }
+
+        // Returns a zero matrix if the determinant is zero.
+        mat3f getInverse() const
+        {
+            using namespace MathSIMD;
+
+            const Vec4 cx = Load3(e[0].e);
+            const Vec4 cy = Load3(e[1].e);
+            const Vec4 cz = Load3(e[2].e);
+
+            // Rows of the inverse are cross products of axis pairs over the determinant.
+            Vec4 r0 = Cross3(cy, cz);
+            Vec4 r1 = Cross3(cz, cx);
+            Vec4 r2 = Cross3(cx, cy);
+            Vec4 r3 = Splat(0.0f);
+
+            mat3f inverse;
+            const Vec4 det = Dot3(cx, r0);
+            if (GetX(det) == 0.0f)
+            {
+                inverse.clear();
+                return inverse;
+            }
+
+            const Vec4 invDet = Div(Splat(1.0f), det);
+            Transpose(r0, r1, r2, r3);
+            Store3(inverse.e[0].e, Mul(r0, invDet));
+            Store3(inverse.e[1].e, Mul(r1, invDet));
+            Store3(inverse.e[2].e, Mul(r2, invDet));
+            return inverse;
+        }
     };
 
-    struct mat4f
+    struct alignas(16) mat4f
     {
         union
         {
+#if CNSDK_MATH_AXIS_NAMES
             struct { vec4f x;                   ///< X-Axis
                      vec4f y;                   ///< Y-Axis
                      vec4f z;                   ///< Z-Axis
                      vec4f w; };                ///< W-Axis
+#endif
             struct { float Xx, Xy, Xz, Xw;      ///< X-Axis scalars
                      float Yx, Yy, Yz, Yw;      ///< Y-Axis scalars
                      float Zx, Zy, Zz, Zw;      ///< Z-Axis scalars
                      float Wx, Wy, Wz, Ww; };   ///< W-Axis scalars
             struct { float M[4][4]; };          ///< All components in a float array
             struct { float m[16]; };            ///< All components in an array
-            struct { vec4f e[4]; };             ///< Indexed axes
+            vec4f e[4];                         ///< Indexed axes
         };
 
         mat4f() = default;
 
-        mat4f
+        constexpr mat4f
         (
             float _Xx, float _Xy, float _Xz, float _Xw,
             float _Yx, float _Yy, float _Yz, float _Yw,
             float _Zx, float _Zy, float _Zz, float _Zw,
-            float _Wx, float _Wy, float _Wz, float _Ww)
+            float _Wx, float _Wy, float _Wz, float _Ww) :
+            Xx(_Xx), Xy(_Xy), Xz(_Xz), Xw(_Xw),
+            Yx(_Yx), Yy(_Yy), Yz(_Yz), Yw(_Yw),
+            Zx(_Zx), Zy(_Zy), Zz(_Zz), Zw(_Zw),
+            Wx(_Wx), Wy(_Wy), Wz(_Wz), Ww(_Ww)
         {
-            Xx = _Xx; Xy = _Xy; Xz = _Xz; Xw = _Xw;
-            Yx = _Yx; Yy = _Yy; Yz = _Yz; Yw = _Yw;
-            Zx = _Zx; Zy = _Zy; Zz = _Zz; Zw = _Zw;
-            Wx = _Wx; Wy = _Wy; Wz = _Wz; Ww = _Ww;
         }
 
         vec4f  operator[](int index) const { return e[index]; }
@@ -396,10 +912,10 @@
 
         void setIdentity()
         {
-            x = vec4f(1.0f, 0.0f, 0.0f, 0.0f);
-            y = vec4f(0.0f, 1.0f, 0.0f, 0.0f);
-            z = vec4f(0.0f, 0.0f, 1.0f, 0.0f);
-            w = vec4f(0.0f, 0.0f, 0.0f, 1.0f);
+            e[0] = vec4f(1.0f, 0.0f, 0.0f, 0.0f);
+            e[1] = vec4f(0.0f, 1.0f, 0.0f, 0.0f);
+            e[2] = vec4f(0.0f, 0.0f, 1.0f, 0.0f);
+            e[3] = vec4f(0.0f, 0.0f, 0.0f, 1.0f);
         }
 
         void create(const mat3f& orientation, const vec3f& position)
@@ -413,26 +929,32 @@
         mat4f operator*(const mat4f& rhs) const
         {
             mat4f ret;
-            ret.x = x * rhs.Xx + y * rhs.Xy + z * rhs.Xz + w * rhs.Xw;
-            ret.y = x * rhs.Yx + y * rhs.Yy + z * rhs.Yz + w * rhs.Yw;
-            ret.z = x * rhs.Zx + y * rhs.Zy + z * rhs.Zz + w * rhs.Zw;
-            ret.w = x * rhs.Wx + y * rhs.Wy + z * rhs.Wz + w * rhs.Ww;
+            MathSIMD::Mat4Mul(ret.m, m, rhs.m);
             return ret;
         }
 
+        vec4f operator*(const vec4f& rhs) const
+        {
+            MathSIMD::Vec4 r = MathSIMD::Mul(e[0].v, MathSIMD::Splat(rhs.x));
+            r = MathSIMD::MulAdd(e[1].v, MathSIMD::Splat(rhs.y), r);
+            r = MathSIMD::MulAdd(e[2].v, MathSIMD::Splat(rhs.z), r);
+            r = MathSIMD::MulAdd(e[3].v, MathSIMD::Splat(rhs.w), r);
+            return vec4f(r);
+        }
+
         void setPerspective(float fovy, float aspectRatio, float znear, float zfar)
         {
-            const float tanHalfFovy = tanf(fovy / 2.0f);
+            const float tanHalfFovy = MathTan(fovy / 2.0f);
 
             const float Xs = 1.0f / (aspectRatio * tanHalfFovy);
             const float Ys = 1.0f / (tanHalfFovy);
             const float Zs = -(zfar + znear) / (zfar - znear);
             const float Us = -(2.0f * zfar * znear) / (zfar - znear);
 
-            x = vec4f(Xs,   0.0f, 0.0f, 0.0f);
-            y = vec4f(0.0f, Ys,   0.0f, 0.0f);
-            z = vec4f(0.0f, 0.0f, Zs,  -1.0f);
-            w = vec4f(0.0f, 0.0f, Us,   0.0f);
+            e[0] = vec4f(Xs,   0.0f, 0.0f, 0.0f);
+            e[1] = vec4f(0.0f, Ys,   0.0f, 0.0f);
+            e[2] = vec4f(0.0f, 0.0f, Zs,  -1.0f);
+            e[3] = vec4f(0.0f, 0.0f, Us,   0.0f);
         }
 
         void setOrthographic(float left, float right, float bottom, float top, float znear, float zfar)
@@ -444,30 +966,273 @@
             const float ty = -(top + bottom) / (top - bottom);
             const float tz = -(zfar + znear) / (zfar - znear);
 
-            x = vec4f(Xs,   0.0f, 0.0f, 0.0f);
-            y = vec4f(0.0f, Ys,   0.0f, 0.0f);
-            z = vec4f(0.0f, 0.0f, Zs,   0.0f);
-            w = vec4f(tx,   ty,   tx,   1.0f);
+            e[0] = vec4f(Xs,   0.0f, 0.0f, 0.0f);
+            e[1] = vec4f(0.0f, Ys,   0.0f, 0.0f);
+            e[2] = vec4f(0.0f, 0.0f, Zs,   0.0f);
+            e[3] = vec4f(tx,   ty,   tz,   1.0f);
         }
 
         void lookAt(const vec3f& eye, const vec3f& center, const vec3f& up)
         {
-            const vec3f f = (center - eye).getNormal();
-            const vec3f s = vec3f::cross(f, up).getNormal();
-            const vec3f u = vec3f::cross(s, f);
+            using namespace MathSIMD;
+
+            const Vec4 p = Load3(eye.e);
+            const Vec4 f = Normalize3(Sub(Load3(center.e), p));
+            const Vec4 s = Normalize3(Cross3(f, Load3(up.e)));
+            const Vec4 u = Cross3(s, f);
+
+            // Rows s, u, -f become the columns of the rotation.
+            Vec4 cx = s, cy = u, cz = Neg(f), cw = Splat(0.0f);
+            Transpose(cx, cy, cz, cw);
+            e[0].v = cx;
+            e[1].v = cy;
+            e[2].v = cz;
+            e[3].v = Set(-GetX(Dot3(s, p)), -GetX(Dot3(u, p)), GetX(Dot3(f, p)), 1.0f);
+        }
+
+        mat4f getTranspose() const
+        {
+            mat4f transpose = *this;
+            MathSIMD::Transpose(transpose.e[0].v, transpose.e[1].v, transpose.e[2].v, transpose.e[3].v);
+            return transpose;
+        }
+
+        // General inverse. Returns a zero matrix if the determinant is zero.
+        mat4f getInverse() const
+        {
+            mat4f inverse;
+            MathSIMD::Mat4Inverse(inverse.m, m);
+            return inverse;
+        }
+
+        // Inverse of an affine matrix (bottom row 0 0 0 1), cheaper than getInverse. The 3x3 part
+        // may hold any invertible rotation, scale and shear. Returns a zero matrix if it's singular.
+        mat4f getAffineInverse() const
+        {
+            using namespace MathSIMD;
+
+            Vec4 r0 = Cross3(e[1].v, e[2].v);
+            Vec4 r1 = Cross3(e[2].v, e[0].v);
+            Vec4 r2 = Cross3(e[0].v, e[1].v);
+            Vec4 r3 = Splat(0.0f);
+
+            const Vec4 det = Dot3(e[0].v, r0);
+            if (GetX(det) == 0.0f)
+                return mat4f(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+
+            const Vec4 invDet = Div(Splat(1.0f), det);
+            r0 = Mul(r0, invDet);
+            r1 = Mul(r1, invDet);
+            r2 = Mul(r2, invDet);
+            Transpose(r0, r1, r2, r3);
+
+            // Carry the translation through the inverted axes.
+            const Vec4 t = MulAdd(r2, SplatLane<2>(e[3].v), MulAdd(r1, SplatLane<1>(e[3].v), Mul(r0, SplatLane<0>(e[3].v))));
+
+            mat4f inverse;
+            inverse.e[0].v = r0;
+            inverse.e[1].v = r1;
+            inverse.e[2].v = r2;
+            inverse.e[3].v = Neg(t);
+            inverse.Ww  = 1.0f;
+            return inverse;
+        }
+
+        // Inverse of a rotation plus translation, such as lookAt and other camera matrices: the
+        // transposed rotation and the negated, rotated translation. The 3x3 part must be orthonormal.
+        mat4f getRigidInverse() const
+        {
+            using namespace MathSIMD;
+
+            Vec4 r0 = e[0].v, r1 = e[1].v, r2 = e[2].v, r3 = Splat(0.0f);
+            Transpose(r0, r1, r2, r3);
+
+            // Carry the translation through the inverted axes.
+            const Vec4 t = MulAdd(r2, SplatLane<2>(e[3].v), MulAdd(r1, SplatLane<1>(e[3].v), Mul(r0, SplatLane<0>(e[3].v))));
+
+            mat4f inverse;
+            inverse.e[0].v = r0;
+            inverse.e[1].v = r1;
+            inverse.e[2].v = r2;
+            inverse.e[3].v = Neg(t);
+            inverse.Ww  = 1.0f;
+            return inverse;
+        }
+    };
+
+    // Rotation quaternion, w the scalar part, in the convention of mat3f::fromQuaternion:
+    // a * b rotates by b, then by a, the same as the matrix product a.getMat3() * b.getMat3().
+    struct alignas(16) quatf
+    {
+        union
+        {
+            struct { float x;         ///< X component
+                     float y;         ///< Y component
+                     float z;         ///< Z component
+                     float w; };      ///< Scalar component
+            struct { float e[4]; };   ///< Indexed components
+            MathSIMD::Vec4 v;         ///< SIMD register
+        };
+
+        // Default constructor
+        quatf() = default;
+
+        // Constructors
+        constexpr explicit quatf(float _x, float _y, float _z, float _w) : x(_x), y(_y), z(_z), w(_w) {}
+        constexpr explicit quatf(const vec4f& xyzw) : x(xyzw.x), y(xyzw.y), z(xyzw.z), w(xyzw.w) {}
+        explicit quatf(MathSIMD::Vec4 _v) : v(_v) {}
+
+        // Hamilton product, one column of sign-flipped lanes per component of lhs.
+        friend quatf operator*(const quatf& lhs, const quatf& rhs)
+        {
+            using namespace MathSIMD;
+
+            const Vec4 b = rhs.v;
+            Vec4 r = Mul(SplatLane<3>(lhs.v), b);
+            r = MulAdd(SplatLane<0>(lhs.v), Mul(Shuffle<3, 2, 1, 0>(b), Set( 1.0f, -1.0f,  1.0f, -1.0f)), r);
+            r = MulAdd(SplatLane<1>(lhs.v), Mul(Shuffle<2, 3, 0, 1>(b), Set( 1.0f,  1.0f, -1.0f, -1.0f)), r);
+            r = MulAdd(SplatLane<2>(lhs.v), Mul(Shuffle<1, 0, 3, 2>(b), Set(-1.0f,  1.0f,  1.0f, -1.0f)), r);
+            return quatf(r);
+        }
+
+        quatf& operator*=(const quatf& rhs) { *this = *this * rhs; return *this; }
+        bool   operator==(const quatf& rhs) const { return MathSIMD::AllEqual(v, rhs.v); }
+        bool   operator!=(const quatf& rhs) const { return !MathSIMD::AllEqual(v, rhs.v); }
+
+        // Static methods
+        static float dot(const quatf& lhs, const quatf& rhs) { return MathSIMD::GetX(MathSIMD::Dot4(lhs.v, rhs.v)); }
+
+        // Normalized linear interpolation along the shorter arc. Cheap, with a slightly uneven
+        // angular speed; fine for small steps such as per-frame smoothing.
+        static quatf nlerp(const quatf& from, const quatf& to, float t)
+        {
+            using namespace MathSIMD;
+
+            const Vec4 b = (dot(from, to) < 0.0f) ? Neg(to.v) : to.v;
+            quatf r(MulAdd(Sub(b, from.v), Splat(t), from.v));
+            r.normalize();
+            return r;
+        }
+
+        // Spherical interpolation along the shorter arc, at constant angular speed. Falls back to
+        // nlerp when the two are too close for the sine weights to be accurate.
+        static quatf slerp(const quatf& from, const quatf& to, float t)
+        {
+            using namespace MathSIMD;
+
+            float cosAngle = dot(from, to);
+            Vec4 b = to.v;
+            if (cosAngle < 0.0f)
+            {
+                cosAngle = -cosAngle;
+                b = Neg(b);
+            }
+
+            if (cosAngle > 0.9995f)
+                return nlerp(from, quatf(b), t);
+
+            const float angle = acosf(cosAngle);
+            const float invSin = 1.0f / MathSin(angle);
+            const float wa = MathSin((1.0f - t) * angle) * invSin;
+            const float wb = MathSin(t * angle) * invSin;
+            return quatf(MulAdd(b, Splat(wb), Mul(from.v, Splat(wa))));
+        }
+
+        void setIdentity()
+        {
+            x = 0.0f; y = 0.0f; z = 0.0f; w = 1.0f;
+        }
+
+        // Same matrix as mat3f::setAxisAngleRotation, _Axis normalized. That matrix is the
+        // fromQuaternion rotation by -_Angle, hence the negated half angle.
+        void setAxisAngleRotation(const vec3f& _Axis, float _Angle)
+        {
+            float s, c;
+            MathSinCos(_Angle * -0.5f, s, c);
+            x = _Axis.x * s;
+            y = _Axis.y * s;
+            z = _Axis.z * s;
+            w = c;
+        }
+
+        // Rotation by x about the X axis, y about Y and z about Z, composed as X * Y * Z: the
+        // same as the product of the three mat3f::setAxisAngleRotation matrices, in closed form.
+        void setEulerRotation(float _x, float _y, float _z)
+        {
+            float sx, cx, sy, cy, sz, cz;
+            MathSinCos(_x * -0.5f, sx, cx);
+            MathSinCos(_y * -0.5f, sy, cy);
+            MathSinCos(_z * -0.5f, sz, cz);
+
+            const float sxcy = sx * cy, cxsy = cx * sy, sxsy = sx * sy, cxcy = cx * cy;
+            x = sxcy * cz + cxsy * sz;
+            y = cxsy * cz - sxcy * sz;
+            z = sxsy * cz + cxcy * sz;
+            w = cxcy * cz - sxsy * sz;
+        }
+
+        float getLength() const
+        {
+            return sqrtf(dot(*this, *this));
+        }
+
+        float normalize(float epsilon = 0.0f)
+        {
+            const MathSIMD::Vec4 length = MathSIMD::Sqrt(MathSIMD::Dot4(v, v));
+
+            if (MathSIMD::GetX(length) > epsilon)
+                v = MathSIMD::Div(v, length);
+
+            return MathSIMD::GetX(length);
+        }
+
+        quatf getNormal(float epsilon = 0.0f) const
+        {
+            quatf normal = *this;
+            if (normal.normalize(epsilon) <= epsilon)
+                normal = quatf(0.0f, 0.0f, 0.0f, 0.0f);
+            return normal;
+        }
+
+        // The inverse rotation, for unit quaternions.
+        quatf getConjugate() const
+        {
+            return quatf(MathSIMD::Mul(v, MathSIMD::Set(-1.0f, -1.0f, -1.0f, 1.0f)));
+        }
+
+        // v + 2w (q x v) + 2 q x (q x v), for unit quaternions.
+        vec3f rotate(const vec3f& _v) const
+        {
+            using namespace MathSIMD;
+
+            const Vec4 p  = Load3(_v.e);
+            const Vec4 t  = Cross3(v, p);
+            const Vec4 t2 = Add(t, t);
+            const Vec4 r  = Add(Add(p, Mul(SplatLane<3>(v), t2)), Cross3(v, t2));
 
-            const float tx = -vec3f::dot(s, eye);
-            const float ty = -vec3f::dot(u, eye);
-            const float tz =  vec3f::dot(f, eye);
+            vec3f ret;
+            Store3(ret.e, r);
+            return ret;
+        }
+
+        mat3f getMat3() const
+        {
+            mat3f ret;
+            ret.fromQuaternion(vec4f(v));
+            return ret;
+        }
 
-            x.x = s.x; x.y = u.x; x.z = -f.x; x.w = 0.0f;
-            y.x = s.y; y.y = u.y; y.z = -f.y; y.w = 0.0f;
-            z.x = s.z; z.y = u.z; z.z = -f.z; z.w = 0.0f;
-            w.x = tx;  w.y = ty;  w.z = tz;   w.w = 1.0f;
+        mat4f getMat4(const vec3f& position = vec3f(0.0f)) const
+        {
+            mat4f ret;
+            ret.create(getMat3(), position);
+            return ret;
         }
     };
 
-#if 0
+    // Double precision types for world-space positions. Rendering stays in float: positions are
+    // made relative to the camera in double first (mat4::getMat4f, ComposeRelativeTransforms) so
+    // large distances from the world origin don't cost precision near the viewer.
     struct vec2
     {
         union
@@ -483,6 +1248,10 @@
         // Constructors
         explicit vec2(double xy) : x(xy), y(xy) {}
         explicit vec2(double _x, double _y) : x(_x), y(_y) {}
+        explicit vec2(const vec2f& v) : x(v.x), y(v.y) {}
+
+        // Conversion to float, rounding to nearest.
+        vec2f getVec2f() const { return vec2f((float)x, (float)y); }
 
         // Binary operators
         friend vec2 operator+ (const vec2& lhs, double rhs)      { return vec2(lhs.x + rhs, lhs.y + rhs); }
@@ -584,11 +1353,9 @@
     {
         union
         {
-            struct {
-                double x;         ///< X component
-                double y;         ///< Y component
-                double z;
-            };      ///< Z component
+            struct { double x;         ///< X component
+                     double y;         ///< Y component
+                     double z; };      ///< Z component
             struct { double e[3]; };   ///< Indexed components
         };
 
@@ -599,6 +1366,10 @@
         explicit vec3(double xyz) : x(xyz), y(xyz), z(xyz) {}
         explicit vec3(double _x, double _y, double _z) : x(_x), y(_y), z(_z) {}
         explicit vec3(const vec2& xy, double _z) : x(xy.x), y(xy.y), z(_z) {}
+        explicit vec3(const vec3f& v) : x(v.x), y(v.y), z(v.z) {}
+
+        // Conversion to float, rounding to nearest.
+        vec3f getVec3f() const { return vec3f((float)x, (float)y, (float)z); }
 
         // Binary operators
         friend vec3 operator+ (const vec3& lhs, double rhs) { return vec3(lhs.x + rhs, lhs.y + rhs, lhs.z + rhs); }
@@ -718,12 +1489,10 @@
     {
         union
         {
-            struct {
-                double x;         ///< X component
-                double y;         ///< Y component
-                double z;         ///< Z component
-                double w;
-            };      ///< W component
+            struct { double x;         ///< X component
+                     double y;         ///< Y component
+                     double z;         ///< Z component
+                     double w; };      ///< W component
             struct { double e[4]; };   ///< Indexed components
         };
 
@@ -734,6 +1503,10 @@
         explicit vec4(double xyzw) : x(xyzw), y(xyzw), z(xyzw), w(xyzw) {}
         explicit vec4(double _x, double _y, double _z, double _w) : x(_x), y(_y), z(_z), w(_w) {}
         explicit vec4(const vec3& xyz, double _w) : x(xyz.x), y(xyz.y), z(xyz.z), w(_w) {}
+        explicit vec4(const vec4f& v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
+
+        // Conversion to float, rounding to nearest.
+        vec4f getVec4f() const { return vec4f((float)x, (float)y, (float)z, (float)w); }
 
         // Binary operators
         friend vec4 operator+(const vec4& lhs, double rhs) { return vec4(lhs.x + rhs, lhs.y + rhs, lhs.z + rhs, lhs.w + rhs); };
@@ -832,47 +1605,60 @@
     {
         union
         {
-            struct {
-                vec3   x;                ///< X-Axis
-                vec3   y;                ///< Y-Axis
-                vec3   z;
-            };             ///< Z-Axis
-            struct {
-                double Xx, Xy, Xz;       ///< X-Axis scalars
-                double Yx, Yy, Yz;       ///< Y-Axis scalars
-                double Zx, Zy, Zz;
-            };    ///< Z-Axis scalars
+#if CNSDK_MATH_AXIS_NAMES
+            struct { vec3   x;                ///< X-Axis
+                     vec3   y;                ///< Y-Axis
+                     vec3   z; };             ///< Z-Axis
+#endif
+            struct { double Xx, Xy, Xz;       ///< X-Axis scalars
+                     double Yx, Yy, Yz;       ///< Y-Axis scalars
+                     double Zx, Zy, Zz; };    ///< Z-Axis scalars
             struct { double M[3][3]; };       ///< All components in a double array
             struct { double m[9]; };          ///< All components in an array
-            struct { vec3   e[3]; };          ///< Indexed axes
+            vec3   e[3];                      ///< Indexed axes
         };
 
         mat3() = default;
 
+        explicit mat3(const mat3f& rhs)
+        {
+            for (int i = 0; i < 9; i++)
+                m[i] = rhs.m[i];
+        }
+
+        // Conversion to float, rounding to nearest.
+        mat3f getMat3f() const
+        {
+            mat3f ret;
+            for (int i = 0; i < 9; i++)
+                ret.m[i] = (float)m[i];
+            return ret;
+        }
+
         vec3  operator[](int index) const { return e[index]; }
         vec3& operator[](int index) { return e[index]; }
 
         mat3 operator*(const mat3& rhs) const
         {
             mat3 ret;
-            ret.x = x * rhs.Xx + y * rhs.Xy + z * rhs.Xz;
-            ret.y = x * rhs.Yx + y * rhs.Yy + z * rhs.Yz;
-            ret.z = x * rhs.Zx + y * rhs.Zy + z * rhs.Zz;
+            ret.e[0] = e[0] * rhs.Xx + e[1] * rhs.Xy + e[2] * rhs.Xz;
+            ret.e[1] = e[0] * rhs.Yx + e[1] * rhs.Yy + e[2] * rhs.Yz;
+            ret.e[2] = e[0] * rhs.Zx + e[1] * rhs.Zy + e[2] * rhs.Zz;
             return ret;
         }
 
         void clear(double value = 0.0)
         {
-            x = vec3(value);
-            y = vec3(value);
-            z = vec3(value);
+            e[0] = vec3(value);
+            e[1] = vec3(value);
+            e[2] = vec3(value);
         }
 
         void setIdentity()
         {
-            x = vec3(1.0, 0.0, 0.0);
-            y = vec3(0.0, 1.0, 0.0);
-            z = vec3(0.0, 0.0, 1.0);
+            e[0] = vec3(1.0, 0.0, 0.0);
+            e[1] = vec3(0.0, 1.0, 0.0);
+            e[2] = vec3(0.0, 0.0, 1.0);
         }
 
         void setAxisAngleRotation(const vec3& _Axis, double _Angle)
@@ -881,17 +1667,17 @@
             const double sa = sin(_Angle);
             const double oneMinusCosA = 1.0 - ca;
 
-            x.x = oneMinusCosA * _Axis.x * _Axis.x + ca;
-            x.y = oneMinusCosA * _Axis.x * _Axis.y - sa * _Axis.z;
-            x.z = oneMinusCosA * _Axis.x * _Axis.z + sa * _Axis.y;
+            Xx = oneMinusCosA * _Axis.x * _Axis.x + ca;
+            Xy = oneMinusCosA * _Axis.x * _Axis.y - sa * _Axis.z;
+            Xz = oneMinusCosA * _Axis.x * _Axis.z + sa * _Axis.y;
 
-            y.x = oneMinusCosA * _Axis.y * _Axis.x + sa * _Axis.z;
-            y.y = oneMinusCosA * _Axis.y * _Axis.y + ca;
-            y.z = oneMinusCosA * _Axis.y * _Axis.z - sa * _Axis.x;
+            Yx = oneMinusCosA * _Axis.y * _Axis.x + sa * _Axis.z;
+            Yy = oneMinusCosA * _Axis.y * _Axis.y + ca;
+            Yz = oneMinusCosA * _Axis.y * _Axis.z - sa * _Axis.x;
 
-            z.x = oneMinusCosA * _Axis.z * _Axis.x - sa * _Axis.y;
-            z.y = oneMinusCosA * _Axis.z * _Axis.y + sa * _Axis.x;
-            z.z = oneMinusCosA * _Axis.z * _Axis.z + ca;
+            Zx = oneMinusCosA * _Axis.z * _Axis.x - sa * _Axis.y;
+            Zy = oneMinusCosA * _Axis.z * _Axis.y + sa * _Axis.x;
+            Zz = oneMinusCosA * _Axis.z * _Axis.z + ca;
         }
 
         void fromQuaternion(vec4 u)
@@ -929,21 +1715,19 @@
     {
         union
         {
-            struct {
-                vec4   x;                     ///< X-Axis
-                vec4   y;                     ///< Y-Axis
-                vec4   z;                     ///< Z-Axis
-                vec4   w;
-            };                  ///< W-Axis
-            struct {
-                double Xx, Xy, Xz, Xw;        ///< X-Axis scalars
-                double Yx, Yy, Yz, Yw;        ///< Y-Axis scalars
-                double Zx, Zy, Zz, Zw;        ///< Z-Axis scalars
-                double Wx, Wy, Wz, Ww;
-            };     ///< W-Axis scalars
+#if CNSDK_MATH_AXIS_NAMES
+            struct { vec4   x;                     ///< X-Axis
+                     vec4   y;                     ///< Y-Axis
+                     vec4   z;                     ///< Z-Axis
+                     vec4   w; };                  ///< W-Axis
+#endif
+            struct { double Xx, Xy, Xz, Xw;        ///< X-Axis scalars
+                     double Yx, Yy, Yz, Yw;        ///< Y-Axis scalars
+                     double Zx, Zy, Zz, Zw;        ///< Z-Axis scalars
+                     double Wx, Wy, Wz, Ww; };     ///< W-Axis scalars
             struct { double M[4][4]; };            ///< All components in a double array
             struct { double m[16]; };              ///< All components in an array
-            struct { vec4   e[4]; };               ///< Indexed axes
+            vec4   e[4];                           ///< Indexed axes
         };
 
         mat4() = default;
@@ -961,28 +1745,50 @@
             Wx = _Wx; Wy = _Wy; Wz = _Wz; Ww = _Ww;
         }
 
+        explicit mat4(const mat4f& rhs)
+        {
+            for (int i = 0; i < 16; i++)
+                m[i] = rhs.m[i];
+        }
+
+        // Conversion to float with the translation taken relative to origin. The subtraction is
+        // done in double, so an object far from the world origin but near the camera keeps its
+        // precision when origin is the camera position.
+        mat4f getMat4f(const vec3& origin = vec3(0.0)) const
+        {
+            // this * translation(-origin): each row loses its w component times origin.
+            mat4f ret;
+            for (int r = 0; r < 4; r++)
+            {
+                for (int c = 0; c < 3; c++)
+                    ret.M[r][c] = (float)(M[r][c] - M[r][3] * origin.e[c]);
+                ret.M[r][3] = (float)M[r][3];
+            }
+            return ret;
+        }
+
         vec4  operator[](int index) const { return e[index]; }
         vec4& operator[](int index) { return e[index]; }
 
         void clear(double value = 0.0)
         {
-            x = vec4(value);
-            y = vec4(value);
-            z = vec4(value);
-            w = vec4(value);
+            e[0] = vec4(value);
+            e[1] = vec4(value);
+            e[2] = vec4(value);
+            e[3] = vec4(value);
         }
 
         void setIdentity()
         {
-            x = vec4(1.0, 0.0, 0.0, 0.0);
-            y = vec4(0.0, 1.0, 0.0, 0.0);
-            z = vec4(0.0, 0.0, 1.0, 0.0);
-            w = vec4(0.0, 0.0, 0.0, 1.0);
+            e[0] = vec4(1.0, 0.0, 0.0, 0.0);
+            e[1] = vec4(0.0, 1.0, 0.0, 0.0);
+            e[2] = vec4(0.0, 0.0, 1.0, 0.0);
+            e[3] = vec4(0.0, 0.0, 0.0, 1.0);
         }
 
         vec3 getPosition() const
         {
-            return vec3(w.x, w.y, w.z) / w.w;
+            return vec3(Wx, Wy, Wz) / Ww;
         }
 
         void create(const mat3& orientation, const vec3& position)
@@ -996,10 +1802,10 @@
         mat4 operator*(const mat4& rhs) const
         {
             mat4 ret;
-            ret.x = x * rhs.Xx + y * rhs.Xy + z * rhs.Xz + w * rhs.Xw;
-            ret.y = x * rhs.Yx + y * rhs.Yy + z * rhs.Yz + w * rhs.Yw;
-            ret.z = x * rhs.Zx + y * rhs.Zy + z * rhs.Zz + w * rhs.Zw;
-            ret.w = x * rhs.Wx + y * rhs.Wy + z * rhs.Wz + w * rhs.Ww;
+            ret.e[0] = e[0] * rhs.Xx + e[1] * rhs.Xy + e[2] * rhs.Xz + e[3] * rhs.Xw;
+            ret.e[1] = e[0] * rhs.Yx + e[1] * rhs.Yy + e[2] * rhs.Yz + e[3] * rhs.Yw;
+            ret.e[2] = e[0] * rhs.Zx + e[1] * rhs.Zy + e[2] * rhs.Zz + e[3] * rhs.Zw;
+            ret.e[3] = e[0] * rhs.Wx + e[1] * rhs.Wy + e[2] * rhs.Wz + e[3] * rhs.Ww;
             return ret;
         }
 
@@ -1012,10 +1818,10 @@
             const double Zs = -(zfar + znear) / (zfar - znear);
             const double Us = -(2.0 * zfar * znear) / (zfar - znear);
 
-            x = vec4(Xs, 0.0, 0.0, 0.0);
-            y = vec4(0.0, Ys, 0.0, 0.0);
-            z = vec4(0.0, 0.0, Zs, -1.0);
-            w = vec4(0.0, 0.0, Us, 0.0);
+            e[0] = vec4(Xs, 0.0, 0.0, 0.0);
+            e[1] = vec4(0.0, Ys, 0.0, 0.0);
+            e[2] = vec4(0.0, 0.0, Zs, -1.0);
+            e[3] = vec4(0.0, 0.0, Us, 0.0);
         }
 
         void setOrthographic(double left, double right, double bottom, double top, double znear, double zfar)
@@ -1028,10 +1834,10 @@
             const double Uy = -(top + bottom) / (top - bottom);
             const double Uz = -(zfar + znear) / (zfar - znear);
 
-            x = vec4(Xs, 0.0, 0.0, 0.0);
-            y = vec4(0.0, Ys, 0.0, 0.0);
-            z = vec4(0.0, 0.0, Zs, 0.0);
-            w = vec4(Ux, Uy, Uz, 1.0);
+            e[0] = vec4(Xs, 0.0, 0.0, 0.0);
+            e[1] = vec4(0.0, Ys, 0.0, 0.0);
+            e[2] = vec4(0.0, 0.0, Zs, 0.0);
+            e[3] = vec4(Ux, Uy, Uz, 1.0);
         }
 
         void setAxisAngleRotation(const vec3& _Axis, double _Angle)
@@ -1041,10 +1847,10 @@
             Rm.setAxisAngleRotation(_Axis, _Angle);
 
             // Set 4d matrix
-            x.x = Rm.x.x; x.y = Rm.x.y; x.z = Rm.x.z; x.w = 0.0;
-            y.x = Rm.y.x; y.y = Rm.y.y; y.z = Rm.y.z; y.w = 0.0;
-            z.x = Rm.z.x; z.y = Rm.z.y; z.z = Rm.z.z; z.w = 0.0;
-            w.x = 0.0;   w.y = 0.0;   w.z = 0.0;   w.w = 1.0;
+            Xx = Rm.Xx; Xy = Rm.Xy; Xz = Rm.Xz; Xw = 0.0;
+            Yx = Rm.Yx; Yy = Rm.Yy; Yz = Rm.Yz; Yw = 0.0;
+            Zx = Rm.Zx; Zy = Rm.Zy; Zz = Rm.Zz; Zw = 0.0;
+            Wx = 0.0;   Wy = 0.0;   Wz = 0.0;   Ww = 1.0;
         }
 
         void lookAt(const vec3& eye, const vec3& center, const vec3& up)
@@ -1057,10 +1863,10 @@
             const double ty = -vec3::dot(u, eye);
             const double tz = vec3::dot(f, eye);
 
-            x.x = s.x; x.y = u.x; x.z = -f.x; x.w = 0.0;
-            y.x = s.y; y.y = u.y; y.z = -f.y; y.w = 0.0;
-            z.x = s.z; z.y = u.z; z.z = -f.z; z.w = 0.0;
-            w.x = tx;  w.y = ty;  w.z = tz;   w.w = 1.0;
+            Xx = s.x; Xy = u.x; Xz = -f.x; Xw = 0.0;
+            Yx = s.y; Yy = u.y; Yz = -f.y; Yw = 0.0;
+            Zx = s.z; Zy = u.z; Zz = -f.z; Zw = 0.0;
+            Wx = tx;  Wy = ty;  Wz = tz;   Ww = 1.0;
         }
 
         mat4 getInverse() const
@@ -1122,9 +1928,16 @@
             return transpose;
         }
     };
-#endif
 
-#pragma pack(pop)
+    // The types are used directly as vertex and constant buffer data.
+    static_assert(sizeof(vec2f) == 8,  "vec2f layout");
+    static_assert(sizeof(vec3f) == 12, "vec3f layout");
+    static_assert(sizeof(vec4f) == 16, "vec4f layout");
+    static_assert(sizeof(mat3f) == 36, "mat3f layout");
+    static_assert(sizeof(mat4f) == 64, "mat4f layout");
+    static_assert(sizeof(quatf) == 16, "quatf layout");
+    static_assert(sizeof(vec3)  == 24, "vec3 layout");
+    static_assert(sizeof(mat4)  == 128, "mat4 layout");
 
     inline float DegreesToRadians(float degrees)
     {
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <type_traits>
+#include "CNSDKGettingStartedMath.h"
+
+// Opt-in deferred products of mat4f and mat3f. Wrap a matrix in Lazy(), or in Affine() when its
+// last row is known to be 0 0 0 1, and products with it build a chain instead of a matrix:
+//
+//     const mat4f mvp  = projection * MathExpr::Affine(view) * MathExpr::Affine(model);
+//     const vec4f clip = MathExpr::Lazy(projection) * view * model * position;
+//
+// Assigning a chain to a matrix evaluates it left to right, as the plain operators would, with
+// the affine product (Mat4MulAffine) wherever the right operand is known affine. A chain times a
+// vector never forms the matrix product: the vector goes through the matrices right to left, one
+// matrix-vector product per matrix.
+//
+// Chains reference their operands, so use them within the expression that builds them; don't
+// keep one in an auto variable. Code that doesn't use Lazy() or Affine() is unaffected.
+
+namespace MathExpr
+{
+    namespace Detail
+    {
+        inline void Multiply(mat4f& out, const mat4f& lhs, const mat4f& rhs, std::false_type) { MathSIMD::Mat4Mul(out.m, lhs.m, rhs.m); }
+        inline void Multiply(mat4f& out, const mat4f& lhs, const mat4f& rhs, std::true_type)  { MathSIMD::Mat4MulAffine(out.m, lhs.m, rhs.m); }
+        inline void Multiply(mat3f& out, const mat3f& lhs, const mat3f& rhs, std::false_type) { MathSIMD::Mat3Mul(out.m, lhs.m, rhs.m); }
+
+        inline vec4f Transform(const mat4f& matrix, const vec4f& v)
+        {
+            return matrix * v;
+        }
+
+        inline vec3f Transform(const mat3f& matrix, const vec3f& v)
+        {
+            using namespace MathSIMD;
+
+            Vec4 r = Mul(Load3(matrix.m + 0), Splat(v.x));
+            r = MulAdd(Load3(matrix.m + 3), Splat(v.y), r);
+            r = MulAdd(Load3(matrix.m + 6), Splat(v.z), r);
+
+            vec3f ret;
+            Store3(ret.e, r);
+            return ret;
+        }
+    }
+
+    // Base of every chain node, so the operators below only take part for chains.
+    template <typename Derived>
+    struct Expr
+    {
+        const Derived& self() const { return static_cast<const Derived&>(*this); }
+    };
+
+    template <typename Matrix, bool IsAffine>
+    struct Operand : Expr<Operand<Matrix, IsAffine>>
+    {
+        typedef Matrix MatrixType;
+        static constexpr bool isAffine = IsAffine;
+
+        explicit Operand(const Matrix& _value) : value(_value) {}
+
+        // The matrix itself; storage is only used by products.
+        const Matrix& evaluate(Matrix& storage) const { (void)storage; return value; }
+
+        template <typename Vector>
+        Vector transform(const Vector& v) const { return Detail::Transform(value, v); }
+
+        const Matrix& value;
+    };
+
+    template <typename Lhs, typename Rhs>
+    struct Product : Expr<Product<Lhs, Rhs>>
+    {
+        typedef typename Lhs::MatrixType MatrixType;
+        static constexpr bool isAffine = Lhs::isAffine && Rhs::isAffine;
+
+        static_assert(std::is_same<MatrixType, typename Rhs::MatrixType>::value, "Chains can't mix mat3f and mat4f");
+
+        Product(const Lhs& _lhs, const Rhs& _rhs) : lhs(_lhs), rhs(_rhs) {}
+
+        const MatrixType& evaluate(MatrixType& storage) const
+        {
+            MatrixType lhsStorage, rhsStorage;
+            Detail::Multiply(storage, lhs.evaluate(lhsStorage), rhs.evaluate(rhsStorage), std::integral_constant<bool, Rhs::isAffine>());
+            return storage;
+        }
+
+        template <typename Vector>
+        Vector transform(const Vector& v) const { return lhs.transform(rhs.transform(v)); }
+
+        operator MatrixType() const
+        {
+            MatrixType result;
+            evaluate(result);
+            return result;
+        }
+
+        Lhs lhs;
+        Rhs rhs;
+    };
+
+    inline Operand<mat4f, false> Lazy(const mat4f& matrix)   { return Operand<mat4f, false>(matrix); }
+    inline Operand<mat3f, false> Lazy(const mat3f& matrix)   { return Operand<mat3f, false>(matrix); }
+    inline Operand<mat4f, true>  Affine(const mat4f& matrix) { return Operand<mat4f, true>(matrix); }
+
+    template <typename Lhs, typename Rhs>
+    Product<Lhs, Rhs> operator*(const Expr<Lhs>& lhs, const Expr<Rhs>& rhs)
+    {
+        return Product<Lhs, Rhs>(lhs.self(), rhs.self());
+    }
+
+    template <typename Lhs>
+    Product<Lhs, Operand<typename Lhs::MatrixType, false>> operator*(const Expr<Lhs>& lhs, const typename Lhs::MatrixType& rhs)
+    {
+        return Product<Lhs, Operand<typename Lhs::MatrixType, false>>(lhs.self(), Operand<typename Lhs::MatrixType, false>(rhs));
+    }
+
+    template <typename Rhs>
+    Product<Operand<typename Rhs::MatrixType, false>, Rhs> operator*(const typename Rhs::MatrixType& lhs, const Expr<Rhs>& rhs)
+    {
+        return Product<Operand<typename Rhs::MatrixType, false>, Rhs>(Operand<typename Rhs::MatrixType, false>(lhs), rhs.self());
+    }
+
+    template <typename Lhs>
+    vec4f operator*(const Expr<Lhs>& lhs, const vec4f& v)
+    {
+        return lhs.self().transform(v);
+    }
+
+    template <typename Lhs>
+    vec3f operator*(const Expr<Lhs>& lhs, const vec3f& v)
+    {
+        return lhs.self().transform(v);
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <stddef.h>
+#include <cstdint>
+#include "CNSDKGettingStartedMath.h"
+
+// Procedural meshes generated at compile time. The builders are constexpr, so
+//
+//     static constexpr CubeMesh cube = MakeCubeMesh(vec3f(1.0f), colors);
+//
+// places the vertices and indices in read-only data, ready to upload, with nothing built at startup.
+// Every quad is split into triangles (0, 2, 1) and (0, 3, 2) of its corners.
+
+// Position and color, the XYZ|RGB layout of the sample's vertex buffers.
+struct MeshVertex
+{
+    vec3f position;
+    vec3f color;
+};
+
+static_assert(sizeof(MeshVertex) == 6 * sizeof(float), "MeshVertex layout");
+
+// Fixed-size mesh with 32-bit indices.
+template <size_t VertexCount, size_t IndexCount>
+struct StaticMesh
+{
+    static constexpr size_t vertexCount = VertexCount;
+    static constexpr size_t indexCount  = IndexCount;
+
+    MeshVertex    vertices[VertexCount];
+    std::uint32_t indices[IndexCount];
+};
+
+typedef StaticMesh<24, 36> CubeMesh;
+
+namespace MeshDetail
+{
+    // Write the two triangles of quad c0 c1 c2 c3 at index start.
+    template <size_t VertexCount, size_t IndexCount>
+    constexpr void AddQuad(StaticMesh<VertexCount, IndexCount>& mesh, size_t start, std::uint32_t c0, std::uint32_t c1, std::uint32_t c2, std::uint32_t c3)
+    {
+        mesh.indices[start + 0] = c0;
+        mesh.indices[start + 1] = c2;
+        mesh.indices[start + 2] = c1;
+        mesh.indices[start + 3] = c0;
+        mesh.indices[start + 4] = c3;
+        mesh.indices[start + 5] = c2;
+    }
+}
+
+// Box of the given size centered on the origin, z up. Each face has its own four vertices so it
+// can be flat colored, in the order bottom, left, front (-y), right, back, top. Faces point outward.
+constexpr CubeMesh MakeCubeMesh(const vec3f& size, const vec3f (&faceColors)[6])
+{
+    const vec3f lo = size * -0.5f;
+    const vec3f hi = lo + size;
+
+    const vec3f corners[8] =
+    {
+        vec3f(lo.x, lo.y, lo.z), // Left Near Bottom
+        vec3f(lo.x, hi.y, lo.z), // Left Far Bottom
+        vec3f(hi.x, hi.y, lo.z), // Right Far Bottom
+        vec3f(hi.x, lo.y, lo.z), // Right Near Bottom
+        vec3f(lo.x, lo.y, hi.z), // Left Near Top
+        vec3f(lo.x, hi.y, hi.z), // Left Far Top
+        vec3f(hi.x, hi.y, hi.z), // Right Far Top
+        vec3f(hi.x, lo.y, hi.z)  // Right Near Top
+    };
+
+    const int faces[6][4] =
+    {
+        {0,1,2,3}, // bottom
+        {1,0,4,5}, // left
+        {0,3,7,4}, // front
+        {3,2,6,7}, // right
+        {2,1,5,6}, // back
+        {4,7,6,5}  // top
+    };
+
+    CubeMesh mesh = {};
+    for (int i = 0; i < 6; i++)
+    {
+        for (int j = 0; j < 4; j++)
+            mesh.vertices[i * 4 + j] = MeshVertex{ corners[faces[i][j]], faceColors[i] };
+
+        const std::uint32_t base = (std::uint32_t)(i * 4);
+        MeshDetail::AddQuad(mesh, i * 6, base + 0, base + 1, base + 2, base + 3);
+    }
+    return mesh;
+}
+
+// Flat grid of Columns x Rows quads spanning origin to origin + edgeU + edgeV, vertices running
+// along edgeU first. Quads face along edgeU x edgeV, wound the same way as the cube's faces.
+template <int Columns, int Rows>
+constexpr StaticMesh<(Columns + 1) * (Rows + 1), Columns * Rows * 6> MakeGridMesh(const vec3f& origin, const vec3f& edgeU, const vec3f& edgeV, const vec3f& color)
+{
+    static_assert((Columns > 0) && (Rows > 0), "Grid needs at least one quad");
+
+    StaticMesh<(Columns + 1) * (Rows + 1), Columns * Rows * 6> mesh = {};
+    for (int v = 0; v <= Rows; v++)
+    {
+        for (int u = 0; u <= Columns; u++)
+        {
+            const vec3f position = origin + edgeU * ((float)u / (float)Columns) + edgeV * ((float)v / (float)Rows);
+            mesh.vertices[v * (Columns + 1) + u] = MeshVertex{ position, color };
+        }
+    }
+
+    for (int v = 0; v < Rows; v++)
+    {
+        for (int u = 0; u < Columns; u++)
+        {
+            const std::uint32_t c0 = (std::uint32_t)(v * (Columns + 1) + u);
+            const std::uint32_t c3 = c0 + (Columns + 1);
+            MeshDetail::AddQuad(mesh, (v * Columns + u) * 6, c0, c0 + 1, c3 + 1, c3);
+        }
+    }
+    return mesh;
+}
+
+// Single quad, e.g. a calibration target.
+constexpr StaticMesh<4, 6> MakeQuadMesh(const vec3f& origin, const vec3f& edgeU, const vec3f& edgeV, const vec3f& color)
+{
+    return MakeGridMesh<1, 1>(origin, edgeU, edgeV, color);
+}
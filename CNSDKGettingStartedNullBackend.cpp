@@ -0,0 +1,319 @@
+#include <string.h>
+#include "CNSDKGettingStartedNullBackend.h"
+
+const char* GetRenderCommandName(RenderCommandType type)
+{
+    switch (type)
+    {
+    case RenderCommandType::Clear:             return "Clear";
+    case RenderCommandType::SetRenderTarget:   return "SetRenderTarget";
+    case RenderCommandType::SetViewport:       return "SetViewport";
+    case RenderCommandType::SetPipeline:       return "SetPipeline";
+    case RenderCommandType::SetVertexBuffer:   return "SetVertexBuffer";
+    case RenderCommandType::SetIndexBuffer:    return "SetIndexBuffer";
+    case RenderCommandType::SetConstantBuffer: return "SetConstantBuffer";
+    case RenderCommandType::UpdateBuffer:      return "UpdateBuffer";
+    case RenderCommandType::UpdateTexture:     return "UpdateTexture";
+    case RenderCommandType::DrawIndexed:       return "DrawIndexed";
+    case RenderCommandType::Interlace:         return "Interlace";
+    case RenderCommandType::Present:           return "Present";
+    }
+    return "Unknown";
+}
+
+NullRenderBackend::NullRenderBackend()
+{
+    Resource backBuffer;
+    backBuffer.kind = ResourceKind::BackBuffer;
+    m_resources.push_back(backBuffer);
+}
+
+RenderHandle NullRenderBackend::createBuffer(RenderBufferType type, const void* data, size_t size)
+{
+    if ((size == 0) || ((type != RenderBufferType::Constant) && (data == nullptr)))
+    {
+        fail(L"Buffer without data");
+        return kNullRenderHandle;
+    }
+
+    Resource resource;
+    resource.kind = (type == RenderBufferType::Vertex) ? ResourceKind::VertexBuffer : (type == RenderBufferType::Index) ? ResourceKind::IndexBuffer : ResourceKind::ConstantBuffer;
+    resource.size = size;
+    m_stats.uploadBytes += (data != nullptr) ? size : 0;
+    return add(resource);
+}
+
+RenderHandle NullRenderBackend::createTexture(const RenderTextureDesc& desc, const TextureMip* mips)
+{
+    if ((desc.width <= 0) || (desc.height <= 0) || (desc.mipCount <= 0) || (mips == nullptr))
+    {
+        fail(L"Invalid texture");
+        return kNullRenderHandle;
+    }
+
+    Resource resource;
+    resource.kind    = ResourceKind::Texture;
+    resource.texture = desc;
+    for (int level = 0; level < desc.mipCount; level++)
+        m_stats.uploadBytes += mips[level].rowPitch * mips[level].height;
+    return add(resource);
+}
+
+RenderHandle NullRenderBackend::createPipeline(const RenderPipelineDesc& desc)
+{
+    (void)desc;
+
+    Resource resource;
+    resource.kind = ResourceKind::Pipeline;
+    return add(resource);
+}
+
+RenderHandle NullRenderBackend::createRenderTarget(int width, int height, bool sRGB)
+{
+    if ((width <= 0) || (height <= 0))
+    {
+        fail(L"Invalid render target size");
+        return kNullRenderHandle;
+    }
+
+    Resource resource;
+    resource.kind           = ResourceKind::RenderTarget;
+    resource.texture.width  = width;
+    resource.texture.height = height;
+    resource.texture.sRGB   = sRGB;
+    return add(resource);
+}
+
+bool NullRenderBackend::updateTexture(RenderHandle texture, const TextureMip* mips)
+{
+    const Resource* resource = get(texture, ResourceKind::Texture, L"UpdateTexture of an unknown texture");
+    if ((resource == nullptr) || (mips == nullptr))
+        return false;
+
+    for (int level = 0; level < resource->texture.mipCount; level++)
+        m_stats.uploadBytes += mips[level].rowPitch * mips[level].height;
+    record(RenderCommandType::UpdateTexture, texture);
+    return true;
+}
+
+void NullRenderBackend::destroy(RenderHandle resource)
+{
+    if (resource == kNullRenderHandle)
+        return;
+    if ((resource == kBackBuffer) || (resource > m_resources.size()) || (m_resources[resource - 1].kind == ResourceKind::None))
+    {
+        fail(L"Destroy of an unknown resource");
+        return;
+    }
+
+    m_resources[resource - 1] = Resource();
+    m_freeHandles.push_back(resource);
+
+    // Draws must bind a live resource again.
+    for (RenderHandle* bound : { &m_target, &m_pipeline, &m_vertexBuffer, &m_indexBuffer })
+    {
+        if (*bound == resource)
+            *bound = kNullRenderHandle;
+    }
+}
+
+void NullRenderBackend::clear(RenderHandle target, const float color[4])
+{
+    if ((target != kBackBuffer) && (get(target, ResourceKind::RenderTarget, L"Clear of an unknown render target") == nullptr))
+        return;
+
+    RenderCommand& command = record(RenderCommandType::Clear, target);
+    memcpy(command.color, color, sizeof(command.color));
+}
+
+void NullRenderBackend::setRenderTarget(RenderHandle target)
+{
+    if ((target != kBackBuffer) && (get(target, ResourceKind::RenderTarget, L"SetRenderTarget of an unknown render target") == nullptr))
+        return;
+
+    m_target = target;
+    record(RenderCommandType::SetRenderTarget, target);
+}
+
+void NullRenderBackend::setViewport(const RenderViewport& viewport)
+{
+    record(RenderCommandType::SetViewport).viewport = viewport;
+}
+
+void NullRenderBackend::setPipeline(RenderHandle pipeline)
+{
+    if (get(pipeline, ResourceKind::Pipeline, L"SetPipeline of an unknown pipeline") == nullptr)
+        return;
+
+    m_pipeline = pipeline;
+    record(RenderCommandType::SetPipeline, pipeline);
+}
+
+void NullRenderBackend::setVertexBuffer(RenderHandle buffer)
+{
+    if (get(buffer, ResourceKind::VertexBuffer, L"SetVertexBuffer of an unknown vertex buffer") == nullptr)
+        return;
+
+    m_vertexBuffer = buffer;
+    record(RenderCommandType::SetVertexBuffer, buffer);
+}
+
+void NullRenderBackend::setIndexBuffer(RenderHandle buffer)
+{
+    if (get(buffer, ResourceKind::IndexBuffer, L"SetIndexBuffer of an unknown index buffer") == nullptr)
+        return;
+
+    m_indexBuffer = buffer;
+    record(RenderCommandType::SetIndexBuffer, buffer);
+}
+
+void NullRenderBackend::setConstantBuffer(RenderHandle buffer)
+{
+    if (get(buffer, ResourceKind::ConstantBuffer, L"SetConstantBuffer of an unknown constant buffer") == nullptr)
+        return;
+
+    record(RenderCommandType::SetConstantBuffer, buffer);
+}
+
+void NullRenderBackend::updateBuffer(RenderHandle buffer, const void* data, size_t size)
+{
+    const Resource* resource = get(buffer, ResourceKind::ConstantBuffer, L"UpdateBuffer of an unknown constant buffer");
+    if (resource == nullptr)
+        return;
+    if (size > resource->size)
+    {
+        fail(L"UpdateBuffer past the end of the buffer");
+        return;
+    }
+
+    RenderCommand& command = record(RenderCommandType::UpdateBuffer, buffer);
+    command.count = (int)size;
+    command.first = (int)m_data.size();
+
+    const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+    m_data.insert(m_data.end(), bytes, bytes + size);
+    m_stats.uploadBytes += size;
+}
+
+void NullRenderBackend::drawIndexed(int indexCount, int firstIndex)
+{
+    if ((m_target == kNullRenderHandle) || (m_pipeline == kNullRenderHandle) || (m_vertexBuffer == kNullRenderHandle) || (m_indexBuffer == kNullRenderHandle))
+    {
+        fail(L"DrawIndexed without a render target, pipeline, vertex buffer and index buffer");
+        return;
+    }
+    if ((indexCount < 0) || (firstIndex < 0) || ((size_t)(firstIndex + indexCount) * sizeof(std::uint32_t) > m_resources[m_indexBuffer - 1].size))
+    {
+        fail(L"DrawIndexed past the end of the index buffer");
+        return;
+    }
+
+    RenderCommand& command = record(RenderCommandType::DrawIndexed);
+    command.count = indexCount;
+    command.first = firstIndex;
+
+    m_stats.draws++;
+    m_stats.triangles += indexCount / 3;
+}
+
+void NullRenderBackend::interlace(RenderHandle source, int viewWidth, int viewHeight, InterlaceMode mode)
+{
+    const ResourceKind kind = (mode == InterlaceMode::Views) ? ResourceKind::RenderTarget : ResourceKind::Texture;
+    if (get(source, kind, L"Interlace of an unknown source") == nullptr)
+        return;
+
+    RenderCommand& command = record(RenderCommandType::Interlace, source);
+    command.count = viewWidth;
+    command.first = viewHeight;
+    command.mode  = mode;
+}
+
+void NullRenderBackend::present()
+{
+    record(RenderCommandType::Present);
+
+    // Keep this frame's commands and reuse the previous frame's storage for the next.
+    m_frameCommands.swap(m_commands);
+    m_frameData.swap(m_data);
+    m_commands.clear();
+    m_data.clear();
+
+    m_stats.frames++;
+}
+
+void NullRenderBackend::printFrame(FILE* file) const
+{
+    for (const RenderCommand& command : m_frameCommands)
+    {
+        fprintf(file, "%-18s", GetRenderCommandName(command.type));
+        switch (command.type)
+        {
+        case RenderCommandType::Clear:
+            fprintf(file, " target %u color %.3f %.3f %.3f %.3f", command.resource, command.color[0], command.color[1], command.color[2], command.color[3]);
+            break;
+        case RenderCommandType::SetViewport:
+            fprintf(file, " %g %g %g x %g depth %g..%g", command.viewport.x, command.viewport.y, command.viewport.width, command.viewport.height, command.viewport.minDepth, command.viewport.maxDepth);
+            break;
+        case RenderCommandType::UpdateBuffer:
+            fprintf(file, " buffer %u %d bytes", command.resource, command.count);
+            break;
+        case RenderCommandType::DrawIndexed:
+            fprintf(file, " %d indices from %d", command.count, command.first);
+            break;
+        case RenderCommandType::Interlace:
+            fprintf(file, " source %u views %d x %d %s", command.resource, command.count, command.first, (command.mode == InterlaceMode::Views) ? "views" : "picture");
+            break;
+        case RenderCommandType::Present:
+            break;
+        default:
+            fprintf(file, " %u", command.resource);
+            break;
+        }
+        fprintf(file, "\n");
+    }
+}
+
+int NullRenderBackend::getResourceCount() const
+{
+    return (int)(m_resources.size() - m_freeHandles.size()) - 1;
+}
+
+RenderHandle NullRenderBackend::add(const Resource& resource)
+{
+    if (!m_freeHandles.empty())
+    {
+        const RenderHandle handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+        m_resources[handle - 1] = resource;
+        return handle;
+    }
+
+    m_resources.push_back(resource);
+    return (RenderHandle)m_resources.size();
+}
+
+const NullRenderBackend::Resource* NullRenderBackend::get(RenderHandle handle, ResourceKind kind, const wchar_t* error)
+{
+    if ((handle == kNullRenderHandle) || (handle > m_resources.size()) || (m_resources[handle - 1].kind != kind))
+    {
+        fail(error);
+        return nullptr;
+    }
+    return &m_resources[handle - 1];
+}
+
+RenderCommand& NullRenderBackend::record(RenderCommandType type, RenderHandle resource)
+{
+    m_commands.emplace_back();
+    RenderCommand& command = m_commands.back();
+    command.type     = type;
+    command.resource = resource;
+    m_stats.commands++;
+    return command;
+}
+
+void NullRenderBackend::fail(const wchar_t* error)
+{
+    if (m_error == nullptr)
+        m_error = error;
+}
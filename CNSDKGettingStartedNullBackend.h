@@ -0,0 +1,135 @@
+#pragma once
+
+#include <stdio.h>
+#include <cstdint>
+#include <vector>
+#include "CNSDKGettingStartedRenderBackend.h"
+
+enum class RenderCommandType
+{
+    Clear,
+    SetRenderTarget,
+    SetViewport,
+    SetPipeline,
+    SetVertexBuffer,
+    SetIndexBuffer,
+    SetConstantBuffer,
+    UpdateBuffer,
+    UpdateTexture,
+    DrawIndexed,
+    Interlace,
+    Present
+};
+
+const char* GetRenderCommandName(RenderCommandType type);
+
+// A recorded command. Fields a command doesn't use are zero.
+struct RenderCommand
+{
+    RenderCommandType type        = RenderCommandType::Present;
+    RenderHandle      resource    = kNullRenderHandle; // Target, pipeline, buffer, texture or interlace source
+    RenderViewport    viewport;                        // SetViewport
+    float             color[4]    = {};                // Clear
+    int               count       = 0;                 // DrawIndexed index count, UpdateBuffer size, Interlace view width
+    int               first       = 0;                 // DrawIndexed first index, UpdateBuffer offset in the frame's data, Interlace view height
+    InterlaceMode     mode        = InterlaceMode::Views;
+};
+
+// Backend that draws nothing: it records the commands of each frame and checks them against the
+// resources they use, so the frame loop runs and can be timed and inspected without a GPU.
+// Misuse (unknown handles, draws without a pipeline or buffers, indices past the index buffer)
+// is reported through getError(), the first failure only. Not thread-safe.
+class NullRenderBackend : public RenderBackend
+{
+public:
+
+    struct Stats
+    {
+        std::uint64_t frames      = 0;
+        std::uint64_t commands    = 0;
+        std::uint64_t draws       = 0;
+        std::uint64_t triangles   = 0;
+        std::uint64_t uploadBytes = 0; // Buffer and texture updates, creation included
+    };
+
+    NullRenderBackend();
+
+    RenderHandle createBuffer(RenderBufferType type, const void* data, size_t size) override;
+    RenderHandle createTexture(const RenderTextureDesc& desc, const TextureMip* mips) override;
+    RenderHandle createPipeline(const RenderPipelineDesc& desc) override;
+    RenderHandle createRenderTarget(int width, int height, bool sRGB) override;
+    RenderHandle getBackBuffer() const override { return kBackBuffer; }
+    bool         updateTexture(RenderHandle texture, const TextureMip* mips) override;
+    void         destroy(RenderHandle resource) override;
+
+    void clear(RenderHandle target, const float color[4]) override;
+    void setRenderTarget(RenderHandle target) override;
+    void setViewport(const RenderViewport& viewport) override;
+    void setPipeline(RenderHandle pipeline) override;
+    void setVertexBuffer(RenderHandle buffer) override;
+    void setIndexBuffer(RenderHandle buffer) override;
+    void setConstantBuffer(RenderHandle buffer) override;
+    void updateBuffer(RenderHandle buffer, const void* data, size_t size) override;
+    void drawIndexed(int indexCount, int firstIndex) override;
+    void interlace(RenderHandle source, int viewWidth, int viewHeight, InterlaceMode mode) override;
+    void present() override;
+
+    const wchar_t* getError() const override { return m_error; }
+
+    // Commands of the last presented frame, Present included, and the data of its buffer updates.
+    const std::vector<RenderCommand>& getFrameCommands() const { return m_frameCommands; }
+    const std::vector<std::uint8_t>&  getFrameData() const     { return m_frameData; }
+
+    // Print the last presented frame's commands, one per line.
+    void printFrame(FILE* file) const;
+
+    int   getResourceCount() const; // Live resources, the back buffer excluded
+    Stats getStats() const          { return m_stats; }
+
+private:
+
+    enum class ResourceKind
+    {
+        None,
+        BackBuffer,
+        VertexBuffer,
+        IndexBuffer,
+        ConstantBuffer,
+        Texture,
+        RenderTarget,
+        Pipeline
+    };
+
+    struct Resource
+    {
+        ResourceKind      kind = ResourceKind::None;
+        size_t            size = 0; // Buffer bytes
+        RenderTextureDesc texture;
+    };
+
+    static const RenderHandle kBackBuffer = 1;
+
+    RenderHandle add(const Resource& resource);
+
+    // The resource of a handle if it's live and of kind, otherwise null after recording an error.
+    const Resource* get(RenderHandle handle, ResourceKind kind, const wchar_t* error);
+
+    RenderCommand& record(RenderCommandType type, RenderHandle resource = kNullRenderHandle);
+    void           fail(const wchar_t* error);
+
+    std::vector<Resource>      m_resources;     // Index handle - 1
+    std::vector<RenderHandle>  m_freeHandles;
+    std::vector<RenderCommand> m_commands;      // Current frame
+    std::vector<std::uint8_t>  m_data;
+    std::vector<RenderCommand> m_frameCommands; // Last presented frame
+    std::vector<std::uint8_t>  m_frameData;
+
+    // Bound state, for checking draws.
+    RenderHandle               m_target        = kNullRenderHandle;
+    RenderHandle               m_pipeline      = kNullRenderHandle;
+    RenderHandle               m_vertexBuffer  = kNullRenderHandle;
+    RenderHandle               m_indexBuffer   = kNullRenderHandle;
+
+    const wchar_t*             m_error         = nullptr;
+    Stats                      m_stats;
+};
@@ -0,0 +1,626 @@
+#include <string.h>
+#include <atomic>
+#include "CNSDKGettingStartedPixels.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PIXELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define PIXELS_NEON
+#include <arm_neon.h>
+#endif
+
+// MSVC compiles any intrinsic without special flags; GCC and Clang need the
+// instruction set enabled per function so the rest of the file stays baseline.
+#if defined(PIXELS_X86) && !defined(_MSC_VER)
+#define PIXELS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PIXELS_TARGET(isa)
+#endif
+
+namespace
+{
+    // Marks a destination channel that doesn't exist in the source.
+    const std::int8_t kFillChannel = -1;
+
+    // Gray weights, sum to 128 so they fit signed 8-bit SIMD multiplies.
+    const int kLumaR = 38;
+    const int kLumaG = 75;
+    const int kLumaB = 15;
+
+    enum Channel { R, G, B, A, Y };
+
+    const Channel* GetChannelLayout(PixelFormat format)
+    {
+        static const Channel rgb[]  = { R, G, B };
+        static const Channel bgr[]  = { B, G, R };
+        static const Channel rgba[] = { R, G, B, A };
+        static const Channel bgra[] = { B, G, R, A };
+        static const Channel gray[] = { Y };
+
+        switch (format)
+        {
+        case PixelFormat::RGB8:  return rgb;
+        case PixelFormat::BGR8:  return bgr;
+        case PixelFormat::RGBA8: return rgba;
+        case PixelFormat::BGRA8: return bgra;
+        case PixelFormat::Gray8: return gray;
+        }
+        return gray;
+    }
+
+    // Describes where each destination channel comes from.
+    struct ChannelMap
+    {
+        int          srcChannels = 0;
+        int          dstChannels = 0;
+        std::int8_t  source[4]   = {};   // Source channel per destination channel, or kFillChannel
+        std::uint8_t fill[4]     = {};   // Value for kFillChannel channels
+        std::int8_t  luma[4]     = {};   // Gray weight per source channel (gray destinations only)
+        bool         isLuma      = false;
+    };
+
+    ChannelMap BuildChannelMap(PixelFormat dstFormat, PixelFormat srcFormat)
+    {
+        ChannelMap map;
+        map.srcChannels = GetPixelFormatChannels(srcFormat);
+        map.dstChannels = GetPixelFormatChannels(dstFormat);
+
+        const Channel* srcLayout = GetChannelLayout(srcFormat);
+        const Channel* dstLayout = GetChannelLayout(dstFormat);
+
+        // Reduce color to gray.
+        if ((dstFormat == PixelFormat::Gray8) && (srcFormat != PixelFormat::Gray8))
+        {
+            map.isLuma = true;
+            for (int c = 0; c < map.srcChannels; c++)
+                map.luma[c] = (std::int8_t)((srcLayout[c] == R) ? kLumaR : (srcLayout[c] == G) ? kLumaG : (srcLayout[c] == B) ? kLumaB : 0);
+            return map;
+        }
+
+        for (int d = 0; d < map.dstChannels; d++)
+        {
+            map.source[d] = kFillChannel;
+            map.fill[d]   = 255;
+
+            for (int s = 0; s < map.srcChannels; s++)
+            {
+                // Gray replicates into every color channel.
+                const bool match = (srcLayout[s] == dstLayout[d]) || ((srcLayout[s] == Y) && (dstLayout[d] != A));
+                if (match)
+                {
+                    map.source[d] = (std::int8_t)s;
+                    break;
+                }
+            }
+        }
+        return map;
+    }
+
+    //
+    // Scalar reference kernels, also used for tails.
+    //
+
+    void ShuffleScalar(std::uint8_t* dst, const std::uint8_t* src, size_t count, const ChannelMap& map)
+    {
+        const int S = map.srcChannels;
+        const int D = map.dstChannels;
+        for (size_t i = 0; i < count; i++, src += S, dst += D)
+            for (int d = 0; d < D; d++)
+                dst[d] = (map.source[d] == kFillChannel) ? map.fill[d] : src[map.source[d]];
+    }
+
+    void LumaScalar(std::uint8_t* dst, const std::uint8_t* src, size_t count, const ChannelMap& map)
+    {
+        const int S = map.srcChannels;
+        for (size_t i = 0; i < count; i++, src += S)
+        {
+            int sum = 64;
+            for (int s = 0; s < S; s++)
+                sum += map.luma[s] * src[s];
+            dst[i] = (std::uint8_t)(sum >> 7);
+        }
+    }
+
+    void FillChannelScalar(std::uint8_t* pixels, size_t count, int channel, std::uint8_t value)
+    {
+        for (size_t i = 0; i < count; i++)
+            pixels[i * 4 + channel] = value;
+    }
+
+    // Kernel table for one instruction set.
+    struct PixelKernels
+    {
+        PixelKernelSet set;
+        void (*shuffle)(std::uint8_t* dst, const std::uint8_t* src, size_t count, const ChannelMap& map);
+        void (*luma)(std::uint8_t* dst, const std::uint8_t* src, size_t count, const ChannelMap& map);
+        void (*fillChannel)(std::uint8_t* pixels, size_t count, int channel, std::uint8_t value);
+    };
+
+    const PixelKernels kScalarKernels = { PixelKernelSet::Scalar, ShuffleScalar, LumaScalar, FillChannelScalar };
+
+    // Number of whole pixels from i that can be processed while reading readBytes and writing writeBytes per step.
+    inline bool HasRoom(size_t i, size_t count, int S, int D, size_t readBytes, size_t writeBytes)
+    {
+        const size_t remaining = count - i;
+        return (remaining * S >= readBytes) && (remaining * D >= writeBytes);
+    }
+
+#if defined(PIXELS_X86)
+
+    // Build a pshufb mask moving pixels [firstPixel, firstPixel + 4) of a source register into 4 destination pixels.
+    void BuildShuffleMask(std::uint8_t mask[16], std::uint8_t fill[16], const ChannelMap& map, int firstPixel)
+    {
+        memset(mask, 0x80, 16);
+        memset(fill, 0, 16);
+        for (int p = 0; p < 4; p++)
+        {
+            for (int d = 0; d < map.dstChannels; d++)
+            {
+                const int o = p * map.dstChannels + d;
+                if (map.source[d] == kFillChannel)
+                    fill[o] = map.fill[d];
+                else
+                    mask[o] = (std::uint8_t)((firstPixel + p) * map.srcChannels + map.source[d]);
+            }
+        }
+    }
+
+    //
+    // SSSE3 kernels, 4 pixels per shuffle.
+    //
+
+    PIXELS_TARGET("ssse3")
+    void ShuffleSSSE3(std::uint8_t* dst, const std::uint8_t* src, size_t count, const ChannelMap& map)
+    {
+        const int S = map.srcChannels;
+        const int D = map.dstChannels;
+        size_t i = 0;
+
+        alignas(16) std::uint8_t mask[4][16];
+        alignas(16) std::uint8_t fill[4][16];
+
+        if (S == 1)
+        {
+            // 16 gray pixels per load, expanded with one shuffle per 4 pixels.
+            __m128i m[4], f[4];
+            for (int k = 0; k < 4; k++)
+            {
+                BuildShuffleMask(mask[k], fill[k], map, k * 4);
+                m[k] = _mm_load_si128((const __m128i*)mask[k]);
+                f[k] = _mm_load_si128((const __m128i*)fill[k]);
+            }
+
+            for (; HasRoom(i, count, S, D, 16, 3 * 4 * D + 16); i += 16)
+            {
+                const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+                std::uint8_t* d = dst + i * D;
+                for (int k = 0; k < 4; k++)
+                    _mm_storeu_si128((__m128i*)(d + k * 4 * D), _mm_or_si128(_mm_shuffle_epi8(v, m[k]), f[k]));
+            }
+        }
+        else
+        {
+            BuildShuffleMask(mask[0], fill[0], map, 0);
+            const __m128i m = _mm_load_si128((const __m128i*)mask[0]);
+            const __m128i f = _mm_load_si128((const __m128i*)fill[0]);
+
+            // Loads and stores are 16 bytes even when only 12 are used; the
+            // extra bytes are re-written by the next step.
+            for (; HasRoom(i, count, S, D, 16, 16); i += 4)
+            {
+                const __m128i v = _mm_loadu_si128((const __m128i*)(src + i * S));
+                _mm_storeu_si128((__m128i*)(dst + i * D), _mm_or_si128(_mm_shuffle_epi8(v, m), f));
+            }
+        }
+
+        ShuffleScalar(dst + i * D, src + i * S, count - i, map);
+    }
+
+    PIXELS_TARGET("ssse3")
+    void LumaSSSE3(std::uint8_t* dst, const std::uint8_t* src, size_t count, const ChannelMap& map)
+    {
+        const int S = map.srcChannels;
+        size_t i = 0;
+
+        // Spread source pixels to 4 bytes each, unused byte zeroed.
+        alignas(16) std::uint8_t mask[16];
+        alignas(16) std::int8_t  weights[16];
+        for (int p = 0; p < 4; p++)
+        {
+            for (int c = 0; c < 4; c++)
+            {
+                mask[p * 4 + c]    = (c < S) ? (std::uint8_t)(p * S + c) : 0x80;
+                weights[p * 4 + c] = (c < S) ? map.luma[c] : 0;
+            }
+        }
+
+        const __m128i m    = _mm_load_si128((const __m128i*)mask);
+        const __m128i w    = _mm_load_si128((const __m128i*)weights);
+        const __m128i ones = _mm_set1_epi16(1);
+        const __m128i half = _mm_set1_epi32(64);
+
+        for (; HasRoom(i, count, S, 1, 4 * S + 16, 8); i += 8)
+        {
+            const __m128i p0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + i * S)), m);
+            const __m128i p1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + i * S + 4 * S)), m);
+
+            // (w0*c0 + w1*c1) + (w2*c2 + w3*c3) per pixel.
+            __m128i s0 = _mm_madd_epi16(_mm_maddubs_epi16(p0, w), ones);
+            __m128i s1 = _mm_madd_epi16(_mm_maddubs_epi16(p1, w), ones);
+            s0 = _mm_srli_epi32(_mm_add_epi32(s0, half), 7);
+            s1 = _mm_srli_epi32(_mm_add_epi32(s1, half), 7);
+
+            const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(s0, s1), _mm_setzero_si128());
+            _mm_storel_epi64((__m128i*)(dst + i), packed);
+        }
+
+        LumaScalar(dst + i, src + i * S, count - i, map);
+    }
+
+    PIXELS_TARGET("ssse3")
+    void FillChannelSSSE3(std::uint8_t* pixels, size_t count, int channel, std::uint8_t value)
+    {
+        const std::uint32_t channelMask = 0xFFu << (channel * 8);
+        const __m128i keep = _mm_set1_epi32((int)~channelMask);
+        const __m128i set  = _mm_set1_epi32((int)(((std::uint32_t)value << (channel * 8))));
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i* p = (__m128i*)(pixels + i * 4);
+            _mm_storeu_si128(p, _mm_or_si128(_mm_and_si128(_mm_loadu_si128(p), keep), set));
+        }
+        FillChannelScalar(pixels + i * 4, count - i, channel, value);
+    }
+
+    const PixelKernels kSSSE3Kernels = { PixelKernelSet::SSSE3, ShuffleSSSE3, LumaSSSE3, FillChannelSSSE3 };
+
+    //
+    // AVX2 kernels, 8 pixels per shuffle. vpshufb works within 128-bit lanes,
+    // so each lane gets its own 4 source pixels.
+    //
+
+    PIXELS_TARGET("avx2")
+    void ShuffleAVX2(std::uint8_t* dst, const std::uint8_t* src, size_t count, const ChannelMap& map)
+    {
+        const int S = map.srcChannels;
+        const int D = map.dstChannels;
+        size_t i = 0;
+
+        alignas(16) std::uint8_t mask[4][16];
+        alignas(16) std::uint8_t fill[4][16];
+
+        // Packs the 12 used bytes of each lane together for 3-channel output.
+        const __m256i compact3 = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+
+        if (S == 1)
+        {
+            // 16 gray pixels per load, lane 0 expands pixels 4k.. and lane 1 pixels 4k+4..
+            __m256i m[2], f[2];
+            for (int k = 0; k < 4; k++)
+                BuildShuffleMask(mask[k], fill[k], map, k * 4);
+            for (int k = 0; k < 2; k++)
+            {
+                m[k] = _mm256_setr_m128i(_mm_load_si128((const __m128i*)mask[k * 2]), _mm_load_si128((const __m128i*)mask[k * 2 + 1]));
+                f[k] = _mm256_setr_m128i(_mm_load_si128((const __m128i*)fill[k * 2]), _mm_load_si128((const __m128i*)fill[k * 2 + 1]));
+            }
+
+            for (; HasRoom(i, count, S, D, 16, 8 * D + 32); i += 16)
+            {
+                const __m256i v = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(src + i)));
+                std::uint8_t* d = dst + i * D;
+                for (int k = 0; k < 2; k++)
+                {
+                    __m256i r = _mm256_or_si256(_mm256_shuffle_epi8(v, m[k]), f[k]);
+                    if (D == 3)
+                        r = _mm256_permutevar8x32_epi32(r, compact3);
+                    _mm256_storeu_si256((__m256i*)(d + k * 8 * D), r);
+                }
+            }
+        }
+        else
+        {
+            BuildShuffleMask(mask[0], fill[0], map, 0);
+            const __m256i m = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)mask[0]));
+            const __m256i f = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)fill[0]));
+
+            for (; HasRoom(i, count, S, D, 4 * S + 16, 32); i += 8)
+            {
+                const __m128i lo = _mm_loadu_si128((const __m128i*)(src + i * S));
+                const __m128i hi = _mm_loadu_si128((const __m128i*)(src + i * S + 4 * S));
+                __m256i r = _mm256_or_si256(_mm256_shuffle_epi8(_mm256_setr_m128i(lo, hi), m), f);
+                if (D == 3)
+                    r = _mm256_permutevar8x32_epi32(r, compact3);
+                _mm256_storeu_si256((__m256i*)(dst + i * D), r);
+            }
+        }
+
+        ShuffleScalar(dst + i * D, src + i * S, count - i, map);
+    }
+
+    PIXELS_TARGET("avx2")
+    void FillChannelAVX2(std::uint8_t* pixels, size_t count, int channel, std::uint8_t value)
+    {
+        const std::uint32_t channelMask = 0xFFu << (channel * 8);
+        const __m256i keep = _mm256_set1_epi32((int)~channelMask);
+        const __m256i set  = _mm256_set1_epi32((int)(((std::uint32_t)value << (channel * 8))));
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i* p = (__m256i*)(pixels + i * 4);
+            _mm256_storeu_si256(p, _mm256_or_si256(_mm256_and_si256(_mm256_loadu_si256(p), keep), set));
+        }
+        FillChannelScalar(pixels + i * 4, count - i, channel, value);
+    }
+
+    // Gray reduction is bound by the horizontal adds, the SSSE3 version is as fast.
+    const PixelKernels kAVX2Kernels = { PixelKernelSet::AVX2, ShuffleAVX2, LumaSSSE3, FillChannelAVX2 };
+
+    struct CPUFeatures
+    {
+        bool ssse3 = false;
+        bool avx2  = false;
+    };
+
+    CPUFeatures DetectCPUFeatures()
+    {
+        CPUFeatures features;
+
+        unsigned int regs[4] = {};
+        auto cpuid = [&regs](unsigned int leaf, unsigned int subLeaf) -> bool
+        {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuidex(info, (int)leaf, (int)subLeaf);
+            for (int r = 0; r < 4; r++)
+                regs[r] = (unsigned int)info[r];
+            return true;
+#else
+            return __get_cpuid_count(leaf, subLeaf, &regs[0], &regs[1], &regs[2], &regs[3]) != 0;
+#endif
+        };
+
+        if (!cpuid(1, 0))
+            return features;
+
+        features.ssse3 = (regs[2] & (1u << 9)) != 0;
+
+        // AVX state must be enabled by the OS as well as supported by the CPU.
+        const bool osxsave = (regs[2] & (1u << 27)) != 0;
+        const bool avx     = (regs[2] & (1u << 28)) != 0;
+        bool ymmEnabled = false;
+        if (osxsave && avx)
+        {
+#if defined(_MSC_VER)
+            ymmEnabled = (_xgetbv(0) & 6) == 6;
+#else
+            unsigned int eax = 0, edx = 0;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            ymmEnabled = (eax & 6) == 6;
+#endif
+        }
+
+        if (ymmEnabled && cpuid(7, 0))
+            features.avx2 = (regs[1] & (1u << 5)) != 0;
+
+        return features;
+    }
+
+    const CPUFeatures& GetCPUFeatures()
+    {
+        static const CPUFeatures features = DetectCPUFeatures();
+        return features;
+    }
+
+#elif defined(PIXELS_NEON)
+
+    //
+    // NEON kernels, 16 pixels per step using the structured (de)interleaving loads and stores.
+    //
+
+    uint8x16_t SelectChannel(const uint8x16_t* channels, const ChannelMap& map, int d)
+    {
+        return (map.source[d] == kFillChannel) ? vdupq_n_u8(map.fill[d]) : channels[map.source[d]];
+    }
+
+    void ShuffleNEON(std::uint8_t* dst, const std::uint8_t* src, size_t count, const ChannelMap& map)
+    {
+        const int S = map.srcChannels;
+        const int D = map.dstChannels;
+        size_t i = 0;
+
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16_t in[4];
+            if (S == 1)
+            {
+                in[0] = vld1q_u8(src + i);
+            }
+            else if (S == 3)
+            {
+                const uint8x16x3_t v = vld3q_u8(src + i * 3);
+                in[0] = v.val[0]; in[1] = v.val[1]; in[2] = v.val[2];
+            }
+            else
+            {
+                const uint8x16x4_t v = vld4q_u8(src + i * 4);
+                in[0] = v.val[0]; in[1] = v.val[1]; in[2] = v.val[2]; in[3] = v.val[3];
+            }
+
+            if (D == 3)
+            {
+                uint8x16x3_t out;
+                for (int d = 0; d < 3; d++)
+                    out.val[d] = SelectChannel(in, map, d);
+                vst3q_u8(dst + i * 3, out);
+            }
+            else if (D == 4)
+            {
+                uint8x16x4_t out;
+                for (int d = 0; d < 4; d++)
+                    out.val[d] = SelectChannel(in, map, d);
+                vst4q_u8(dst + i * 4, out);
+            }
+            else
+            {
+                vst1q_u8(dst + i, SelectChannel(in, map, 0));
+            }
+        }
+
+        ShuffleScalar(dst + i * D, src + i * S, count - i, map);
+    }
+
+    void LumaNEON(std::uint8_t* dst, const std::uint8_t* src, size_t count, const ChannelMap& map)
+    {
+        const int S = map.srcChannels;
+        const uint8x8_t w0 = vdup_n_u8((std::uint8_t)map.luma[0]);
+        const uint8x8_t w1 = vdup_n_u8((std::uint8_t)map.luma[1]);
+        const uint8x8_t w2 = vdup_n_u8((std::uint8_t)map.luma[2]);
+        size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8_t c0, c1, c2;
+            if (S == 3)
+            {
+                const uint8x8x3_t v = vld3_u8(src + i * 3);
+                c0 = v.val[0]; c1 = v.val[1]; c2 = v.val[2];
+            }
+            else
+            {
+                const uint8x8x4_t v = vld4_u8(src + i * 4);
+                c0 = v.val[0]; c1 = v.val[1]; c2 = v.val[2];
+            }
+
+            uint16x8_t sum = vmull_u8(c0, w0);
+            sum = vmlal_u8(sum, c1, w1);
+            sum = vmlal_u8(sum, c2, w2);
+
+            // Rounding shift is (sum + 64) >> 7, same as the scalar path.
+            vst1_u8(dst + i, vrshrn_n_u16(sum, 7));
+        }
+
+        LumaScalar(dst + i, src + i * S, count - i, map);
+    }
+
+    void FillChannelNEON(std::uint8_t* pixels, size_t count, int channel, std::uint8_t value)
+    {
+        const uint8x16_t v = vdupq_n_u8(value);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x4_t p = vld4q_u8(pixels + i * 4);
+            p.val[channel] = v;
+            vst4q_u8(pixels + i * 4, p);
+        }
+        FillChannelScalar(pixels + i * 4, count - i, channel, value);
+    }
+
+    const PixelKernels kNEONKernels = { PixelKernelSet::NEON, ShuffleNEON, LumaNEON, FillChannelNEON };
+
+#endif
+
+    const PixelKernels* GetKernels(PixelKernelSet kernelSet)
+    {
+        switch (kernelSet)
+        {
+#if defined(PIXELS_X86)
+        case PixelKernelSet::SSSE3: return GetCPUFeatures().ssse3 ? &kSSSE3Kernels : nullptr;
+        case PixelKernelSet::AVX2:  return GetCPUFeatures().avx2  ? &kAVX2Kernels  : nullptr;
+#elif defined(PIXELS_NEON)
+        case PixelKernelSet::NEON:  return &kNEONKernels;
+#endif
+        case PixelKernelSet::Scalar: return &kScalarKernels;
+        default:                     return nullptr;
+        }
+    }
+
+    const PixelKernels* SelectBestKernels()
+    {
+        const PixelKernelSet preference[] = { PixelKernelSet::AVX2, PixelKernelSet::NEON, PixelKernelSet::SSSE3 };
+        for (PixelKernelSet set : preference)
+            if (const PixelKernels* kernels = GetKernels(set))
+                return kernels;
+        return &kScalarKernels;
+    }
+
+    std::atomic<const PixelKernels*> g_pixelKernels(nullptr);
+
+    const PixelKernels& GetActiveKernels()
+    {
+        const PixelKernels* kernels = g_pixelKernels.load(std::memory_order_relaxed);
+        if (kernels == nullptr)
+        {
+            kernels = SelectBestKernels();
+            g_pixelKernels.store(kernels, std::memory_order_relaxed);
+        }
+        return *kernels;
+    }
+
+    // Below this many pixels the scalar loop beats building shuffle masks.
+    const size_t kMinVectorPixels = 16;
+}
+
+void ConvertPixels(void* dst, PixelFormat dstFormat, const void* src, PixelFormat srcFormat, size_t count)
+{
+    std::uint8_t*       d = (std::uint8_t*)dst;
+    const std::uint8_t* s = (const std::uint8_t*)src;
+
+    if (dstFormat == srcFormat)
+    {
+        memcpy(d, s, count * GetPixelFormatChannels(srcFormat));
+        return;
+    }
+
+    const ChannelMap map = BuildChannelMap(dstFormat, srcFormat);
+    const PixelKernels& kernels = (count < kMinVectorPixels) ? kScalarKernels : GetActiveKernels();
+
+    if (map.isLuma)
+        kernels.luma(d, s, count, map);
+    else
+        kernels.shuffle(d, s, count, map);
+}
+
+void FillPixelChannel(void* pixels, size_t count, int channel, std::uint8_t value)
+{
+    GetActiveKernels().fillChannel((std::uint8_t*)pixels, count, channel, value);
+}
+
+PixelKernelSet GetPixelKernelSet()
+{
+    return GetActiveKernels().set;
+}
+
+bool SetPixelKernelSet(PixelKernelSet kernelSet)
+{
+    const PixelKernels* kernels = GetKernels(kernelSet);
+    if (kernels == nullptr)
+        return false;
+
+    g_pixelKernels.store(kernels, std::memory_order_relaxed);
+    return true;
+}
+
+bool IsPixelKernelSetSupported(PixelKernelSet kernelSet)
+{
+    return GetKernels(kernelSet) != nullptr;
+}
+
+const char* GetPixelKernelSetName(PixelKernelSet kernelSet)
+{
+    switch (kernelSet)
+    {
+    case PixelKernelSet::Scalar: return "Scalar";
+    case PixelKernelSet::SSSE3:  return "SSSE3";
+    case PixelKernelSet::AVX2:   return "AVX2";
+    case PixelKernelSet::NEON:   return "NEON";
+    }
+    return "Unknown";
+}
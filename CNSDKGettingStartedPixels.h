@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stddef.h>
+#include <cstdint>
+
+// 8-bit per channel pixel layouts, named in memory byte order.
+enum class PixelFormat
+{
+    RGB8,
+    BGR8,
+    RGBA8,
+    BGRA8,
+    Gray8
+};
+
+// Instruction sets the conversion kernels are implemented for.
+enum class PixelKernelSet
+{
+    Scalar,
+    SSSE3,
+    AVX2,
+    NEON
+};
+
+inline int GetPixelFormatChannels(PixelFormat format)
+{
+    switch (format)
+    {
+    case PixelFormat::RGB8:
+    case PixelFormat::BGR8:  return 3;
+    case PixelFormat::RGBA8:
+    case PixelFormat::BGRA8: return 4;
+    case PixelFormat::Gray8: return 1;
+    }
+    return 0;
+}
+
+// Convert count pixels from src to dst. Covers 3<->4 channel expansion and packing,
+// channel swizzles, gray replication and gray reduction. Channels missing from the
+// source are filled with 255 (alpha). Gray is computed as (38R + 75G + 15B + 64) >> 7.
+// src and dst must not overlap.
+void ConvertPixels(void* dst, PixelFormat dstFormat, const void* src, PixelFormat srcFormat, size_t count);
+
+// Set one channel of count 4-channel pixels to value (usually alpha to 255).
+void FillPixelChannel(void* pixels, size_t count, int channel, std::uint8_t value);
+
+// Kernel set picked at startup from CPUID (or the one forced with SetPixelKernelSet).
+PixelKernelSet GetPixelKernelSet();
+
+// Force a kernel set, e.g. for benchmarking. Returns false if the CPU doesn't support it.
+bool SetPixelKernelSet(PixelKernelSet kernelSet);
+
+// Whether the CPU supports a kernel set.
+bool IsPixelKernelSetSupported(PixelKernelSet kernelSet);
+
+const char* GetPixelKernelSetName(PixelKernelSet kernelSet);
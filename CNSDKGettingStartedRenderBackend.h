@@ -0,0 +1,119 @@
+#pragma once
+
+#include <stddef.h>
+#include <cstdint>
+#include "CNSDKGettingStartedTexture.h"
+
+// The graphics API calls of the sample's frame loop, so the scene code (see
+// CNSDKGettingStartedScene.h) runs on D3D11 or headless. Deliberately small: what the spinning
+// cube and the stereo image need, not a general abstraction.
+//
+// Resources are referred to by handles. Commands execute in the order they are issued; a backend
+// may record them and execute them later, so data passed to a command is copied before it returns.
+
+// Identifies a resource of a backend. 0 is never a valid handle.
+typedef std::uint32_t RenderHandle;
+const RenderHandle kNullRenderHandle = 0;
+
+enum class RenderBufferType
+{
+    Vertex,
+    Index,    // 32-bit indices
+    Constant  // Bound to register b0 of both shader stages
+};
+
+// Layout of vertex buffers and the input of a pipeline's vertex shader.
+enum class RenderVertexFormat
+{
+    PositionColor // MeshVertex: float3 position, float3 color
+};
+
+// A sampled texture, e.g. a stereo image.
+struct RenderTextureDesc
+{
+    int           width    = 0;
+    int           height   = 0;
+    int           mipCount = 1;
+    TextureFormat format   = TextureFormat::RGBA8;
+    bool          sRGB     = false;
+
+    bool operator==(const RenderTextureDesc& other) const
+    {
+        return (width == other.width) && (height == other.height) && (mipCount == other.mipCount) && (format == other.format) && (sRGB == other.sRGB);
+    }
+};
+
+// HLSL shaders with entry points VSMain and PSMain. Backends that don't compile HLSL implement the
+// pipelines the scene uses natively and identify them by vertex format.
+struct RenderPipelineDesc
+{
+    const char*        vertexShader = nullptr;
+    const char*        pixelShader  = nullptr;
+    RenderVertexFormat vertexFormat = RenderVertexFormat::PositionColor;
+};
+
+// Pixel rectangle of the render target and depth range to draw to.
+struct RenderViewport
+{
+    float x        = 0.0f;
+    float y        = 0.0f;
+    float width    = 0.0f;
+    float height   = 0.0f;
+    float minDepth = 0.0f;
+    float maxDepth = 1.0f;
+};
+
+// Interlacer entry point for a side-by-side view atlas.
+enum class InterlaceMode
+{
+    Views,  // Views rendered this frame
+    Picture // A still stereo image
+};
+
+class RenderBackend
+{
+public:
+
+    virtual ~RenderBackend() = default;
+
+    // Resource creation. Each returns kNullRenderHandle on failure; getError() says why.
+    virtual RenderHandle createBuffer(RenderBufferType type, const void* data, size_t size) = 0;
+    virtual RenderHandle createTexture(const RenderTextureDesc& desc, const TextureMip* mips) = 0;
+    virtual RenderHandle createPipeline(const RenderPipelineDesc& desc) = 0;
+
+    // Color target with a depth buffer, usable as the source of interlace().
+    virtual RenderHandle createRenderTarget(int width, int height, bool sRGB) = 0;
+
+    // The window's color and depth buffers.
+    virtual RenderHandle getBackBuffer() const = 0;
+
+    // Replace all levels of a texture. Returns false on failure.
+    virtual bool updateTexture(RenderHandle texture, const TextureMip* mips) = 0;
+
+    virtual void destroy(RenderHandle resource) = 0;
+
+    // Clear a render target's color to color and its depth to 1.
+    virtual void clear(RenderHandle target, const float color[4]) = 0;
+
+    virtual void setRenderTarget(RenderHandle target) = 0;
+    virtual void setViewport(const RenderViewport& viewport) = 0;
+    virtual void setPipeline(RenderHandle pipeline) = 0;
+    virtual void setVertexBuffer(RenderHandle buffer) = 0;
+    virtual void setIndexBuffer(RenderHandle buffer) = 0;
+    virtual void setConstantBuffer(RenderHandle buffer) = 0;
+
+    // Replace the first size bytes of a constant buffer.
+    virtual void updateBuffer(RenderHandle buffer, const void* data, size_t size) = 0;
+
+    // Draw triangles of indices firstIndex .. firstIndex + indexCount - 1.
+    virtual void drawIndexed(int indexCount, int firstIndex) = 0;
+
+    // Interlace the side-by-side views in source, each viewWidth x viewHeight, to the back buffer.
+    virtual void interlace(RenderHandle source, int viewWidth, int viewHeight, InterlaceMode mode) = 0;
+
+    // Show the back buffer. Ends the frame.
+    virtual void present() = 0;
+
+    // First failure, null if none.
+    virtual const wchar_t* getError() const = 0;
+};
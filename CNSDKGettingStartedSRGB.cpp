@@ -0,0 +1,586 @@
+#include <math.h>
+#include "CNSDKGettingStartedPixels.h"
+#include "CNSDKGettingStartedSRGB.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SRGB_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define SRGB_NEON
+#include <arm_neon.h>
+#endif
+
+// See CNSDKGettingStartedPixels.cpp.
+#if defined(SRGB_X86) && !defined(_MSC_VER)
+#define SRGB_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SRGB_TARGET(isa)
+#endif
+
+namespace
+{
+    const int kTableIntervals = 4096;
+
+    // Where the linear segment of the curve ends, rounded so the float compares agree with the
+    // exact formula's (linear below 0.0031308f, at or below 0.04045f).
+    const float kEncodeKnee = 0.0031308f;
+    const float kDecodeKnee = 0.04045f;
+
+    // Below this many values the scalar loop is as fast.
+    const size_t kMinVectorValues = 16;
+
+    // The encode curve is steep near the knee, so its table is indexed by sqrt(value) and holds
+    // the power segment everywhere. Values below the knee take the linear segment instead.
+    struct SRGBTables
+    {
+        float decode8[256];
+        float decode[kTableIntervals + 1];
+        float encode[kTableIntervals + 1];
+
+        SRGBTables()
+        {
+            for (int i = 0; i < 256; i++)
+                decode8[i] = (float)SRGBToLinearExact(i / 255.0);
+            for (int i = 0; i <= kTableIntervals; i++)
+            {
+                const double x = (double)i / kTableIntervals;
+                decode[i] = (float)SRGBToLinearExact(x);
+                encode[i] = (float)(1.055 * pow(x * x, 1.0 / 2.4) - 0.055);
+            }
+        }
+    };
+
+    const SRGBTables& GetTables()
+    {
+        static const SRGBTables tables;
+        return tables;
+    }
+
+    float Clamp01(float value)
+    {
+        return (value > 0.0f) ? ((value < 1.0f) ? value : 1.0f) : 0.0f;
+    }
+
+    // position in [0, 1].
+    float Interpolate(const float* table, float position)
+    {
+        const float scaled = position * kTableIntervals;
+        const int   i      = ((int)scaled < kTableIntervals) ? (int)scaled : kTableIntervals - 1;
+        const float t      = scaled - (float)i;
+        return table[i] + (table[i + 1] - table[i]) * t;
+    }
+
+    float Decode(const float* table, float value)
+    {
+        return Interpolate(table, Clamp01(value));
+    }
+
+    float Encode(const float* table, float value)
+    {
+        value = Clamp01(value);
+        return (value < kEncodeKnee) ? (value * 12.92f) : Interpolate(table, sqrtf(value));
+    }
+
+    // value in [0, 1].
+    std::uint8_t ToCode(float value)
+    {
+        return (std::uint8_t)(value * 255.0f + 0.5f);
+    }
+
+    //
+    // Scalar kernels, also used for tails.
+    //
+
+    void ToLinearScalar(float* dst, const float* src, size_t count)
+    {
+        const float* table = GetTables().decode;
+        for (size_t i = 0; i < count; i++)
+            dst[i] = Decode(table, src[i]);
+    }
+
+    void ToSRGBScalar(float* dst, const float* src, size_t count)
+    {
+        const float* table = GetTables().encode;
+        for (size_t i = 0; i < count; i++)
+            dst[i] = Encode(table, src[i]);
+    }
+
+    // With rgba set every fourth value is alpha, which is only scaled. count must then be a multiple of 4.
+    void ToSRGB8Scalar(std::uint8_t* dst, const float* src, size_t count, bool rgba)
+    {
+        const float* table = GetTables().encode;
+        for (size_t i = 0; i < count; i++)
+            dst[i] = (rgba && ((i & 3) == 3)) ? ToCode(Clamp01(src[i])) : ToCode(Encode(table, src[i]));
+    }
+
+    // Kernel table for one instruction set.
+    struct SRGBKernels
+    {
+        void (*toLinear)(float* dst, const float* src, size_t count);
+        void (*toSRGB)(float* dst, const float* src, size_t count);
+        void (*toSRGB8)(std::uint8_t* dst, const float* src, size_t count, bool rgba);
+    };
+
+    const SRGBKernels kScalarKernels = { ToLinearScalar, ToSRGBScalar, ToSRGB8Scalar };
+
+    // The vector kernels compute pow(x, y) as exp2(y * log2(x)).
+    //
+    // log2: x = m * 2^e with m in [sqrt(1/2), sqrt(2)), log2(m) = 2/ln(2) * atanh(t) with
+    // t = (m - 1) / (m + 1), |t| < 0.172, summed to t^7. Only called with normal positive x.
+    //
+    // exp2: y = n + f with f in [-0.5, 0.5], 2^f by its Taylor series to f^6, n added to the
+    // exponent. Only called with y > -126.
+    const float kLog2C1 = 2.88539008f;
+    const float kLog2C3 = 0.961796694f;
+    const float kLog2C5 = 0.577078016f;
+    const float kLog2C7 = 0.412198583f;
+
+    const float kExp2C1 = 0.693147181f;
+    const float kExp2C2 = 0.240226507f;
+    const float kExp2C3 = 0.0555041087f;
+    const float kExp2C4 = 0.00961812911f;
+    const float kExp2C5 = 0.00133335581f;
+    const float kExp2C6 = 0.000154035304f;
+
+#if defined(SRGB_X86)
+
+    //
+    // SSE2 kernels, 4 values per step.
+    //
+
+    SRGB_TARGET("sse2")
+    inline __m128 Clamp01SSE2(__m128 v)
+    {
+        // maxps returns the second operand for NaN.
+        return _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    }
+
+    SRGB_TARGET("sse2")
+    inline __m128 SelectSSE2(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    SRGB_TARGET("sse2")
+    inline __m128 Log2SSE2(__m128 x)
+    {
+        const __m128i bits = _mm_castps_si128(x);
+        const __m128  one  = _mm_set1_ps(1.0f);
+
+        __m128i e = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+        __m128  m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+
+        const __m128 big = _mm_cmpgt_ps(m, _mm_set1_ps(1.41421356f));
+        m = SelectSSE2(big, _mm_mul_ps(m, _mm_set1_ps(0.5f)), m);
+        e = _mm_sub_epi32(e, _mm_castps_si128(big));
+
+        const __m128 t  = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+        const __m128 t2 = _mm_mul_ps(t, t);
+        __m128 p = _mm_set1_ps(kLog2C7);
+        p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(kLog2C5));
+        p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(kLog2C3));
+        p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(kLog2C1));
+        return _mm_add_ps(_mm_cvtepi32_ps(e), _mm_mul_ps(p, t));
+    }
+
+    SRGB_TARGET("sse2")
+    inline __m128 Exp2SSE2(__m128 y)
+    {
+        // Truncation is floor once the argument is positive.
+        const __m128i n = _mm_sub_epi32(_mm_cvttps_epi32(_mm_add_ps(y, _mm_set1_ps(128.5f))), _mm_set1_epi32(128));
+        const __m128  f = _mm_sub_ps(y, _mm_cvtepi32_ps(n));
+
+        __m128 p = _mm_set1_ps(kExp2C6);
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(kExp2C5));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(kExp2C4));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(kExp2C3));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(kExp2C2));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(kExp2C1));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.0f));
+        return _mm_castsi128_ps(_mm_add_epi32(_mm_castps_si128(p), _mm_slli_epi32(n, 23)));
+    }
+
+    // v in [0, 1].
+    SRGB_TARGET("sse2")
+    inline __m128 EncodeSSE2(__m128 v)
+    {
+        const __m128 knee  = _mm_set1_ps(kEncodeKnee);
+        const __m128 power = Exp2SSE2(_mm_mul_ps(Log2SSE2(_mm_max_ps(v, knee)), _mm_set1_ps(1.0f / 2.4f)));
+        const __m128 curve = _mm_sub_ps(_mm_mul_ps(power, _mm_set1_ps(1.055f)), _mm_set1_ps(0.055f));
+        return SelectSSE2(_mm_cmplt_ps(v, knee), _mm_mul_ps(v, _mm_set1_ps(12.92f)), curve);
+    }
+
+    SRGB_TARGET("sse2")
+    inline __m128 DecodeSSE2(__m128 v)
+    {
+        const __m128 base  = _mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(1.0f / 1.055f)), _mm_set1_ps(0.055f / 1.055f));
+        const __m128 curve = Exp2SSE2(_mm_mul_ps(Log2SSE2(base), _mm_set1_ps(2.4f)));
+        return SelectSSE2(_mm_cmple_ps(v, _mm_set1_ps(kDecodeKnee)), _mm_mul_ps(v, _mm_set1_ps(1.0f / 12.92f)), curve);
+    }
+
+    SRGB_TARGET("sse2")
+    void ToLinearSSE2(float* dst, const float* src, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(dst + i, DecodeSSE2(Clamp01SSE2(_mm_loadu_ps(src + i))));
+        ToLinearScalar(dst + i, src + i, count - i);
+    }
+
+    SRGB_TARGET("sse2")
+    void ToSRGBSSE2(float* dst, const float* src, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(dst + i, EncodeSSE2(Clamp01SSE2(_mm_loadu_ps(src + i))));
+        ToSRGBScalar(dst + i, src + i, count - i);
+    }
+
+    SRGB_TARGET("sse2")
+    void ToSRGB8SSE2(std::uint8_t* dst, const float* src, size_t count, bool rgba)
+    {
+        const __m128 alpha = rgba ? _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1)) : _mm_setzero_ps();
+        const __m128 scale = _mm_set1_ps(255.0f);
+        const __m128 half  = _mm_set1_ps(0.5f);
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i codes[4];
+            for (int k = 0; k < 4; k++)
+            {
+                const __m128 v = Clamp01SSE2(_mm_loadu_ps(src + i + k * 4));
+                const __m128 e = SelectSSE2(alpha, v, EncodeSSE2(v));
+                codes[k] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(e, scale), half));
+            }
+            const __m128i lo = _mm_packs_epi32(codes[0], codes[1]);
+            const __m128i hi = _mm_packs_epi32(codes[2], codes[3]);
+            _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+        }
+        ToSRGB8Scalar(dst + i, src + i, count - i, rgba);
+    }
+
+    const SRGBKernels kSSE2Kernels = { ToLinearSSE2, ToSRGBSSE2, ToSRGB8SSE2 };
+
+    //
+    // AVX2 kernels, 8 values per step. Same algorithm as SSE2, no FMA so results match it.
+    //
+
+    SRGB_TARGET("avx2")
+    inline __m256 Clamp01AVX2(__m256 v)
+    {
+        return _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+    }
+
+    SRGB_TARGET("avx2")
+    inline __m256 Log2AVX2(__m256 x)
+    {
+        const __m256i bits = _mm256_castps_si256(x);
+        const __m256  one  = _mm256_set1_ps(1.0f);
+
+        __m256i e = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127));
+        __m256  m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+
+        const __m256 big = _mm256_cmp_ps(m, _mm256_set1_ps(1.41421356f), _CMP_GT_OQ);
+        m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(0.5f)), big);
+        e = _mm256_sub_epi32(e, _mm256_castps_si256(big));
+
+        const __m256 t  = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+        const __m256 t2 = _mm256_mul_ps(t, t);
+        __m256 p = _mm256_set1_ps(kLog2C7);
+        p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(kLog2C5));
+        p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(kLog2C3));
+        p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(kLog2C1));
+        return _mm256_add_ps(_mm256_cvtepi32_ps(e), _mm256_mul_ps(p, t));
+    }
+
+    SRGB_TARGET("avx2")
+    inline __m256 Exp2AVX2(__m256 y)
+    {
+        const __m256i n = _mm256_sub_epi32(_mm256_cvttps_epi32(_mm256_add_ps(y, _mm256_set1_ps(128.5f))), _mm256_set1_epi32(128));
+        const __m256  f = _mm256_sub_ps(y, _mm256_cvtepi32_ps(n));
+
+        __m256 p = _mm256_set1_ps(kExp2C6);
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(kExp2C5));
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(kExp2C4));
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(kExp2C3));
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(kExp2C2));
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(kExp2C1));
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(1.0f));
+        return _mm256_castsi256_ps(_mm256_add_epi32(_mm256_castps_si256(p), _mm256_slli_epi32(n, 23)));
+    }
+
+    SRGB_TARGET("avx2")
+    inline __m256 EncodeAVX2(__m256 v)
+    {
+        const __m256 knee  = _mm256_set1_ps(kEncodeKnee);
+        const __m256 power = Exp2AVX2(_mm256_mul_ps(Log2AVX2(_mm256_max_ps(v, knee)), _mm256_set1_ps(1.0f / 2.4f)));
+        const __m256 curve = _mm256_sub_ps(_mm256_mul_ps(power, _mm256_set1_ps(1.055f)), _mm256_set1_ps(0.055f));
+        return _mm256_blendv_ps(curve, _mm256_mul_ps(v, _mm256_set1_ps(12.92f)), _mm256_cmp_ps(v, knee, _CMP_LT_OQ));
+    }
+
+    SRGB_TARGET("avx2")
+    inline __m256 DecodeAVX2(__m256 v)
+    {
+        const __m256 base  = _mm256_add_ps(_mm256_mul_ps(v, _mm256_set1_ps(1.0f / 1.055f)), _mm256_set1_ps(0.055f / 1.055f));
+        const __m256 curve = Exp2AVX2(_mm256_mul_ps(Log2AVX2(base), _mm256_set1_ps(2.4f)));
+        return _mm256_blendv_ps(curve, _mm256_mul_ps(v, _mm256_set1_ps(1.0f / 12.92f)), _mm256_cmp_ps(v, _mm256_set1_ps(kDecodeKnee), _CMP_LE_OQ));
+    }
+
+    SRGB_TARGET("avx2")
+    void ToLinearAVX2(float* dst, const float* src, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+            _mm256_storeu_ps(dst + i, DecodeAVX2(Clamp01AVX2(_mm256_loadu_ps(src + i))));
+        ToLinearScalar(dst + i, src + i, count - i);
+    }
+
+    SRGB_TARGET("avx2")
+    void ToSRGBAVX2(float* dst, const float* src, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+            _mm256_storeu_ps(dst + i, EncodeAVX2(Clamp01AVX2(_mm256_loadu_ps(src + i))));
+        ToSRGBScalar(dst + i, src + i, count - i);
+    }
+
+    SRGB_TARGET("avx2")
+    void ToSRGB8AVX2(std::uint8_t* dst, const float* src, size_t count, bool rgba)
+    {
+        const __m256 alpha = rgba ? _mm256_castsi256_ps(_mm256_setr_epi32(0, 0, 0, -1, 0, 0, 0, -1)) : _mm256_setzero_ps();
+        const __m256 scale = _mm256_set1_ps(255.0f);
+        const __m256 half  = _mm256_set1_ps(0.5f);
+
+        // The packs work within 128-bit lanes, this restores the order of the 4-byte groups.
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32)
+        {
+            __m256i codes[4];
+            for (int k = 0; k < 4; k++)
+            {
+                const __m256 v = Clamp01AVX2(_mm256_loadu_ps(src + i + k * 8));
+                const __m256 e = _mm256_blendv_ps(EncodeAVX2(v), v, alpha);
+                codes[k] = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(e, scale), half));
+            }
+            const __m256i lo = _mm256_packs_epi32(codes[0], codes[1]);
+            const __m256i hi = _mm256_packs_epi32(codes[2], codes[3]);
+            _mm256_storeu_si256((__m256i*)(dst + i), _mm256_permutevar8x32_epi32(_mm256_packus_epi16(lo, hi), order));
+        }
+        ToSRGB8Scalar(dst + i, src + i, count - i, rgba);
+    }
+
+    const SRGBKernels kAVX2Kernels = { ToLinearAVX2, ToSRGBAVX2, ToSRGB8AVX2 };
+
+#elif defined(SRGB_NEON)
+
+    //
+    // NEON kernels, 4 values per step.
+    //
+
+    inline float32x4_t Clamp01NEON(float32x4_t v)
+    {
+        // Comparisons with NaN are false, so this also maps NaN to 0.
+        const uint32x4_t positive = vcgtq_f32(v, vdupq_n_f32(0.0f));
+        v = vreinterpretq_f32_u32(vandq_u32(positive, vreinterpretq_u32_f32(v)));
+        return vminq_f32(v, vdupq_n_f32(1.0f));
+    }
+
+    inline float32x4_t DivNEON(float32x4_t a, float32x4_t b)
+    {
+#if defined(__aarch64__) || defined(_M_ARM64)
+        return vdivq_f32(a, b);
+#else
+        float32x4_t r = vrecpeq_f32(b);
+        r = vmulq_f32(r, vrecpsq_f32(b, r));
+        r = vmulq_f32(r, vrecpsq_f32(b, r));
+        return vmulq_f32(a, r);
+#endif
+    }
+
+    inline float32x4_t Log2NEON(float32x4_t x)
+    {
+        const int32x4_t   bits = vreinterpretq_s32_f32(x);
+        const float32x4_t one  = vdupq_n_f32(1.0f);
+
+        int32x4_t   e = vsubq_s32(vshrq_n_s32(bits, 23), vdupq_n_s32(127));
+        float32x4_t m = vreinterpretq_f32_s32(vorrq_s32(vandq_s32(bits, vdupq_n_s32(0x007FFFFF)), vdupq_n_s32(0x3F800000)));
+
+        const uint32x4_t big = vcgtq_f32(m, vdupq_n_f32(1.41421356f));
+        m = vbslq_f32(big, vmulq_f32(m, vdupq_n_f32(0.5f)), m);
+        e = vsubq_s32(e, vreinterpretq_s32_u32(big));
+
+        const float32x4_t t  = DivNEON(vsubq_f32(m, one), vaddq_f32(m, one));
+        const float32x4_t t2 = vmulq_f32(t, t);
+        float32x4_t p = vdupq_n_f32(kLog2C7);
+        p = vmlaq_f32(vdupq_n_f32(kLog2C5), p, t2);
+        p = vmlaq_f32(vdupq_n_f32(kLog2C3), p, t2);
+        p = vmlaq_f32(vdupq_n_f32(kLog2C1), p, t2);
+        return vaddq_f32(vcvtq_f32_s32(e), vmulq_f32(p, t));
+    }
+
+    inline float32x4_t Exp2NEON(float32x4_t y)
+    {
+        const int32x4_t   n = vsubq_s32(vcvtq_s32_f32(vaddq_f32(y, vdupq_n_f32(128.5f))), vdupq_n_s32(128));
+        const float32x4_t f = vsubq_f32(y, vcvtq_f32_s32(n));
+
+        float32x4_t p = vdupq_n_f32(kExp2C6);
+        p = vmlaq_f32(vdupq_n_f32(kExp2C5), p, f);
+        p = vmlaq_f32(vdupq_n_f32(kExp2C4), p, f);
+        p = vmlaq_f32(vdupq_n_f32(kExp2C3), p, f);
+        p = vmlaq_f32(vdupq_n_f32(kExp2C2), p, f);
+        p = vmlaq_f32(vdupq_n_f32(kExp2C1), p, f);
+        p = vmlaq_f32(vdupq_n_f32(1.0f), p, f);
+        return vreinterpretq_f32_s32(vaddq_s32(vreinterpretq_s32_f32(p), vshlq_n_s32(n, 23)));
+    }
+
+    inline float32x4_t EncodeNEON(float32x4_t v)
+    {
+        const float32x4_t knee  = vdupq_n_f32(kEncodeKnee);
+        const float32x4_t power = Exp2NEON(vmulq_f32(Log2NEON(vmaxq_f32(v, knee)), vdupq_n_f32(1.0f / 2.4f)));
+        const float32x4_t curve = vsubq_f32(vmulq_f32(power, vdupq_n_f32(1.055f)), vdupq_n_f32(0.055f));
+        return vbslq_f32(vcltq_f32(v, knee), vmulq_f32(v, vdupq_n_f32(12.92f)), curve);
+    }
+
+    inline float32x4_t DecodeNEON(float32x4_t v)
+    {
+        const float32x4_t base  = vmlaq_f32(vdupq_n_f32(0.055f / 1.055f), v, vdupq_n_f32(1.0f / 1.055f));
+        const float32x4_t curve = Exp2NEON(vmulq_f32(Log2NEON(base), vdupq_n_f32(2.4f)));
+        return vbslq_f32(vcleq_f32(v, vdupq_n_f32(kDecodeKnee)), vmulq_f32(v, vdupq_n_f32(1.0f / 12.92f)), curve);
+    }
+
+    void ToLinearNEON(float* dst, const float* src, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            vst1q_f32(dst + i, DecodeNEON(Clamp01NEON(vld1q_f32(src + i))));
+        ToLinearScalar(dst + i, src + i, count - i);
+    }
+
+    void ToSRGBNEON(float* dst, const float* src, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            vst1q_f32(dst + i, EncodeNEON(Clamp01NEON(vld1q_f32(src + i))));
+        ToSRGBScalar(dst + i, src + i, count - i);
+    }
+
+    void ToSRGB8NEON(std::uint8_t* dst, const float* src, size_t count, bool rgba)
+    {
+        const std::uint32_t alphaLanes[4] = { 0, 0, 0, rgba ? 0xFFFFFFFFu : 0 };
+        const uint32x4_t    alpha         = vld1q_u32(alphaLanes);
+        const float32x4_t   scale         = vdupq_n_f32(255.0f);
+        const float32x4_t   half          = vdupq_n_f32(0.5f);
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            uint16x4_t codes[4];
+            for (int k = 0; k < 4; k++)
+            {
+                const float32x4_t v = Clamp01NEON(vld1q_f32(src + i + k * 4));
+                const float32x4_t e = vbslq_f32(alpha, v, EncodeNEON(v));
+                codes[k] = vmovn_u32(vcvtq_u32_f32(vmlaq_f32(half, e, scale)));
+            }
+            const uint8x8_t lo = vmovn_u16(vcombine_u16(codes[0], codes[1]));
+            const uint8x8_t hi = vmovn_u16(vcombine_u16(codes[2], codes[3]));
+            vst1q_u8(dst + i, vcombine_u8(lo, hi));
+        }
+        ToSRGB8Scalar(dst + i, src + i, count - i, rgba);
+    }
+
+    const SRGBKernels kNEONKernels = { ToLinearNEON, ToSRGBNEON, ToSRGB8NEON };
+
+#endif
+
+    // Follows the pixel kernel selection, so SetPixelKernelSet switches these too.
+    const SRGBKernels& GetActiveKernels(size_t count)
+    {
+        if (count < kMinVectorValues)
+            return kScalarKernels;
+
+        switch (GetPixelKernelSet())
+        {
+#if defined(SRGB_X86)
+        case PixelKernelSet::AVX2:  return kAVX2Kernels;
+        case PixelKernelSet::SSSE3: return kSSE2Kernels;
+#elif defined(SRGB_NEON)
+        case PixelKernelSet::NEON:  return kNEONKernels;
+#endif
+        default:                    return kScalarKernels;
+        }
+    }
+}
+
+double SRGBToLinearExact(double value)
+{
+    value = (value > 0.0) ? ((value < 1.0) ? value : 1.0) : 0.0;
+    return (value <= 0.04045) ? (value / 12.92) : pow((value + 0.055) / 1.055, 2.4);
+}
+
+double LinearToSRGBExact(double value)
+{
+    value = (value > 0.0) ? ((value < 1.0) ? value : 1.0) : 0.0;
+    return (value <= 0.0031308) ? (value * 12.92) : (1.055 * pow(value, 1.0 / 2.4) - 0.055);
+}
+
+const float* GetSRGB8DecodeTable()
+{
+    return GetTables().decode8;
+}
+
+float SRGBToLinear(float value)
+{
+    return Decode(GetTables().decode, value);
+}
+
+float LinearToSRGB(float value)
+{
+    return Encode(GetTables().encode, value);
+}
+
+std::uint8_t LinearToSRGB8(float value)
+{
+    return ToCode(Encode(GetTables().encode, value));
+}
+
+void SRGBToLinear(float* dst, const float* src, size_t count)
+{
+    GetActiveKernels(count).toLinear(dst, src, count);
+}
+
+void LinearToSRGB(float* dst, const float* src, size_t count)
+{
+    GetActiveKernels(count).toSRGB(dst, src, count);
+}
+
+void SRGB8ToLinear(float* dst, const std::uint8_t* src, size_t count)
+{
+    const float* table = GetTables().decode8;
+    for (size_t i = 0; i < count; i++)
+        dst[i] = table[src[i]];
+}
+
+void LinearToSRGB8(std::uint8_t* dst, const float* src, size_t count)
+{
+    GetActiveKernels(count).toSRGB8(dst, src, count, false);
+}
+
+void SRGBA8ToLinear(float* dst, const std::uint8_t* src, size_t pixelCount)
+{
+    const float* table = GetTables().decode8;
+    for (size_t i = 0; i < pixelCount; i++, src += 4, dst += 4)
+    {
+        dst[0] = table[src[0]];
+        dst[1] = table[src[1]];
+        dst[2] = table[src[2]];
+        dst[3] = src[3] * (1.0f / 255.0f);
+    }
+}
+
+void LinearToSRGBA8(std::uint8_t* dst, const float* src, size_t pixelCount)
+{
+    GetActiveKernels(pixelCount * 4).toSRGB8(dst, src, pixelCount * 4, true);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stddef.h>
+#include <cstdint>
+
+// sRGB transfer function (IEC 61966-2-1) conversions between sRGB encoded and linear values.
+// Inputs are clamped to [0, 1], NaN converts to 0.
+//
+// Scalar conversions interpolate 4096-interval tables built from the exact formula in double.
+// Batch conversions use the instruction set selected for the pixel kernels (GetPixelKernelSet)
+// and evaluate the formula with log2/exp2 polynomials. Maximum absolute error against the exact
+// formula, over [0, 1]:
+//
+//   SRGBToLinear     scalar 1e-7, batch 4e-7
+//   LinearToSRGB     scalar 1e-7, batch 2e-7
+//   SRGB8ToLinear    exact (correctly rounded table)
+//   LinearToSRGB8    the correctly rounded code, except that values within 3e-5 of a code's
+//                    rounding boundary may round either way
+
+// Exact formula, evaluated with pow. For building tables and checking the fast paths.
+double SRGBToLinearExact(double value);
+double LinearToSRGBExact(double value);
+
+// Linear value of each 8-bit sRGB code.
+const float* GetSRGB8DecodeTable();
+
+float SRGBToLinear(float value);
+float LinearToSRGB(float value);
+
+inline float SRGB8ToLinear(std::uint8_t value)
+{
+    return GetSRGB8DecodeTable()[value];
+}
+
+std::uint8_t LinearToSRGB8(float value);
+
+// Convert count values. dst and src may be the same buffer for the float to float conversions.
+void SRGBToLinear(float* dst, const float* src, size_t count);
+void LinearToSRGB(float* dst, const float* src, size_t count);
+void SRGB8ToLinear(float* dst, const std::uint8_t* src, size_t count);
+void LinearToSRGB8(std::uint8_t* dst, const float* src, size_t count);
+
+// Convert count RGBA pixels. Color channels are converted, alpha is scaled between [0, 255] and [0, 1].
+void SRGBA8ToLinear(float* dst, const std::uint8_t* src, size_t pixelCount);
+void LinearToSRGBA8(std::uint8_t* dst, const float* src, size_t pixelCount);
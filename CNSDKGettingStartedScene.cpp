@@ -0,0 +1,326 @@
+#include <math.h>
+#include <cstdint>
+#include "CNSDKGettingStartedScene.h"
+#include "CNSDKGettingStartedCulling.h"
+#include "CNSDKGettingStartedFrameSource.h"
+#include "CNSDKGettingStartedMathExpr.h"
+#include "CNSDKGettingStartedMesh.h"
+#include "CNSDKGettingStartedSRGB.h"
+#include "CNSDKGettingStartedViewLatch.h"
+
+namespace
+{
+    // One float4x4, which D3D11 lays out without padding. Not packed: mat4f's members are loaded
+    // and stored with aligned SIMD operations.
+    struct CONSTANTBUFFER
+    {
+        mat4f transform;
+    };
+
+    static_assert(sizeof(CONSTANTBUFFER) == 64 && alignof(CONSTANTBUFFER) == 16, "CONSTANTBUFFER must be one aligned float4x4");
+
+    // Edge length of the spinning cube.
+    constexpr float g_cubeSize = 200.0f;
+
+    // Spinning cube with faces of 50% red, green, blue, yellow, cyan and magenta at channel value c.
+    constexpr CubeMesh MakeSpinningCube(float c)
+    {
+        const vec3f faceColors[6] =
+        {
+            vec3f(c,0,0),
+            vec3f(0,c,0),
+            vec3f(0,0,c),
+            vec3f(c,c,0),
+            vec3f(0,c,c),
+            vec3f(c,0,c)
+        };
+
+        return MakeCubeMesh(vec3f(g_cubeSize), faceColors);
+    }
+
+    // Built at compile time for both values getSRGB(0.5f) can take: sRGB render targets encode on
+    // write, otherwise the colors are stored encoded (0.735356987 is LinearToSRGB(0.5f)).
+    constexpr CubeMesh g_cubeMeshLinear  = MakeSpinningCube(0.5f);
+    constexpr CubeMesh g_cubeMeshEncoded = MakeSpinningCube(0.735356987f);
+
+    const char* g_cubeVertexShader =
+        "struct VSInput\n"
+        "{\n"
+        "    float3 Pos : POSITION;\n"
+        "    float3 Col : COLOR;\n"
+        "};\n"
+        "struct PSInput\n"
+        "{\n"
+        "    float4 Pos : SV_POSITION;\n"
+        "    float3 Col : COLOR;\n"
+        "};\n"
+        "cbuffer ConstantBufferData : register(b0)\n"
+        "{\n"
+        "    float4x4 transform;\n"
+        "};\n"
+        "PSInput VSMain(VSInput input)\n"
+        "{\n"
+        "    PSInput output = (PSInput)0;\n"
+        "    output.Pos = mul(transform, float4(input.Pos, 1.0f));\n"
+        "    output.Col = input.Col;\n"
+        "    return output;\n"
+        "}\n";
+
+    const char* g_cubePixelShader =
+        "struct PSInput\n"
+        "{\n"
+        "    float4 Pos : SV_POSITION;\n"
+        "    float3 Col : COLOR;\n"
+        "};\n"
+        "float4 PSMain(PSInput input) : SV_Target0\n"
+        "{\n"
+        "    return float4(input.Col, 1);\n"
+        "};\n";
+
+    void RotateOrientation(quatf& orientation, float x, float y, float z)
+    {
+        quatf rotation;
+        rotation.setEulerRotation(x, y, z);
+        orientation = orientation * rotation;
+    }
+}
+
+const RenderPipelineDesc& GetCubePipelineDesc()
+{
+    static const RenderPipelineDesc desc = { g_cubeVertexShader, g_cubePixelShader, RenderVertexFormat::PositionColor };
+    return desc;
+}
+
+StereoScene::StereoScene(RenderBackend& backend, const SceneSettings& settings)
+    : m_backend(backend)
+    , m_settings(settings)
+{
+    m_geometryPositions.resize(1);
+    m_geometryRotations.resize(1);
+    m_geometryScales.resize(1);
+    m_geometryScales.set(0, vec3f(1.0f));
+}
+
+StereoScene::~StereoScene()
+{
+    for (RenderHandle resource : { m_imageTexture, m_pipeline, m_constantBuffer, m_indexBuffer, m_vertexBuffer, m_offscreenTarget })
+        m_backend.destroy(resource);
+}
+
+bool StereoScene::initializeOffscreenFrameBuffer()
+{
+    // Use Leia's pre-defined view size (you can use a different size to suit your application).
+    m_offscreenTarget = m_backend.createRenderTarget(m_settings.viewWidth * 2, m_settings.viewHeight, m_settings.sRGB);
+    if (m_offscreenTarget == kNullRenderHandle)
+        return fail(m_backend.getError());
+    return true;
+}
+
+bool StereoScene::loadScene(StereoFrameSource* stereoImageSource)
+{
+    if (m_settings.demoMode == eDemoMode::Spinning3DCube)
+    {
+        const CubeMesh& mesh = m_settings.sRGB ? g_cubeMeshLinear : g_cubeMeshEncoded;
+
+        // Format = XYZ|RGB
+        m_vertexBuffer = m_backend.createBuffer(RenderBufferType::Vertex, mesh.vertices, sizeof(mesh.vertices));
+        if (m_vertexBuffer == kNullRenderHandle)
+            return fail(L"Error creating vertex buffer");
+
+        // Format = uint32
+        m_indexBuffer = m_backend.createBuffer(RenderBufferType::Index, mesh.indices, sizeof(mesh.indices));
+        if (m_indexBuffer == kNullRenderHandle)
+            return fail(L"Error creating index buffer");
+
+        m_constantBuffer = m_backend.createBuffer(RenderBufferType::Constant, nullptr, sizeof(CONSTANTBUFFER));
+        if (m_constantBuffer == kNullRenderHandle)
+            return fail(L"Failed to create constant buffer");
+
+        m_pipeline = m_backend.createPipeline(GetCubePipelineDesc());
+        if (m_pipeline == kNullRenderHandle)
+            return fail(m_backend.getError());
+    }
+    else if (m_settings.demoMode == eDemoMode::StereoImage)
+    {
+        m_stereoImageSource = stereoImageSource;
+        if (m_stereoImageSource == nullptr)
+            return fail(L"No stereo images");
+
+        StereoFrame frame;
+        if (m_stereoImageSource->getCurrentFrame(frame) && !uploadStereoFrame(frame))
+            return false;
+    }
+    return true;
+}
+
+bool StereoScene::render(float elapsedTime, ViewLatch& latch)
+{
+    latch.beginFrame();
+
+    bool succeeded = true;
+    if (m_settings.demoMode == eDemoMode::StereoImage)
+        succeeded = renderStereoImage(elapsedTime);
+    else if (m_settings.demoMode == eDemoMode::Spinning3DCube)
+        renderCube(elapsedTime, latch);
+
+    m_backend.present();
+    return succeeded;
+}
+
+float StereoScene::getSRGB(float value) const
+{
+    // If already in sRGB, no change.
+    if (m_settings.sRGB)
+        return value;
+
+    // Convert linear->sRGB.
+    return LinearToSRGB(value);
+}
+
+void StereoScene::renderCube(float elapsedTime, ViewLatch& latch)
+{
+    const int viewWidth  = m_settings.viewWidth;
+    const int viewHeight = m_settings.viewHeight;
+
+    // geometry transform.
+    mat4f geometryTransform;
+    {
+        // Place cube at specified distance from the camera. World positions are double and the
+        // transform is composed relative to the camera, which is far from the world origin, so
+        // the cube stays precise where float world positions would be off by a meter.
+        quatf geometryOrientation;
+        geometryOrientation.setIdentity();
+        RotateOrientation(geometryOrientation, 0.1f * elapsedTime, 0.2f * elapsedTime, 0.3f * elapsedTime);
+
+        m_geometryPositions.set(0, m_settings.cameraPosition + vec3(0, m_settings.geometryDist, 0));
+        m_geometryRotations.set(0, geometryOrientation);
+        ComposeRelativeTransforms(m_settings.cameraPosition, m_geometryPositions, m_geometryRotations, m_geometryScales, &geometryTransform);
+    }
+
+    // Clear back-buffer to green.
+    const float backBufferColor[4] = { getSRGB(0.0f), getSRGB(0.25f), getSRGB(0.0f), 1.0f };
+    m_backend.clear(m_backend.getBackBuffer(), backBufferColor);
+
+    // Clear offscreen render-target to blue
+    const float offscreenColor[4] = { getSRGB(0.0f), getSRGB(0.0f), getSRGB(0.25f), 1.0f };
+    m_backend.clear(m_offscreenTarget, offscreenColor);
+
+    // Bind the cube's pipeline state, the same for both views.
+    m_backend.setRenderTarget(m_offscreenTarget);
+    m_backend.setPipeline(m_pipeline);
+    m_backend.setConstantBuffer(m_constantBuffer);
+    m_backend.setVertexBuffer(m_vertexBuffer);
+    m_backend.setIndexBuffer(m_indexBuffer);
+
+    // Everything above is independent of the viewer. Sample the face and compute the views
+    // now, as close to submission as the draws that use them allow.
+    const FrameViews& views = latch.latch();
+
+    // Views the cube may be visible in, from its bounding sphere. Without a usable frustum
+    // (e.g. an infinite far plane) draw into both.
+    const vec3f      geometryCenter = vec3f(geometryTransform.Wx, geometryTransform.Wy, geometryTransform.Wz);
+    const float      geometryRadius = 0.5f * g_cubeSize * sqrtf(3.0f);
+    std::uint32_t    visibleViews   = 0x3;
+    MultiViewFrustum frustum;
+    if (frustum.set(views.viewProjections, 2))
+    {
+        visibleViews = 0;
+        if (frustum.getUnion().intersectsSphere(geometryCenter, geometryRadius))
+        {
+            for (int i = 0; i < 2; i++)
+                visibleViews |= frustum.getView(i).intersectsSphere(geometryCenter, geometryRadius) ? (1u << i) : 0u;
+        }
+    }
+
+    // Render stereo views.
+    for (int i = 0; i < 2; i++)
+    {
+        if ((visibleViews & (1u << i)) == 0)
+            continue;
+
+        // Compute combined matrix. The geometry transform is affine.
+        CONSTANTBUFFER constants;
+        constants.transform = views.viewProjections[i] * MathExpr::Affine(geometryTransform);
+
+        // Set viewport to render to left, then right.
+        RenderViewport viewport;
+        viewport.x        = (float)(i * viewWidth);
+        viewport.y        = 0.0f;
+        viewport.width    = (float)viewWidth;
+        viewport.height   = (float)viewHeight;
+        viewport.minDepth = 0.0f;
+        viewport.maxDepth = 1.0f;
+        m_backend.setViewport(viewport);
+
+        m_backend.updateBuffer(m_constantBuffer, &constants, sizeof(constants));
+
+        // Render.
+        m_backend.drawIndexed((int)CubeMesh::indexCount, 0);
+    }
+
+    // Perform interlacing.
+    m_backend.interlace(m_offscreenTarget, viewWidth, viewHeight, InterlaceMode::Views);
+    latch.submit();
+}
+
+bool StereoScene::renderStereoImage(float elapsedTime)
+{
+    // Show the next image once its time is up, if it has been decoded. Otherwise keep the current one.
+    if ((elapsedTime - m_imageTime >= m_settings.stereoImageInterval) && m_stereoImageSource->advance())
+    {
+        StereoFrame frame;
+        if (m_stereoImageSource->getCurrentFrame(frame) && !uploadStereoFrame(frame))
+            return false;
+        m_imageTime = elapsedTime;
+    }
+
+    // Clear backbuffer to green.
+    const float color[4] = { getSRGB(0.0f), getSRGB(0.25f), getSRGB(0.0f), 1.0f };
+    m_backend.clear(m_backend.getBackBuffer(), color);
+
+    // Perform interlacing, once there is an image.
+    if (m_imageTexture != kNullRenderHandle)
+        m_backend.interlace(m_imageTexture, m_settings.viewWidth, m_settings.viewHeight, InterlaceMode::Picture);
+    return true;
+}
+
+bool StereoScene::uploadStereoFrame(const StereoFrame& frame)
+{
+    RenderTextureDesc desc;
+    desc.width    = frame.width;
+    desc.height   = frame.height;
+    desc.mipCount = frame.mipCount;
+    desc.format   = frame.format;
+
+    // An sRGB view decodes the texels only in an sRGB pipeline, otherwise they pass through as
+    // stored. Linear texture files never get one.
+    desc.sRGB     = m_settings.sRGB && frame.sRGB;
+
+    // Frames of the same layout reuse the texture.
+    if (m_imageTexture != kNullRenderHandle)
+    {
+        if (desc == m_imageDesc)
+        {
+            if (!m_backend.updateTexture(m_imageTexture, frame.mips))
+                return fail(L"Failed to update stereo image texture");
+            return true;
+        }
+
+        m_backend.destroy(m_imageTexture);
+        m_imageTexture = kNullRenderHandle;
+    }
+
+    // Create texture straight from the frame's levels (mapped texture file pages or decoded pixels).
+    m_imageTexture = m_backend.createTexture(desc, frame.mips);
+    if (m_imageTexture == kNullRenderHandle)
+        return fail(L"Failed to create stereo image texture");
+
+    m_imageDesc = desc;
+    return true;
+}
+
+bool StereoScene::fail(const wchar_t* error)
+{
+    m_error = error;
+    return false;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CNSDKGettingStartedMath.h"
+#include "CNSDKGettingStartedRenderBackend.h"
+#include "CNSDKGettingStartedTransforms.h"
+
+class StereoFrameSource;
+class ViewLatch;
+struct StereoFrame;
+
+enum class eDemoMode { Spinning3DCube, StereoImage };
+
+struct SceneSettings
+{
+    eDemoMode demoMode            = eDemoMode::Spinning3DCube;
+    bool      sRGB                = true;   // Render targets encode sRGB on write
+    int       viewWidth           = 0;
+    int       viewHeight          = 0;
+    double    geometryDist        = 500;    // Cube distance in front of the camera
+    vec3      cameraPosition      = vec3(6.4e6, 0.0, 0.0); // World position, about Earth's radius from the origin
+    float     stereoImageInterval = 5.0f;   // Seconds each stereo image is shown
+};
+
+// Shaders of the spinning cube, e.g. to compile them ahead of LoadScene.
+const RenderPipelineDesc& GetCubePipelineDesc();
+
+// The sample's frame loop on a RenderBackend: the spinning cube rendered into a double-wide view
+// atlas, or a sequence of stereo images, interlaced to the back buffer. The backend and the views
+// (through a ViewLatch) come from the host, the D3D11 window or the headless runner.
+class StereoScene
+{
+public:
+
+    StereoScene(RenderBackend& backend, const SceneSettings& settings);
+    ~StereoScene();
+
+    StereoScene(const StereoScene&) = delete;
+    StereoScene& operator=(const StereoScene&) = delete;
+
+    // Create the double-wide offscreen render target the cube's views are drawn to, left then
+    // right, like a typical VR application.
+    bool initializeOffscreenFrameBuffer();
+
+    // Create the scene's resources: the cube's buffers and pipeline, or a texture of the image
+    // source's current frame. The source must outlive the scene.
+    bool loadScene(StereoFrameSource* stereoImageSource = nullptr);
+
+    // Draw and present a frame at elapsedTime seconds. The cube's views are latched from latch
+    // after all commands that don't depend on them. Returns false if a stereo image fails to upload.
+    bool render(float elapsedTime, ViewLatch& latch);
+
+    const SceneSettings& getSettings() const        { return m_settings; }
+    RenderHandle         getOffscreenTarget() const { return m_offscreenTarget; } // The view atlas
+    const wchar_t*       getError() const           { return m_error; }
+
+private:
+
+    // Color value for a render target: unchanged for sRGB targets, which encode on write,
+    // otherwise encoded here.
+    float getSRGB(float value) const;
+
+    void renderCube(float elapsedTime, ViewLatch& latch);
+    bool renderStereoImage(float elapsedTime);
+    bool uploadStereoFrame(const StereoFrame& frame);
+
+    bool fail(const wchar_t* error);
+
+    RenderBackend&     m_backend;
+    SceneSettings      m_settings;
+    StereoFrameSource* m_stereoImageSource = nullptr;
+    float              m_imageTime         = 0.0f;
+
+    RenderHandle       m_offscreenTarget   = kNullRenderHandle;
+    RenderHandle       m_vertexBuffer      = kNullRenderHandle;
+    RenderHandle       m_indexBuffer       = kNullRenderHandle;
+    RenderHandle       m_constantBuffer    = kNullRenderHandle;
+    RenderHandle       m_pipeline          = kNullRenderHandle;
+    RenderHandle       m_imageTexture      = kNullRenderHandle;
+    RenderTextureDesc  m_imageDesc;
+
+    // The cube's world placement, composed relative to the camera each frame.
+    Vec3dBatch         m_geometryPositions;
+    QuatfBatch         m_geometryRotations;
+    Vec3fBatch         m_geometryScales;
+
+    const wchar_t*     m_error             = nullptr;
+};
@@ -0,0 +1,798 @@
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include "CNSDKGettingStartedSoftwareBackend.h"
+#include "CNSDKGettingStartedMath.h"
+#include "CNSDKGettingStartedMesh.h"
+#include "CNSDKGettingStartedSRGB.h"
+#include "CNSDKGettingStartedThreadPool.h"
+
+namespace
+{
+    // Draws are transformed and set up across the pool in chunks of this many triangles.
+    const int kSetupChunkTriangles = 4096;
+
+    // Triangles reaching further than this many viewport half-sizes out are clipped to that band,
+    // nearer ones only by their pixel bounds. Keeps the edge functions within float precision.
+    const float kGuardBand = 8.0f;
+
+    // Most vertices a triangle has after clipping to the near plane and the four guard band planes.
+    const int kMaxClippedVertices = 8;
+
+    std::uint8_t ToUNorm8(float value)
+    {
+        value = (value > 0.0f) ? ((value < 1.0f) ? value : 1.0f) : 0.0f; // NaN to 0
+        return (std::uint8_t)(value * 255.0f + 0.5f);
+    }
+
+    std::uint32_t PackColor(float r, float g, float b, float a, bool sRGB)
+    {
+        const std::uint32_t red   = sRGB ? LinearToSRGB8(r) : ToUNorm8(r);
+        const std::uint32_t green = sRGB ? LinearToSRGB8(g) : ToUNorm8(g);
+        const std::uint32_t blue  = sRGB ? LinearToSRGB8(b) : ToUNorm8(b);
+        return red | (green << 8) | (blue << 16) | ((std::uint32_t)ToUNorm8(a) << 24);
+    }
+
+    // Swap the red and blue bytes of a pixel.
+    std::uint32_t SwizzleBGRA(std::uint32_t pixel)
+    {
+        return (pixel & 0xFF00FF00u) | ((pixel >> 16) & 0xFFu) | ((pixel & 0xFFu) << 16);
+    }
+}
+
+void SoftwareRenderBackend::Surface::resize(int w, int h)
+{
+    width  = w;
+    height = h;
+    stride = (w + 3) & ~3;
+    color.assign((size_t)stride * h, 0);
+    depth.assign((size_t)stride * h, 1.0f);
+}
+
+SoftwareRenderBackend::SoftwareRenderBackend(int backBufferWidth, int backBufferHeight, bool sRGB, ThreadPool* pool)
+    : m_pool(pool)
+{
+    Resource backBuffer;
+    backBuffer.kind         = ResourceKind::BackBuffer;
+    backBuffer.surface.sRGB = sRGB;
+    backBuffer.surface.resize(std::max(backBufferWidth, 1), std::max(backBufferHeight, 1));
+    m_resources.push_back(std::move(backBuffer));
+}
+
+RenderHandle SoftwareRenderBackend::createBuffer(RenderBufferType type, const void* data, size_t size)
+{
+    if ((size == 0) || ((type != RenderBufferType::Constant) && (data == nullptr)))
+    {
+        fail(L"Buffer without data");
+        return kNullRenderHandle;
+    }
+
+    Resource resource;
+    resource.kind = (type == RenderBufferType::Vertex) ? ResourceKind::VertexBuffer : (type == RenderBufferType::Index) ? ResourceKind::IndexBuffer : ResourceKind::ConstantBuffer;
+    resource.data.assign(size, 0);
+    if (data != nullptr)
+        memcpy(resource.data.data(), data, size);
+    return add(resource);
+}
+
+RenderHandle SoftwareRenderBackend::createTexture(const RenderTextureDesc& desc, const TextureMip* mips)
+{
+    if ((desc.width <= 0) || (desc.height <= 0) || (desc.mipCount <= 0) || (mips == nullptr))
+    {
+        fail(L"Invalid texture");
+        return kNullRenderHandle;
+    }
+
+    Resource resource;
+    resource.kind    = ResourceKind::Texture;
+    resource.texture = desc;
+    resource.data.resize((size_t)desc.width * desc.height * 4);
+    const RenderHandle handle = add(resource);
+    return updateTexture(handle, mips) ? handle : kNullRenderHandle;
+}
+
+RenderHandle SoftwareRenderBackend::createPipeline(const RenderPipelineDesc& desc)
+{
+    // The shaders are implemented natively for the vertex format.
+    if (desc.vertexFormat != RenderVertexFormat::PositionColor)
+    {
+        fail(L"Unsupported vertex format");
+        return kNullRenderHandle;
+    }
+
+    Resource resource;
+    resource.kind = ResourceKind::Pipeline;
+    return add(resource);
+}
+
+RenderHandle SoftwareRenderBackend::createRenderTarget(int width, int height, bool sRGB)
+{
+    if ((width <= 0) || (height <= 0))
+    {
+        fail(L"Invalid render target size");
+        return kNullRenderHandle;
+    }
+
+    Resource resource;
+    resource.kind         = ResourceKind::RenderTarget;
+    resource.surface.sRGB = sRGB;
+    resource.surface.resize(width, height);
+    return add(resource);
+}
+
+bool SoftwareRenderBackend::updateTexture(RenderHandle texture, const TextureMip* mips)
+{
+    Resource* resource = get(texture, ResourceKind::Texture, L"UpdateTexture of an unknown texture");
+    if ((resource == nullptr) || (mips == nullptr) || (mips[0].width != resource->texture.width) || (mips[0].height != resource->texture.height))
+        return false;
+
+    // Only the top level is sampled.
+    const size_t rowSize = (size_t)resource->texture.width * 4;
+    for (int y = 0; y < resource->texture.height; y++)
+        memcpy(&resource->data[y * rowSize], mips[0].data + y * mips[0].rowPitch, rowSize);
+    return true;
+}
+
+void SoftwareRenderBackend::destroy(RenderHandle resource)
+{
+    if (resource == kNullRenderHandle)
+        return;
+    if ((resource == kBackBuffer) || (resource > m_resources.size()) || (m_resources[resource - 1].kind == ResourceKind::None))
+    {
+        fail(L"Destroy of an unknown resource");
+        return;
+    }
+
+    // Work pending on a destroyed target is dropped.
+    if (resource == m_binTarget)
+    {
+        m_pendingClear = false;
+        m_triangles.clear();
+        for (std::vector<std::uint32_t>& bin : m_bins)
+            bin.clear();
+        m_binTarget = kNullRenderHandle;
+    }
+
+    m_resources[resource - 1] = Resource();
+    m_freeHandles.push_back(resource);
+
+    // Draws must bind a live resource again.
+    for (RenderHandle* bound : { &m_target, &m_pipeline, &m_vertexBuffer, &m_indexBuffer, &m_constantBuffer })
+    {
+        if (*bound == resource)
+            *bound = kNullRenderHandle;
+    }
+}
+
+void SoftwareRenderBackend::clear(RenderHandle target, const float color[4])
+{
+    const Surface* surface = getSurface(target, L"Clear of an unknown render target");
+    if (surface == nullptr)
+        return;
+
+    // Draws issued before the clear go first; otherwise the clear is done tile by tile together
+    // with the draws that follow it.
+    setBinTarget(target);
+    if (!m_triangles.empty())
+        flush();
+
+    m_pendingClear = true;
+    m_clearColor   = PackColor(color[0], color[1], color[2], color[3], surface->sRGB);
+}
+
+void SoftwareRenderBackend::setRenderTarget(RenderHandle target)
+{
+    if (getSurface(target, L"SetRenderTarget of an unknown render target") != nullptr)
+        m_target = target;
+}
+
+void SoftwareRenderBackend::setViewport(const RenderViewport& viewport)
+{
+    m_viewport = viewport;
+}
+
+void SoftwareRenderBackend::setPipeline(RenderHandle pipeline)
+{
+    if (get(pipeline, ResourceKind::Pipeline, L"SetPipeline of an unknown pipeline") != nullptr)
+        m_pipeline = pipeline;
+}
+
+void SoftwareRenderBackend::setVertexBuffer(RenderHandle buffer)
+{
+    if (get(buffer, ResourceKind::VertexBuffer, L"SetVertexBuffer of an unknown vertex buffer") != nullptr)
+        m_vertexBuffer = buffer;
+}
+
+void SoftwareRenderBackend::setIndexBuffer(RenderHandle buffer)
+{
+    if (get(buffer, ResourceKind::IndexBuffer, L"SetIndexBuffer of an unknown index buffer") != nullptr)
+        m_indexBuffer = buffer;
+}
+
+void SoftwareRenderBackend::setConstantBuffer(RenderHandle buffer)
+{
+    if (get(buffer, ResourceKind::ConstantBuffer, L"SetConstantBuffer of an unknown constant buffer") != nullptr)
+        m_constantBuffer = buffer;
+}
+
+void SoftwareRenderBackend::updateBuffer(RenderHandle buffer, const void* data, size_t size)
+{
+    Resource* resource = get(buffer, ResourceKind::ConstantBuffer, L"UpdateBuffer of an unknown constant buffer");
+    if (resource == nullptr)
+        return;
+    if (size > resource->data.size())
+    {
+        fail(L"UpdateBuffer past the end of the buffer");
+        return;
+    }
+
+    // Draws read the constants as they are issued, so the buffer can be overwritten right away.
+    memcpy(resource->data.data(), data, size);
+}
+
+void SoftwareRenderBackend::drawIndexed(int indexCount, int firstIndex)
+{
+    using namespace MathSIMD;
+
+    if ((m_target == kNullRenderHandle) || (m_pipeline == kNullRenderHandle) || (m_vertexBuffer == kNullRenderHandle) || (m_indexBuffer == kNullRenderHandle) || (m_constantBuffer == kNullRenderHandle))
+    {
+        fail(L"DrawIndexed without a render target, pipeline, vertex buffer, index buffer and constant buffer");
+        return;
+    }
+
+    const std::vector<std::uint8_t>& vertexData   = m_resources[m_vertexBuffer - 1].data;
+    const std::vector<std::uint8_t>& indexData    = m_resources[m_indexBuffer - 1].data;
+    const std::vector<std::uint8_t>& constantData = m_resources[m_constantBuffer - 1].data;
+    if ((indexCount < 0) || (firstIndex < 0) || ((size_t)(firstIndex + indexCount) * sizeof(std::uint32_t) > indexData.size()))
+    {
+        fail(L"DrawIndexed past the end of the index buffer");
+        return;
+    }
+    if (constantData.size() < 16 * sizeof(float))
+    {
+        fail(L"DrawIndexed with a constant buffer smaller than the transform");
+        return;
+    }
+
+    const MeshVertex*    vertices    = reinterpret_cast<const MeshVertex*>(vertexData.data());
+    const std::uint32_t* indices     = reinterpret_cast<const std::uint32_t*>(indexData.data()) + firstIndex;
+    const int            vertexCount = (int)(vertexData.size() / sizeof(MeshVertex));
+    for (int i = 0; i < indexCount; i++)
+    {
+        if (indices[i] >= (std::uint32_t)vertexCount)
+        {
+            fail(L"DrawIndexed with an index past the end of the vertex buffer");
+            return;
+        }
+    }
+
+    setBinTarget(m_target);
+    Surface& surface = m_resources[m_target - 1].surface;
+
+    const int triangleCount = indexCount / 3;
+    m_stats.draws++;
+    m_stats.triangles += triangleCount;
+
+    // clip = transform * (x, y, z, 1), the transform's columns consecutive like HLSL's default packing.
+    float transform[16];
+    memcpy(transform, constantData.data(), sizeof(transform));
+    const Vec4 column0 = Load(transform + 0);
+    const Vec4 column1 = Load(transform + 4);
+    const Vec4 column2 = Load(transform + 8);
+    const Vec4 column3 = Load(transform + 12);
+
+    // Large draws are transformed, clipped and set up in chunks across the pool; the vertex
+    // buffer is transformed as a whole, in as many parts.
+    const int chunkCount = std::max((triangleCount + kSetupChunkTriangles - 1) / kSetupChunkTriangles, 1);
+    m_vertices.resize(vertexCount);
+    if ((int)m_chunkTriangles.size() < chunkCount)
+        m_chunkTriangles.resize(chunkCount);
+
+    run(chunkCount, [&](int chunk)
+    {
+        const int begin = (int)((std::int64_t)vertexCount * chunk / chunkCount);
+        const int end   = (int)((std::int64_t)vertexCount * (chunk + 1) / chunkCount);
+        for (int i = begin; i < end; i++)
+        {
+            const MeshVertex& vertex = vertices[i];
+            const Vec4 position = MulAdd(column0, Splat(vertex.position.x), MulAdd(column1, Splat(vertex.position.y), MulAdd(column2, Splat(vertex.position.z), column3)));
+
+            Store(m_vertices[i].position, position);
+            m_vertices[i].color[0] = vertex.color.x;
+            m_vertices[i].color[1] = vertex.color.y;
+            m_vertices[i].color[2] = vertex.color.z;
+        }
+    });
+
+    run(chunkCount, [&](int chunk)
+    {
+        std::vector<RasterTriangle>& triangles = m_chunkTriangles[chunk];
+        triangles.clear();
+
+        const int end = std::min((chunk + 1) * kSetupChunkTriangles, triangleCount);
+        for (int i = chunk * kSetupChunkTriangles; i < end; i++)
+            setupTriangle(m_vertices[indices[i * 3 + 0]], m_vertices[indices[i * 3 + 1]], m_vertices[indices[i * 3 + 2]], surface, triangles);
+    });
+
+    // Bin in issue order.
+    const int tilesX = surface.getTilesX();
+    for (int chunk = 0; chunk < chunkCount; chunk++)
+    {
+        for (const RasterTriangle& triangle : m_chunkTriangles[chunk])
+        {
+            const std::uint32_t index = (std::uint32_t)m_triangles.size();
+            m_triangles.push_back(triangle);
+
+            for (int tileY = triangle.minY / kTileSize; tileY <= (triangle.maxY - 1) / kTileSize; tileY++)
+            {
+                for (int tileX = triangle.minX / kTileSize; tileX <= (triangle.maxX - 1) / kTileSize; tileX++)
+                    m_bins[tileY * tilesX + tileX].push_back(index);
+            }
+        }
+        m_stats.rasterized += m_chunkTriangles[chunk].size();
+    }
+}
+
+void SoftwareRenderBackend::interlace(RenderHandle source, int viewWidth, int viewHeight, InterlaceMode mode)
+{
+    const std::uint32_t* pixels = nullptr;
+    int                  width  = 0;
+    int                  height = 0;
+    int                  stride = 0;
+    bool                 bgra   = false;
+    if (mode == InterlaceMode::Views)
+    {
+        const Surface* surface = getSurface(source, L"Interlace of an unknown source");
+        if (surface == nullptr)
+            return;
+
+        pixels = surface->color.data();
+        width  = surface->width;
+        height = surface->height;
+        stride = surface->stride;
+    }
+    else
+    {
+        const Resource* resource = get(source, ResourceKind::Texture, L"Interlace of an unknown source");
+        if (resource == nullptr)
+            return;
+
+        pixels = reinterpret_cast<const std::uint32_t*>(resource->data.data());
+        width  = resource->texture.width;
+        height = resource->texture.height;
+        stride = width;
+        bgra   = (resource->texture.format == TextureFormat::BGRA8);
+    }
+    if ((viewWidth <= 0) || (viewHeight <= 0))
+    {
+        fail(L"Interlace of empty views");
+        return;
+    }
+
+    flush();
+
+    // Even columns from the left view, odd ones from the right, each view scaled to the back buffer.
+    Surface&  backBuffer = m_resources[kBackBuffer - 1].surface;
+    const int kBandRows  = 16;
+    m_interlaceColumns.resize(backBuffer.width);
+    for (int x = 0; x < backBuffer.width; x++)
+        m_interlaceColumns[x] = std::min((x & 1) * viewWidth + (int)((std::int64_t)x * viewWidth / backBuffer.width), width - 1);
+
+    run((backBuffer.height + kBandRows - 1) / kBandRows, [&](int band)
+    {
+        const int endY = std::min((band + 1) * kBandRows, backBuffer.height);
+        for (int y = band * kBandRows; y < endY; y++)
+        {
+            const int            sourceY = std::min((int)((std::int64_t)y * viewHeight / backBuffer.height), height - 1);
+            const std::uint32_t* row     = pixels + (size_t)sourceY * stride;
+            std::uint32_t*       dst     = &backBuffer.color[(size_t)y * backBuffer.stride];
+            if (bgra)
+            {
+                for (int x = 0; x < backBuffer.width; x++)
+                    dst[x] = SwizzleBGRA(row[m_interlaceColumns[x]]);
+            }
+            else
+            {
+                for (int x = 0; x < backBuffer.width; x++)
+                    dst[x] = row[m_interlaceColumns[x]];
+            }
+        }
+    });
+}
+
+void SoftwareRenderBackend::present()
+{
+    flush();
+    m_stats.frames++;
+}
+
+bool SoftwareRenderBackend::readPixels(RenderHandle target, std::vector<std::uint8_t>& pixels, int& width, int& height)
+{
+    const Surface* surface = getSurface(target, L"ReadPixels of an unknown render target");
+    if (surface == nullptr)
+        return false;
+
+    if (target == m_binTarget)
+        flush();
+
+    width  = surface->width;
+    height = surface->height;
+    pixels.resize((size_t)width * height * 4);
+    for (int y = 0; y < height; y++)
+        memcpy(&pixels[(size_t)y * width * 4], &surface->color[(size_t)y * surface->stride], (size_t)width * 4);
+    return true;
+}
+
+int SoftwareRenderBackend::getResourceCount() const
+{
+    return (int)(m_resources.size() - m_freeHandles.size()) - 1;
+}
+
+RenderHandle SoftwareRenderBackend::add(const Resource& resource)
+{
+    if (!m_freeHandles.empty())
+    {
+        const RenderHandle handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+        m_resources[handle - 1] = resource;
+        return handle;
+    }
+
+    m_resources.push_back(resource);
+    return (RenderHandle)m_resources.size();
+}
+
+SoftwareRenderBackend::Resource* SoftwareRenderBackend::get(RenderHandle handle, ResourceKind kind, const wchar_t* error)
+{
+    if ((handle == kNullRenderHandle) || (handle > m_resources.size()) || (m_resources[handle - 1].kind != kind))
+    {
+        fail(error);
+        return nullptr;
+    }
+    return &m_resources[handle - 1];
+}
+
+SoftwareRenderBackend::Surface* SoftwareRenderBackend::getSurface(RenderHandle target, const wchar_t* error)
+{
+    if (target == kBackBuffer)
+        return &m_resources[kBackBuffer - 1].surface;
+
+    Resource* resource = get(target, ResourceKind::RenderTarget, error);
+    return (resource != nullptr) ? &resource->surface : nullptr;
+}
+
+void SoftwareRenderBackend::setupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, const Surface& surface, std::vector<RasterTriangle>& triangles) const
+{
+    // Signed distance of a vertex to a clip plane, inside where positive: the near plane (z >= 0
+    // in D3D clip space), then the guard band.
+    auto getDistance = [](const ClipVertex& v, int plane) -> float
+    {
+        const float* p = v.position;
+        switch (plane)
+        {
+        case 0:  return p[2];
+        case 1:  return kGuardBand * p[3] - p[0];
+        case 2:  return kGuardBand * p[3] + p[0];
+        case 3:  return kGuardBand * p[3] - p[1];
+        default: return kGuardBand * p[3] + p[1];
+        }
+    };
+
+    // Reject triangles entirely outside one side of the view volume.
+    auto getOutCode = [](const ClipVertex& v) -> int
+    {
+        const float* p = v.position;
+        return ((p[0] < -p[3]) ? 1 : 0) | ((p[0] > p[3]) ? 2 : 0) | ((p[1] < -p[3]) ? 4 : 0) | ((p[1] > p[3]) ? 8 : 0) | ((p[2] < 0.0f) ? 16 : 0) | ((p[2] > p[3]) ? 32 : 0);
+    };
+    if ((getOutCode(v0) & getOutCode(v1) & getOutCode(v2)) != 0)
+        return;
+
+    // Clip to the planes any vertex is outside of.
+    ClipVertex polygons[2][kMaxClippedVertices + 1];
+    ClipVertex* polygon = polygons[0];
+    int         count   = 3;
+    polygon[0] = v0;
+    polygon[1] = v1;
+    polygon[2] = v2;
+
+    for (int plane = 0; plane < 5; plane++)
+    {
+        float distances[kMaxClippedVertices + 1];
+        bool  outside = false;
+        for (int i = 0; i < count; i++)
+        {
+            distances[i] = getDistance(polygon[i], plane);
+            outside |= (distances[i] < 0.0f);
+        }
+        if (!outside)
+            continue;
+
+        ClipVertex* clipped      = (polygon == polygons[0]) ? polygons[1] : polygons[0];
+        int         clippedCount = 0;
+        for (int i = 0; i < count; i++)
+        {
+            const int j = (i + 1 < count) ? i + 1 : 0;
+            if (distances[i] >= 0.0f)
+                clipped[clippedCount++] = polygon[i];
+            if ((distances[i] >= 0.0f) != (distances[j] >= 0.0f))
+            {
+                const float t = distances[i] / (distances[i] - distances[j]);
+                ClipVertex& v = clipped[clippedCount++];
+                for (int k = 0; k < 4; k++)
+                    v.position[k] = polygon[i].position[k] + (polygon[j].position[k] - polygon[i].position[k]) * t;
+                for (int k = 0; k < 3; k++)
+                    v.color[k] = polygon[i].color[k] + (polygon[j].color[k] - polygon[i].color[k]) * t;
+            }
+        }
+        polygon = clipped;
+        count   = clippedCount;
+        if (count < 3)
+            return;
+    }
+
+    // Pixels the viewport covers.
+    const RenderViewport& viewport = m_viewport;
+    const int scissorMinX = std::max((int)floorf(viewport.x), 0);
+    const int scissorMinY = std::max((int)floorf(viewport.y), 0);
+    const int scissorMaxX = std::min((int)ceilf(viewport.x + viewport.width), surface.width);
+    const int scissorMaxY = std::min((int)ceilf(viewport.y + viewport.height), surface.height);
+    if ((scissorMinX >= scissorMaxX) || (scissorMinY >= scissorMaxY))
+        return;
+
+    // To pixels, y down, and depth range.
+    float x[kMaxClippedVertices], y[kMaxClippedVertices], z[kMaxClippedVertices], invW[kMaxClippedVertices];
+    for (int i = 0; i < count; i++)
+    {
+        const float* p = polygon[i].position;
+        if (!(p[3] > 0.0f))
+            return;
+
+        invW[i] = 1.0f / p[3];
+        x[i]    = viewport.x + (p[0] * invW[i] + 1.0f) * 0.5f * viewport.width;
+        y[i]    = viewport.y + (1.0f - p[1] * invW[i]) * 0.5f * viewport.height;
+        z[i]    = viewport.minDepth + p[2] * invW[i] * (viewport.maxDepth - viewport.minDepth);
+    }
+
+    // Fan of the clipped polygon.
+    for (int fan = 1; fan + 1 < count; fan++)
+    {
+        const int v[3] = { 0, fan, fan + 1 };
+
+        // Positive for clockwise triangles with y down, D3D's default front face. Back facing
+        // and degenerate triangles are culled.
+        const float area = (x[v[1]] - x[v[0]]) * (y[v[2]] - y[v[0]]) - (x[v[2]] - x[v[0]]) * (y[v[1]] - y[v[0]]);
+        if (!(area > 0.0f))
+            continue;
+
+        RasterTriangle triangle;
+        triangle.minX = std::max((int)floorf(std::min({ x[v[0]], x[v[1]], x[v[2]] })), scissorMinX);
+        triangle.minY = std::max((int)floorf(std::min({ y[v[0]], y[v[1]], y[v[2]] })), scissorMinY);
+        triangle.maxX = std::min((int)ceilf(std::max({ x[v[0]], x[v[1]], x[v[2]] })), scissorMaxX);
+        triangle.maxY = std::min((int)ceilf(std::max({ y[v[0]], y[v[1]], y[v[2]] })), scissorMaxY);
+        if ((triangle.minX >= triangle.maxX) || (triangle.minY >= triangle.maxY))
+            continue;
+
+        // Edge e runs between the other two vertices, a to b. Top edges are horizontal and run
+        // right, left edges run up.
+        triangle.topLeft = 0;
+        for (int e = 0; e < 3; e++)
+        {
+            const int a = v[(e + 1) % 3];
+            const int b = v[(e + 2) % 3];
+            triangle.edgeA[e] = y[a] - y[b];
+            triangle.edgeB[e] = x[b] - x[a];
+            triangle.edgeC[e] = -(triangle.edgeA[e] * x[a] + triangle.edgeB[e] * y[a]);
+            if (((y[a] == y[b]) && (x[b] > x[a])) || (y[b] < y[a]))
+                triangle.topLeft |= 1 << e;
+        }
+
+        // Plane through the vertices' values, from the barycentric weights edge / area.
+        const float invArea = 1.0f / area;
+        auto setPlane = [&](const float (&values)[3], float& a, float& b, float& c)
+        {
+            a = (values[0] * triangle.edgeA[0] + values[1] * triangle.edgeA[1] + values[2] * triangle.edgeA[2]) * invArea;
+            b = (values[0] * triangle.edgeB[0] + values[1] * triangle.edgeB[1] + values[2] * triangle.edgeB[2]) * invArea;
+            c = (values[0] * triangle.edgeC[0] + values[1] * triangle.edgeC[1] + values[2] * triangle.edgeC[2]) * invArea;
+        };
+
+        const float depths[3]      = { z[v[0]], z[v[1]], z[v[2]] };
+        const float reciprocals[3] = { invW[v[0]], invW[v[1]], invW[v[2]] };
+        setPlane(depths, triangle.zA, triangle.zB, triangle.zC);
+        setPlane(reciprocals, triangle.invWA, triangle.invWB, triangle.invWC);
+        triangle.maxDepth = viewport.maxDepth;
+
+        const float* c0 = polygon[v[0]].color;
+        const float* c1 = polygon[v[1]].color;
+        const float* c2 = polygon[v[2]].color;
+        triangle.flat      = (c0[0] == c1[0]) && (c0[0] == c2[0]) && (c0[1] == c1[1]) && (c0[1] == c2[1]) && (c0[2] == c1[2]) && (c0[2] == c2[2]);
+        triangle.flatColor = PackColor(c0[0], c0[1], c0[2], 1.0f, surface.sRGB);
+        for (int k = 0; k < 3; k++)
+        {
+            const float values[3] = { c0[k] * reciprocals[0], c1[k] * reciprocals[1], c2[k] * reciprocals[2] };
+            setPlane(values, triangle.colorA[k], triangle.colorB[k], triangle.colorC[k]);
+        }
+
+        triangles.push_back(triangle);
+    }
+}
+
+void SoftwareRenderBackend::setBinTarget(RenderHandle target)
+{
+    if (target == m_binTarget)
+        return;
+
+    flush();
+    m_binTarget = target;
+
+    const Surface& surface = *getSurface(target, L"Draw to an unknown render target");
+    m_bins.resize((size_t)surface.getTilesX() * surface.getTilesY());
+}
+
+void SoftwareRenderBackend::flush()
+{
+    if ((m_binTarget == kNullRenderHandle) || (!m_pendingClear && m_triangles.empty()))
+        return;
+
+    // Every tile if clearing, otherwise the ones with triangles.
+    m_activeTiles.clear();
+    for (int tile = 0; tile < (int)m_bins.size(); tile++)
+    {
+        if (m_pendingClear || !m_bins[tile].empty())
+            m_activeTiles.push_back(tile);
+    }
+
+    Surface& surface = *getSurface(m_binTarget, L"Flush of an unknown render target");
+    run((int)m_activeTiles.size(), [&](int i) { rasterizeTile(surface, m_activeTiles[i]); });
+    m_stats.tileBatches += m_activeTiles.size();
+
+    for (std::vector<std::uint32_t>& bin : m_bins)
+        bin.clear();
+    m_triangles.clear();
+    m_pendingClear = false;
+}
+
+void SoftwareRenderBackend::rasterizeTile(Surface& surface, int tile) const
+{
+    using namespace MathSIMD;
+
+    const int tilesX = surface.getTilesX();
+    const int tileX0 = (tile % tilesX) * kTileSize;
+    const int tileY0 = (tile / tilesX) * kTileSize;
+    const int tileX1 = std::min(tileX0 + kTileSize, surface.width);
+    const int tileY1 = std::min(tileY0 + kTileSize, surface.height);
+
+    if (m_pendingClear)
+    {
+        for (int y = tileY0; y < tileY1; y++)
+        {
+            std::fill_n(&surface.color[(size_t)y * surface.stride + tileX0], tileX1 - tileX0, m_clearColor);
+            std::fill_n(&surface.depth[(size_t)y * surface.stride + tileX0], tileX1 - tileX0, 1.0f);
+        }
+    }
+
+    const Vec4 zero    = Splat(0.0f);
+    const Vec4 one     = Splat(1.0f);
+    const Vec4 four    = Splat(4.0f);
+    const Vec4 centers = Set(0.5f, 1.5f, 2.5f, 3.5f);
+
+    for (std::uint32_t index : m_bins[tile])
+    {
+        const RasterTriangle& triangle = m_triangles[index];
+
+        const int minX = std::max(triangle.minX, tileX0);
+        const int minY = std::max(triangle.minY, tileY0);
+        const int maxX = std::min(triangle.maxX, tileX1);
+        const int maxY = std::min(triangle.maxY, tileY1);
+        if ((minX >= maxX) || (minY >= maxY))
+            continue;
+
+        // Four pixels at a time, from the 4-aligned column at or left of minX (rows are 4-aligned
+        // in the surface, and so are tiles).
+        const int  startX      = minX & ~3;
+        const Vec4 startXs     = Add(Splat((float)startX), centers);
+        const Vec4 edgeA[3]    = { Splat(triangle.edgeA[0]), Splat(triangle.edgeA[1]), Splat(triangle.edgeA[2]) };
+        const Vec4 edgeStep[3] = { Mul(edgeA[0], four), Mul(edgeA[1], four), Mul(edgeA[2], four) };
+        const Vec4 zA          = Splat(triangle.zA);
+        const Vec4 maxDepth    = Splat(triangle.maxDepth);
+        const Vec4 invWA       = Splat(triangle.invWA);
+        const Vec4 colorA[3]   = { Splat(triangle.colorA[0]), Splat(triangle.colorA[1]), Splat(triangle.colorA[2]) };
+
+        for (int y = minY; y < maxY; y++)
+        {
+            const float centerY = (float)y + 0.5f;
+
+            Vec4 edges[3];
+            for (int e = 0; e < 3; e++)
+                edges[e] = MulAdd(edgeA[e], startXs, Splat(triangle.edgeB[e] * centerY + triangle.edgeC[e]));
+
+            const Vec4 zRow    = Splat(triangle.zB * centerY + triangle.zC);
+            const Vec4 invWRow = Splat(triangle.invWB * centerY + triangle.invWC);
+            const Vec4 colorRow[3] =
+            {
+                Splat(triangle.colorB[0] * centerY + triangle.colorC[0]),
+                Splat(triangle.colorB[1] * centerY + triangle.colorC[1]),
+                Splat(triangle.colorB[2] * centerY + triangle.colorC[2])
+            };
+
+            std::uint32_t* colors = &surface.color[(size_t)y * surface.stride];
+            float*         depths = &surface.depth[(size_t)y * surface.stride];
+
+            Vec4 xs = startXs;
+            for (int x = startX; x < maxX; x += 4)
+            {
+                // Lanes within the bounds, then inside all edges. Pixels on an edge belong to
+                // the triangle if it's a top or left edge.
+                int mask = 0xF;
+                if (x < minX)
+                    mask &= 0xF << (minX - x);
+                if (x + 4 > maxX)
+                    mask &= 0xF >> (x + 4 - maxX);
+                for (int e = 0; e < 3; e++)
+                    mask &= ((triangle.topLeft >> e) & 1) ? ~MoveMask(Less(edges[e], zero)) : MoveMask(Less(zero, edges[e]));
+
+                if (mask != 0)
+                {
+                    // Depth test less, against the far end of the depth range too.
+                    const Vec4 z = MulAdd(zA, xs, zRow);
+                    mask &= MoveMask(Less(z, Load(depths + x))) & ~MoveMask(Less(maxDepth, z));
+                    if (mask != 0)
+                    {
+                        float zs[4];
+                        Store(zs, z);
+
+                        if (triangle.flat)
+                        {
+                            for (int i = 0; i < 4; i++)
+                            {
+                                if (mask & (1 << i))
+                                {
+                                    depths[x + i] = zs[i];
+                                    colors[x + i] = triangle.flatColor;
+                                }
+                            }
+                        }
+                        else
+                        {
+                            // Perspective-correct: color / w and 1 / w are linear in screen space.
+                            const Vec4 w = Div(one, MulAdd(invWA, xs, invWRow));
+                            float red[4], green[4], blue[4];
+                            Store(red,   Mul(MulAdd(colorA[0], xs, colorRow[0]), w));
+                            Store(green, Mul(MulAdd(colorA[1], xs, colorRow[1]), w));
+                            Store(blue,  Mul(MulAdd(colorA[2], xs, colorRow[2]), w));
+                            for (int i = 0; i < 4; i++)
+                            {
+                                if (mask & (1 << i))
+                                {
+                                    depths[x + i] = zs[i];
+                                    colors[x + i] = PackColor(red[i], green[i], blue[i], 1.0f, surface.sRGB);
+                                }
+                            }
+                        }
+                    }
+                }
+
+                for (int e = 0; e < 3; e++)
+                    edges[e] = Add(edges[e], edgeStep[e]);
+                xs = Add(xs, four);
+            }
+        }
+    }
+}
+
+void SoftwareRenderBackend::run(int count, const std::function<void(int)>& func)
+{
+    if ((m_pool != nullptr) && (count > 1))
+    {
+        m_pool->parallelFor(count, func);
+        return;
+    }
+
+    for (int i = 0; i < count; i++)
+        func(i);
+}
+
+void SoftwareRenderBackend::fail(const wchar_t* error)
+{
+    if (m_error == nullptr)
+        m_error = error;
+}
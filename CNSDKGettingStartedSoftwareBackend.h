@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "CNSDKGettingStartedRenderBackend.h"
+
+class ThreadPool;
+
+// Backend that rasterizes on the CPU, for rendering without a GPU: golden images of the view atlas
+// to check the interlacer's input against, and headless content rendering.
+//
+// Implements the PositionColor pipeline natively (the transform in the first 64 bytes of the
+// constant buffer, column-major as HLSL packs a float4x4) with D3D11's default states: clockwise
+// triangles are front facing and back faces culled, depth test less with depth writes, triangles
+// clipped to the near plane and to the viewport, top-left fill rule, perspective-correct colors.
+// Color targets are RGBA8, encoding on write if sRGB.
+//
+// Draws are transformed and set up as they are issued, then binned into kTileSize square tiles of
+// the render target. A tile's pending clear and triangles are rasterized together, in issue order,
+// when the target's pixels are needed (interlace, present, readPixels, a clear after draws or a
+// change of target), with the tiles spread over the thread pool. Edge functions, depth and colors
+// are evaluated four pixels at a time with MathSIMD.
+//
+// interlace() interleaves the views' columns into the back buffer, a stand-in for the display's
+// calibrated pattern. Not thread-safe.
+class SoftwareRenderBackend : public RenderBackend
+{
+public:
+
+    static const int kTileSize = 64;
+
+    struct Stats
+    {
+        std::uint64_t frames      = 0;
+        std::uint64_t draws       = 0;
+        std::uint64_t triangles   = 0; // Submitted
+        std::uint64_t rasterized  = 0; // Binned, after culling and clipping
+        std::uint64_t tileBatches = 0; // Tiles rasterized at a flush
+    };
+
+    // pool may be null to rasterize on the calling thread only. The pool must outlive the backend.
+    SoftwareRenderBackend(int backBufferWidth, int backBufferHeight, bool sRGB, ThreadPool* pool = nullptr);
+
+    RenderHandle createBuffer(RenderBufferType type, const void* data, size_t size) override;
+    RenderHandle createTexture(const RenderTextureDesc& desc, const TextureMip* mips) override;
+    RenderHandle createPipeline(const RenderPipelineDesc& desc) override;
+    RenderHandle createRenderTarget(int width, int height, bool sRGB) override;
+    RenderHandle getBackBuffer() const override { return kBackBuffer; }
+    bool         updateTexture(RenderHandle texture, const TextureMip* mips) override;
+    void         destroy(RenderHandle resource) override;
+
+    void clear(RenderHandle target, const float color[4]) override;
+    void setRenderTarget(RenderHandle target) override;
+    void setViewport(const RenderViewport& viewport) override;
+    void setPipeline(RenderHandle pipeline) override;
+    void setVertexBuffer(RenderHandle buffer) override;
+    void setIndexBuffer(RenderHandle buffer) override;
+    void setConstantBuffer(RenderHandle buffer) override;
+    void updateBuffer(RenderHandle buffer, const void* data, size_t size) override;
+    void drawIndexed(int indexCount, int firstIndex) override;
+    void interlace(RenderHandle source, int viewWidth, int viewHeight, InterlaceMode mode) override;
+    void present() override;
+
+    const wchar_t* getError() const override { return m_error; }
+
+    // Copy a render target's or the back buffer's pixels, all commands issued so far applied, as
+    // tightly packed RGBA8 rows top to bottom. Returns false for an unknown target.
+    bool readPixels(RenderHandle target, std::vector<std::uint8_t>& pixels, int& width, int& height);
+
+    int   getResourceCount() const; // Live resources, the back buffer excluded
+    Stats getStats() const          { return m_stats; }
+
+private:
+
+    enum class ResourceKind
+    {
+        None,
+        BackBuffer,
+        VertexBuffer,
+        IndexBuffer,
+        ConstantBuffer,
+        Texture,
+        RenderTarget,
+        Pipeline
+    };
+
+    // Color and depth planes of a render target, rows stride pixels apart (a multiple of 4).
+    struct Surface
+    {
+        int                        width  = 0;
+        int                        height = 0;
+        int                        stride = 0;
+        bool                       sRGB   = false;
+        std::vector<std::uint32_t> color;  // RGBA8, R in the low byte
+        std::vector<float>         depth;
+
+        void resize(int w, int h);
+        int  getTilesX() const { return (width + kTileSize - 1) / kTileSize; }
+        int  getTilesY() const { return (height + kTileSize - 1) / kTileSize; }
+    };
+
+    struct Resource
+    {
+        ResourceKind              kind = ResourceKind::None;
+        std::vector<std::uint8_t> data;    // Buffer contents, or a texture's top level (tightly packed)
+        RenderTextureDesc         texture;
+        Surface                   surface; // Render target, back buffer
+    };
+
+    // Post-transform vertex.
+    struct ClipVertex
+    {
+        float position[4]; // Clip space
+        float color[3];
+    };
+
+    // A triangle set up for rasterization: edge functions and attribute planes, each
+    // a * x + b * y + c at pixel centers, and its pixel bounds, clipped to the viewport.
+    struct RasterTriangle
+    {
+        float         edgeA[3], edgeB[3], edgeC[3]; // Inside where all are positive
+        int           topLeft;                      // Bit e set if edge e is a top or left edge, inside at 0
+        float         zA, zB, zC;
+        float         maxDepth;
+        float         invWA, invWB, invWC;          // 1 / w
+        float         colorA[3], colorB[3], colorC[3]; // Color / w
+        bool          flat;                         // All vertices one color, flatColor
+        std::uint32_t flatColor;
+        int           minX, minY, maxX, maxY;       // Pixels minX <= x < maxX, minY <= y < maxY
+    };
+
+    static const RenderHandle kBackBuffer = 1;
+
+    RenderHandle add(const Resource& resource);
+
+    // The resource of a handle if it's live and of kind, otherwise null after recording an error.
+    Resource* get(RenderHandle handle, ResourceKind kind, const wchar_t* error);
+
+    // Surface of a render target or the back buffer, null after recording an error.
+    Surface* getSurface(RenderHandle target, const wchar_t* error);
+
+    // Clip triangle v0 v1 v2 and append what's left, set up, to triangles.
+    void setupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, const Surface& surface, std::vector<RasterTriangle>& triangles) const;
+
+    // Bin target, its pending clear and triangles. flush() rasterizes and empties the bins.
+    void setBinTarget(RenderHandle target);
+    void flush();
+    void rasterizeTile(Surface& surface, int tile) const;
+
+    // Run func(0) ... func(count - 1), across the pool if there is one.
+    void run(int count, const std::function<void(int)>& func);
+
+    void fail(const wchar_t* error);
+
+    ThreadPool*                              m_pool           = nullptr;
+    std::vector<Resource>                    m_resources;      // Index handle - 1
+    std::vector<RenderHandle>                m_freeHandles;
+
+    // Bound state.
+    RenderHandle                             m_target         = kNullRenderHandle;
+    RenderHandle                             m_pipeline       = kNullRenderHandle;
+    RenderHandle                             m_vertexBuffer   = kNullRenderHandle;
+    RenderHandle                             m_indexBuffer    = kNullRenderHandle;
+    RenderHandle                             m_constantBuffer = kNullRenderHandle;
+    RenderViewport                           m_viewport;
+
+    // Work pending on m_binTarget.
+    RenderHandle                             m_binTarget      = kNullRenderHandle;
+    bool                                     m_pendingClear   = false;
+    std::uint32_t                            m_clearColor     = 0;
+    std::vector<RasterTriangle>              m_triangles;
+    std::vector<std::vector<std::uint32_t>>  m_bins;           // Triangle indices per tile, in issue order
+    std::vector<int>                         m_activeTiles;
+
+    // Per-call scratch.
+    std::vector<ClipVertex>                  m_vertices;
+    std::vector<std::vector<RasterTriangle>> m_chunkTriangles;
+    std::vector<int>                         m_interlaceColumns; // Source column of each back buffer column
+
+    const wchar_t*                           m_error          = nullptr;
+    Stats                                    m_stats;
+};
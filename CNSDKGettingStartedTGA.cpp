@@ -0,0 +1,433 @@
+#include <string.h>
+#include <atomic>
+#include "CNSDKGettingStartedPixels.h"
+#include "CNSDKGettingStartedTGA.h"
+#include "CNSDKGettingStartedThreadPool.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define TGA_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define TGA_USE_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+    // Runs shorter than this are written pixel by pixel, setting up the vector pattern isn't worth it.
+    const size_t kMinVectorRun = 16;
+
+    // Output bytes per band of a parallel decode. Small enough to balance across threads,
+    // large enough that the per-band setup and RLE restart cost is negligible.
+    const size_t kBandBytes = 256 * 1024;
+
+    void FillPixelsScalar(std::uint8_t* dst, const std::uint8_t* pixel, int bytesPerPixel, size_t count)
+    {
+        for (size_t i = 0; i < count; i++, dst += bytesPerPixel)
+            memcpy(dst, pixel, bytesPerPixel);
+    }
+
+    void FillPixels4(std::uint8_t* dst, const std::uint8_t* pixel, size_t count)
+    {
+        std::uint32_t value;
+        memcpy(&value, pixel, 4);
+
+        size_t i = 0;
+#if defined(__AVX2__)
+        const __m256i v = _mm256_set1_epi32((int)value);
+        for (; i + 8 <= count; i += 8)
+            _mm256_storeu_si256((__m256i*)(dst + i * 4), v);
+#elif defined(TGA_USE_SSE2)
+        const __m128i v = _mm_set1_epi32((int)value);
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_si128((__m128i*)(dst + i * 4), v);
+#elif defined(TGA_USE_NEON)
+        const uint32x4_t v = vdupq_n_u32(value);
+        for (; i + 4 <= count; i += 4)
+            vst1q_u8(dst + i * 4, vreinterpretq_u8_u32(v));
+#endif
+        for (; i < count; i++)
+            memcpy(dst + i * 4, &value, 4);
+    }
+
+    void FillPixels3(std::uint8_t* dst, const std::uint8_t* pixel, size_t count)
+    {
+        size_t i = 0;
+#if defined(__AVX2__) || defined(TGA_USE_SSE2)
+        // 16 pixels are exactly 48 bytes, so three registers hold a repeating pattern.
+        alignas(16) std::uint8_t pattern[48];
+        FillPixelsScalar(pattern, pixel, 3, 16);
+        const __m128i p0 = _mm_load_si128((const __m128i*)(pattern +  0));
+        const __m128i p1 = _mm_load_si128((const __m128i*)(pattern + 16));
+        const __m128i p2 = _mm_load_si128((const __m128i*)(pattern + 32));
+        for (; i + 16 <= count; i += 16)
+        {
+            std::uint8_t* d = dst + i * 3;
+            _mm_storeu_si128((__m128i*)(d +  0), p0);
+            _mm_storeu_si128((__m128i*)(d + 16), p1);
+            _mm_storeu_si128((__m128i*)(d + 32), p2);
+        }
+#elif defined(TGA_USE_NEON)
+        uint8x16x3_t v;
+        v.val[0] = vdupq_n_u8(pixel[0]);
+        v.val[1] = vdupq_n_u8(pixel[1]);
+        v.val[2] = vdupq_n_u8(pixel[2]);
+        for (; i + 16 <= count; i += 16)
+            vst3q_u8(dst + i * 3, v);
+#endif
+        FillPixelsScalar(dst + i * 3, pixel, 3, count - i);
+    }
+}
+
+void FillPixels(std::uint8_t* dst, const std::uint8_t* pixel, int bytesPerPixel, size_t count)
+{
+    if (count < kMinVectorRun)
+        FillPixelsScalar(dst, pixel, bytesPerPixel, count);
+    else if (bytesPerPixel == 4)
+        FillPixels4(dst, pixel, count);
+    else
+        FillPixels3(dst, pixel, count);
+}
+
+bool TGADecoder::fillChunk()
+{
+    while (m_chunkPos >= m_chunk.size)
+    {
+        m_chunk    = m_input.next();
+        m_chunkPos = 0;
+        if (m_chunk.empty())
+            return false;
+    }
+    return true;
+}
+
+bool TGADecoder::readBytes(std::uint8_t* dst, size_t size)
+{
+    while (size > 0)
+    {
+        if (!fillChunk())
+            return fail(L"Invalid TGA file is truncated.");
+
+        const size_t available = m_chunk.size - m_chunkPos;
+        const size_t bytes     = (size < available) ? size : available;
+        memcpy(dst, m_chunk.data + m_chunkPos, bytes);
+        m_chunkPos += bytes;
+        dst        += bytes;
+        size       -= bytes;
+    }
+    return true;
+}
+
+bool TGADecoder::skipBytes(size_t size)
+{
+    while (size > 0)
+    {
+        if (!fillChunk())
+            return fail(L"Invalid TGA file is truncated.");
+
+        const size_t available = m_chunk.size - m_chunkPos;
+        const size_t bytes     = (size < available) ? size : available;
+        m_chunkPos += bytes;
+        size       -= bytes;
+    }
+    return true;
+}
+
+bool TGADecoder::readPixels(std::uint8_t* dst, size_t count)
+{
+    if (m_outputFormat == TGAOutputFormat::Native)
+        return readBytes(dst, count * m_bytesPerPixel);
+
+    const int         bpp       = m_bytesPerPixel;
+    const PixelFormat srcFormat = (bpp == 4) ? PixelFormat::BGRA8 : PixelFormat::BGR8;
+
+    while (count > 0)
+    {
+        if (!fillChunk())
+            return fail(L"Invalid TGA file is truncated.");
+
+        // Convert all whole pixels available in this chunk directly from the input.
+        const size_t available = (m_chunk.size - m_chunkPos) / bpp;
+        if (available > 0)
+        {
+            const size_t pixels = (count < available) ? count : available;
+            ConvertPixels(dst, PixelFormat::RGBA8, m_chunk.data + m_chunkPos, srcFormat, pixels);
+            m_chunkPos += pixels * bpp;
+            dst        += pixels * 4;
+            count      -= pixels;
+        }
+        else
+        {
+            // Pixel straddles two chunks.
+            std::uint8_t pixel[4];
+            if (!readBytes(pixel, bpp))
+                return false;
+            ConvertPixels(dst, PixelFormat::RGBA8, pixel, srcFormat, 1);
+            dst   += 4;
+            count -= 1;
+        }
+    }
+
+    return true;
+}
+
+bool TGADecoder::readHeader()
+{
+    std::uint8_t header[18];
+    if (!readBytes(header, sizeof(header)))
+        return false;
+
+    const int idLength     = header[0];
+    const int colorMapType = header[1];
+    const int imageType    = header[2];
+    const int bitsPerPixel = header[16];
+
+    if (colorMapType != 0)
+        return fail(L"Invalid TGA file uses a color map.");
+
+    if ((imageType != 2) && (imageType != 10))
+        return fail(L"Invalid TGA file isn't true-color.");
+
+    if ((bitsPerPixel != 24) && (bitsPerPixel != 32))
+        return fail(L"Invalid TGA file isn't 24/32-bit.");
+
+    m_width         = header[13] * 256 + header[12];
+    m_height        = header[15] * 256 + header[14];
+    m_bytesPerPixel = bitsPerPixel / 8;
+    m_compressed    = (imageType == 10);
+    m_currentRow    = 0;
+
+    if ((m_width <= 0) || (m_height <= 0))
+        return fail(L"Invalid TGA file has no pixels.");
+
+    // Skip image ID field.
+    std::uint8_t id[255];
+    return readBytes(id, idLength);
+}
+
+bool TGADecoder::beginPixelData(int width, int rowCount, int bytesPerPixel, bool compressed, size_t skipPixelCount)
+{
+    if ((width <= 0) || (rowCount < 0) || ((bytesPerPixel != 3) && (bytesPerPixel != 4)))
+        return fail(L"Invalid TGA pixel data layout.");
+
+    m_width           = width;
+    m_height          = rowCount;
+    m_bytesPerPixel   = bytesPerPixel;
+    m_compressed      = compressed;
+    m_currentRow      = 0;
+    m_isBand          = true;
+    m_packetRemaining = 0;
+
+    return skipPixels(skipPixelCount);
+}
+
+bool TGADecoder::beginPacket(size_t pixelsLeft)
+{
+    std::uint8_t packetHeader = 0;
+    if (!readBytes(&packetHeader, 1))
+        return false;
+
+    m_packetIsRun     = (packetHeader & 0x80) != 0;
+    m_packetRemaining = (packetHeader & 0x7F) + 1;
+
+    if (m_packetIsRun && !readPixels(m_runPixel, 1))
+        return false;
+
+    // A packet may cross into the next row but never past the end of the image.
+    if (!m_isBand && ((size_t)m_packetRemaining > pixelsLeft))
+        return fail(L"Invalid TGA file has a packet past the end of the image.");
+
+    return true;
+}
+
+bool TGADecoder::skipPixels(size_t count)
+{
+    if (!m_compressed)
+        return skipBytes(count * m_bytesPerPixel);
+
+    while (count > 0)
+    {
+        if ((m_packetRemaining == 0) && !beginPacket(count))
+            return false;
+
+        const size_t skipped = ((size_t)m_packetRemaining < count) ? (size_t)m_packetRemaining : count;
+        if (!m_packetIsRun && !skipBytes(skipped * m_bytesPerPixel))
+            return false;
+
+        count             -= skipped;
+        m_packetRemaining -= (int)skipped;
+    }
+
+    return true;
+}
+
+bool TGADecoder::decodeRowPixels(std::uint8_t* dst, int pixelCount)
+{
+    const int outputBpp = getOutputBytesPerPixel();
+
+    while (pixelCount > 0)
+    {
+        // Start a new packet.
+        if (m_packetRemaining == 0)
+        {
+            const size_t pixelsLeft = (size_t)(m_height - m_currentRow - 1) * m_width + pixelCount;
+            if (!beginPacket(pixelsLeft))
+                return false;
+        }
+
+        const int count = (m_packetRemaining < pixelCount) ? m_packetRemaining : pixelCount;
+
+        if (m_packetIsRun)
+            FillPixels(dst, m_runPixel, outputBpp, count);
+        else if (!readPixels(dst, count))
+            return false;
+
+        dst               += (size_t)count * outputBpp;
+        pixelCount        -= count;
+        m_packetRemaining -= count;
+    }
+
+    return true;
+}
+
+bool TGADecoder::decodeRows(std::uint8_t* dst, size_t dstRowPitch, int rowCount)
+{
+    if (m_bytesPerPixel == 0)
+        return fail(L"TGA header hasn't been read.");
+
+    if ((rowCount < 0) || (rowCount > m_height - m_currentRow))
+        return fail(L"Too many TGA rows requested.");
+
+    for (int row = 0; row < rowCount; row++, dst += dstRowPitch)
+    {
+        // Uncompressed rows are a single bulk copy or conversion.
+        const bool ok = m_compressed ? decodeRowPixels(dst, m_width) : readPixels(dst, m_width);
+        if (!ok)
+            return false;
+
+        m_currentRow++;
+    }
+
+    return true;
+}
+
+bool TGAParallelDecoder::readHeader()
+{
+    TGASpanInput input(m_file);
+    TGADecoder   decoder(input);
+    if (!decoder.readHeader())
+        return fail(decoder.getError());
+
+    m_width         = decoder.getWidth();
+    m_height        = decoder.getHeight();
+    m_bytesPerPixel = decoder.getBytesPerPixel();
+    m_compressed    = decoder.isCompressed();
+    m_dataOffset    = 18 + (size_t)m_file.data[0];
+    m_currentRow    = 0;
+
+    const size_t bandRows = kBandBytes / ((size_t)m_width * 4);
+    m_bandRows = (bandRows > 0) ? (int)bandRows : 1;
+
+    if (m_compressed)
+        return prescan();
+
+    if (m_file.size - m_dataOffset < (size_t)m_width * m_height * m_bytesPerPixel)
+        return fail(L"Invalid TGA file is truncated.");
+
+    return true;
+}
+
+bool TGAParallelDecoder::prescan()
+{
+    const size_t totalPixels = (size_t)m_width * m_height;
+    const size_t bandPixels  = (size_t)m_width * m_bandRows;
+
+    m_restarts.clear();
+    m_restarts.reserve((totalPixels + bandPixels - 1) / bandPixels);
+
+    size_t offset    = m_dataOffset;
+    size_t pixel     = 0;
+    size_t bandStart = 0;
+
+    while (pixel < totalPixels)
+    {
+        if (offset >= m_file.size)
+            return fail(L"Invalid TGA file is truncated.");
+
+        const std::uint8_t packetHeader = m_file.data[offset];
+        const bool         isRun        = (packetHeader & 0x80) != 0;
+        const size_t       count        = (packetHeader & 0x7F) + 1;
+        const size_t       payload      = (isRun ? 1 : count) * m_bytesPerPixel;
+
+        if (m_file.size - offset - 1 < payload)
+            return fail(L"Invalid TGA file is truncated.");
+
+        if (count > totalPixels - pixel)
+            return fail(L"Invalid TGA file has a packet past the end of the image.");
+
+        // Record every band that starts inside this packet.
+        for (; bandStart < pixel + count; bandStart += bandPixels)
+            m_restarts.push_back({ offset, bandStart - pixel });
+
+        pixel  += count;
+        offset += 1 + payload;
+    }
+
+    return true;
+}
+
+bool TGAParallelDecoder::decodeRows(std::uint8_t* dst, size_t dstRowPitch, int rowCount)
+{
+    if (m_bytesPerPixel == 0)
+        return fail(L"TGA header hasn't been read.");
+
+    if ((rowCount < 0) || (rowCount > m_height - m_currentRow))
+        return fail(L"Too many TGA rows requested.");
+
+    if (rowCount == 0)
+        return true;
+
+    // One job per band overlapping the requested rows, clipped to them.
+    const int firstRow  = m_currentRow;
+    const int endRow    = firstRow + rowCount;
+    const int firstBand = firstRow / m_bandRows;
+    const int jobCount  = (endRow - 1) / m_bandRows - firstBand + 1;
+
+    std::atomic<const wchar_t*> error{nullptr};
+
+    m_pool.parallelFor(jobCount, [&](int job)
+    {
+        const int band     = firstBand + job;
+        const int bandRow  = band * m_bandRows;
+        const int jobStart = (bandRow > firstRow) ? bandRow : firstRow;
+        const int jobEnd   = (bandRow + m_bandRows < endRow) ? bandRow + m_bandRows : endRow;
+
+        size_t offset = m_dataOffset + (size_t)jobStart * m_width * m_bytesPerPixel;
+        size_t skip   = 0;
+        if (m_compressed)
+        {
+            offset = m_restarts[band].offset;
+            skip   = m_restarts[band].skipPixels + (size_t)(jobStart - bandRow) * m_width;
+        }
+
+        TGASpanInput input(ByteSpan{ m_file.data + offset, m_file.size - offset });
+        TGADecoder   decoder(input);
+        decoder.setOutputFormat(m_outputFormat);
+
+        const bool ok = decoder.beginPixelData(m_width, jobEnd - jobStart, m_bytesPerPixel, m_compressed, skip) &&
+                        decoder.decodeRows(dst + (size_t)(jobStart - firstRow) * dstRowPitch, dstRowPitch, jobEnd - jobStart);
+        if (!ok)
+        {
+            const wchar_t* expected = nullptr;
+            error.compare_exchange_strong(expected, decoder.getError());
+        }
+    });
+
+    if (error.load() != nullptr)
+        return fail(error.load());
+
+    m_currentRow = endRow;
+    return true;
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <stdio.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "CNSDKGettingStartedFile.h"
+
+class ThreadPool;
+
+// Source of encoded TGA bytes. The decoder pulls chunks on demand, so an image
+// never has to be resident in memory as a whole.
+class TGAInput
+{
+public:
+
+    virtual ~TGAInput() = default;
+
+    // Returns the next chunk of input, or an empty span at the end of the stream.
+    virtual ByteSpan next() = 0;
+};
+
+// Input from a block of memory, e.g. a mapped FileSource.
+class TGASpanInput : public TGAInput
+{
+public:
+
+    explicit TGASpanInput(ByteSpan span) : m_span(span) {}
+
+    ByteSpan next() override
+    {
+        const ByteSpan ret = m_span;
+        m_span = ByteSpan();
+        return ret;
+    }
+
+private:
+
+    ByteSpan m_span;
+};
+
+// Input read from a file in fixed-size chunks.
+class TGAFileInput : public TGAInput
+{
+public:
+
+    explicit TGAFileInput(FILE* file, size_t chunkSize = 64 * 1024) : m_file(file), m_chunkSize(chunkSize), m_buffer(new std::uint8_t[chunkSize]) {}
+
+    ByteSpan next() override
+    {
+        const size_t bytes = (m_file != nullptr) ? fread(m_buffer.get(), 1, m_chunkSize, m_file) : 0;
+        return ByteSpan(m_buffer.get(), bytes);
+    }
+
+private:
+
+    FILE*                           m_file      = nullptr;
+    size_t                          m_chunkSize = 0;
+    std::unique_ptr<std::uint8_t[]> m_buffer;
+};
+
+// Pixel layout written by TGADecoder.
+enum class TGAOutputFormat
+{
+    Native, // File channel order, 3 or 4 bytes per pixel (BGR/BGRA)
+    RGBA8   // 4 bytes per pixel, swizzled to RGBA, alpha is 255 for 24-bit images
+};
+
+// Bounds-checked decoder for uncompressed (type 2) and run-length encoded (type 10)
+// 24/32-bit true-color TGA images.
+//
+// Rows are produced in file order, either in the file's channel order or swizzled
+// and expanded to RGBA8 in the same pass, so the output can go straight to an
+// upload buffer. Decoding can be split into any number of decodeRows() calls;
+// RLE packets that cross row boundaries are carried over between calls.
+class TGADecoder
+{
+public:
+
+    explicit TGADecoder(TGAInput& input) : m_input(input) {}
+
+    // Parse and validate the header. Must be called once before decoding.
+    bool readHeader();
+
+    // Start on headerless pixel data instead of calling readHeader(), e.g. one band of a larger
+    // image whose input begins at a packet boundary. The first skipPixels pixels are consumed
+    // without output. Packets may run past rowCount rows, the caller has validated the stream.
+    bool beginPixelData(int width, int rowCount, int bytesPerPixel, bool compressed, size_t skipPixels);
+
+    // Select the output layout. Defaults to TGAOutputFormat::Native.
+    void setOutputFormat(TGAOutputFormat format) { m_outputFormat = format; }
+
+    // Decode the next rowCount rows into dst, one row every dstRowPitch bytes.
+    bool decodeRows(std::uint8_t* dst, size_t dstRowPitch, int rowCount);
+
+    // Decode all remaining rows.
+    bool decode(std::uint8_t* dst, size_t dstRowPitch) { return decodeRows(dst, dstRowPitch, m_height - m_currentRow); }
+
+    int  getWidth()         const { return m_width; }
+    int  getHeight()        const { return m_height; }
+    int  getBytesPerPixel() const { return m_bytesPerPixel; }
+    bool isCompressed()     const { return m_compressed; }
+
+    // Bytes per decoded pixel in the selected output format.
+    int getOutputBytesPerPixel() const { return (m_outputFormat == TGAOutputFormat::RGBA8) ? 4 : m_bytesPerPixel; }
+
+    // Size of one tightly-packed decoded row.
+    size_t getRowSize() const { return (size_t)m_width * getOutputBytesPerPixel(); }
+
+    // Message describing why readHeader() or decodeRows() failed.
+    const wchar_t* getError() const { return m_error; }
+
+private:
+
+    bool fail(const wchar_t* error) { m_error = error; return false; }
+
+    // Copy exactly size input bytes into dst, gathering across chunks.
+    bool readBytes(std::uint8_t* dst, size_t size);
+
+    // Consume size input bytes.
+    bool skipBytes(size_t size);
+
+    // Make sure at least one input byte is available.
+    bool fillChunk();
+
+    // Read count pixels from the input and write them in the output format.
+    bool readPixels(std::uint8_t* dst, size_t count);
+
+    // Read the next RLE packet header (and run pixel). pixelsLeft is the number of pixels still to decode.
+    bool beginPacket(size_t pixelsLeft);
+
+    // Consume count pixels without output.
+    bool skipPixels(size_t count);
+
+    bool decodeRowPixels(std::uint8_t* dst, int pixelCount);
+
+    TGAInput&       m_input;
+    ByteSpan        m_chunk;
+    size_t          m_chunkPos        = 0;
+    const wchar_t*  m_error           = nullptr;
+
+    int             m_width           = 0;
+    int             m_height          = 0;
+    int             m_bytesPerPixel   = 0;
+    bool            m_compressed      = false;
+    int             m_currentRow      = 0;
+    bool            m_isBand          = false;
+    TGAOutputFormat m_outputFormat    = TGAOutputFormat::Native;
+
+    // RLE packet state carried across rows.
+    int             m_packetRemaining = 0;
+    bool            m_packetIsRun     = false;
+    std::uint8_t    m_runPixel[4]     = {};  // Already in the output format
+};
+
+// Decoder for a TGA image held in memory that spreads the work over a thread pool.
+//
+// Rows are split into bands decoded concurrently by TGADecoder instances. Uncompressed bands
+// start at a computed offset; RLE bands start at restart points (packet offset plus pixels to
+// skip) found by a prescan that only reads packet headers. The prescan also validates the whole
+// packet stream. Output is bit-identical to a single TGADecoder.
+class TGAParallelDecoder
+{
+public:
+
+    TGAParallelDecoder(ByteSpan file, ThreadPool& pool) : m_file(file), m_pool(pool) {}
+
+    // Parse and validate the header and, for RLE images, prescan the packets.
+    bool readHeader();
+
+    void setOutputFormat(TGAOutputFormat format) { m_outputFormat = format; }
+
+    // Decode the next rowCount rows into dst, one row every dstRowPitch bytes.
+    bool decodeRows(std::uint8_t* dst, size_t dstRowPitch, int rowCount);
+
+    // Decode all remaining rows.
+    bool decode(std::uint8_t* dst, size_t dstRowPitch) { return decodeRows(dst, dstRowPitch, m_height - m_currentRow); }
+
+    int  getWidth()         const { return m_width; }
+    int  getHeight()        const { return m_height; }
+    int  getBytesPerPixel() const { return m_bytesPerPixel; }
+    bool isCompressed()     const { return m_compressed; }
+
+    int    getOutputBytesPerPixel() const { return (m_outputFormat == TGAOutputFormat::RGBA8) ? 4 : m_bytesPerPixel; }
+    size_t getRowSize()             const { return (size_t)m_width * getOutputBytesPerPixel(); }
+
+    const wchar_t* getError() const { return m_error; }
+
+private:
+
+    struct RestartPoint
+    {
+        size_t offset;      // Offset of the packet containing the band's first pixel
+        size_t skipPixels;  // Pixels of that packet before the band starts
+    };
+
+    bool fail(const wchar_t* error) { m_error = error; return false; }
+
+    bool prescan();
+
+    ByteSpan                  m_file;
+    ThreadPool&               m_pool;
+    const wchar_t*            m_error         = nullptr;
+
+    int                       m_width         = 0;
+    int                       m_height        = 0;
+    int                       m_bytesPerPixel = 0;
+    bool                      m_compressed    = false;
+    size_t                    m_dataOffset    = 0;
+    int                       m_bandRows      = 0;
+    int                       m_currentRow    = 0;
+    TGAOutputFormat           m_outputFormat  = TGAOutputFormat::Native;
+    std::vector<RestartPoint> m_restarts;
+};
+
+// Write count copies of a bytesPerPixel (3 or 4) pixel to dst.
+void FillPixels(std::uint8_t* dst, const std::uint8_t* pixel, int bytesPerPixel, size_t count);
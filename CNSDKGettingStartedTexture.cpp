@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <string.h>
+#include "CNSDKGettingStartedPixels.h"
+#include "CNSDKGettingStartedSRGB.h"
+#include "CNSDKGettingStartedTexture.h"
+
+namespace
+{
+    size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Halve src with a 2x2 box filter. Odd edges reuse the last row/column. sRGB color
+    // channels are averaged in linear light, alpha always as stored.
+    void DownsampleRGBA(std::uint8_t* dst, int dstWidth, int dstHeight, const std::uint8_t* src, int srcWidth, int srcHeight, bool sRGB)
+    {
+        std::vector<float> linear[2];
+        std::vector<float> average;
+        if (sRGB)
+        {
+            linear[0].resize((size_t)srcWidth * 4);
+            linear[1].resize((size_t)srcWidth * 4);
+            average.resize((size_t)dstWidth * 4);
+        }
+
+        for (int y = 0; y < dstHeight; y++)
+        {
+            const int y0 = y * 2;
+            const int y1 = (y0 + 1 < srcHeight) ? y0 + 1 : y0;
+            const std::uint8_t* row0 = src + (size_t)y0 * srcWidth * 4;
+            const std::uint8_t* row1 = src + (size_t)y1 * srcWidth * 4;
+            std::uint8_t*       d    = dst + (size_t)y * dstWidth * 4;
+
+            if (sRGB)
+            {
+                SRGBA8ToLinear(linear[0].data(), row0, srcWidth);
+                SRGBA8ToLinear(linear[1].data(), row1, srcWidth);
+                for (int x = 0; x < dstWidth; x++)
+                {
+                    const int x0 = x * 2;
+                    const int x1 = (x0 + 1 < srcWidth) ? x0 + 1 : x0;
+                    for (int c = 0; c < 4; c++)
+                        average[x * 4 + c] = (linear[0][x0 * 4 + c] + linear[0][x1 * 4 + c] + linear[1][x0 * 4 + c] + linear[1][x1 * 4 + c]) * 0.25f;
+                }
+                LinearToSRGBA8(d, average.data(), dstWidth);
+            }
+
+            for (int x = 0; x < dstWidth; x++)
+            {
+                const int x0 = x * 2;
+                const int x1 = (x0 + 1 < srcWidth) ? x0 + 1 : x0;
+                const std::uint8_t* p[4] = { row0 + x0 * 4, row0 + x1 * 4, row1 + x0 * 4, row1 + x1 * 4 };
+
+                for (int c = sRGB ? 3 : 0; c < 4; c++)
+                    d[x * 4 + c] = (std::uint8_t)((p[0][c] + p[1][c] + p[2][c] + p[3][c] + 2) >> 2);
+            }
+        }
+    }
+}
+
+bool TextureFile::open(const char* filename)
+{
+    close();
+    m_error = nullptr;
+
+    if (!m_file.open(filename))
+        return fail(L"Failed to read texture file.");
+
+    const ByteSpan span = m_file.getSpan();
+    if (span.size < sizeof(TextureFileHeader))
+        return fail(L"Invalid texture file is truncated.");
+
+    TextureFileHeader header;
+    memcpy(&header, span.data, sizeof(header));
+
+    if (header.magic != kTextureFileMagic)
+        return fail(L"Invalid texture file signature.");
+
+    if (header.version != kTextureFileVersion)
+        return fail(L"Unsupported texture file version.");
+
+    const int bytesPerPixel = GetTextureFormatBytesPerPixel((TextureFormat)header.format);
+    if (bytesPerPixel == 0)
+        return fail(L"Unsupported texture file format.");
+
+    if ((header.width == 0) || (header.height == 0) || (header.width > (std::uint32_t)kTextureFileMaxSize) || (header.height > (std::uint32_t)kTextureFileMaxSize))
+        return fail(L"Invalid texture file size.");
+
+    if ((header.mipCount == 0) || (header.mipCount > (std::uint32_t)kTextureFileMaxMips))
+        return fail(L"Invalid texture file mip count.");
+
+    if (span.size - sizeof(TextureFileHeader) < header.mipCount * sizeof(TextureFileMip))
+        return fail(L"Invalid texture file is truncated.");
+
+    m_format = (TextureFormat)header.format;
+    m_sRGB   = (header.flags & kTextureFlagSRGB) != 0;
+
+    // Every level must be the expected halving of the previous one and lie inside the file.
+    std::uint32_t width  = header.width;
+    std::uint32_t height = header.height;
+    m_mips.resize(header.mipCount);
+    for (std::uint32_t i = 0; i < header.mipCount; i++)
+    {
+        TextureFileMip mip;
+        memcpy(&mip, span.data + sizeof(TextureFileHeader) + i * sizeof(TextureFileMip), sizeof(mip));
+
+        const std::uint64_t rowPitch = (std::uint64_t)width * bytesPerPixel;
+        if ((mip.width != width) || (mip.height != height) || (mip.rowPitch != rowPitch) || (mip.size != rowPitch * height))
+            return fail(L"Invalid texture file mip layout.");
+
+        if ((mip.offset % kTextureFileAlignment != 0) || (mip.offset > span.size) || (mip.size > span.size - mip.offset))
+            return fail(L"Invalid texture file mip is out of bounds.");
+
+        m_mips[i].data     = span.data + mip.offset;
+        m_mips[i].width    = (int)width;
+        m_mips[i].height   = (int)height;
+        m_mips[i].rowPitch = (size_t)rowPitch;
+
+        width  = (width  > 1) ? width  / 2 : 1;
+        height = (height > 1) ? height / 2 : 1;
+    }
+
+    return true;
+}
+
+bool TextureFileBuilder::setImage(const std::uint8_t* rgba, int width, int height, size_t rowPitch, bool sRGB, bool buildMips)
+{
+    if ((width <= 0) || (height <= 0) || (width > kTextureFileMaxSize) || (height > kTextureFileMaxSize))
+        return fail(L"Invalid texture size.");
+
+    m_sRGB = sRGB;
+    m_levels.clear();
+    m_levels.reserve(kTextureFileMaxMips);
+
+    Level top;
+    top.width  = width;
+    top.height = height;
+    top.rgba.resize((size_t)width * height * 4);
+    for (int y = 0; y < height; y++)
+        memcpy(top.rgba.data() + (size_t)y * width * 4, rgba + y * rowPitch, (size_t)width * 4);
+    m_levels.push_back(std::move(top));
+
+    if (!buildMips)
+        return true;
+
+    while ((m_levels.back().width > 1) || (m_levels.back().height > 1))
+    {
+        const Level& src = m_levels.back();
+
+        Level dst;
+        dst.width  = (src.width  > 1) ? src.width  / 2 : 1;
+        dst.height = (src.height > 1) ? src.height / 2 : 1;
+        dst.rgba.resize((size_t)dst.width * dst.height * 4);
+        DownsampleRGBA(dst.rgba.data(), dst.width, dst.height, src.rgba.data(), src.width, src.height, sRGB);
+        m_levels.push_back(std::move(dst));
+    }
+
+    return true;
+}
+
+bool TextureFileBuilder::write(const char* filename, TextureFormat format)
+{
+    if (m_levels.empty())
+        return fail(L"No texture image set.");
+
+    const int bytesPerPixel = GetTextureFormatBytesPerPixel(format);
+    if (bytesPerPixel == 0)
+        return fail(L"Unsupported texture format.");
+
+    TextureFileHeader header = {};
+    header.magic    = kTextureFileMagic;
+    header.version  = kTextureFileVersion;
+    header.format   = (std::uint32_t)format;
+    header.flags    = m_sRGB ? kTextureFlagSRGB : 0;
+    header.width    = (std::uint32_t)m_levels[0].width;
+    header.height   = (std::uint32_t)m_levels[0].height;
+    header.mipCount = (std::uint32_t)m_levels.size();
+
+    // Lay out the payloads after the mip table, each aligned.
+    std::vector<TextureFileMip> mips(m_levels.size());
+    size_t offset = AlignUp(sizeof(TextureFileHeader) + mips.size() * sizeof(TextureFileMip), kTextureFileAlignment);
+    for (size_t i = 0; i < m_levels.size(); i++)
+    {
+        TextureFileMip& mip = mips[i];
+        mip          = {};
+        mip.width    = (std::uint32_t)m_levels[i].width;
+        mip.height   = (std::uint32_t)m_levels[i].height;
+        mip.rowPitch = mip.width * bytesPerPixel;
+        mip.size     = (std::uint64_t)mip.rowPitch * mip.height;
+        mip.offset   = offset;
+        offset       = AlignUp(offset + (size_t)mip.size, kTextureFileAlignment);
+    }
+
+    FILE* file = fopen(filename, "wb");
+    if (file == nullptr)
+        return fail(L"Failed to create texture file.");
+
+    bool ok = (fwrite(&header, sizeof(header), 1, file) == 1) &&
+              (fwrite(mips.data(), sizeof(TextureFileMip), mips.size(), file) == mips.size());
+
+    size_t position = sizeof(header) + mips.size() * sizeof(TextureFileMip);
+
+    std::vector<std::uint8_t> converted;
+    for (size_t i = 0; ok && (i < m_levels.size()); i++)
+    {
+        // Pad up to the payload.
+        static const std::uint8_t zeros[kTextureFileAlignment] = {};
+        const size_t padding = (size_t)mips[i].offset - position;
+        ok = (fwrite(zeros, 1, padding, file) == padding);
+        position += padding + (size_t)mips[i].size;
+
+        const std::uint8_t* data = m_levels[i].rgba.data();
+        const size_t pixelCount  = (size_t)mips[i].width * mips[i].height;
+        if (format == TextureFormat::BGRA8)
+        {
+            converted.resize(pixelCount * 4);
+            ConvertPixels(converted.data(), PixelFormat::BGRA8, data, PixelFormat::RGBA8, pixelCount);
+            data = converted.data();
+        }
+
+        ok = ok && (fwrite(data, 1, (size_t)mips[i].size, file) == (size_t)mips[i].size);
+    }
+
+    ok = (fclose(file) == 0) && ok;
+    if (!ok)
+    {
+        remove(filename);
+        return fail(L"Failed to write texture file.");
+    }
+
+    return true;
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <stddef.h>
+#include <cstdint>
+#include <vector>
+#include "CNSDKGettingStartedFile.h"
+
+// Preprocessed texture container (.ctex), written offline by CNSDKTextureConverter and
+// memory-mapped at runtime so mip levels go straight to texture creation.
+//
+// Layout, all fields little-endian:
+//   TextureFileHeader                  64 bytes
+//   TextureFileMip[mipCount]           32 bytes each, largest level first
+//   Mip payloads                       each starting at a multiple of kTextureFileAlignment
+// Rows are tightly packed, so rowPitch is width * bytes per pixel.
+
+const std::uint32_t kTextureFileMagic     = 0x58455443; // "CTEX"
+const std::uint32_t kTextureFileVersion   = 1;
+const size_t        kTextureFileAlignment = 64;
+const int           kTextureFileMaxMips   = 16;
+const int           kTextureFileMaxSize   = 1 << (kTextureFileMaxMips - 1); // Largest width or height, so the full chain fits
+
+// Texel layouts, named in memory byte order.
+enum class TextureFormat : std::uint32_t
+{
+    RGBA8 = 1,
+    BGRA8 = 2
+};
+
+// TextureFileHeader::flags
+const std::uint32_t kTextureFlagSRGB = 1; // Color channels are sRGB encoded (mips were filtered in linear light)
+
+struct TextureFileHeader
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t format;   // TextureFormat
+    std::uint32_t flags;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t mipCount;
+    std::uint32_t reserved[9];
+};
+
+struct TextureFileMip
+{
+    std::uint64_t offset;   // From the start of the file
+    std::uint64_t size;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t rowPitch;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(TextureFileHeader) == 64, "TextureFileHeader layout");
+static_assert(sizeof(TextureFileMip) == 32, "TextureFileMip layout");
+
+inline int GetTextureFormatBytesPerPixel(TextureFormat format)
+{
+    switch (format)
+    {
+    case TextureFormat::RGBA8:
+    case TextureFormat::BGRA8: return 4;
+    }
+    return 0;
+}
+
+// One mip level.
+struct TextureMip
+{
+    const std::uint8_t* data     = nullptr;
+    int                 width    = 0;
+    int                 height   = 0;
+    size_t              rowPitch = 0;
+};
+
+// Memory-mapped, validated texture file. Mip data points into the mapping.
+class TextureFile
+{
+public:
+
+    // Map the file and validate the header and every mip's bounds.
+    bool open(const char* filename);
+
+    void close() { m_file.close(); m_mips.clear(); }
+
+    bool          isOpen()      const { return m_file.isOpen(); }
+    TextureFormat getFormat()   const { return m_format; }
+    bool          isSRGB()      const { return m_sRGB; }
+    int           getMipCount() const { return (int)m_mips.size(); }
+
+    // Valid until close() or destruction. Level 0 is the full-size image.
+    const TextureMip& getMip(int level) const { return m_mips[level]; }
+
+    const wchar_t* getError() const { return m_error; }
+
+private:
+
+    bool fail(const wchar_t* error) { close(); m_error = error; return false; }
+
+    FileSource              m_file;
+    TextureFormat           m_format = TextureFormat::RGBA8;
+    bool                    m_sRGB   = false;
+    std::vector<TextureMip> m_mips;
+    const wchar_t*          m_error  = nullptr;
+};
+
+// Builds the mip chain for an image and writes it as a texture file.
+class TextureFileBuilder
+{
+public:
+
+    // Take an RGBA8 image as level 0 and, if buildMips is set, generate every level down to 1x1
+    // with a 2x2 box filter. sRGB images are filtered in linear light.
+    bool setImage(const std::uint8_t* rgba, int width, int height, size_t rowPitch, bool sRGB, bool buildMips);
+
+    // Write the levels in the given format.
+    bool write(const char* filename, TextureFormat format);
+
+    int getMipCount() const { return (int)m_levels.size(); }
+
+    const wchar_t* getError() const { return m_error; }
+
+private:
+
+    struct Level
+    {
+        int                       width  = 0;
+        int                       height = 0;
+        std::vector<std::uint8_t> rgba;
+    };
+
+    bool fail(const wchar_t* error) { m_error = error; return false; }
+
+    std::vector<Level> m_levels;
+    bool               m_sRGB  = false;
+    const wchar_t*     m_error = nullptr;
+};
@@ -0,0 +1,119 @@
+#include <atomic>
+#include <memory>
+#include "CNSDKGettingStartedThreadPool.h"
+
+ThreadPool::ThreadPool(int threadCount)
+{
+    if (threadCount <= 0)
+        threadCount = (int)std::thread::hardware_concurrency();
+    if (threadCount <= 0)
+        threadCount = 1;
+
+    m_threads.reserve(threadCount);
+    for (int i = 0; i < threadCount; i++)
+        m_threads.emplace_back(&ThreadPool::workerMain, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (std::thread& thread : m_threads)
+        thread.join();
+}
+
+void ThreadPool::enqueue(std::function<void()> func, TaskPriority priority)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push({ priority, m_nextSequence++, std::move(func) });
+    }
+    m_wakeCondition.notify_one();
+}
+
+TaskHandle ThreadPool::submit(std::function<void()> task, TaskPriority priority)
+{
+    // std::function must be copyable, so the packaged task is held by pointer.
+    std::shared_ptr<std::packaged_task<void()>> packagedTask = std::make_shared<std::packaged_task<void()>>(std::move(task));
+    TaskHandle handle = packagedTask->get_future().share();
+    enqueue([packagedTask]() { (*packagedTask)(); }, priority);
+    return handle;
+}
+
+void ThreadPool::workerMain()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+
+            // Drain the queue before stopping.
+            if (m_tasks.empty())
+                return;
+
+            // priority_queue only exposes a const top.
+            task = std::move(const_cast<QueuedTask&>(m_tasks.top()).func);
+            m_tasks.pop();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& func)
+{
+    if (count <= 0)
+        return;
+
+    if (count == 1)
+    {
+        func(0);
+        return;
+    }
+
+    // Indices are handed out dynamically so uneven items balance across threads. The state is
+    // shared with the helper tasks because a helper may only get to run after all items are done.
+    struct Shared
+    {
+        std::atomic<int>        next{0};
+        std::atomic<int>        remaining{0};
+        std::mutex              mutex;
+        std::condition_variable doneCondition;
+    };
+    std::shared_ptr<Shared> shared = std::make_shared<Shared>();
+    shared->remaining = count;
+
+    const std::function<void(int)>* funcPtr = &func;
+    auto worker = [shared, funcPtr, count]()
+    {
+        int done = 0;
+        for (int i = shared->next++; i < count; i = shared->next++)
+        {
+            (*funcPtr)(i);
+            done++;
+        }
+
+        if ((done > 0) && (shared->remaining.fetch_sub(done) == done))
+        {
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            shared->doneCondition.notify_all();
+        }
+    };
+
+    // Helpers jump the queue, the caller may itself be a task that others are waiting on.
+    const int helpers = (count - 1 < getThreadCount()) ? count - 1 : getThreadCount();
+    for (int i = 0; i < helpers; i++)
+        enqueue(worker, TaskPriority::High);
+
+    // The calling thread takes part too.
+    worker();
+
+    // Wait for items still running on workers.
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    shared->doneCondition.wait(lock, [&shared] { return shared->remaining.load() == 0; });
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Order in which queued tasks are started. Tasks of equal priority start in submission order.
+enum class TaskPriority
+{
+    Low,
+    Normal,
+    High
+};
+
+// Completion handle of a submitted task. wait() blocks until the task has run,
+// wait_for(std::chrono::seconds(0)) polls.
+typedef std::shared_future<void> TaskHandle;
+
+// Fixed set of worker threads executing queued tasks.
+class ThreadPool
+{
+public:
+
+    // threadCount <= 0 uses one worker per hardware thread.
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int getThreadCount() const { return (int)m_threads.size(); }
+
+    // Queue a task to run on a worker thread.
+    TaskHandle submit(std::function<void()> task, TaskPriority priority = TaskPriority::Normal);
+
+    // Run func(0) ... func(count - 1) across the workers and the calling thread, return when all are done.
+    void parallelFor(int count, const std::function<void(int)>& func);
+
+private:
+
+    struct QueuedTask
+    {
+        TaskPriority          priority;
+        std::uint64_t         sequence;
+        std::function<void()> func;
+
+        // Highest priority first, then lowest sequence.
+        bool operator<(const QueuedTask& other) const
+        {
+            if (priority != other.priority)
+                return priority < other.priority;
+            return sequence > other.sequence;
+        }
+    };
+
+    void enqueue(std::function<void()> func, TaskPriority priority);
+    void workerMain();
+
+    std::vector<std::thread>        m_threads;
+    std::priority_queue<QueuedTask> m_tasks;
+    std::uint64_t                   m_nextSequence = 0;
+    std::mutex                      m_mutex;
+    std::condition_variable         m_wakeCondition;
+    bool                            m_stopping     = false;
+};
@@ -0,0 +1,271 @@
+#include "CNSDKGettingStartedTransforms.h"
+#include <string.h>
+#include <algorithm>
+#include <new>
+#include "CNSDKGettingStartedThreadPool.h"
+
+using namespace MathSIMD;
+
+namespace
+{
+    // Ranges per thread of ForEachBatchRange, the workers and the calling thread.
+    const size_t kRangesPerThread = 4;
+
+    void ClearPadding(Vec3fBatch& batch)
+    {
+        batch.x.clearPadding();
+        batch.y.clearPadding();
+        batch.z.clearPadding();
+    }
+
+    // Blocks of 4 covering [begin, end). Batch arrays are padded, so the last block may run past end.
+    void TransformPointRange(const mat4f& matrix, const Vec3fBatch& in, Vec3fBatch& out, size_t begin, size_t end)
+    {
+        const Vec4 Xx = Splat(matrix.Xx), Xy = Splat(matrix.Xy), Xz = Splat(matrix.Xz);
+        const Vec4 Yx = Splat(matrix.Yx), Yy = Splat(matrix.Yy), Yz = Splat(matrix.Yz);
+        const Vec4 Zx = Splat(matrix.Zx), Zy = Splat(matrix.Zy), Zz = Splat(matrix.Zz);
+        const Vec4 Wx = Splat(matrix.Wx), Wy = Splat(matrix.Wy), Wz = Splat(matrix.Wz);
+
+        for (size_t i = begin; i < end; i += 4)
+        {
+            const Vec4 x = Load(in.x.data() + i);
+            const Vec4 y = Load(in.y.data() + i);
+            const Vec4 z = Load(in.z.data() + i);
+
+            Store(out.x.data() + i, Add(MulAdd(Zx, z, MulAdd(Yx, y, Mul(Xx, x))), Wx));
+            Store(out.y.data() + i, Add(MulAdd(Zy, z, MulAdd(Yy, y, Mul(Xy, x))), Wy));
+            Store(out.z.data() + i, Add(MulAdd(Zz, z, MulAdd(Yz, y, Mul(Xz, x))), Wz));
+        }
+    }
+
+    void TransformVectorRange(const mat4f& matrix, const Vec3fBatch& in, Vec3fBatch& out, size_t begin, size_t end)
+    {
+        const Vec4 Xx = Splat(matrix.Xx), Xy = Splat(matrix.Xy), Xz = Splat(matrix.Xz);
+        const Vec4 Yx = Splat(matrix.Yx), Yy = Splat(matrix.Yy), Yz = Splat(matrix.Yz);
+        const Vec4 Zx = Splat(matrix.Zx), Zy = Splat(matrix.Zy), Zz = Splat(matrix.Zz);
+
+        for (size_t i = begin; i < end; i += 4)
+        {
+            const Vec4 x = Load(in.x.data() + i);
+            const Vec4 y = Load(in.y.data() + i);
+            const Vec4 z = Load(in.z.data() + i);
+
+            Store(out.x.data() + i, MulAdd(Zx, z, MulAdd(Yx, y, Mul(Xx, x))));
+            Store(out.y.data() + i, MulAdd(Zy, z, MulAdd(Yy, y, Mul(Xy, x))));
+            Store(out.z.data() + i, MulAdd(Zz, z, MulAdd(Yz, y, Mul(Xz, x))));
+        }
+    }
+
+    // Same operation order as Mat4Mul, with lhs kept in registers across the range.
+    void MultiplyMatrixRange(const mat4f& lhs, const mat4f* matrices, mat4f* out, size_t begin, size_t end)
+    {
+        const Vec4 a0 = lhs.e[0].v;
+        const Vec4 a1 = lhs.e[1].v;
+        const Vec4 a2 = lhs.e[2].v;
+        const Vec4 a3 = lhs.e[3].v;
+
+        for (size_t i = begin; i < end; i++)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                const Vec4 c = matrices[i].e[j].v;
+                Vec4 r = Mul(a0, SplatLane<0>(c));
+                r = MulAdd(a1, SplatLane<1>(c), r);
+                r = MulAdd(a2, SplatLane<2>(c), r);
+                r = MulAdd(a3, SplatLane<3>(c), r);
+                out[i].e[j].v = r;
+            }
+        }
+    }
+
+    // Four objects per step: every matrix component is computed for all four in one register,
+    // then the registers are transposed into four columns. loadTranslation(i, x, y, z) loads the
+    // translations of objects i..i+3.
+    template <typename LoadTranslation>
+    void ComposeTransformRange(const LoadTranslation& loadTranslation, const QuatfBatch& rotations, const Vec3fBatch& scales, mat4f* out, size_t begin, size_t end)
+    {
+        const Vec4 zero = Splat(0.0f);
+        const Vec4 one  = Splat(1.0f);
+
+        for (size_t i = begin; i < end; i += 4)
+        {
+            const Vec4 qx = Load(rotations.x.data() + i);
+            const Vec4 qy = Load(rotations.y.data() + i);
+            const Vec4 qz = Load(rotations.z.data() + i);
+            const Vec4 qw = Load(rotations.w.data() + i);
+
+            // As mat3f::fromQuaternion.
+            const Vec4 x2  = Add(qx, qx);
+            const Vec4 y2  = Add(qy, qy);
+            const Vec4 z2  = Add(qz, qz);
+            const Vec4 xx2 = Mul(qx, x2);
+            const Vec4 xy2 = Mul(qx, y2);
+            const Vec4 xz2 = Mul(qx, z2);
+            const Vec4 yy2 = Mul(qy, y2);
+            const Vec4 yz2 = Mul(qy, z2);
+            const Vec4 zz2 = Mul(qz, z2);
+            const Vec4 sx2 = Mul(qw, x2);
+            const Vec4 sy2 = Mul(qw, y2);
+            const Vec4 sz2 = Mul(qw, z2);
+
+            const Vec4 sx = Load(scales.x.data() + i);
+            const Vec4 sy = Load(scales.y.data() + i);
+            const Vec4 sz = Load(scales.z.data() + i);
+
+            Vec4 cx0 = Mul(Sub(one, Add(yy2, zz2)), sx);
+            Vec4 cx1 = Mul(Add(xy2, sz2), sx);
+            Vec4 cx2 = Mul(Sub(xz2, sy2), sx);
+            Vec4 cx3 = zero;
+
+            Vec4 cy0 = Mul(Sub(xy2, sz2), sy);
+            Vec4 cy1 = Mul(Sub(one, Add(xx2, zz2)), sy);
+            Vec4 cy2 = Mul(Add(yz2, sx2), sy);
+            Vec4 cy3 = zero;
+
+            Vec4 cz0 = Mul(Add(xz2, sy2), sz);
+            Vec4 cz1 = Mul(Sub(yz2, sx2), sz);
+            Vec4 cz2 = Mul(Sub(one, Add(xx2, yy2)), sz);
+            Vec4 cz3 = zero;
+
+            Vec4 cw0, cw1, cw2;
+            Vec4 cw3 = one;
+            loadTranslation(i, cw0, cw1, cw2);
+
+            Transpose(cx0, cx1, cx2, cx3);
+            Transpose(cy0, cy1, cy2, cy3);
+            Transpose(cz0, cz1, cz2, cz3);
+            Transpose(cw0, cw1, cw2, cw3);
+
+            // The output array isn't padded, so the last partial block goes through a temporary.
+            mat4f block[4];
+            mat4f* dst = ((end - i) >= 4) ? (out + i) : block;
+
+            dst[0].e[0].v = cx0; dst[0].e[1].v = cy0; dst[0].e[2].v = cz0; dst[0].e[3].v = cw0;
+            dst[1].e[0].v = cx1; dst[1].e[1].v = cy1; dst[1].e[2].v = cz1; dst[1].e[3].v = cw1;
+            dst[2].e[0].v = cx2; dst[2].e[1].v = cy2; dst[2].e[2].v = cz2; dst[2].e[3].v = cw2;
+            dst[3].e[0].v = cx3; dst[3].e[1].v = cy3; dst[3].e[2].v = cz3; dst[3].e[3].v = cw3;
+
+            if (dst == block)
+                memcpy(out + i, block, (end - i) * sizeof(mat4f));
+        }
+    }
+}
+
+template <typename T>
+void BasicBatchArray<T>::AlignedDelete::operator()(T* data) const
+{
+    ::operator delete[](data, std::align_val_t(kBatchAlignment));
+}
+
+template <typename T>
+void BasicBatchArray<T>::resize(size_t count)
+{
+    const size_t padded = (count + kBatchPadding - 1) / kBatchPadding * kBatchPadding;
+
+    m_data.reset();
+    m_size = 0;
+    if (padded > 0)
+    {
+        m_data.reset((T*)::operator new[](padded * sizeof(T), std::align_val_t(kBatchAlignment)));
+        memset(m_data.get() + count, 0, (padded - count) * sizeof(T));
+    }
+    m_size = count;
+}
+
+template <typename T>
+void BasicBatchArray<T>::clearPadding()
+{
+    const size_t padded = (m_size + kBatchPadding - 1) / kBatchPadding * kBatchPadding;
+    if (padded > m_size)
+        memset(m_data.get() + m_size, 0, (padded - m_size) * sizeof(T));
+}
+
+template class BasicBatchArray<float>;
+template class BasicBatchArray<double>;
+
+void ForEachBatchRange(size_t count, ThreadPool* pool, const std::function<void(size_t, size_t)>& func)
+{
+    // A multiple of kBatchPadding, so ranges start on aligned blocks.
+    const size_t threadCount = (pool != nullptr) ? (size_t)pool->getThreadCount() + 1 : 1;
+    const size_t target      = (count + threadCount * kRangesPerThread - 1) / (threadCount * kRangesPerThread);
+    const size_t rangeSize   = (std::max(target, kMinBatchRangeSize) + kBatchPadding - 1) / kBatchPadding * kBatchPadding;
+    const size_t rangeCount  = (count + rangeSize - 1) / rangeSize;
+    if ((pool == nullptr) || (rangeCount <= 1))
+    {
+        func((size_t)0, count);
+        return;
+    }
+
+    pool->parallelFor((int)rangeCount, [&](int range)
+    {
+        const size_t begin = (size_t)range * rangeSize;
+        func(begin, std::min(begin + rangeSize, count));
+    });
+}
+
+void TransformPoints(const mat4f& matrix, const Vec3fBatch& in, Vec3fBatch& out, ThreadPool* pool)
+{
+    // Same size when out is in, so this never discards the input.
+    if (out.size() != in.size())
+        out.resize(in.size());
+
+    ForEachBatchRange(in.size(), pool, [&](size_t begin, size_t end)
+    {
+        TransformPointRange(matrix, in, out, begin, end);
+    });
+    ClearPadding(out);
+}
+
+void TransformVectors(const mat4f& matrix, const Vec3fBatch& in, Vec3fBatch& out, ThreadPool* pool)
+{
+    if (out.size() != in.size())
+        out.resize(in.size());
+
+    ForEachBatchRange(in.size(), pool, [&](size_t begin, size_t end)
+    {
+        TransformVectorRange(matrix, in, out, begin, end);
+    });
+    ClearPadding(out);
+}
+
+void MultiplyMatrices(const mat4f& lhs, const mat4f* matrices, mat4f* out, size_t count, ThreadPool* pool)
+{
+    ForEachBatchRange(count, pool, [&](size_t begin, size_t end)
+    {
+        MultiplyMatrixRange(lhs, matrices, out, begin, end);
+    });
+}
+
+void ComposeTransforms(const Vec3fBatch& translations, const QuatfBatch& rotations, const Vec3fBatch& scales, mat4f* out, ThreadPool* pool)
+{
+    const size_t count = std::min(translations.size(), std::min(rotations.size(), scales.size()));
+
+    const auto loadTranslation = [&](size_t i, Vec4& x, Vec4& y, Vec4& z)
+    {
+        x = Load(translations.x.data() + i);
+        y = Load(translations.y.data() + i);
+        z = Load(translations.z.data() + i);
+    };
+
+    ForEachBatchRange(count, pool, [&](size_t begin, size_t end)
+    {
+        ComposeTransformRange(loadTranslation, rotations, scales, out, begin, end);
+    });
+}
+
+void ComposeRelativeTransforms(const vec3& origin, const Vec3dBatch& positions, const QuatfBatch& rotations, const Vec3fBatch& scales, mat4f* out, ThreadPool* pool)
+{
+    const size_t count = std::min(positions.size(), std::min(rotations.size(), scales.size()));
+
+    const auto loadTranslation = [&](size_t i, Vec4& x, Vec4& y, Vec4& z)
+    {
+        x = LoadRelative(positions.x.data() + i, origin.x);
+        y = LoadRelative(positions.y.data() + i, origin.y);
+        z = LoadRelative(positions.z.data() + i, origin.z);
+    };
+
+    ForEachBatchRange(count, pool, [&](size_t begin, size_t end)
+    {
+        ComposeTransformRange(loadTranslation, rotations, scales, out, begin, end);
+    });
+}
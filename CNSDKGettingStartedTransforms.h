@@ -0,0 +1,128 @@
+#pragma once
+
+#include <stddef.h>
+#include <functional>
+#include <memory>
+#include "CNSDKGettingStartedMath.h"
+
+class ThreadPool;
+
+// Batch transforms over many objects, on structure-of-arrays data: each vector component lives
+// in its own contiguous array so four objects fill a SIMD register. The arithmetic is done in the
+// same order as the per-object mat4f operations, so results match them bit for bit.
+//
+// The functions split large batches into ranges across a thread pool when one is passed, and run
+// on the calling thread otherwise.
+
+// Start alignment of every batch array, and the multiple its storage is padded to.
+const size_t kBatchAlignment = 32;
+const size_t kBatchPadding   = kBatchAlignment / sizeof(float);
+
+// Float or double array aligned to kBatchAlignment. Storage is padded to a multiple of
+// kBatchPadding elements, with the padding zeroed, so kernels can always run whole SIMD blocks.
+// Kernels writing whole blocks into an array zero its padding again when done.
+template <typename T>
+class BasicBatchArray
+{
+public:
+
+    BasicBatchArray() = default;
+    explicit BasicBatchArray(size_t count) { resize(count); }
+
+    // Reallocate for count elements. The previous contents are discarded.
+    void resize(size_t count);
+
+    // Zero the padding after size(), e.g. after storing whole blocks over it.
+    void clearPadding();
+
+    size_t   size() const                     { return m_size; }
+    T*       data()                           { return m_data.get(); }
+    const T* data() const                     { return m_data.get(); }
+    T&       operator[](size_t index)         { return m_data[index]; }
+    T        operator[](size_t index) const   { return m_data[index]; }
+
+private:
+
+    struct AlignedDelete
+    {
+        void operator()(T* data) const;
+    };
+
+    std::unique_ptr<T[], AlignedDelete> m_data;
+    size_t                              m_size = 0;
+};
+
+typedef BasicBatchArray<float>  BatchArray;
+typedef BasicBatchArray<double> DoubleBatchArray;
+
+// Positions, directions or scales.
+struct Vec3fBatch
+{
+    BatchArray x;
+    BatchArray y;
+    BatchArray z;
+
+    void   resize(size_t count)                 { x.resize(count); y.resize(count); z.resize(count); }
+    size_t size() const                         { return x.size(); }
+    vec3f  get(size_t index) const              { return vec3f(x[index], y[index], z[index]); }
+    void   set(size_t index, const vec3f& v)    { x[index] = v.x; y[index] = v.y; z[index] = v.z; }
+};
+
+// World-space positions in double precision.
+struct Vec3dBatch
+{
+    DoubleBatchArray x;
+    DoubleBatchArray y;
+    DoubleBatchArray z;
+
+    void   resize(size_t count)                 { x.resize(count); y.resize(count); z.resize(count); }
+    size_t size() const                         { return x.size(); }
+    vec3   get(size_t index) const              { return vec3(x[index], y[index], z[index]); }
+    void   set(size_t index, const vec3& v)     { x[index] = v.x; y[index] = v.y; z[index] = v.z; }
+};
+
+// Unit rotation quaternions, the components of quatf.
+struct QuatfBatch
+{
+    BatchArray x;
+    BatchArray y;
+    BatchArray z;
+    BatchArray w;
+
+    void   resize(size_t count)                 { x.resize(count); y.resize(count); z.resize(count); w.resize(count); }
+    size_t size() const                         { return x.size(); }
+    quatf  get(size_t index) const              { return quatf(x[index], y[index], z[index], w[index]); }
+    void   set(size_t index, const quatf& q)    { x[index] = q.x; y[index] = q.y; z[index] = q.z; w[index] = q.w; }
+};
+
+// Smallest range ForEachBatchRange hands to a thread, so tiny ranges don't cost more to
+// schedule than to run.
+const size_t kMinBatchRangeSize = 1024;
+
+// Call func(begin, end) over [0, count), split into ranges starting on kBatchPadding boundaries
+// and run across the pool, a few ranges per thread so uneven ones balance. Runs on the calling
+// thread without a pool or when there is only one range.
+void ForEachBatchRange(size_t count, ThreadPool* pool, const std::function<void(size_t, size_t)>& func);
+
+// out[i] = matrix * (in[i], 1), keeping xyz. For affine matrices. out is resized to match in
+// and may be in.
+void TransformPoints(const mat4f& matrix, const Vec3fBatch& in, Vec3fBatch& out, ThreadPool* pool = nullptr);
+
+// out[i] = upper 3x3 of matrix * in[i], for directions. out is resized to match in and may be in.
+void TransformVectors(const mat4f& matrix, const Vec3fBatch& in, Vec3fBatch& out, ThreadPool* pool = nullptr);
+
+// out[i] = lhs * matrices[i], e.g. a view-projection times each model matrix. Call once per view
+// for several views. out may not overlap matrices.
+void MultiplyMatrices(const mat4f& lhs, const mat4f* matrices, mat4f* out, size_t count, ThreadPool* pool = nullptr);
+
+// Model matrices from translation, rotation and scale: out[i] = T * R * S, the same as
+// mat4f::create with the fromQuaternion axes scaled by scales[i]. All batches must have the
+// same size; out must hold that many matrices.
+void ComposeTransforms(const Vec3fBatch& translations, const QuatfBatch& rotations, const Vec3fBatch& scales, mat4f* out, ThreadPool* pool = nullptr);
+
+// ComposeTransforms for objects placed in double-precision world space, rendered relative to
+// origin (usually the camera position): the translation of out[i] is positions[i] - origin,
+// subtracted in double and then rounded to float. Pair with a view matrix for a camera at
+// cameraPosition - origin, so float precision is spent near the viewer however far from the
+// world origin it is. Same results as ComposeTransforms on the rounded differences.
+void ComposeRelativeTransforms(const vec3& origin, const Vec3dBatch& positions, const QuatfBatch& rotations, const Vec3fBatch& scales, mat4f* out, ThreadPool* pool = nullptr);
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <math.h>
+#include "CNSDKGettingStartedMath.h"
+
+// Per-view camera math of leia_get_view_info (leia/core/interlacer.h) for all views of a camera
+// in one pass, inline and without the SDK. Terms shared by the views (camera basis, plane size,
+// depth mapping) are computed once; the per-view terms four views at a time on MathSIMD lanes.
+//
+// For view offset o = (ox, oy, oz) in camera space (x right, y up, z forward) and convergence
+// distance D, the view sits at cameraPos + ox * right + oy * up + oz * dir and looks along dir.
+// Its frustum is sheared so the convergence plane, W x H half extents at distance D from the
+// camera, maps to the same screen rectangle in every view:
+//
+//   distance to the plane  Dv     = D - oz
+//   shear                  shearX = -ox / Dv, shearY = -oy / Dv
+//   perspective            W = D tan(fov / 2), H = W / aspect; the view field of view is 2 atan(W / Dv)
+//   perspective from plane H = convergencePlaneHeight / 2, W = H * aspect
+//   orthographic           W = orthoWidth / 2, H = orthoHeight / 2, sheared by shearX, shearY
+//
+// Projections are column-major with clip-space depth -w..w, like mat4f::setPerspective. The SDK
+// documents its parameters but not its formulas, so these are checked against it where it runs:
+// the D3D11 sample compares both at startup and keeps the SDK calls if they disagree.
+
+// Same values as leia_view_info_mode.
+enum class ViewInfoMode
+{
+    Perspective          = 0,
+    PerspectiveFromPlane = 1,
+    Orthographic         = 2
+};
+
+// The camera arguments of leia_get_view_info.
+struct ViewInfoCamera
+{
+    ViewInfoMode mode                     = ViewInfoMode::Perspective;
+    vec3f        position                 = vec3f(0.0f);
+    vec3f        direction                = vec3f(0.0f, 1.0f, 0.0f);   // Unit vector
+    vec3f        up                       = vec3f(0.0f, 0.0f, 1.0f);   // Unit vector
+    float        perspectiveFieldOfView   = 1.5707963f;                // Horizontal, radians
+    float        perspectiveAspectRatio   = 1.0f;                      // Width over height
+    float        orthoWidth               = 1.0f;
+    float        orthoHeight              = 1.0f;
+    float        nearPlane                = 1.0f;
+    float        farPlane                 = 10000.0f;
+    float        convergencePlaneDistance = 500.0f;
+    float        convergencePlaneHeight   = 500.0f;                    // PerspectiveFromPlane only
+};
+
+namespace ViewInfoDetail
+{
+    // 2 atan(w / d) per lane, the horizontal field of view of a view at distance d from the plane.
+    inline MathSIMD::Vec4 FieldOfView(MathSIMD::Vec4 w, MathSIMD::Vec4 d)
+    {
+#if defined(CNSDK_MATH_FAST_TRIG)
+        const MathSIMD::Vec4 angle = FastMath::Atan2(w, d);
+        return MathSIMD::Add(angle, angle);
+#else
+        float ws[4], ds[4];
+        MathSIMD::Store(ws, w);
+        MathSIMD::Store(ds, d);
+        return MathSIMD::Set(2.0f * atan2f(ws[0], ds[0]), 2.0f * atan2f(ws[1], ds[1]), 2.0f * atan2f(ws[2], ds[2]), 2.0f * atan2f(ws[3], ds[3]));
+#endif
+    }
+}
+
+// Fill the outputs of leia_get_view_info for views 0 .. viewCount - 1 with offsets viewOffsets.
+// Outputs hold viewCount entries; any may be null. Orthographic views have field of view 0.
+inline void GetViewInfos(const ViewInfoCamera& camera, const vec3f* viewOffsets, int viewCount,
+                         vec3f* viewPositions, mat4f* viewProjections, float* viewFieldOfViews = nullptr, float* viewShearX = nullptr, float* viewShearY = nullptr)
+{
+    using namespace MathSIMD;
+
+    const bool orthographic = (camera.mode == ViewInfoMode::Orthographic);
+
+    // Camera basis.
+    const vec3f forward = camera.direction;
+    const vec3f right   = vec3f::cross(forward, camera.up).getNormal();
+    const vec3f up      = vec3f::cross(right, forward);
+
+    // Half extents of the convergence plane.
+    float halfWidth, halfHeight;
+    if (camera.mode == ViewInfoMode::Perspective)
+    {
+        halfWidth  = camera.convergencePlaneDistance * MathTan(0.5f * camera.perspectiveFieldOfView);
+        halfHeight = halfWidth / camera.perspectiveAspectRatio;
+    }
+    else if (camera.mode == ViewInfoMode::PerspectiveFromPlane)
+    {
+        halfHeight = 0.5f * camera.convergencePlaneHeight;
+        halfWidth  = halfHeight * camera.perspectiveAspectRatio;
+    }
+    else
+    {
+        halfWidth  = 0.5f * camera.orthoWidth;
+        halfHeight = 0.5f * camera.orthoHeight;
+    }
+
+    // Depth mapping, the same for every view.
+    const float n     = camera.nearPlane;
+    const float f     = camera.farPlane;
+    const float depth = orthographic ? -2.0f / (f - n)        : -(f + n) / (f - n);
+    const float shift = orthographic ? -(f + n) / (f - n)     : -(2.0f * f * n) / (f - n);
+
+    const Vec4 invWidth  = Splat(1.0f / halfWidth);
+    const Vec4 invHeight = Splat(1.0f / halfHeight);
+    const Vec4 distance  = Splat(camera.convergencePlaneDistance);
+
+    for (int first = 0; first < viewCount; first += 4)
+    {
+        const int lanes = (viewCount - first < 4) ? (viewCount - first) : 4;
+
+        // Offsets of up to four views, the missing ones zero.
+        float ox[4] = {}, oy[4] = {}, oz[4] = {};
+        for (int j = 0; j < lanes; j++)
+        {
+            ox[j] = viewOffsets[first + j].x;
+            oy[j] = viewOffsets[first + j].y;
+            oz[j] = viewOffsets[first + j].z;
+        }
+        const Vec4 x = Load(ox);
+        const Vec4 y = Load(oy);
+        const Vec4 z = Load(oz);
+
+        const Vec4 planeDistance = Sub(distance, z);
+        const Vec4 invDistance   = Div(Splat(1.0f), planeDistance);
+        const Vec4 shearX        = Mul(Neg(x), invDistance);
+        const Vec4 shearY        = Mul(Neg(y), invDistance);
+
+        // Scale and shear columns of the projections. A perspective view's scale grows with its
+        // distance to the plane; its shear column is the shear times that scale.
+        Vec4 scaleX, scaleY, shearColumnX, shearColumnY;
+        if (orthographic)
+        {
+            scaleX       = invWidth;
+            scaleY       = invHeight;
+            shearColumnX = Mul(shearX, invWidth);
+            shearColumnY = Mul(shearY, invHeight);
+        }
+        else
+        {
+            scaleX       = Mul(planeDistance, invWidth);
+            scaleY       = Mul(planeDistance, invHeight);
+            shearColumnX = Mul(Neg(x), invWidth);
+            shearColumnY = Mul(Neg(y), invHeight);
+        }
+
+        // View positions, one component of four views per register.
+        const Vec4 px = MulAdd(Splat(forward.x), z, MulAdd(Splat(up.x), y, MulAdd(Splat(right.x), x, Splat(camera.position.x))));
+        const Vec4 py = MulAdd(Splat(forward.y), z, MulAdd(Splat(up.y), y, MulAdd(Splat(right.y), x, Splat(camera.position.y))));
+        const Vec4 pz = MulAdd(Splat(forward.z), z, MulAdd(Splat(up.z), y, MulAdd(Splat(right.z), x, Splat(camera.position.z))));
+
+        float lane[10][4];
+        Store(lane[0], scaleX);
+        Store(lane[1], scaleY);
+        Store(lane[2], shearColumnX);
+        Store(lane[3], shearColumnY);
+        Store(lane[4], px);
+        Store(lane[5], py);
+        Store(lane[6], pz);
+        Store(lane[7], shearX);
+        Store(lane[8], shearY);
+        if (viewFieldOfViews != nullptr)
+            Store(lane[9], orthographic ? Splat(0.0f) : ViewInfoDetail::FieldOfView(Splat(halfWidth), planeDistance));
+
+        for (int j = 0; j < lanes; j++)
+        {
+            const int view = first + j;
+
+            if (viewProjections != nullptr)
+            {
+                viewProjections[view] = mat4f
+                (
+                    lane[0][j], 0.0f,       0.0f,  0.0f,
+                    0.0f,       lane[1][j], 0.0f,  0.0f,
+                    lane[2][j], lane[3][j], depth, orthographic ? 0.0f : -1.0f,
+                    0.0f,       0.0f,       shift, orthographic ? 1.0f : 0.0f
+                );
+            }
+            if (viewPositions != nullptr)
+                viewPositions[view] = vec3f(lane[4][j], lane[5][j], lane[6][j]);
+            if (viewShearX != nullptr)
+                viewShearX[view] = lane[7][j];
+            if (viewShearY != nullptr)
+                viewShearY[view] = lane[8][j];
+            if (viewFieldOfViews != nullptr)
+                viewFieldOfViews[view] = lane[9][j];
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#include <math.h>
+#include <algorithm>
+#include "CNSDKGettingStartedViewInfoCache.h"
+
+namespace
+{
+    // Whether a and b differ by at most tolerance relative to their magnitude, at least 1.
+    inline bool IsClose(float a, float b, float tolerance)
+    {
+        return fabsf(a - b) <= tolerance * std::max(1.0f, std::max(fabsf(a), fabsf(b)));
+    }
+
+    inline bool IsClose(const vec3f& a, const vec3f& b, float tolerance)
+    {
+        return IsClose(a.e[0], b.e[0], tolerance) && IsClose(a.e[1], b.e[1], tolerance) && IsClose(a.e[2], b.e[2], tolerance);
+    }
+}
+
+bool ViewInfoCache::find(const ViewInfoCacheKey& key, vec3f* viewPositions, mat4f* viewProjections)
+{
+    if (!m_valid || !matches(key))
+    {
+        m_stats.misses++;
+        return false;
+    }
+
+    m_stats.hits++;
+    if (viewPositions != nullptr)
+        std::copy(m_positions.begin(), m_positions.end(), viewPositions);
+    if (viewProjections != nullptr)
+        std::copy(m_projections.begin(), m_projections.end(), viewProjections);
+    return true;
+}
+
+void ViewInfoCache::insert(const ViewInfoCacheKey& key, const vec3f* viewPositions, const mat4f* viewProjections)
+{
+    if ((key.viewCount <= 0) || (key.viewCount > kViewInfoCacheMaxViews))
+    {
+        m_valid = false;
+        return;
+    }
+
+    m_key = key;
+    m_positions.assign(viewPositions, viewPositions + key.viewCount);
+    m_projections.assign(viewProjections, viewProjections + key.viewCount);
+    m_valid = true;
+}
+
+bool ViewInfoCache::matches(const ViewInfoCacheKey& key) const
+{
+    const float           tolerance = m_tolerance.parameter;
+    const ViewInfoCamera& a         = key.camera;
+    const ViewInfoCamera& b         = m_key.camera;
+
+    if ((key.viewCount != m_key.viewCount) || (a.mode != b.mode))
+        return false;
+
+    // The offsets move the views, so they're held to a distance.
+    const float maxDistanceSq = m_tolerance.viewOffset * m_tolerance.viewOffset;
+    for (int i = 0; i < key.viewCount; i++)
+    {
+        if ((key.viewOffsets[i] - m_key.viewOffsets[i]).getLengthSq() > maxDistanceSq)
+            return false;
+    }
+
+    return IsClose(key.baselineScaling,        m_key.baselineScaling,        tolerance) &&
+           IsClose(a.position,                 b.position,                   tolerance) &&
+           IsClose(a.direction,                b.direction,                  tolerance) &&
+           IsClose(a.up,                       b.up,                         tolerance) &&
+           IsClose(a.perspectiveFieldOfView,   b.perspectiveFieldOfView,     tolerance) &&
+           IsClose(a.perspectiveAspectRatio,   b.perspectiveAspectRatio,     tolerance) &&
+           IsClose(a.orthoWidth,               b.orthoWidth,                 tolerance) &&
+           IsClose(a.orthoHeight,              b.orthoHeight,                tolerance) &&
+           IsClose(a.nearPlane,                b.nearPlane,                  tolerance) &&
+           IsClose(a.farPlane,                 b.farPlane,                   tolerance) &&
+           IsClose(a.convergencePlaneDistance, b.convergencePlaneDistance,   tolerance) &&
+           IsClose(a.convergencePlaneHeight,   b.convergencePlaneHeight,     tolerance);
+}
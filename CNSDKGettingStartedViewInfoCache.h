@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "CNSDKGettingStartedMath.h"
+#include "CNSDKGettingStartedViewInfo.h"
+
+// Most views the cache holds. Views of keys with more are never cached.
+const int kViewInfoCacheMaxViews = 8;
+
+// Everything the views of a camera depend on: the camera, including the convergence distance, and
+// the display's view offsets. The offsets are keyed rather than the tracked face they follow, as
+// the SDK's smoothing and prediction can move them while the face stands still.
+struct ViewInfoCacheKey
+{
+    ViewInfoCamera camera;
+    vec3f          viewOffsets[kViewInfoCacheMaxViews]; // From GetViewOffset, in scene units
+    float          baselineScaling = 1.0f;
+    int            viewCount       = 0;
+};
+
+// How far the inputs may move before the cached views are recomputed.
+struct ViewInfoCacheTolerance
+{
+    float viewOffset = 0.1f;       // Distance any view offset may move, in scene units
+    float parameter  = 1e-5f;      // Difference of any other value relative to its magnitude, at least 1
+};
+
+// Per-view positions and projections of the last camera, reused while its inputs stay within
+// tolerance of the ones they were computed for. A seated viewer or a kiosk with nobody in front
+// of it hits every frame. Inputs are compared with the key of the cached views, not the previous
+// frame's, so slow drift still invalidates once it adds up to the tolerance. Not thread-safe.
+class ViewInfoCache
+{
+public:
+
+    struct Stats
+    {
+        std::uint64_t hits   = 0;
+        std::uint64_t misses = 0;
+
+        // Fraction of lookups that hit, 0 before the first.
+        double getHitRate() const { return (hits + misses > 0) ? (double)hits / (double)(hits + misses) : 0.0; }
+    };
+
+    ViewInfoCache() = default;
+    explicit ViewInfoCache(const ViewInfoCacheTolerance& tolerance) : m_tolerance(tolerance) {}
+
+    // Copy the cached views to viewPositions and viewProjections (key.viewCount entries each, either
+    // may be null) if key is within tolerance of their key. Counts a hit or a miss.
+    bool find(const ViewInfoCacheKey& key, vec3f* viewPositions, mat4f* viewProjections);
+
+    // Replace the cached views with key.viewCount views computed for key.
+    void insert(const ViewInfoCacheKey& key, const vec3f* viewPositions, const mat4f* viewProjections);
+
+    // Drop the cached views, e.g. when a setting the key doesn't cover has changed.
+    void invalidate() { m_valid = false; }
+
+    void                          setTolerance(const ViewInfoCacheTolerance& tolerance) { m_tolerance = tolerance; }
+    const ViewInfoCacheTolerance& getTolerance() const                                  { return m_tolerance; }
+
+    Stats getStats() const { return m_stats; }
+    void  resetStats()     { m_stats = Stats(); }
+
+private:
+
+    // Whether key is within tolerance of m_key.
+    bool matches(const ViewInfoCacheKey& key) const;
+
+    ViewInfoCacheTolerance m_tolerance;
+    ViewInfoCacheKey       m_key;
+    std::vector<vec3f>     m_positions;
+    std::vector<mat4f>     m_projections;
+    bool                   m_valid = false;
+    Stats                  m_stats;
+};
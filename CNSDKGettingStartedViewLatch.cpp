@@ -0,0 +1,47 @@
+#include "CNSDKGettingStartedViewLatch.h"
+
+namespace
+{
+    typedef std::chrono::duration<double> Seconds;
+}
+
+void ViewLatch::beginFrame()
+{
+    m_frameStart = Clock::now();
+}
+
+const FrameViews& ViewLatch::latch()
+{
+    // A failed sample keeps the previous views and their sample time, so their age keeps growing.
+    // So do reused views, which are no newer than the sample they were computed at.
+    const Clock::time_point now = Clock::now();
+    if (m_sample(m_views))
+    {
+        if (!m_views.viewsReused || !m_sampled)
+            m_sampleTime = now;
+        m_readTime = now;
+        m_sampled  = true;
+    }
+    return m_views;
+}
+
+void ViewLatch::submit()
+{
+    if (!m_sampled)
+        return;
+
+    const Clock::time_point now       = Clock::now();
+    const double            staleness = Seconds(now - m_sampleTime).count();
+
+    m_stats.frames++;
+    m_stats.lastStaleness    = staleness;
+    m_stats.maxStaleness     = (staleness > m_stats.maxStaleness) ? staleness : m_stats.maxStaleness;
+    m_stats.totalStaleness  += staleness;
+    if (m_readTime > m_frameStart)
+        m_stats.totalLatchDelay += Seconds(m_readTime - m_frameStart).count();
+}
+
+double ViewLatch::getPoseAge() const
+{
+    return m_sampled ? Seconds(Clock::now() - m_sampleTime).count() : 0.0;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include "CNSDKGettingStartedMath.h"
+
+// Most views a FrameViews block holds.
+const int kMaxLatchedViews = 8;
+
+// Per-frame view block: the tracked pose and everything rendering derives from it.
+struct FrameViews
+{
+    int   viewCount                          = 0;
+    bool  viewsReused                        = false; // The views are those computed at an earlier sample, e.g. a cache hit
+    bool  faceTracked                        = false;
+    vec3f facePosition                       = vec3f(0.0f);
+    vec3f viewPositions[kMaxLatchedViews];
+    mat4f viewProjections[kMaxLatchedViews]; // Projection * view
+};
+
+// Late latching of a frame's views. Pose-independent work is recorded first; latch() then samples
+// the freshest pose into the frame's block right before the pose-dependent commands are issued,
+// and submit() marks when the frame went to the GPU. The time between the two is the pose's
+// staleness at submit, a lower bound on its motion-to-photon latency. Views the sample function
+// reuses (FrameViews::viewsReused) are as stale as the sample they were computed at, so the
+// function must reuse only views computed through this latch.
+//
+// latch() may be called more than once a frame, e.g. for culling and again for drawing; the
+// frame renders with the last sample. Not thread-safe.
+class ViewLatch
+{
+public:
+
+    // Fill views from the tracked pose, setting viewsReused. Returns false to keep the previous
+    // views, e.g. when the tracker has no data yet.
+    typedef std::function<bool(FrameViews& views)> SampleFunction;
+
+    struct Stats
+    {
+        std::uint64_t frames          = 0;
+        double        lastStaleness   = 0.0; // Seconds from the sample the last frame's views were computed at to its submit
+        double        maxStaleness    = 0.0;
+        double        totalStaleness  = 0.0;
+        double        totalLatchDelay = 0.0; // Seconds from beginFrame to the sample, the age the
+                                             // pose would have had if sampled at frame start
+
+        double getMeanStaleness() const { return (frames > 0) ? totalStaleness / (double)frames : 0.0; }
+        double getMeanLatchDelay() const { return (frames > 0) ? totalLatchDelay / (double)frames : 0.0; }
+    };
+
+    explicit ViewLatch(SampleFunction sample) : m_sample(std::move(sample)) {}
+
+    // Start a frame, before any of its work.
+    void beginFrame();
+
+    // Sample the pose into the frame's block. Returns the block to render with.
+    const FrameViews& latch();
+
+    // The frame's commands were submitted. Records the staleness of the last sample.
+    void submit();
+
+    const FrameViews& getViews() const { return m_views; }
+
+    // Seconds since the sample the current views were computed at, 0 before the first sample.
+    double getPoseAge() const;
+
+    Stats getStats() const { return m_stats; }
+    void  resetStats()     { m_stats = Stats(); }
+
+private:
+
+    typedef std::chrono::steady_clock Clock;
+
+    SampleFunction    m_sample;
+    FrameViews        m_views;
+    Clock::time_point m_frameStart;
+    Clock::time_point m_sampleTime; // Of the sample the views were computed at
+    Clock::time_point m_readTime;   // Of the last successful sample, reused views or not
+    bool              m_sampled = false;
+    Stats             m_stats;
+};
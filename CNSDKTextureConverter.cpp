@@ -0,0 +1,314 @@
+// Offline converter from TGA/PNG/JPG images to preprocessed texture files (.ctex), see CNSDKGettingStartedTexture.h.
+//
+// Usage: CNSDKTextureConverter [--linear] [--no-mips] [--bgra] [-o output.ctex] input...
+//
+// Without -o each input is written next to itself with a .ctex extension. PNG and JPG are read with
+// WIC on Windows, and with libpng/libjpeg elsewhere when built with TEXCONV_USE_LIBPNG/TEXCONV_USE_LIBJPEG.
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "CNSDKGettingStartedPixels.h"
+#include "CNSDKGettingStartedTGA.h"
+#include "CNSDKGettingStartedTexture.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <wincodec.h>
+#pragma comment(lib, "windowscodecs.lib")
+#else
+#include <setjmp.h>
+#ifdef TEXCONV_USE_LIBPNG
+#include <png.h>
+#endif
+#ifdef TEXCONV_USE_LIBJPEG
+#include <jpeglib.h>
+#endif
+#endif
+
+struct Image
+{
+    int                       width  = 0;
+    int                       height = 0;
+    std::vector<std::uint8_t> rgba;
+};
+
+static bool HasExtension(const std::string& filename, const char* extension)
+{
+    const size_t length = strlen(extension);
+    if (filename.size() < length)
+        return false;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        const char c = filename[filename.size() - length + i];
+        if (((c >= 'A') && (c <= 'Z') ? (char)(c - 'A' + 'a') : c) != extension[i])
+            return false;
+    }
+    return true;
+}
+
+static bool LoadTGA(const char* filename, Image& image)
+{
+    FileSource file;
+    if (!file.open(filename))
+        return false;
+
+    TGASpanInput input(file.getSpan());
+    TGADecoder   decoder(input);
+    decoder.setOutputFormat(TGAOutputFormat::RGBA8);
+    if (!decoder.readHeader())
+    {
+        fprintf(stderr, "%s: %ls\n", filename, decoder.getError());
+        return false;
+    }
+
+    image.width  = decoder.getWidth();
+    image.height = decoder.getHeight();
+    image.rgba.resize(decoder.getRowSize() * image.height);
+    if (!decoder.decode(image.rgba.data(), decoder.getRowSize()))
+    {
+        fprintf(stderr, "%s: %ls\n", filename, decoder.getError());
+        return false;
+    }
+
+    return true;
+}
+
+#ifdef _WIN32
+
+template <typename T>
+static void SafeRelease(T*& p)
+{
+    if (p != nullptr)
+        p->Release();
+    p = nullptr;
+}
+
+static bool LoadWIC(const char* filename, Image& image)
+{
+    wchar_t path[MAX_PATH];
+    if (MultiByteToWideChar(CP_ACP, 0, filename, -1, path, MAX_PATH) == 0)
+        return false;
+
+    IWICImagingFactory*    factory   = nullptr;
+    IWICBitmapDecoder*     decoder   = nullptr;
+    IWICBitmapFrameDecode* frame     = nullptr;
+    IWICFormatConverter*   converter = nullptr;
+
+    HRESULT hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&factory));
+    if (SUCCEEDED(hr))
+        hr = factory->CreateDecoderFromFilename(path, nullptr, GENERIC_READ, WICDecodeMetadataCacheOnDemand, &decoder);
+    if (SUCCEEDED(hr))
+        hr = decoder->GetFrame(0, &frame);
+    if (SUCCEEDED(hr))
+        hr = factory->CreateFormatConverter(&converter);
+    if (SUCCEEDED(hr))
+        hr = converter->Initialize(frame, GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom);
+
+    UINT width = 0, height = 0;
+    if (SUCCEEDED(hr))
+        hr = converter->GetSize(&width, &height);
+    if (SUCCEEDED(hr))
+    {
+        image.width  = (int)width;
+        image.height = (int)height;
+        image.rgba.resize((size_t)width * height * 4);
+        hr = converter->CopyPixels(nullptr, width * 4, (UINT)image.rgba.size(), image.rgba.data());
+    }
+
+    SafeRelease(converter);
+    SafeRelease(frame);
+    SafeRelease(decoder);
+    SafeRelease(factory);
+    return SUCCEEDED(hr);
+}
+
+#else
+
+#ifdef TEXCONV_USE_LIBPNG
+static bool LoadPNG(const char* filename, Image& image)
+{
+    png_image png = {};
+    png.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_file(&png, filename))
+        return false;
+
+    png.format   = PNG_FORMAT_RGBA;
+    image.width  = (int)png.width;
+    image.height = (int)png.height;
+    image.rgba.resize(PNG_IMAGE_SIZE(png));
+    if (!png_image_finish_read(&png, nullptr, image.rgba.data(), 0, nullptr))
+    {
+        png_image_free(&png);
+        return false;
+    }
+
+    return true;
+}
+#endif
+
+#ifdef TEXCONV_USE_LIBJPEG
+struct JPEGError
+{
+    jpeg_error_mgr manager;
+    jmp_buf        jump;
+};
+
+static void OnJPEGError(j_common_ptr info)
+{
+    longjmp(((JPEGError*)info->err)->jump, 1);
+}
+
+static bool LoadJPEG(const char* filename, Image& image, std::vector<std::uint8_t>& rgb)
+{
+    FILE* file = fopen(filename, "rb");
+    if (file == nullptr)
+        return false;
+
+    jpeg_decompress_struct info;
+    JPEGError              error;
+    info.err                   = jpeg_std_error(&error.manager);
+    error.manager.error_exit   = OnJPEGError;
+    if (setjmp(error.jump))
+    {
+        jpeg_destroy_decompress(&info);
+        fclose(file);
+        return false;
+    }
+
+    jpeg_create_decompress(&info);
+    jpeg_stdio_src(&info, file);
+    jpeg_read_header(&info, TRUE);
+    info.out_color_space = JCS_RGB;
+    jpeg_start_decompress(&info);
+
+    image.width  = (int)info.output_width;
+    image.height = (int)info.output_height;
+    rgb.resize((size_t)image.width * image.height * 3);
+    while (info.output_scanline < info.output_height)
+    {
+        JSAMPROW row = rgb.data() + (size_t)info.output_scanline * image.width * 3;
+        jpeg_read_scanlines(&info, &row, 1);
+    }
+
+    jpeg_finish_decompress(&info);
+    jpeg_destroy_decompress(&info);
+    fclose(file);
+
+    image.rgba.resize((size_t)image.width * image.height * 4);
+    ConvertPixels(image.rgba.data(), PixelFormat::RGBA8, rgb.data(), PixelFormat::RGB8, (size_t)image.width * image.height);
+    return true;
+}
+#endif
+
+#endif
+
+static bool LoadImage(const std::string& filename, Image& image)
+{
+    if (HasExtension(filename, ".tga"))
+        return LoadTGA(filename.c_str(), image);
+
+#ifdef _WIN32
+    return LoadWIC(filename.c_str(), image);
+#else
+#ifdef TEXCONV_USE_LIBPNG
+    if (HasExtension(filename, ".png"))
+        return LoadPNG(filename.c_str(), image);
+#endif
+#ifdef TEXCONV_USE_LIBJPEG
+    if (HasExtension(filename, ".jpg") || HasExtension(filename, ".jpeg"))
+    {
+        std::vector<std::uint8_t> rgb;
+        return LoadJPEG(filename.c_str(), image, rgb);
+    }
+#endif
+    fprintf(stderr, "%s: format not supported in this build\n", filename.c_str());
+    return false;
+#endif
+}
+
+static void PrintUsage()
+{
+    printf("Usage: CNSDKTextureConverter [--linear] [--no-mips] [--bgra] [-o output.ctex] input...\n"
+           "  --linear   Color channels are linear, not sRGB (affects mip filtering)\n"
+           "  --no-mips  Only store the full-size image\n"
+           "  --bgra     Store BGRA8 texels instead of RGBA8\n"
+           "  -o         Output file, only with a single input (default: input with .ctex extension)\n");
+}
+
+int main(int argc, char** argv)
+{
+    bool                     sRGB      = true;
+    bool                     buildMips = true;
+    TextureFormat            format    = TextureFormat::RGBA8;
+    std::string              output;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--linear") == 0)
+            sRGB = false;
+        else if (strcmp(argv[i], "--no-mips") == 0)
+            buildMips = false;
+        else if (strcmp(argv[i], "--bgra") == 0)
+            format = TextureFormat::BGRA8;
+        else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc))
+            output = argv[++i];
+        else if (argv[i][0] == '-')
+        {
+            PrintUsage();
+            return 1;
+        }
+        else
+            inputs.push_back(argv[i]);
+    }
+
+    if (inputs.empty() || (!output.empty() && (inputs.size() != 1)))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+#ifdef _WIN32
+    CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+
+    int failures = 0;
+    for (const std::string& input : inputs)
+    {
+        std::string target = output;
+        if (target.empty())
+        {
+            const size_t dot = input.find_last_of('.');
+            const size_t sep = input.find_last_of("/\\");
+            target = ((dot != std::string::npos) && ((sep == std::string::npos) || (dot > sep)) ? input.substr(0, dot) : input) + ".ctex";
+        }
+
+        Image image;
+        if (!LoadImage(input, image))
+        {
+            fprintf(stderr, "%s: failed to load image\n", input.c_str());
+            failures++;
+            continue;
+        }
+
+        TextureFileBuilder builder;
+        if (!builder.setImage(image.rgba.data(), image.width, image.height, (size_t)image.width * 4, sRGB, buildMips) ||
+            !builder.write(target.c_str(), format))
+        {
+            fprintf(stderr, "%s: %ls\n", target.c_str(), builder.getError());
+            failures++;
+            continue;
+        }
+
+        printf("%s -> %s (%dx%d, %d mips)\n", input.c_str(), target.c_str(), image.width, image.height, builder.getMipCount());
+    }
+
+#ifdef _WIN32
+    CoUninitialize();
+#endif
+
+    return (failures == 0) ? 0 : 1;
+}